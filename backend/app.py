@@ -3,10 +3,11 @@
 from flask import Flask, jsonify, request
 from flask_socketio import SocketIO, emit
 from flask_cors import CORS
+import time
 import traceback
 
 from config import Config
-from solver_manager import SolverManager
+from solver_manager import SolverManager, BatchSolver
 
 # Initialize Flask app
 app = Flask(__name__)
@@ -25,6 +26,9 @@ socketio = SocketIO(
 # Global solver manager
 solver_manager = SolverManager(socketio)
 
+# Shared thread pool for batch jobs
+batch_solver = BatchSolver(Config.BATCH_THREADS)
+
 # ============================================================================
 # REST Endpoints
 # ============================================================================
@@ -102,6 +106,32 @@ def get_default_parameters():
     })
 
 
+@app.route('/api/batch', methods=['POST'])
+def solve_batch():
+    """Solve many jobs on the shared solver pool and return all results"""
+    data = request.get_json(silent=True) or {}
+    jobs = data.get('jobs')
+
+    if not isinstance(jobs, list) or not jobs:
+        return jsonify({'error': 'Expected a non-empty "jobs" list'}), 400
+    if len(jobs) > Config.BATCH_MAX_JOBS:
+        return jsonify({'error': f'At most {Config.BATCH_MAX_JOBS} jobs per request'}), 400
+    if not all(isinstance(job, dict) for job in jobs):
+        return jsonify({'error': 'Every job must be an object'}), 400
+
+    try:
+        start = time.time()
+        results = batch_solver.solve_batch(jobs)
+        return jsonify({
+            'results': results,
+            'elapsedTime': round(time.time() - start, 3),
+            'poolThreads': batch_solver.pool.getNumThreads()
+        })
+    except Exception as e:
+        print(f"Error in batch: {traceback.format_exc()}")
+        return jsonify({'error': f'Server error: {str(e)}'}), 500
+
+
 # ============================================================================
 # WebSocket Events
 # ============================================================================
@@ -246,6 +276,7 @@ if __name__ == '__main__':
     print("  GET  /api/benchmarks")
     print("  GET  /api/benchmarks/<name>")
     print("  GET  /api/parameters")
+    print("  POST /api/batch")
     print("\nWebSocket Events:")
     print("  connect -> connected")
     print("  preview -> preview_loaded (load cities without solving)")
@@ -20,6 +20,13 @@ class Config:
     # ACO solver paths
     BASE_DIR = Path(__file__).parent.parent
     DATA_DIR = BASE_DIR / 'data'
+    # Binary instance caches (memory-mapped, shared by all solver processes)
+    CACHE_DIR = Path(os.environ.get('ACO_CACHE_DIR', BASE_DIR / '.aco_cache'))
+
+    # Batch solving (POST /api/batch): thread slots shared by all batch jobs
+    # (0 = one per hardware thread) and the most jobs accepted per request
+    BATCH_THREADS = int(os.environ.get('ACO_BATCH_THREADS', 0))
+    BATCH_MAX_JOBS = int(os.environ.get('ACO_BATCH_MAX_JOBS', 64))
 
     # Default ACO parameters
     DEFAULT_PARAMS = {
@@ -1,9 +1,12 @@
 """Bridge between Flask and C++ ACO solver"""
 
 import sys
+import threading
 import time
 from pathlib import Path
 
+import numpy as np
+
 # Add python_bindings to path
 sys.path.insert(0, str(Path(__file__).parent.parent / 'python_bindings'))
 
@@ -21,6 +24,7 @@ class SolverManager:
         self.benchmark_name = None
         self.start_time = None
         self.is_running = False
+        self.colony = None  # Colony of the running solve, for stop()
 
     def load_benchmark(self, benchmark_name):
         """Load TSPLIB benchmark file"""
@@ -30,17 +34,18 @@ class SolverManager:
             raise FileNotFoundError(f"Benchmark {benchmark_name} not found at {filepath}")
 
         # Load graph using TSPLoader (auto-searches data/ directories)
+        # and keeps a binary cache so later loads map the preprocessed graph
         loader = aco_solver.TSPLoader(str(filepath))
+        loader.setCacheDirectory(str(Config.CACHE_DIR))
+        loader.setWriteCache(True)
         self.graph = loader.loadGraph()
 
         if not self.graph.isValid():
             raise ValueError(f"Failed to load graph from {benchmark_name}")
 
         # Extract city coordinates for frontend visualization
-        self.cities_coords = [
-            [city.getX(), city.getY()]
-            for city in self.graph.getCities()
-        ]
+        # (one bulk conversion of the zero-copy (n, 2) view, no City objects)
+        self.cities_coords = self.graph.getCoordinatesArray().tolist()
 
         self.benchmark_name = benchmark_name
 
@@ -81,6 +86,8 @@ class SolverManager:
         use_local_search = params.get('useLocalSearch', False)
         use_3opt_param = params.get('use3Opt')
         local_search_mode_param = params.get('localSearchMode')
+        local_search_operator = params.get('localSearchOperator', 'exhaustive')
+        local_search_top_k = params.get('localSearchTopK', 0)  # 0 = one tour per thread
 
         # Smart defaults based on problem size
         # Small problems (<100 cities): can afford 3-opt + all mode
@@ -129,6 +136,7 @@ class SolverManager:
         print(f"  - Local search: {use_local_search}")
         if use_local_search:
             print(f"  - Mode: {local_search_mode}")
+            print(f"  - Operator: {local_search_operator}")
             print(f"  - 3-opt: {use_3opt}")
             if use_3opt_param is None or local_search_mode_param is None:
                 print(f"  - (Auto-adjusted for problem size)")
@@ -144,6 +152,27 @@ class SolverManager:
         elitist_weight = params.get('elitistWeight')  # None = use default (numAnts)
         pheromone_mode = params.get('pheromoneMode', 'all')
         rank_size = params.get('rankSize')  # None = use default (numAnts/2)
+        mmas_restart = params.get('mmasRestartIterations')  # None = use default (100)
+        q0 = params.get('q0')  # None = use default (0.9)
+        xi = params.get('xi')  # None = use default (0.1)
+
+        # Candidate lists (k nearest neighbors per construction step)
+        candidate_list_size = params.get('candidateListSize', 0)
+
+        # Execution backend: 'cpu' or 'cuda' (not available in current builds)
+        backend = params.get('backend', 'cpu')
+        if not aco_solver.AntColony.isBackendAvailable(backend):
+            raise ValueError(f"Backend '{backend}' is not available in this build")
+
+        # Random seed (None = non-deterministic)
+        seed = params.get('seed')
+
+        # Per-phase timings and counters, reported with progress and the result
+        profile = bool(params.get('profile', False))
+
+        # Early stopping: wall-clock budget (seconds) and target gap (% above the known optimum)
+        time_limit = params.get('timeLimit')  # None = no limit
+        target_gap = params.get('targetGap')  # None = no target
 
         # Create colony
         colony = aco_solver.AntColony(
@@ -163,6 +192,8 @@ class SolverManager:
         colony.setUseLocalSearch(use_local_search)
         colony.setUse3Opt(use_3opt)
         colony.setLocalSearchMode(local_search_mode)
+        colony.setLocalSearchOperator(local_search_operator)
+        colony.setLocalSearchTopK(local_search_top_k)
 
         # Configure elitist strategy
         colony.setUseElitist(use_elitist)
@@ -171,6 +202,32 @@ class SolverManager:
         colony.setPheromoneMode(pheromone_mode)
         if rank_size is not None:
             colony.setRankSize(rank_size)
+        if mmas_restart is not None:
+            colony.setMMASRestartIterations(int(mmas_restart))
+        if q0 is not None:
+            colony.setQ0(float(q0))
+        if xi is not None:
+            colony.setXi(float(xi))
+
+        # Configure candidate lists
+        colony.setCandidateListSize(candidate_list_size)
+
+        # Configure execution backend
+        colony.setBackend(backend)
+
+        # Configure random seed
+        if seed is not None:
+            colony.setSeed(int(seed))
+
+        # Configure profiling
+        colony.setProfiling(profile)
+
+        # Configure stopping criteria
+        if time_limit is not None:
+            colony.setTimeLimit(float(time_limit))
+        if target_gap is not None and self.benchmark_name in Config.BENCHMARKS:
+            optimal = Config.BENCHMARKS[self.benchmark_name]['optimal']
+            colony.setTargetDistance(optimal * (1.0 + float(target_gap) / 100.0))
 
         # Initialize
         colony.initialize()
@@ -178,11 +235,15 @@ class SolverManager:
         # Set up progress callback
         self.start_time = time.time()
         self.is_running = True
+        self.colony = colony
 
-        def progress_callback(iteration, best_distance, best_tour, convergence):
-            """Called from C++ every N iterations"""
-            if not self.is_running:
-                return
+        # Running global best over the convergence points reported so far
+        reported = {'best': float('inf')}
+
+        def progress_callback(update):
+            """Called from a C++ worker thread every N iterations (the solver never waits for it)"""
+            if not self.is_running or update.final:
+                return  # The final state is sent as the result
 
             elapsed = time.time() - self.start_time
 
@@ -191,28 +252,33 @@ class SolverManager:
                 # For convergence mode, we don't know total iterations, so just show elapsed time
                 progress_pct = 0  # Indeterminate progress
             else:
-                progress_pct = (iteration / iterations) * 100
+                progress_pct = (update.iteration / iterations) * 100
 
-            # Convert iteration bests to running global bests for convergence graph
-            global_bests = []
-            running_best = float('inf')
-            for dist in convergence:
+            # Convert the new iteration bests to running global bests for the convergence graph
+            new_bests = []
+            running_best = reported['best']
+            for dist in update.newConvergence:
                 running_best = min(running_best, dist)
-                global_bests.append(running_best)
-
-            # Emit progress update via WebSocket
-            self.socketio.emit('progress', {
-                'iteration': iteration,
-                'bestDistance': best_distance,
-                'bestTour': best_tour,
-                'convergenceHistory': global_bests,
-                'cities': self.cities_coords,
+                new_bests.append(running_best)
+            reported['best'] = running_best
+
+            # Emit only what changed: new convergence points, and the tour if it improved
+            message = {
+                'iteration': update.iteration,
+                'bestDistance': update.bestDistance,
+                'convergenceOffset': update.convergenceOffset,
+                'newConvergence': new_bests,
                 'elapsedTime': round(elapsed, 2),
                 'progress': round(progress_pct, 1)
-            })
-
-        # Set callback interval (every 10 iterations by default)
-        colony.setProgressCallback(progress_callback)
+            }
+            if update.tourImproved:
+                message['bestTour'] = update.bestTour
+            if profile:
+                message['profile'] = update.profile.toDict()
+            self.socketio.emit('progress', message)
+
+        # Incremental updates every 10 iterations, delivered asynchronously
+        colony.setIncrementalCallback(progress_callback, True)
         colony.setCallbackInterval(10)
 
         # Configure convergence threshold if using convergence mode
@@ -227,18 +293,15 @@ class SolverManager:
         # Send final result
         elapsed = time.time() - self.start_time
         self.is_running = False
+        self.colony = None
 
-        # Get convergence data (iteration bests from C++)
-        iteration_bests = colony.getConvergenceData()
+        # Get convergence data (view of the iteration bests in C++)
+        iteration_bests = colony.getConvergenceArray()
         total_iterations = len(iteration_bests)
 
         # Convert iteration bests to running global bests (cumulative minimum)
         # This ensures the convergence graph always shows non-increasing values
-        global_bests = []
-        running_best = float('inf')
-        for dist in iteration_bests:
-            running_best = min(running_best, dist)
-            global_bests.append(running_best)
+        global_bests = np.minimum.accumulate(iteration_bests).tolist()
 
         # Calculate optimality gap if we know the optimal distance
         best_distance = best_tour.getDistance()
@@ -252,16 +315,137 @@ class SolverManager:
 
         return {
             'bestDistance': best_distance,
-            'bestTour': best_tour.getSequence(),
+            'bestTour': best_tour.getSequenceArray().tolist(),
             'convergenceHistory': global_bests,
             'cities': self.cities_coords,
             'elapsedTime': round(elapsed, 2),
             'totalIterations': total_iterations,
+            'stopReason': colony.getStopReason(),
             'benchmark': self.benchmark_name,
             'optimalDistance': optimal_distance,
-            'optimalityGap': round(optimality_gap, 2) if optimality_gap is not None else None
+            'optimalityGap': round(optimality_gap, 2) if optimality_gap is not None else None,
+            'profile': colony.getStats().total.toDict() if profile else None
         }
 
     def stop(self):
-        """Stop running solver"""
+        """Stop running solver (the C++ loop returns after its current iteration)"""
         self.is_running = False
+        colony = self.colony
+        if colony is not None:
+            colony.requestStop()
+
+
+class BatchSolver:
+    """Runs many small solves on one shared C++ SolverPool
+
+    Jobs share one thread pool, so concurrent requests never oversubscribe
+    the cores, and each benchmark is loaded once and shared read-only by
+    every job that uses it.
+    """
+
+    def __init__(self, num_threads=0):
+        self.pool = aco_solver.SolverPool(num_threads)
+        self.graphs = {}  # Benchmark name -> shared Graph
+        self.graphs_lock = threading.Lock()
+
+    def get_graph(self, benchmark_name):
+        """Load a benchmark once; later jobs reuse the same graph"""
+        with self.graphs_lock:
+            graph = self.graphs.get(benchmark_name)
+            if graph is not None:
+                return graph
+
+            filepath = Config.DATA_DIR / benchmark_name
+            if not filepath.exists():
+                raise FileNotFoundError(f"Benchmark {benchmark_name} not found at {filepath}")
+
+            loader = aco_solver.TSPLoader(str(filepath))
+            loader.setCacheDirectory(str(Config.CACHE_DIR))
+            loader.setWriteCache(True)
+            graph = loader.loadGraph()
+            if not graph.isValid():
+                raise ValueError(f"Failed to load graph from {benchmark_name}")
+
+            self.graphs[benchmark_name] = graph
+            return graph
+
+    def make_job(self, spec):
+        """Translate one request entry into a SolverJob"""
+        benchmark = spec.get('benchmark')
+        if not benchmark:
+            raise ValueError("Job without benchmark")
+        graph = self.get_graph(benchmark)
+
+        num_ants = spec.get('numAnts')
+        if num_ants is None:
+            num_ants = max(10, min(100, graph.getNumCities()))
+
+        seed = spec.get('seed')
+        use_local_search = spec.get('useLocalSearch', False)
+        time_limit = spec.get('timeLimit', 0)
+
+        configure = None
+        if seed is not None or use_local_search or time_limit:
+            def configure(colony):
+                if seed is not None:
+                    colony.setSeed(int(seed))
+                if use_local_search:
+                    colony.setUseLocalSearch(True)
+                    colony.setUse3Opt(spec.get('use3Opt', graph.getNumCities() < 300))
+                    colony.setLocalSearchMode(spec.get('localSearchMode', 'best'))
+                if time_limit:
+                    colony.setTimeLimit(float(time_limit))
+
+        return aco_solver.SolverJob(
+            graph,
+            numAnts=int(num_ants),
+            alpha=spec.get('alpha', Config.DEFAULT_PARAMS['alpha']),
+            beta=spec.get('beta', Config.DEFAULT_PARAMS['beta']),
+            rho=spec.get('rho', Config.DEFAULT_PARAMS['rho']),
+            Q=spec.get('Q', Config.DEFAULT_PARAMS['Q']),
+            maxIterations=int(spec.get('iterations', Config.DEFAULT_PARAMS['iterations'])),
+            threads=int(spec.get('threads', 1)),
+            priority=int(spec.get('priority', 0)),
+            configure=configure
+        )
+
+    def solve_batch(self, specs):
+        """Submit every job, then wait for all of them (results in request order)"""
+        submitted = []
+        for spec in specs:
+            try:
+                submitted.append((spec, self.pool.submit(self.make_job(spec)), None))
+            except (FileNotFoundError, ValueError) as e:
+                submitted.append((spec, None, str(e)))
+
+        results = []
+        for spec, future, error in submitted:
+            benchmark = spec.get('benchmark')
+            if future is None:
+                results.append({'benchmark': benchmark, 'error': error})
+                continue
+            try:
+                result = future.result()
+            except Exception as e:
+                results.append({'benchmark': benchmark, 'error': str(e)})
+                continue
+
+            best_distance = result.tour.getDistance()
+            optimal_distance = None
+            optimality_gap = None
+            if benchmark in Config.BENCHMARKS:
+                optimal_distance = Config.BENCHMARKS[benchmark]['optimal']
+                optimality_gap = round((best_distance - optimal_distance) / optimal_distance * 100, 2)
+
+            results.append({
+                'benchmark': benchmark,
+                'bestDistance': best_distance,
+                'bestTour': result.tour.getSequenceArray().tolist(),
+                'totalIterations': len(result.convergence),
+                'stopReason': result.stopReason,
+                'waitSeconds': round(result.waitSeconds, 3),
+                'solveSeconds': round(result.solveSeconds, 3),
+                'optimalDistance': optimal_distance,
+                'optimalityGap': optimality_gap
+            })
+        return results
@@ -4,6 +4,9 @@ Quick Analysis Script for Benchmark Results
 
 Usage:
     python analyze_results.py results/benchmark_YYYYMMDD_HHMMSS.csv
+    python analyze_results.py --profile baseline.csv [candidate.csv]
+
+Profile files are written by ant_colony_tsp --profile-csv <file>.
 """
 
 import sys
@@ -133,21 +136,104 @@ def analyze_benchmark(csv_file):
     print("=" * 80)
 
 
+PROFILE_PHASES = ['Construction', 'LocalSearch', 'Selection', 'Deposit', 'Evaporation']
+PROFILE_COUNTERS = ['LSMoves', 'LSEvaluations', 'CandidateFallbacks']
+
+
+def load_profile(csv_file):
+    """Mean time per iteration (ms) of each phase and counters per iteration"""
+    df = pd.read_csv(csv_file)
+    phases = {phase: df[f'{phase}(ms)'].mean() for phase in PROFILE_PHASES}
+    counters = {counter: df[counter].mean() for counter in PROFILE_COUNTERS}
+    return len(df), phases, counters
+
+
+def analyze_profile(csv_files):
+    """Print the per-phase breakdown of one profile, or compare a candidate to a baseline"""
+
+    print("=" * 80)
+    print("  ACO TSP Solver - Phase Profile")
+    print("=" * 80)
+    print()
+
+    baseline_rows, baseline, baseline_counters = load_profile(csv_files[0])
+    baseline_total = sum(baseline.values())
+    print(f"Baseline:  {csv_files[0]} ({baseline_rows} iterations)")
+
+    if len(csv_files) == 1:
+        print()
+        print(f"  {'Phase':15} {'ms/iter':>10} {'Share':>8}")
+        print(f"  {'-'*15} {'-'*10} {'-'*8}")
+        for phase in PROFILE_PHASES:
+            share = baseline[phase] / baseline_total * 100 if baseline_total > 0 else 0
+            print(f"  {phase:15} {baseline[phase]:>10.3f} {share:>7.1f}%")
+        print(f"  {'Total':15} {baseline_total:>10.3f}")
+        print()
+        for counter in PROFILE_COUNTERS:
+            print(f"  {counter + '/iter':25} {baseline_counters[counter]:>14.1f}")
+        print()
+        print("=" * 80)
+        return
+
+    candidate_rows, candidate, candidate_counters = load_profile(csv_files[1])
+    candidate_total = sum(candidate.values())
+    print(f"Candidate: {csv_files[1]} ({candidate_rows} iterations)")
+    print()
+
+    def change(before, after):
+        return (after - before) / before * 100 if before > 0 else 0.0
+
+    # Phases sorted by how much they add to the iteration time
+    print(f"  {'Phase':15} {'Base ms':>10} {'Cand ms':>10} {'Delta ms':>10} {'Change':>9}")
+    print(f"  {'-'*15} {'-'*10} {'-'*10} {'-'*10} {'-'*9}")
+    for phase in sorted(PROFILE_PHASES, key=lambda p: baseline[p] - candidate[p]):
+        delta = candidate[phase] - baseline[phase]
+        print(f"  {phase:15} {baseline[phase]:>10.3f} {candidate[phase]:>10.3f} "
+              f"{delta:>+10.3f} {change(baseline[phase], candidate[phase]):>+8.1f}%")
+    print(f"  {'Total':15} {baseline_total:>10.3f} {candidate_total:>10.3f} "
+          f"{candidate_total - baseline_total:>+10.3f} {change(baseline_total, candidate_total):>+8.1f}%")
+    print()
+
+    # Work counters tell slower kernels apart from kernels doing more work
+    print(f"  {'Counter/iter':25} {'Base':>14} {'Cand':>14} {'Change':>9}")
+    print(f"  {'-'*25} {'-'*14} {'-'*14} {'-'*9}")
+    for counter in PROFILE_COUNTERS:
+        print(f"  {counter:25} {baseline_counters[counter]:>14.1f} {candidate_counters[counter]:>14.1f} "
+              f"{change(baseline_counters[counter], candidate_counters[counter]):>+8.1f}%")
+    print()
+    print("=" * 80)
+
+
 def main():
     parser = argparse.ArgumentParser(
         description='Analyze ACO TSP benchmark results'
     )
     parser.add_argument(
         'csv_file',
-        help='Path to benchmark CSV file'
+        help='Path to benchmark CSV file (profile CSV with --profile)'
+    )
+    parser.add_argument(
+        'candidate_file',
+        nargs='?',
+        help='With --profile: second profile CSV to compare against the first'
+    )
+    parser.add_argument(
+        '--profile',
+        action='store_true',
+        help='Analyze per-iteration phase profiles from ant_colony_tsp --profile-csv'
     )
 
     args = parser.parse_args()
+    if args.candidate_file and not args.profile:
+        parser.error('a second file is only accepted with --profile')
 
     try:
-        analyze_benchmark(args.csv_file)
-    except FileNotFoundError:
-        print(f"Error: File not found: {args.csv_file}")
+        if args.profile:
+            analyze_profile([f for f in (args.csv_file, args.candidate_file) if f])
+        else:
+            analyze_benchmark(args.csv_file)
+    except FileNotFoundError as e:
+        print(f"Error: File not found: {e.filename}")
         sys.exit(1)
     except Exception as e:
         print(f"Error analyzing results: {e}")
@@ -0,0 +1,96 @@
+#!/bin/bash
+
+# ============================================================================
+# NUMA Scaling - Thread Placement and First-Touch Benchmark
+# ============================================================================
+# Measures solve time from 1 thread up to all cores under three placements:
+#
+# - single:  matrices filled on one thread (--no-first-touch), threads
+#            bound close: every page on node 0, the classic layout
+# - close:   parallel first touch, threads fill one socket before the next
+#            (up to cores-per-socket threads this is the 1-socket curve)
+# - spread:  parallel first touch, threads dealt round-robin over the
+#            sockets (from 2 threads on this is the 2-socket curve)
+#
+# Usage:   ./numa_scaling.sh [instance] [trials]
+# Default: fnl4461 (two 160 MB matrices), 3 trials per configuration
+#
+# Output:  results/numa_scaling_<timestamp>.csv
+#          Instance,Placement,Threads,Trial,Milliseconds,Distance
+# ============================================================================
+
+set -e
+
+SCRIPT_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)"
+PROJECT_ROOT="$(dirname "$SCRIPT_DIR")"
+BINARY="$PROJECT_ROOT/cpp/build/bin/ant_colony_tsp"
+DATA_DIR="$PROJECT_ROOT/data"
+RESULTS_DIR="$SCRIPT_DIR/results"
+
+INSTANCE="${1:-fnl4461}"
+TRIALS="${2:-3}"
+ARGS="--ants 64 --iterations 20 --candidates 20 --pheromone-mode mmas --seed 42"
+
+if [ ! -f "$BINARY" ]; then
+    echo "ERROR: Binary not found at: $BINARY"
+    echo "Please build the project first:"
+    echo "  cd cpp && cmake -S . -B build -DCMAKE_BUILD_TYPE=Release && cmake --build build"
+    exit 1
+fi
+if [ ! -f "$DATA_DIR/$INSTANCE.tsp" ]; then
+    echo "ERROR: Instance not found: $DATA_DIR/$INSTANCE.tsp"
+    exit 1
+fi
+
+# Thread counts: 1, 2, 4, ... and the core count itself
+CORES=$(nproc)
+THREADS=()
+for ((t = 1; t < CORES; t *= 2)); do
+    THREADS+=("$t")
+done
+THREADS+=("$CORES")
+
+NODES=$(ls -d /sys/devices/system/node/node[0-9]* 2>/dev/null | wc -l)
+echo "============================================================================"
+echo "  NUMA Scaling: $INSTANCE, $CORES CPUs on $NODES node(s), $TRIALS trials"
+echo "============================================================================"
+if [ "$NODES" -lt 2 ]; then
+    echo "Note: one NUMA node, so the placements should perform alike"
+fi
+
+mkdir -p "$RESULTS_DIR"
+OUTPUT="$RESULTS_DIR/numa_scaling_$(date +%Y%m%d_%H%M%S).csv"
+echo "Instance,Placement,Threads,Trial,Milliseconds,Distance" > "$OUTPUT"
+
+run() {
+    local placement="$1"
+    local threads="$2"
+    local flags
+    case "$placement" in
+        single) flags="--no-first-touch --bind close" ;;
+        close)  flags="--bind close" ;;
+        spread) flags="--bind spread" ;;
+    esac
+
+    local total=0
+    for ((trial = 1; trial <= TRIALS; trial++)); do
+        local start_time end_time output distance elapsed_ms
+        start_time=$(date +%s%N)
+        output=$("$BINARY" "$DATA_DIR/$INSTANCE.tsp" $ARGS --threads "$threads" $flags 2>&1)
+        end_time=$(date +%s%N)
+        elapsed_ms=$(( (end_time - start_time) / 1000000 ))
+        distance=$(echo "$output" | grep "Best tour distance:" | awk '{print $4}')
+        echo "$INSTANCE,$placement,$threads,$trial,$elapsed_ms,$distance" >> "$OUTPUT"
+        total=$(( total + elapsed_ms ))
+    done
+    printf "  %-7s %3d threads: %7d ms (mean)\n" "$placement" "$threads" $(( total / TRIALS ))
+}
+
+for placement in single close spread; do
+    for threads in "${THREADS[@]}"; do
+        run "$placement" "$threads"
+    done
+done
+
+echo ""
+echo "Results written to: $OUTPUT"
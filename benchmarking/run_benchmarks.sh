@@ -29,6 +29,10 @@ NUM_TRIALS=5
 ITERATIONS=100
 NUM_ANTS=30
 
+# Extra solver flags for every run, e.g. to measure local search scaling:
+#   EXTRA_ARGS="--local-search --ls-mode top-k" ./run_benchmarks.sh
+EXTRA_ARGS="${EXTRA_ARGS:-}"
+
 # Test problems (name, optimal_distance)
 declare -A PROBLEMS
 PROBLEMS=(
@@ -150,7 +154,7 @@ run_benchmarks() {
                 log "    Trial $trial/$NUM_TRIALS (${progress}% complete)"
 
                 # Build command
-                local cmd="$BINARY $problem --ants $NUM_ANTS --iterations $ITERATIONS"
+                local cmd="$BINARY $problem --ants $NUM_ANTS --iterations $ITERATIONS $EXTRA_ARGS"
                 if [ "$threads" -eq 1 ]; then
                     cmd="$cmd --serial"
                 elif [ "$threads" -gt 0 ]; then
@@ -204,6 +208,11 @@ generate_summary() {
 - Number of Ants: 30
 - Trials per configuration: 5
 - Thread counts tested: 1, 4, 8, 16, 32, auto-detect
+EOF
+    if [ -n "$EXTRA_ARGS" ]; then
+        echo "- Extra solver flags: $EXTRA_ARGS" >> "$SUMMARY_FILE"
+    fi
+    cat >> "$SUMMARY_FILE" << 'EOF'
 
 **Problems Tested:**
 
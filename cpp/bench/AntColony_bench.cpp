@@ -0,0 +1,202 @@
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include "Ant.h"
+#include "AntColony.h"
+#include "BenchmarkInstances.h"
+#include "Random.h"
+#include "SelectionKernels.h"
+
+namespace {
+
+// Ants per colony: fixed, so the instance size alone scales the work
+constexpr int NUM_ANTS = 16;
+
+// Colony with the default parameters of the command-line solver
+std::unique_ptr<AntColony> makeColony(std::shared_ptr<const Graph> graph, int threads) {
+    auto colony = std::make_unique<AntColony>(std::move(graph), NUM_ANTS, 1.0, 2.0, 0.5, 100.0);
+    colony->setSeed(bench::SEED);
+    colony->setNumThreads(threads);
+    colony->initialize();
+    return colony;
+}
+
+}  // namespace
+
+// One complete tour built from a choice-info row: every step is a roulette
+// selection over all unvisited cities
+static void BM_SelectNextCity(benchmark::State& state) {
+    const std::string& name = bench::kernelInstances()[state.range(0)];
+    auto graph = bench::loadInstance(name);
+    if (!graph) {
+        state.SkipWithError(("instance not found: " + name).c_str());
+        return;
+    }
+    int numCities = graph->getNumCities();
+
+    std::vector<double> choiceRow(numCities);
+    Xoshiro256 rng(bench::SEED);
+    for (double& value : choiceRow) {
+        value = 0.01 + rng.nextDouble();
+    }
+
+    Ant ant(0, numCities, bench::SEED);
+    for (auto _ : state) {
+        ant.reset(0);
+        for (int step = 1; step < numCities; ++step) {
+            ant.visitCity(ant.selectNextCity(choiceRow.data()), *graph);
+        }
+        benchmark::DoNotOptimize(ant.getTourLength());
+    }
+    state.SetLabel(name);
+    state.SetItemsProcessed(state.iterations() * (numCities - 1));
+}
+BENCHMARK(BM_SelectNextCity)->Apply([](benchmark::internal::Benchmark* b) {
+    bench::instanceArgs(b, 4);
+});
+
+// BM_SelectNextCity with the selection kernels of one instruction set
+// (0 = scalar, 1 = AVX2, 2 = AVX-512, 3 = NEON); skipped where unsupported
+static void BM_SelectNextCityIsa(benchmark::State& state) {
+    const std::string& name = bench::kernelInstances()[state.range(0)];
+    auto isa = static_cast<selection::Isa>(state.range(1));
+    auto graph = bench::loadInstance(name);
+    if (!graph) {
+        state.SkipWithError(("instance not found: " + name).c_str());
+        return;
+    }
+    if (!selection::isSupported(isa)) {
+        state.SkipWithError("instruction set not supported");
+        return;
+    }
+    int numCities = graph->getNumCities();
+
+    std::vector<double> choiceRow(numCities);
+    Xoshiro256 rng(bench::SEED);
+    for (double& value : choiceRow) {
+        value = 0.01 + rng.nextDouble();
+    }
+
+    selection::Isa previous = selection::activeKernels().isa;
+    selection::setActiveIsa(isa);
+    Ant ant(0, numCities, bench::SEED);
+    for (auto _ : state) {
+        ant.reset(0);
+        for (int step = 1; step < numCities; ++step) {
+            ant.visitCity(ant.selectNextCity(choiceRow.data()), *graph);
+        }
+        benchmark::DoNotOptimize(ant.getTourLength());
+    }
+    selection::setActiveIsa(previous);
+    state.SetLabel(name + "/" + selection::kernels(isa).name);
+    state.SetItemsProcessed(state.iterations() * (numCities - 1));
+}
+BENCHMARK(BM_SelectNextCityIsa)
+    ->ArgNames({"instance", "isa"})
+    ->ArgsProduct({{0, 1, 2, 3}, {0, 1, 2, 3}});
+
+// All ants build one tour each
+static void BM_ConstructSolutions(benchmark::State& state) {
+    const std::string& name = bench::kernelInstances()[state.range(0)];
+    auto graph = bench::loadInstance(name);
+    if (!graph) {
+        state.SkipWithError(("instance not found: " + name).c_str());
+        return;
+    }
+    int threads = static_cast<int>(state.range(1));
+    auto colony = makeColony(graph, threads);
+
+    for (auto _ : state) {
+        colony->constructSolutions();
+    }
+    state.SetLabel(name);
+    state.SetItemsProcessed(state.iterations() * NUM_ANTS);
+}
+BENCHMARK(BM_ConstructSolutions)->Apply(bench::instanceThreadArgs)->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+// Evaporation and deposits for one iteration's tours
+static void BM_UpdatePheromones(benchmark::State& state) {
+    const std::string& name = bench::kernelInstances()[state.range(0)];
+    auto graph = bench::loadInstance(name);
+    if (!graph) {
+        state.SkipWithError(("instance not found: " + name).c_str());
+        return;
+    }
+    int threads = static_cast<int>(state.range(1));
+    auto colony = makeColony(graph, threads);
+    colony->constructSolutions();
+
+    for (auto _ : state) {
+        colony->updatePheromones();
+    }
+    state.SetLabel(name);
+}
+BENCHMARK(BM_UpdatePheromones)->Apply(bench::instanceThreadArgs)->Unit(benchmark::kMicrosecond)
+    ->UseRealTime();
+
+// Construction with 10-nearest-neighbor candidate lists (one thread). Once its
+// candidates are used up an ant scans every unvisited city for the best
+// pheromone^alpha * heuristic^beta, so the powers are evaluated O(n) times per
+// step there: beta = 2 becomes a multiplication, beta = 2.5 stays std::pow.
+static void BM_ConstructCandidates(benchmark::State& state) {
+    const std::string& name = bench::kernelInstances()[state.range(0)];
+    auto graph = bench::loadInstance(name);
+    if (!graph) {
+        state.SkipWithError(("instance not found: " + name).c_str());
+        return;
+    }
+    double beta = state.range(1) / 10.0;
+    AntColony colony(graph, NUM_ANTS, 1.0, beta, 0.5, 100.0);
+    colony.setSeed(bench::SEED);
+    colony.setNumThreads(1);
+    colony.setCandidateListSize(10);
+    colony.initialize();
+
+    for (auto _ : state) {
+        colony.constructSolutions();
+    }
+    state.SetLabel(name + "/beta=" + std::to_string(beta).substr(0, 3));
+    state.SetItemsProcessed(state.iterations() * NUM_ANTS);
+}
+BENCHMARK(BM_ConstructCandidates)
+    ->ArgNames({"instance", "beta10"})
+    ->ArgsProduct({{1, 2, 3}, {20, 25}})
+    ->Unit(benchmark::kMillisecond);
+
+// The first five iterations (construction, neighbor-list 2-opt on every tour,
+// update) on one thread, with profiling off and on: the cost of the
+// instrumentation. The colony restarts untimed, so both see the same work.
+static void BM_RunIteration(benchmark::State& state) {
+    const std::string& name = bench::kernelInstances()[state.range(0)];
+    auto graph = bench::loadInstance(name);
+    if (!graph) {
+        state.SkipWithError(("instance not found: " + name).c_str());
+        return;
+    }
+    AntColony colony(graph, NUM_ANTS, 1.0, 2.0, 0.5, 100.0);
+    colony.setSeed(bench::SEED);
+    colony.setNumThreads(1);
+    colony.setCandidateListSize(10);
+    colony.setUseLocalSearch(true);
+    colony.setUse3Opt(false);
+    colony.setLocalSearchMode("all");
+    colony.setLocalSearchOperator("neighbor");
+    colony.setProfiling(state.range(1) != 0);
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        colony.initialize();
+        state.ResumeTiming();
+        for (int iteration = 0; iteration < 5; ++iteration) {
+            colony.runIteration();
+        }
+    }
+    state.SetLabel(name + (state.range(1) ? "/profiled" : ""));
+}
+BENCHMARK(BM_RunIteration)
+    ->ArgNames({"instance", "profiling"})
+    ->ArgsProduct({{1, 2, 3}, {0, 1}})
+    ->Unit(benchmark::kMillisecond);
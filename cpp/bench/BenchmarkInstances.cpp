@@ -0,0 +1,109 @@
+#include "BenchmarkInstances.h"
+#include <algorithm>
+#include <map>
+#include <sys/stat.h>
+#include <utility>
+#include "Random.h"
+#include "TSPLoader.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace bench {
+
+const std::vector<std::string>& kernelInstances() {
+    static const std::vector<std::string> names = {"eil51", "a280", "pr1002", "fnl4461"};
+    return names;
+}
+
+std::string instancePath(const std::string& name) {
+    const std::string dataDir = ANT_COLONY_DATA_DIR;
+    const std::vector<std::string> candidates = {
+        dataDir + "/" + name + ".tsp",
+        dataDir + "/../uncompatibleData/OTHER/" + name + ".tsp",
+        dataDir + "/../uncompatibleData/EXPLICIT/" + name + ".tsp",
+        dataDir + "/../uncompatibleData/GEO/" + name + ".tsp",
+        dataDir + "/../uncompatibleData/ATT/" + name + ".tsp"
+    };
+    for (const auto& path : candidates) {
+        struct stat buffer;
+        if (stat(path.c_str(), &buffer) == 0) {
+            return path;
+        }
+    }
+    return std::string();
+}
+
+std::shared_ptr<const Graph> loadInstance(const std::string& name, DistanceStorage storage) {
+    static std::map<std::pair<std::string, DistanceStorage>, std::shared_ptr<const Graph>> cache;
+
+    auto key = std::make_pair(name, storage);
+    auto found = cache.find(key);
+    if (found != cache.end()) {
+        return found->second;
+    }
+
+    std::shared_ptr<const Graph> graph;
+    std::string path = instancePath(name);
+    if (!path.empty()) {
+        auto loaded = std::make_shared<Graph>(TSPLoader(path).loadGraph(storage));
+        if (loaded->isValid()) {
+            graph = loaded;
+        }
+    }
+    cache[key] = graph;
+    return graph;
+}
+
+std::vector<int> randomTour(int numCities, std::uint64_t seed) {
+    std::vector<int> sequence(numCities);
+    for (int i = 0; i < numCities; ++i) {
+        sequence[i] = i;
+    }
+    Xoshiro256 rng(seed);
+    for (int i = numCities - 1; i > 0; --i) {
+        std::swap(sequence[i], sequence[rng.nextInt(i + 1)]);
+    }
+    return sequence;
+}
+
+double tourLength(const Graph& graph, const std::vector<int>& sequence) {
+    double length = 0.0;
+    for (std::size_t i = 0; i < sequence.size(); ++i) {
+        length += graph.getDistance(sequence[i], sequence[(i + 1) % sequence.size()]);
+    }
+    return length;
+}
+
+std::vector<int> threadCounts() {
+    int maxThreads = 1;
+#ifdef _OPENMP
+    maxThreads = std::max(1, omp_get_max_threads());
+#endif
+    std::vector<int> counts;
+    for (int t = 1; t < maxThreads; t *= 2) {
+        counts.push_back(t);
+    }
+    counts.push_back(maxThreads);
+    return counts;
+}
+
+void instanceThreadArgs(benchmark::internal::Benchmark* b) {
+    b->ArgNames({"instance", "threads"});
+    for (int i = 0; i < static_cast<int>(kernelInstances().size()); ++i) {
+        for (int threads : threadCounts()) {
+            b->Args({i, threads});
+        }
+    }
+}
+
+void instanceArgs(benchmark::internal::Benchmark* b, int numInstances) {
+    b->ArgName("instance");
+    numInstances = std::min(numInstances, static_cast<int>(kernelInstances().size()));
+    for (int i = 0; i < numInstances; ++i) {
+        b->Arg(i);
+    }
+}
+
+}  // namespace bench
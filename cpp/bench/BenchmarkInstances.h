@@ -0,0 +1,47 @@
+#ifndef BENCHMARKINSTANCES_H
+#define BENCHMARKINSTANCES_H
+
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "Graph.h"
+
+// Shared setup of the micro-benchmarks: instance files, cached graphs, seeds
+// and the argument lists that sweep instance sizes and thread counts.
+namespace bench {
+
+// Seed of every random choice in the benchmarks (tours, colonies, ants)
+constexpr std::uint64_t SEED = 42;
+
+// Instances swept by the kernel benchmarks, selected by benchmark argument
+const std::vector<std::string>& kernelInstances();
+
+// Path of an instance: data/ first, then the uncompatibleData/ subdirectories.
+// Returns an empty string if the file is not found.
+std::string instancePath(const std::string& name);
+
+// Load an instance once per storage mode and keep it for later benchmarks.
+// Returns nullptr if the file is missing or invalid.
+std::shared_ptr<const Graph> loadInstance(const std::string& name,
+                                          DistanceStorage storage = DistanceStorage::FULL_DOUBLE);
+
+// Seeded random permutation of 0..numCities-1
+std::vector<int> randomTour(int numCities, std::uint64_t seed);
+
+// Closed tour length under the graph's metric
+double tourLength(const Graph& graph, const std::vector<int>& sequence);
+
+// Thread counts to sweep: 1, 2, 4, ... up to the OpenMP maximum (always included)
+std::vector<int> threadCounts();
+
+// Args {instance index, threads} for every kernel instance and thread count
+void instanceThreadArgs(benchmark::internal::Benchmark* b);
+
+// Args {instance index} for the first numInstances kernel instances
+void instanceArgs(benchmark::internal::Benchmark* b, int numInstances);
+
+}  // namespace bench
+
+#endif // BENCHMARKINSTANCES_H
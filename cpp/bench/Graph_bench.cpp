@@ -0,0 +1,56 @@
+#include <benchmark/benchmark.h>
+#include <string>
+#include "BenchmarkInstances.h"
+#include "Graph.h"
+
+namespace {
+
+const DistanceStorage STORAGES[] = {
+    DistanceStorage::FULL_DOUBLE, DistanceStorage::FULL_FLOAT, DistanceStorage::TRIANGULAR_DOUBLE,
+    DistanceStorage::TRIANGULAR_FLOAT, DistanceStorage::ON_THE_FLY
+};
+const char* STORAGE_NAMES[] = {"full", "full-float", "triangular", "triangular-float", "on-the-fly"};
+
+}  // namespace
+
+// Build a graph (distance matrix in the given layout) from already parsed cities
+static void BM_GraphConstruction(benchmark::State& state) {
+    const std::string& name = bench::kernelInstances()[state.range(0)];
+    auto source = bench::loadInstance(name, DistanceStorage::ON_THE_FLY);
+    if (!source) {
+        state.SkipWithError(("instance not found: " + name).c_str());
+        return;
+    }
+    DistanceStorage storage = STORAGES[state.range(1)];
+
+    for (auto _ : state) {
+        Graph graph(source->getCities(), storage, source->getDistanceMetric());
+        benchmark::DoNotOptimize(graph.getDistanceMemoryBytes());
+    }
+    state.SetLabel(name + "/" + STORAGE_NAMES[state.range(1)]);
+    state.counters["cities"] = source->getNumCities();
+}
+BENCHMARK(BM_GraphConstruction)
+    ->ArgNames({"instance", "storage"})
+    ->ArgsProduct({benchmark::CreateDenseRange(0, 3, 1), benchmark::CreateDenseRange(0, 4, 1)})
+    ->Unit(benchmark::kMillisecond);
+
+// Nearest-neighbor lists (k = 10), as built for candidate lists and local search
+static void BM_NeighborLists(benchmark::State& state) {
+    const std::string& name = bench::kernelInstances()[state.range(0)];
+    auto graph = bench::loadInstance(name);
+    if (!graph) {
+        state.SkipWithError(("instance not found: " + name).c_str());
+        return;
+    }
+
+    for (auto _ : state) {
+        std::vector<int> lists = graph->computeNeighborLists(10);
+        benchmark::DoNotOptimize(lists.data());
+    }
+    state.SetLabel(name);
+    state.counters["cities"] = graph->getNumCities();
+}
+BENCHMARK(BM_NeighborLists)->Apply([](benchmark::internal::Benchmark* b) {
+    bench::instanceArgs(b, 4);
+})->Unit(benchmark::kMillisecond);
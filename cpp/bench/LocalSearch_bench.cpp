@@ -0,0 +1,62 @@
+#include <benchmark/benchmark.h>
+#include <string>
+#include <vector>
+#include "BenchmarkInstances.h"
+#include "LocalSearch.h"
+#include "Tour.h"
+
+namespace {
+
+// Improve a seeded random tour (2-opt optimal first if startTwoOpt) to a local
+// optimum with the given operator
+template <typename Operator>
+void runLocalSearch(benchmark::State& state, bool startTwoOpt, Operator improve) {
+    const std::string& name = bench::kernelInstances()[state.range(0)];
+    auto graph = bench::loadInstance(name);
+    if (!graph) {
+        state.SkipWithError(("instance not found: " + name).c_str());
+        return;
+    }
+    std::vector<int> start = bench::randomTour(graph->getNumCities(), bench::SEED);
+    double startLength = bench::tourLength(*graph, start);
+    if (startTwoOpt) {
+        Tour optimized(start, startLength);
+        LocalSearch::twoOpt(optimized, *graph);
+        start = optimized.getSequence();
+        startLength = optimized.getDistance();
+    }
+
+    double finalLength = startLength;
+    for (auto _ : state) {
+        Tour tour(start, startLength);
+        improve(tour, *graph);
+        finalLength = tour.getDistance();
+        benchmark::DoNotOptimize(finalLength);
+    }
+    state.SetLabel(name);
+    state.counters["start_length"] = startLength;
+    state.counters["final_length"] = finalLength;
+}
+
+}  // namespace
+
+// Exhaustive 2-opt from a random tour (eil51, a280, pr1002)
+static void BM_TwoOpt(benchmark::State& state) {
+    runLocalSearch(state, false, [](Tour& tour, const Graph& graph) {
+        LocalSearch::twoOpt(tour, graph);
+    });
+}
+BENCHMARK(BM_TwoOpt)->Apply([](benchmark::internal::Benchmark* b) {
+    bench::instanceArgs(b, 3);
+})->Unit(benchmark::kMillisecond);
+
+// Exhaustive 3-opt (O(n^3) per pass) after 2-opt, as in LocalSearch::improve();
+// small instances only
+static void BM_ThreeOpt(benchmark::State& state) {
+    runLocalSearch(state, true, [](Tour& tour, const Graph& graph) {
+        LocalSearch::threeOpt(tour, graph);
+    });
+}
+BENCHMARK(BM_ThreeOpt)->Apply([](benchmark::internal::Benchmark* b) {
+    bench::instanceArgs(b, 2);
+})->Unit(benchmark::kMillisecond);
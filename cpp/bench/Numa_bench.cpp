@@ -0,0 +1,55 @@
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <string>
+#include <vector>
+#include "AntColony.h"
+#include "BenchmarkInstances.h"
+#include "NumaPlacement.h"
+
+namespace {
+
+constexpr int NUM_ANTS = 16;
+
+// Largest kernel instance: its matrices are far larger than the caches
+constexpr int INSTANCE = 3;
+
+}  // namespace
+
+// Full iterations on matrices first touched on one thread (placement 0: all
+// pages on one node) or by the compute threads (placement 1). The graph and
+// trails are rebuilt per run because pages keep their first placement. On a
+// multi-socket machine run it with OMP_PROC_BIND=spread OMP_PLACES=cores so
+// threads stay on their socket; on one node both placements perform alike.
+static void BM_IterationPlacement(benchmark::State& state) {
+    const std::string& name = bench::kernelInstances()[INSTANCE];
+    auto cached = bench::loadInstance(name);
+    if (!cached) {
+        state.SkipWithError(("instance not found: " + name).c_str());
+        return;
+    }
+    bool parallelFirstTouch = state.range(0) != 0;
+    int threads = static_cast<int>(state.range(1));
+
+    bool previous = numa::isFirstTouchEnabled();
+    numa::setFirstTouchEnabled(parallelFirstTouch);
+    auto graph = std::make_shared<const Graph>(cached->getCities());
+    AntColony colony(graph, NUM_ANTS, 1.0, 2.0, 0.5, 100.0);
+    colony.setSeed(bench::SEED);
+    colony.setNumThreads(threads);
+    colony.initialize();
+    numa::setFirstTouchEnabled(previous);
+
+    for (auto _ : state) {
+        colony.runIteration();
+    }
+    state.SetLabel(name + (parallelFirstTouch ? "/parallel-first-touch" : "/single-first-touch"));
+    state.SetItemsProcessed(state.iterations() * NUM_ANTS);
+}
+BENCHMARK(BM_IterationPlacement)->Apply([](benchmark::internal::Benchmark* b) {
+    b->ArgNames({"placement", "threads"});
+    for (int placement : {0, 1}) {
+        for (int threads : bench::threadCounts()) {
+            b->Args({placement, threads});
+        }
+    }
+})->Unit(benchmark::kMillisecond)->UseRealTime();
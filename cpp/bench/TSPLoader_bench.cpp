@@ -0,0 +1,83 @@
+#include <benchmark/benchmark.h>
+#include <filesystem>
+#include <string>
+#include <utility>
+#include <vector>
+#include "BenchmarkInstances.h"
+#include "TSPLoader.h"
+
+namespace {
+
+// Files loaded by BM_TSPLoad: coordinate instances from small to 85,900 cities
+// plus an explicit distance matrix
+const std::vector<std::string>& loadInstances() {
+    static const std::vector<std::string> names = {"eil51", "pr1002", "fnl4461", "d18512",
+                                                   "pla85900", "si1032"};
+    return names;
+}
+
+}  // namespace
+
+// Parse a file into a graph. on-the-fly storage keeps the distance matrix out of
+// the measurement for coordinate files; EXPLICIT files always store their matrix.
+static void BM_TSPLoad(benchmark::State& state) {
+    const std::string& name = loadInstances()[state.range(0)];
+    std::string path = bench::instancePath(name);
+    if (path.empty()) {
+        state.SkipWithError(("instance not found: " + name).c_str());
+        return;
+    }
+
+    int numCities = 0;
+    for (auto _ : state) {
+        Graph graph = TSPLoader(path).loadGraph(DistanceStorage::ON_THE_FLY);
+        numCities = graph.getNumCities();
+        benchmark::DoNotOptimize(numCities);
+    }
+    state.SetLabel(name);
+    state.counters["cities"] = numCities;
+    state.SetItemsProcessed(state.iterations() * numCities);
+}
+BENCHMARK(BM_TSPLoad)->DenseRange(0, 5)->ArgName("instance")->Unit(benchmark::kMillisecond);
+
+// Everything a solver run does before the first iteration: load, neighbor lists
+// (k = 10) and the nearest neighbor tour, parsed (cached = 0) or mapped from a
+// binary cache (cached = 1). Caches live in a temporary directory.
+static void BM_Startup(benchmark::State& state) {
+    static const std::vector<std::pair<std::string, DistanceStorage>> instances = {
+        {"pr1002", DistanceStorage::FULL_DOUBLE},
+        {"fnl4461", DistanceStorage::FULL_DOUBLE},
+        {"d18512", DistanceStorage::ON_THE_FLY},
+    };
+    const std::string& name = instances[state.range(0)].first;
+    DistanceStorage storage = instances[state.range(0)].second;
+    bool cached = state.range(1) != 0;
+    std::string path = bench::instancePath(name);
+    if (path.empty()) {
+        state.SkipWithError(("instance not found: " + name).c_str());
+        return;
+    }
+
+    std::string cacheDirectory =
+        (std::filesystem::temp_directory_path() / "ant_colony_bench_cache").string();
+    if (cached) {
+        TSPLoader writer(path);
+        writer.setCacheDirectory(cacheDirectory);
+        writer.setWriteCache(true);
+        writer.loadGraph(storage);
+    }
+
+    for (auto _ : state) {
+        TSPLoader loader(path);
+        // Uncached runs look in an empty directory, so they always parse
+        loader.setCacheDirectory(cached ? cacheDirectory : cacheDirectory + "/none");
+        Graph graph = loader.loadGraph(storage);
+        graph.buildNeighborLists(10);
+        benchmark::DoNotOptimize(graph.nearestNeighborTourLength());
+    }
+    state.SetLabel(name + (cached ? "/cached" : "/parsed"));
+}
+BENCHMARK(BM_Startup)
+    ->ArgNames({"instance", "cached"})
+    ->ArgsProduct({{0, 1, 2}, {0, 1}})
+    ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,35 @@
+#include <benchmark/benchmark.h>
+#include <string>
+#include "BenchmarkInstances.h"
+#include "SelectionKernels.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+// Google Benchmark entry point with the run settings recorded in the JSON context,
+// so results from different machines and builds can be told apart
+int main(int argc, char** argv) {
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+
+    benchmark::AddCustomContext("seed", std::to_string(bench::SEED));
+    benchmark::AddCustomContext("data_dir", ANT_COLONY_DATA_DIR);
+    benchmark::AddCustomContext("selection_kernels", selection::activeKernels().name);
+#ifdef _OPENMP
+    benchmark::AddCustomContext("openmp_max_threads", std::to_string(omp_get_max_threads()));
+#else
+    benchmark::AddCustomContext("openmp_max_threads", "0");
+#endif
+#ifdef NDEBUG
+    benchmark::AddCustomContext("assertions", "off");
+#else
+    benchmark::AddCustomContext("assertions", "on");
+#endif
+
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -0,0 +1,88 @@
+/**
+ * @file AlignedAllocator.h
+ * @brief Standard-conforming allocator returning over-aligned memory
+ *
+ * Used for the large n×n matrices (distances, pheromones) so that each
+ * buffer starts on a cache-line boundary, which keeps rows from straddling
+ * cache lines and lets the compiler use aligned vector loads.
+ *
+ * resize(count) default-initializes: arithmetic elements are left unwritten,
+ * so the pages of a fresh buffer are first touched (and, on NUMA systems,
+ * placed) by whichever threads fill it, not by the allocating thread.
+ */
+
+#ifndef ALIGNEDALLOCATOR_H
+#define ALIGNEDALLOCATOR_H
+
+#include <cstddef>
+#include <new>
+#include <utility>
+#include <vector>
+
+/// Cache line size assumed for matrix storage (bytes)
+constexpr std::size_t CACHE_LINE_SIZE = 64;
+
+/**
+ * @class AlignedAllocator
+ * @brief Allocator for std::vector that aligns storage to Alignment bytes
+ * @tparam T Element type
+ * @tparam Alignment Required alignment in bytes (power of two)
+ */
+template <typename T, std::size_t Alignment = CACHE_LINE_SIZE>
+class AlignedAllocator {
+public:
+    using value_type = T;
+
+    template <typename U>
+    struct rebind {
+        using other = AlignedAllocator<U, Alignment>;
+    };
+
+    AlignedAllocator() noexcept = default;
+
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment>&) noexcept {}
+
+    T* allocate(std::size_t count) {
+        return static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t(Alignment)));
+    }
+
+    void deallocate(T* pointer, std::size_t /*count*/) noexcept {
+        ::operator delete(pointer, std::align_val_t(Alignment));
+    }
+
+    /// Default-initialize (no zeroing of arithmetic types, see @file)
+    template <typename U>
+    void construct(U* pointer) noexcept(noexcept(::new (static_cast<void*>(pointer)) U)) {
+        ::new (static_cast<void*>(pointer)) U;
+    }
+
+    template <typename U, typename... Args>
+    void construct(U* pointer, Args&&... args) {
+        ::new (static_cast<void*>(pointer)) U(std::forward<Args>(args)...);
+    }
+
+    template <typename U>
+    bool operator==(const AlignedAllocator<U, Alignment>&) const noexcept { return true; }
+
+    template <typename U>
+    bool operator!=(const AlignedAllocator<U, Alignment>&) const noexcept { return false; }
+};
+
+/// Contiguous vector whose data() is cache-line aligned
+template <typename T>
+using AlignedVector = std::vector<T, AlignedAllocator<T>>;
+
+/**
+ * @brief Round a row length up so every row starts on a cache-line boundary
+ * @tparam T Element type stored in the row
+ * @param count Number of elements per row
+ * @return Padded row stride in elements
+ */
+template <typename T>
+constexpr std::size_t alignedRowStride(std::size_t count) {
+    constexpr std::size_t perLine = CACHE_LINE_SIZE / sizeof(T);
+    return (count + perLine - 1) / perLine * perLine;
+}
+
+#endif // ALIGNEDALLOCATOR_H
@@ -1,10 +1,11 @@
 #ifndef ANT_H
 #define ANT_H
 
+#include <cstdint>
 #include <vector>
-#include <random>
 #include "Graph.h"
 #include "PheromoneMatrix.h"
+#include "Random.h"
 #include "Tour.h"
 
 class Ant {
@@ -12,16 +13,45 @@ public:
     // Constants
     static constexpr double EPSILON_DISTANCE = 1e-10;  // Minimum distance to avoid division by zero
 
-    // Constructor
+    // Constructor (random generator seeded from std::random_device)
     Ant(int startCity, int numCities);
 
-    // Reset ant to start a new tour
+    // Constructor with a deterministic random stream
+    Ant(int startCity, int numCities, std::uint64_t seed);
+
+    // Restart this ant's random stream from a seed
+    void setSeed(std::uint64_t seed) { rng_.seed(seed); }
+
+    // Reset ant to start a new tour (reuses its buffers, no allocation)
     void reset(int startCity);
 
     // Choose next city probabilistically based on pheromone and heuristic
     int selectNextCity(const Graph& graph, const PheromoneMatrix& pheromones,
                       double alpha, double beta);
 
+    // Choose next city among the unvisited cities of a candidate list (usually the
+    // k nearest neighbors of the current city). Falls back to the best remaining city
+    // (highest pheromone^alpha * heuristic^beta) only when all candidates are visited.
+    int selectNextCityFromCandidates(const Graph& graph, const PheromoneMatrix& pheromones,
+                                     double alpha, double beta,
+                                     const int* candidates, int numCandidates);
+
+    // Choose next city from a precomputed choice-info row, where
+    // choiceRow[j] = pheromone(current, j)^alpha * heuristic(current, j)^beta.
+    // Avoids all std::pow calls in the construction loop.
+    // With q0 > 0 (Ant Colony System pseudo-random-proportional rule) the ant
+    // exploits with probability q0, taking the unvisited city with the largest
+    // choice info, and otherwise falls back to roulette selection.
+    int selectNextCity(const double* choiceRow, double q0 = 0.0);
+
+    // Candidate-list variant using precomputed choice info: candidateChoice[c] is the
+    // choice info of candidates[c]. The graph, pheromones, alpha and beta are only used
+    // for the (rare) best-remaining-city fallback. q0 as for selectNextCity().
+    int selectNextCityFromCandidates(const int* candidates, const double* candidateChoice,
+                                     int numCandidates, const Graph& graph,
+                                     const PheromoneMatrix& pheromones,
+                                     double alpha, double beta, double q0 = 0.0);
+
     // Add city to tour
     void visitCity(int city, const Graph& graph);
 
@@ -31,24 +61,44 @@ public:
     // Finalize and return the tour
     Tour completeTour(const Graph& graph);
 
+    // Finalize the tour into an existing Tour, reusing its storage
+    void completeTour(const Graph& graph, Tour& tour) const;
+
     // Calculate total tour distance
     double calculateTourLength(const Graph& graph) const;
 
     // Getters
     int getCurrentCity() const { return currentCity_; }
+    int getNumCities() const { return numCities_; }
     const std::vector<int>& getTour() const { return tour_; }
     double getTourLength() const { return tourLength_; }
-    bool hasVisited(int city) const { return visited_[city]; }
+    bool hasVisited(int city) const { return visited_[city] != 0; }
+
+    // Candidate-list steps since reset() that found every candidate visited and
+    // took the best remaining city instead
+    int getCandidateFallbacks() const { return candidateFallbacks_; }
 
 private:
+    // Attractiveness of moving from the current city: pheromone^alpha * heuristic^beta,
+    // with the powers given as functors from Power.h
+    template <typename AlphaPower, typename BetaPower>
+    double edgeWeight(int city, const Graph& graph, const PheromoneMatrix& pheromones,
+                      AlphaPower alphaPower, BetaPower betaPower) const;
+
+    // Deterministic fallback: unvisited city with the highest edge weight
+    // (counted in candidateFallbacks_ when there is one)
+    int selectBestRemainingCity(const Graph& graph, const PheromoneMatrix& pheromones,
+                                double alpha, double beta);
+
     int currentCity_;
-    std::vector<bool> visited_;
+    std::vector<std::uint8_t> visited_;  // Byte mask: plain loads, no bit twiddling
     std::vector<int> tour_;
     double tourLength_;
     int numCities_;
+    int candidateFallbacks_ = 0;
 
-    // Shared random number generator for all ants
-    static std::mt19937& getRandomGenerator();
+    // Per-ant random stream: ants never share generator state across threads
+    Xoshiro256 rng_;
 };
 
 #endif // ANT_H
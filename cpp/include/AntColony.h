@@ -1,24 +1,43 @@
 #ifndef ANTCOLONY_H
 #define ANTCOLONY_H
 
+#include <atomic>
+#include <cstdint>
 #include <vector>
-#include <random>
 #include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
 #include "Graph.h"
 #include "PheromoneMatrix.h"
 #include "Ant.h"
+#include "GpuColony.h"
+#include "Random.h"
 #include "Tour.h"
 #include "LocalSearch.h"
+#include "ColonyStats.h"
+#include "ProgressReporter.h"
 
 class AntColony {
 public:
     // Progress callback: iteration number, best distance, best tour sequence, convergence history
     using ProgressCallback = std::function<void(int, double, const std::vector<int>&, const std::vector<double>&)>;
 
-    // Constructor
+    // Incremental progress callback: only what changed since the previous call
+    using IncrementalCallback = ProgressReporter::Callback;
+
+    // Constructor (copies the graph into colony-owned shared storage)
     AntColony(const Graph& graph, int numAnts, double alpha, double beta,
               double rho, double Q, bool useDistinctStartCities = false);
 
+    // Constructor sharing a read-only graph without copying it.
+    // Several colonies (or other owners) may hold the same graph; it must not be
+    // modified while they run. Neighbor lists already built on the graph are reused
+    // for candidate lists, otherwise the colony computes its own.
+    AntColony(std::shared_ptr<const Graph> graph, int numAnts, double alpha, double beta,
+              double rho, double Q, bool useDistinctStartCities = false);
+
     // Initialize pheromones and ants
     void initialize();
 
@@ -31,13 +50,105 @@ public:
     // Evaporate and deposit pheromones
     void updatePheromones();
 
+    // Adopt a tour found elsewhere (e.g. another colony of a MultiColony): if it is
+    // shorter than the best-so-far tour it replaces it and its edges receive one
+    // best-tour deposit. Tours of the wrong size or no better are ignored.
+    void importTour(const Tour& tour);
+
+    // Add pheromone to individual edges (both directions), e.g. the trail changes
+    // another process reported, then re-apply the trail limits and refresh the
+    // choice info. edges[i] receives amounts[i]; invalid edges are skipped.
+    void addPheromoneEdges(const std::vector<std::pair<int, int>>& edges,
+                           const std::vector<double>& amounts);
+
     // Run algorithm for specified iterations (or until convergence if maxIterations < 0)
-    // If maxIterations < 0, runs until no improvement for convergenceThreshold_ iterations
+    // If maxIterations < 0, runs until no improvement for convergenceThreshold_ iterations.
+    // The time limit (counted from the call, setup included), target distance and
+    // requestStop() end the run early; they are checked before every iteration,
+    // the first one included. Stopped before any iteration, solve() returns the
+    // warm start or the nearest neighbor tour. getStopReason() tells which
+    // criterion ended the run.
     Tour solve(int maxIterations, ProgressCallback callback = nullptr);
 
+    // Wall-clock budget for solve() in seconds (default: 0 = none). An iteration is
+    // not started if the previous one suggests it would overrun the budget.
+    void setTimeLimit(double seconds);
+
+    // Stop solve() once the best tour is at most this long (default: 0 = none)
+    void setTargetDistance(double distance);
+
+    // Ask solve() to return after the current iteration. Safe to call from any
+    // thread; a request made before solve() starts stops it before its first
+    // iteration. solve() clears the request when it returns.
+    void requestStop();
+
+    // Why the last solve() returned: "iterations", "convergence", "time-limit",
+    // "target" or "stopped" (empty before the first solve())
+    const std::string& getStopReason() const { return stopReason_; }
+
+    // Copy of the best tour so far and the number of completed iterations, safe
+    // to read from another thread while solve() is running
+    Tour getBestTourSnapshot() const;
+    int getCompletedIterations() const { return completedIterations_.load(std::memory_order_relaxed); }
+
+    // Save the search state to a versioned binary file: trails (upper triangle,
+    // full precision), best tour, iteration history, random stream, MMAS state
+    // and the search parameters (ants, alpha, beta, rho, Q, pheromone mode and
+    // its settings, candidate list size, seed). Written to a temporary file and
+    // renamed, so a crash never leaves a partial checkpoint. Returns false if
+    // there is nothing to save yet or the file cannot be written.
+    bool checkpoint(const std::string& path) const;
+
+    // Load a checkpoint of this instance (same city count, and its best tour
+    // must have the recorded length on this graph). The next solve() continues
+    // from it instead of calling initialize(): maxIterations counts the
+    // restored iterations too, so solve(N) after a restore ends at iteration N
+    // like the interrupted run would have, with the same tours for a seeded
+    // run. Local search, threading, backend, stop criteria and callbacks stay
+    // as configured here. Returns false, leaving the colony unchanged, if the
+    // file is missing, corrupt or from another instance.
+    bool restore(const std::string& path);
+
+    // Whether the next solve() resumes a restored checkpoint
+    bool hasRestoredState() const { return resumePending_; }
+
+    // Write a checkpoint to path every interval iterations of solve() and
+    // when solve() returns (default: "" = none, interval 0 = only at the end)
+    void setCheckpointFile(const std::string& path, int interval = 100);
+    const std::string& getCheckpointFile() const { return checkpointPath_; }
+
+    // Warm start: after initialize(), the tour (a city permutation, e.g. a
+    // nearest neighbor tour or the solution of a previous run) becomes the
+    // best-so-far tour and its edges receive one best-tour deposit, as for
+    // importTour(). Its length is computed on this graph. Returns false (and
+    // clears the warm start) if the sequence is not a permutation of the cities.
+    bool setWarmStartTour(const std::vector<int>& sequence);
+    const std::vector<int>& getWarmStartTour() const { return warmStartTour_; }
+
+    // Record per-phase timings and work counters of every iteration (default:
+    // disabled, which reads no clocks). Only runIteration() commits an entry;
+    // construction or update calls outside it add to the next one.
+    void setProfiling(bool profiling);
+    bool getProfiling() const { return profiling_; }
+
+    // Profile collected since initialize() (empty unless profiling is enabled).
+    // Safe to read from the progress callback, which runs on the solving thread
+    // (asynchronous incremental updates carry a copy of the totals instead).
+    const ColonyStats& getStats() const { return stats_; }
+
     // Set progress callback (alternative to passing to solve())
     void setProgressCallback(ProgressCallback callback);
 
+    // Incremental alternative to the progress callback, invoked every callback
+    // interval and once more when solve() ends (update.final). Each update holds
+    // the iteration bests since the previous one, and the best tour only when it
+    // improved, so a call costs O(interval) instead of O(n + iterations). With
+    // asynchronous = true the callback runs on a thread of its own: solve()
+    // queues the update and continues (merging updates the callback has not
+    // taken yet), and only waits for it before returning. Exceptions thrown by
+    // an asynchronous callback are rethrown by solve().
+    void setIncrementalCallback(IncrementalCallback callback, bool asynchronous = false);
+
     // Set callback interval (default: 10 iterations)
     void setCallbackInterval(int interval);
 
@@ -47,8 +158,15 @@ public:
     // Enable/disable parallel execution (default: true if OpenMP available)
     void setUseParallel(bool useParallel);
 
+    // Seed the random streams (default: non-deterministic). Each ant gets its own
+    // stream derived from this seed, so a seeded solve() gives the same tours for
+    // any thread count (up to floating-point summation order in pheromone deposits)
+    void setSeed(std::uint64_t seed);
+
     // Set number of threads for parallel execution (0 = auto-detect, 1 = serial, 2+ = specific count)
-    // Only effective if OpenMP is available and useParallel is true
+    // Only effective if OpenMP is available and useParallel is true. Applies to this
+    // colony's work alone: the thread count of the calling thread is set for the
+    // duration of each call and restored afterwards, never process-wide.
     void setNumThreads(int numThreads);
 
     // Enable/disable local search optimization (default: disabled)
@@ -58,10 +176,23 @@ public:
     // Only effective if local search is enabled
     void setUse3Opt(bool use3opt);
 
-    // Set when to apply local search: "best" (only to best tour), "all" (to all ant tours), or "none" (disabled)
+    // Set when to apply local search: "best" (only to best tour), "all" (to all ant tours),
+    // "top-k" (to the k shortest tours of each iteration, one tour per thread) or "none" (disabled).
+    // In "best" mode the exhaustive operator splits its 2-opt/3-opt scans across threads
+    // (LocalSearch::improveParallel) when parallel execution is enabled.
     // Default: "best"
     void setLocalSearchMode(const std::string& mode);
 
+    // Set k for the "top-k" local search mode (default: 0 = number of threads)
+    void setLocalSearchTopK(int k);
+
+    // Set the local search move family: "exhaustive" (full-scan 2-opt/3-opt),
+    // "neighbor" (2-opt, Or-opt and or-3opt over nearest-neighbor lists with
+    // don't-look bits) or "lk" (Lin-Kernighan-style chains of 2-opt flips).
+    // Neighbor operators use the candidate lists when enabled, otherwise
+    // LocalSearch::DEFAULT_NEIGHBORS nearest neighbors. Default: "exhaustive"
+    void setLocalSearchOperator(const std::string& op);
+
     // Enable/disable elitist strategy (default: disabled)
     // When enabled, best-so-far tour deposits additional weighted pheromones
     void setUseElitist(bool useElitist);
@@ -71,29 +202,81 @@ public:
     void setElitistWeight(double weight);
 
     // Set pheromone update mode: "all" (all ants), "best-iteration" (only iteration best),
-    // "best-so-far" (only global best), "rank" (top-k ants)
+    // "best-so-far" (only global best), "rank" (top-k ants), "mmas" (MAX-MIN Ant
+    // System: one tour deposits, trails bounded by tau_min/tau_max derived from the
+    // best-so-far length, reset to tau_max on stagnation), "acs" (Ant Colony System:
+    // q0 exploitation, local updates towards tau0 as edges are used, global update
+    // of the best-so-far tour's n edges only; elitist and rank settings are ignored)
     // Default: "all" (classic Ant Cycle)
     void setPheromoneMode(const std::string& mode);
 
     // Set number of elite ants for rank-based mode (default: numAnts/2)
     void setRankSize(int rankSize);
 
+    // Set how many iterations without improvement of the best-so-far tour make
+    // MMAS reinitialize all trails to tau_max (default: 100, 0 = never)
+    void setMMASRestartIterations(int iterations);
+
+    // ACS: probability of taking the best edge instead of roulette selection (default: 0.9)
+    void setQ0(double q0);
+
+    // ACS: local pheromone update rate, tau <- (1 - xi) * tau + xi * tau0 (default: 0.1)
+    void setXi(double xi);
+
+    // Set the execution backend: "cpu" (default) or "cuda". With "cuda" the
+    // distances, heuristic, trails and choice info stay on the GPU (GpuColony):
+    // ants build their tours there and the pheromone update runs there, and
+    // only the tour lengths plus the tours the host needs (iteration best, tours
+    // for local search) are copied back. solve(), callbacks and local search
+    // work unchanged; getPheromones() is brought up to date when solve()
+    // returns. initialize() throws std::runtime_error if the backend is not
+    // available (no build includes a device implementation yet, see
+    // GpuColony.h) and std::invalid_argument for "acs" or candidate lists,
+    // which only the CPU backend implements.
+    void setBackend(const std::string& backend);
+    const std::string& getBackend() const { return backend_; }
+
+    // Whether a backend can run in this build on this machine
+    static bool isBackendAvailable(const std::string& backend);
+
+    // Set candidate list size for tour construction (default: 0 = disabled)
+    // When k > 0, ants only choose among the k nearest unvisited neighbors of the
+    // current city, falling back to the best remaining city when all are visited.
+    // Reduces tour construction from O(n²) to roughly O(n·k) per ant.
+    void setCandidateListSize(int candidateListSize);
+
     // Get best solution found
     const Tour& getBestTour() const { return bestTour_; }
 
     // Get iteration history
     const std::vector<double>& getConvergenceData() const { return iterationBestDistances_; }
 
+    // Get the (shared, read-only) problem graph
+    const Graph& getGraph() const { return *graph_; }
+    std::shared_ptr<const Graph> getSharedGraph() const { return graph_; }
+
     // Getters for parameters
     int getNumAnts() const { return numAnts_; }
     double getAlpha() const { return alpha_; }
     double getBeta() const { return beta_; }
     double getRho() const { return rho_; }
     double getQ() const { return Q_; }
+    int getCandidateListSize() const { return candidateListSize_; }
+    const std::string& getLocalSearchOperator() const { return localSearchOperator_; }
+    int getLocalSearchTopK() const { return localSearchTopK_; }
+    const std::string& getPheromoneMode() const { return pheromoneMode_; }
+    std::uint64_t getSeed() const { return seed_; }
+    int getMMASRestartIterations() const { return mmasRestartIterations_; }
+    double getQ0() const { return q0_; }
+    double getXi() const { return xi_; }
+    double getTimeLimit() const { return timeLimit_; }
+    double getTargetDistance() const { return targetDistance_; }
+    const PheromoneMatrix& getPheromones() const { return pheromones_; }
 
 private:
-    Graph graph_;
+    std::shared_ptr<const Graph> graph_;
     PheromoneMatrix pheromones_;
+    PheromoneDeposits deposits_;  // Per-ant deposit buckets for the "all" update (reused)
     std::vector<Ant> ants_;
     int numAnts_;
     double alpha_;       // Pheromone importance
@@ -104,8 +287,32 @@ private:
     Tour bestTour_;
     std::vector<double> iterationBestDistances_;
     ProgressCallback progressCallback_;  // Callback for progress updates
+    IncrementalCallback incrementalCallback_;  // Callback for incremental updates
+    bool asynchronousIncremental_ = false;     // Deliver incremental updates on a worker thread
     int callbackInterval_ = 10;          // Invoke callback every N iterations
     int convergenceThreshold_ = 200;     // Iterations without improvement before stopping
+    double timeLimit_ = 0.0;             // Wall-clock budget of solve() in seconds (0 = none)
+    double targetDistance_ = 0.0;        // Stop once the best tour is this short (0 = none)
+    std::string stopReason_;             // Criterion that ended the last solve()
+    std::atomic<bool> stopRequested_{false};    // Set by requestStop(), possibly from another thread
+    std::atomic<int> completedIterations_{0};   // Iterations finished in the running solve()
+    mutable std::mutex snapshotMutex_;   // Guards bestTourSnapshot_
+    Tour bestTourSnapshot_;              // Best tour published for other threads
+
+    // Publish bestTour_ to bestTourSnapshot_ if it improved
+    void publishBestTour();
+
+    // Profiling state
+    bool profiling_ = false;             // Collect stats_ in runIteration()
+    ColonyStats stats_;
+    PhaseStats currentPhases_;           // Iteration being profiled
+    mutable std::atomic<std::uint64_t> profileMoves_{0};        // Local search work of the
+    mutable std::atomic<std::uint64_t> profileEvaluations_{0};  // current iteration (any thread)
+
+    // Accumulator of one phase of currentPhases_, or nullptr when not profiling
+    double* profilePhase(double PhaseStats::*phase) {
+        return profiling_ ? &(currentPhases_.*phase) : nullptr;
+    }
 
     // Threading control
     bool useParallel_ = true;            // Enable parallel execution (if OpenMP available)
@@ -114,19 +321,136 @@ private:
     // Local search control
     bool useLocalSearch_ = false;        // Enable local search (2-opt/3-opt)
     bool use3opt_ = true;                // Use 3-opt in addition to 2-opt
-    std::string localSearchMode_ = "best";  // "best", "all", or "none"
+    std::string localSearchMode_ = "best";  // "best", "all", "top-k", or "none"
+    int localSearchTopK_ = 0;            // Tours improved per iteration in "top-k" mode (0 = threads)
+    std::vector<int> topTourIndices_;    // Scratch for "top-k" mode
+    std::string localSearchOperator_ = "exhaustive";  // "exhaustive", "neighbor" or "lk"
+    NeighborLists localSearchNeighbors_;  // Lists used by neighbor operators (set in initialize())
+    std::vector<int> localSearchLists_;   // Colony-owned lists if no candidate/graph lists fit
+
+    // Select the neighbor lists used by the local search operator
+    void prepareLocalSearchNeighbors();
+
+    // Apply the configured local search to one tour. parallelScan lets the
+    // exhaustive operator split its scans across threads (single-tour use only)
+    void applyLocalSearch(Tour& tour, bool parallelScan = false) const;
+
+    // k of the "top-k" local search mode after resolving 0 = number of threads
+    int effectiveLocalSearchTopK() const;
 
     // Elitist strategy control
     bool useElitist_ = false;            // Enable elitist pheromone deposits
     double elitistWeight_ = 0.0;         // Weight for elitist pheromone (0 = auto = numAnts)
-    std::string pheromoneMode_ = "all";  // "all", "best-iteration", "best-so-far", "rank"
+    std::string pheromoneMode_ = "all";  // "all", "best-iteration", "best-so-far", "rank", "mmas", "acs"
     int rankSize_ = 0;                   // Number of elite ants for rank mode (0 = auto = numAnts/2)
 
+    // MAX-MIN Ant System state
+    static constexpr double MMAS_PBEST = 0.05;  // Probability of rebuilding the best tour at convergence
+    int mmasRestartIterations_ = 100;    // Stagnation length that triggers a trail reset (0 = never)
+    int mmasIteration_ = 0;              // Iterations since the last trail (re)initialization
+    int mmasStagnation_ = 0;             // Iterations since the best-so-far tour improved
+    double mmasBestDistance_ = 0.0;      // Best-so-far length at the previous update
+
+    // Set tau_max = Q / (rho * length) and the matching tau_min on the matrix
+    void updateMMASLimits(double bestDistance);
+
+    // Deposit schedule: true if the best-so-far tour (not the iteration best) deposits
+    bool mmasUseBestSoFar() const;
+
+    // Count an update towards stagnation; true if the trails must restart at tau_max
+    bool advanceMMASStagnation();
+
+    // GPU backend state (gpu_ is set in initialize() for the "cuda" backend)
+    std::string backend_ = "cpu";        // "cpu" or "cuda"
+    std::unique_ptr<GpuColony> gpu_;
+    std::vector<int> gpuStartCities_;    // Per-ant start city of the current iteration
+    std::vector<std::uint64_t> gpuSeeds_;  // Per-ant random seed of the current iteration
+    std::vector<double> gpuLengths_;     // Device tour lengths (host-improved ones updated)
+    std::vector<int> gpuTourAnts_;       // Ant of each tour in antTours_ (copied back)
+    std::vector<int> gpuTourSlots_;      // Index into antTours_ per ant, or -1
+    std::vector<double> gpuAmounts_;     // Deposit per device tour (scratch)
+
+    // Build the tours on the device and copy back the ones the host needs
+    void constructGpuSolutions();
+
+    // Pheromone update on the device
+    void updateGpuPheromones();
+
+    // Ant Colony System state
+    double q0_ = 0.9;                    // Exploitation probability
+    double xi_ = 0.1;                    // Local update rate
+    double acsTau0_ = 0.0;               // Initial trail and local update target (set in initialize())
+    std::vector<std::pair<int, int>> acsMoves_;  // Edge each ant took in the current step
+
+    // Build all tours step by step, applying local updates between steps
+    void constructACSTours(bool useChoiceInfo, int numCandidates);
+
+    // Local update of one traversed edge (trail and both choice entries)
+    void acsLocalUpdate(int cityA, int cityB);
+
+    // Global update of one tour's edges (the best-so-far tour, or a migrant)
+    void updateACSPheromones(const Tour& tour);
+
+    // Recompute choiceInfo_ for one directed edge after its trail changed
+    void refreshChoiceInfo(int from, int to);
+
+    // Candidate list control
+    int candidateListSize_ = 0;          // Nearest neighbors considered per step (0 = all cities)
+    int numCandidates_ = 0;              // Effective candidates per city (set in initialize())
+    int candidateStride_ = 0;            // Row length of the active neighbor lists
+    const int* candidateData_ = nullptr; // Active neighbor lists (graph's or candidateLists_)
+    std::vector<int> candidateLists_;    // Colony-owned lists if the graph has none
+
+    // Candidate list of a city (first numCandidates_ entries are used)
+    const int* getCandidates(int city) const {
+        return candidateData_ + static_cast<size_t>(city) * candidateStride_;
+    }
+
+    // Select the neighbor lists used for candidate-list construction
+    void prepareCandidateLists();
+
+    // Next city for an ant from the cached choice info (or pheromones directly
+    // if it is stale, which ignores q0); q0 > 0 enables the ACS exploitation rule
+    int selectNextCity(Ant& ant, bool useChoiceInfo, int numCandidates, double q0);
+
+    // Store an ant's finished tour in antTours_ (empty tour if incomplete)
+    void completeAntTour(int antIndex);
+
     // Store constructed/improved tours for pheromone updates
     std::vector<Tour> antTours_;         // Tours from each ant (possibly improved by local search)
+    std::vector<std::pair<double, const Tour*>> rankedTours_;  // Scratch for rank mode
+
+    // Cached ant decision data (row-major). Each row holds either all n cities or,
+    // when candidate lists are enabled, the k candidates of that city in list order.
+    // Both are first touched by the static row loops that fill them (see NumaPlacement.h)
+    AlignedVector<double> heuristicInfo_;  // eta^beta = (1/d)^beta, computed once in initialize()
+    AlignedVector<double> choiceInfo_;     // tau^alpha * eta^beta, rebuilt after each pheromone update
+    int choiceInfoStride_ = 0;           // Entries per row (n, or k with candidate lists)
+    bool choiceInfoUsesCandidates_ = false;  // True if rows follow the neighbor lists
+
+    // Compute heuristicInfo_ for the current candidate configuration
+    void computeHeuristicInfo();
+
+    // Rebuild choiceInfo_ from the current pheromones and heuristicInfo_
+    void computeChoiceInfo();
+
+    // Checkpoint and warm start state
+    bool resumePending_ = false;         // restore() succeeded, solve() continues from it
+    std::string checkpointPath_;         // Automatic checkpoints of solve() ("" = none)
+    int checkpointInterval_ = 100;       // Iterations between them (0 = only at the end)
+    std::vector<int> warmStartTour_;     // Tour imported by initialize() (empty = none)
+
+    // Everything initialize() derives from the settings and the trails:
+    // candidate and local search lists, heuristic and choice info and the GPU
+    // copies. Shared by initialize() and a resumed solve()
+    void prepareSearch();
+
+    // Write the automatic checkpoint (warns on failure)
+    void writeAutomaticCheckpoint();
 
-    // Shared random number generator for colony
-    static std::mt19937& getRandomGenerator();
+    // Colony random stream (start cities and per-ant seeds), restarted in initialize()
+    std::uint64_t seed_ = 0;
+    Xoshiro256 rng_;
 };
 
 #endif // ANTCOLONY_H
@@ -10,6 +10,9 @@
 #define CITY_H
 
 #include <cmath>
+#include <cstddef>
+#include <type_traits>
+#include "DistanceMetric.h"
 
 /**
  * @class City
@@ -37,6 +40,19 @@ public:
      */
     double distanceTo(const City& other) const;
 
+    /**
+     * @brief Calculate the distance to another city under a metric policy
+     * @tparam Metric Policy from namespace metric (see DistanceMetric.h)
+     * @param other The destination city
+     * @return double Metric::distance of the two coordinate pairs
+     *
+     * metric::Geo expects coordinates in radians, as Graph stores them.
+     */
+    template <typename Metric>
+    double distanceTo(const City& other, Metric) const {
+        return Metric::distance(x_, y_, other.x_, other.y_);
+    }
+
     /**
      * @brief Get the city's unique identifier
      * @return int The city ID
@@ -55,10 +71,30 @@ public:
      */
     double getY() const;
 
+    /**
+     * @brief Get the address of the coordinate pair
+     * @return const double* Pointer to x, immediately followed by y
+     *
+     * Lets a std::vector<City> be viewed as an n×2 strided array of
+     * doubles (row stride sizeof(City)) without copying, as the Python
+     * bindings do for Graph::getCities().
+     */
+    const double* getCoordinates() const;
+
 private:
     int id_;     ///< Unique identifier for this city
     double x_;   ///< X-coordinate in 2D space
     double y_;   ///< Y-coordinate in 2D space
 };
 
+// getCoordinates() hands out x_ as the start of an (x, y) pair: the layout
+// must keep y_ directly after x_ (checked here, where the class is complete)
+inline const double* City::getCoordinates() const {
+    static_assert(std::is_standard_layout<City>::value,
+                  "City must be standard layout for offsetof");
+    static_assert(offsetof(City, y_) == offsetof(City, x_) + sizeof(double),
+                  "City::y_ must directly follow City::x_");
+    return &x_;
+}
+
 #endif // CITY_H
@@ -0,0 +1,42 @@
+#ifndef COLONYSTATS_H
+#define COLONYSTATS_H
+
+#include <cstdint>
+#include <vector>
+
+// Wall time (seconds) and work counters of colony iterations, collected when
+// profiling is enabled (AntColony::setProfiling)
+struct PhaseStats {
+    double construction = 0.0;   // Tour building, ACS local updates included
+    double localSearch = 0.0;    // Local search on ant tours and on the best tour
+    double selection = 0.0;      // Iteration-best search and best-so-far update
+    double deposit = 0.0;        // Choosing the depositing tours and buffering their deposits
+    double evaporation = 0.0;    // Fused evaporate/deposit/clamp pass and choice info refresh
+    std::uint64_t localSearchMoves = 0;        // Improving moves applied
+    std::uint64_t localSearchEvaluations = 0;  // Move deltas evaluated
+    std::uint64_t candidateFallbacks = 0;      // Steps that found every candidate visited
+
+    double totalSeconds() const {
+        return construction + localSearch + selection + deposit + evaporation;
+    }
+
+    PhaseStats& operator+=(const PhaseStats& other) {
+        construction += other.construction;
+        localSearch += other.localSearch;
+        selection += other.selection;
+        deposit += other.deposit;
+        evaporation += other.evaporation;
+        localSearchMoves += other.localSearchMoves;
+        localSearchEvaluations += other.localSearchEvaluations;
+        candidateFallbacks += other.candidateFallbacks;
+        return *this;
+    }
+};
+
+// Profile of the iterations since initialize()
+struct ColonyStats {
+    PhaseStats total;                    // Sum over all iterations
+    std::vector<PhaseStats> iterations;  // One entry per runIteration()
+};
+
+#endif // COLONYSTATS_H
@@ -0,0 +1,124 @@
+/**
+ * @file DistanceMetric.h
+ * @brief Distance metrics as compile-time policies
+ *
+ * Graph selects its metric at runtime, but hot loops should not branch on it
+ * per distance. Each coordinate metric is a policy type with an inline
+ * distance function; dispatchMetric() turns the runtime value into one of
+ * these types once, so a templated loop is compiled (and inlined) for
+ * exactly that formula.
+ */
+
+#ifndef DISTANCEMETRIC_H
+#define DISTANCEMETRIC_H
+
+#include <cmath>
+
+/**
+ * @enum DistanceMetric
+ * @brief How the distance between two city coordinates is measured
+ *
+ * EUCLIDEAN is the unrounded planar distance this project has always used.
+ * The coordinate metrics follow the TSPLIB EDGE_WEIGHT_TYPE definitions, which
+ * round to integers (GEO treats coordinates as DDD.MM latitude/longitude).
+ * EXPLICIT graphs take their distances from a given matrix; their coordinates
+ * are only used for display.
+ */
+enum class DistanceMetric {
+    EUCLIDEAN,  ///< sqrt(dx² + dy²) without rounding (default)
+    EUC_2D,     ///< TSPLIB EUC_2D: Euclidean rounded to nearest integer
+    CEIL_2D,    ///< TSPLIB CEIL_2D: Euclidean rounded up
+    GEO,        ///< TSPLIB GEO: great-circle distance in km
+    ATT,        ///< TSPLIB ATT: pseudo-Euclidean (att48/att532)
+    EXPLICIT    ///< TSPLIB EXPLICIT: distances given as a matrix, not computed
+};
+
+/**
+ * @namespace metric
+ * @brief One policy type per coordinate metric
+ *
+ * Every policy has a static distance(xa, ya, xb, yb) for the coordinates
+ * Graph stores (radians for GEO) and its DistanceMetric as kind.
+ */
+namespace metric {
+
+/// Unrounded planar distance
+struct Euclidean {
+    static constexpr DistanceMetric kind = DistanceMetric::EUCLIDEAN;
+    static double distance(double xa, double ya, double xb, double yb) {
+        double dx = xa - xb;
+        double dy = ya - yb;
+        return std::sqrt(dx * dx + dy * dy);
+    }
+};
+
+/// TSPLIB EUC_2D: nint of the Euclidean distance
+struct Euc2D {
+    static constexpr DistanceMetric kind = DistanceMetric::EUC_2D;
+    static double distance(double xa, double ya, double xb, double yb) {
+        return std::floor(Euclidean::distance(xa, ya, xb, yb) + 0.5);
+    }
+};
+
+/// TSPLIB CEIL_2D: Euclidean distance rounded up
+struct Ceil2D {
+    static constexpr DistanceMetric kind = DistanceMetric::CEIL_2D;
+    static double distance(double xa, double ya, double xb, double yb) {
+        return std::ceil(Euclidean::distance(xa, ya, xb, yb));
+    }
+};
+
+/// TSPLIB ATT: pseudo-Euclidean distance, rounded up when nint falls short
+struct Att {
+    static constexpr DistanceMetric kind = DistanceMetric::ATT;
+    static double distance(double xa, double ya, double xb, double yb) {
+        double dx = xa - xb;
+        double dy = ya - yb;
+        double r = std::sqrt((dx * dx + dy * dy) / 10.0);
+        double t = std::floor(r + 0.5);
+        return (t < r) ? t + 1.0 : t;
+    }
+};
+
+/// TSPLIB GEO on an idealized sphere of radius 6378.388 km; x is latitude
+/// and y longitude, both already converted to radians
+struct Geo {
+    static constexpr DistanceMetric kind = DistanceMetric::GEO;
+    static double distance(double xa, double ya, double xb, double yb) {
+        const double RRR = 6378.388;
+        double q1 = std::cos(ya - yb);
+        double q2 = std::cos(xa - xb);
+        double q3 = std::cos(xa + xb);
+        double arc = std::acos(0.5 * ((1.0 + q1) * q2 - (1.0 - q1) * q3));
+        return static_cast<int>(RRR * arc + 1.0);
+    }
+};
+
+}  // namespace metric
+
+/**
+ * @brief Call a function with the policy of a coordinate metric
+ * @param kind Metric to dispatch on
+ * @param function Generic callable taking a metric policy by value
+ * @return Whatever function returns
+ *
+ * EXPLICIT has no formula (its graphs always read their matrix) and is
+ * dispatched as Euclidean; callers handle it before dispatching.
+ */
+template <typename Function>
+decltype(auto) dispatchMetric(DistanceMetric kind, Function&& function) {
+    switch (kind) {
+        case DistanceMetric::EUC_2D:
+            return function(metric::Euc2D{});
+        case DistanceMetric::CEIL_2D:
+            return function(metric::Ceil2D{});
+        case DistanceMetric::GEO:
+            return function(metric::Geo{});
+        case DistanceMetric::ATT:
+            return function(metric::Att{});
+        default:
+            return function(metric::Euclidean{});
+    }
+}
+
+#endif // DISTANCEMETRIC_H
@@ -0,0 +1,74 @@
+#ifndef GPUCOLONY_H
+#define GPUCOLONY_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "AlignedAllocator.h"
+
+class Graph;
+class PheromoneMatrix;
+
+// Device side of AntColony's "cuda" backend. Distances, heuristic, trails and
+// choice info live on the GPU for the whole run; each iteration builds every
+// ant's tour there (one warp per ant, data-parallel roulette selection) and
+// only tour lengths, and the few tours the host asks for, come back.
+//
+// This is the interface AntColony drives. The device implementation is not
+// part of the tree yet; src/GpuColony.cpp provides a stub whose
+// isAvailable() is false and whose constructor throws.
+class GpuColony {
+public:
+    // Whether this build has CUDA support and a device is present
+    static bool isAvailable();
+
+    // Name of the device used (empty if none)
+    static std::string deviceName();
+
+    // Allocate device buffers for numAnts ants and upload the distance matrix
+    // and the dense heuristic eta^beta (n×n, row-major). Throws
+    // std::runtime_error if no device is available.
+    GpuColony(const Graph& graph, int numAnts, const AlignedVector<double>& heuristic, double alpha);
+    ~GpuColony();
+
+    GpuColony(const GpuColony&) = delete;
+    GpuColony& operator=(const GpuColony&) = delete;
+
+    // Copy all trails to the device (limits included) and rebuild the choice info
+    void uploadTrails(const PheromoneMatrix& pheromones);
+
+    // Copy the device trails back into pheromones (same size)
+    void downloadTrails(PheromoneMatrix& pheromones) const;
+
+    // Reset every trail to value and rebuild the choice info
+    void resetTrails(double value);
+
+    // Build one tour per ant from the device choice info. startCities and seeds
+    // hold one entry per ant; the tour lengths are written to lengths.
+    void constructTours(const std::vector<int>& startCities, const std::vector<std::uint64_t>& seeds,
+                        std::vector<double>& lengths);
+
+    // Copy the tour of one ant (numCities entries, without the return edge)
+    void copyTour(int ant, std::vector<int>& tour) const;
+
+    // One host tour depositing amount on each of its edges
+    struct HostDeposit {
+        const std::vector<int>* tour;
+        double amount;
+    };
+
+    // Evaporate, deposit and clamp in two kernels: a scatter-add of the
+    // deposits (antAmounts[i] on every edge of ant i's device tour, zero to
+    // skip, plus the host tours), then one fused pass computing
+    // clamp(tau * (1 - rho) + delta) and the choice entry of every cell
+    void updateTrails(double rho, const std::vector<double>& antAmounts,
+                      const std::vector<HostDeposit>& hostDeposits,
+                      double minPheromone, double maxPheromone);
+
+private:
+    struct Device;  // Device buffers and stream (defined by the implementation)
+    std::unique_ptr<Device> device_;
+};
+
+#endif // GPUCOLONY_H
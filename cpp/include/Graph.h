@@ -3,15 +3,43 @@
  * @brief Represents the complete TSP problem instance
  *
  * This class stores all cities in the problem and maintains a precomputed
- * distance matrix for O(1) distance lookups between any two cities.
+ * distance matrix for O(1) distance lookups between any two cities, or
+ * computes distances on demand for instances too large for any n² matrix.
  */
 
 #ifndef GRAPH_H
 #define GRAPH_H
 
+#include "AlignedAllocator.h"
 #include "City.h"
+#include "DistanceMetric.h"
+#include <cmath>
+#include <cstddef>
+#include <memory>
 #include <vector>
 
+class MappedFile;
+
+/**
+ * @enum DistanceStorage
+ * @brief Memory layout and precision of the precomputed distance matrix
+ *
+ * The full double matrix gives the fastest lookups. The other layouts trade
+ * a little lookup arithmetic or precision for memory, which matters for
+ * 10k-20k city instances (d18512 needs 2.7 GB as a full double matrix but
+ * only 0.7 GB as a triangular float matrix). ON_THE_FLY keeps no matrix at
+ * all and recomputes each distance from the coordinates, which is the only
+ * option beyond ~20k cities (pla85900 would need 27 GB even as triangular
+ * floats).
+ */
+enum class DistanceStorage {
+    FULL_DOUBLE,        ///< n×n doubles (default)
+    FULL_FLOAT,         ///< n×n floats (1/2 the memory)
+    TRIANGULAR_DOUBLE,  ///< Strict upper triangle, doubles (1/2 the memory)
+    TRIANGULAR_FLOAT,   ///< Strict upper triangle, floats (1/4 the memory)
+    ON_THE_FLY          ///< No matrix: computed from coordinates on each lookup
+};
+
 /**
  * @class Graph
  * @brief Complete representation of the TSP problem with cities and distances
@@ -19,6 +47,15 @@
  * The Graph precomputes and caches all pairwise distances between cities
  * for efficient access during the ACO algorithm. The distance matrix is
  * symmetric (distance[i][j] == distance[j][i]) for undirected TSP.
+ *
+ * Distances live in a single contiguous, cache-line aligned buffer. Full
+ * layouts are row-major with rows padded to a multiple of 64 bytes so every
+ * row starts on a cache-line boundary; triangular layouts store only the
+ * n(n-1)/2 entries above the diagonal (see DistanceStorage).
+ *
+ * A graph loaded from a GraphCache file reads its distances and neighbor
+ * lists directly from the read-only mapping of that file; copies of such a
+ * graph share the mapping instead of duplicating the matrix.
  */
 class Graph {
 public:
@@ -32,6 +69,32 @@ public:
      */
     explicit Graph(const std::vector<City>& cities);
 
+    /**
+     * @brief Construct a graph with a specific distance storage layout
+     * @param cities Vector of City objects representing the problem instance
+     * @param storage Layout/precision of the distance matrix
+     * @param metric Distance function applied to the city coordinates
+     *
+     * Float layouts round each distance to single precision (about 7
+     * significant digits); tour lengths are still accumulated in double.
+     */
+    Graph(const std::vector<City>& cities, DistanceStorage storage,
+          DistanceMetric metric = DistanceMetric::EUCLIDEAN);
+
+    /**
+     * @brief Construct a graph from explicitly given distances
+     * @param cities Cities of the instance (coordinates are used for display only)
+     * @param upperTriangle Strict upper triangle of the symmetric distance matrix,
+     *        row by row: d(0,1), d(0,2), ..., d(0,n-1), d(1,2), ..., d(n-2,n-1)
+     * @param storage Layout/precision of the distance matrix
+     *
+     * The metric is DistanceMetric::EXPLICIT. There is no formula to recompute
+     * distances from, so DistanceStorage::ON_THE_FLY falls back to
+     * TRIANGULAR_DOUBLE, whose layout is exactly the given buffer.
+     */
+    Graph(const std::vector<City>& cities, std::vector<double> upperTriangle,
+          DistanceStorage storage = DistanceStorage::FULL_DOUBLE);
+
     /**
      * @brief Default constructor creating an empty graph
      *
@@ -39,6 +102,17 @@ public:
      */
     Graph();
 
+    /**
+     * @brief Copy a graph
+     *
+     * Owned buffers are duplicated; data read from a cache mapping is
+     * shared with the original (the mapping stays alive until both are gone).
+     */
+    Graph(const Graph& other);
+    Graph& operator=(const Graph& other);
+    Graph(Graph&& other) noexcept = default;
+    Graph& operator=(Graph&& other) noexcept = default;
+
     /**
      * @brief Get the distance between two cities by their indices
      * @param cityA Index of first city (0-based)
@@ -49,6 +123,144 @@ public:
      */
     double getDistance(int cityA, int cityB) const;
 
+    /**
+     * @brief Get the distance between two cities without bounds checking
+     * @param cityA Index of first city (0-based, must be valid)
+     * @param cityB Index of second city (0-based, must be valid)
+     * @return double The distance between the cities
+     *
+     * Inlined fast path for hot loops (tour construction, local search deltas).
+     */
+    double getDistanceUnchecked(int cityA, int cityB) const {
+        switch (storage_) {
+            case DistanceStorage::FULL_DOUBLE:
+                return distanceData_[static_cast<std::size_t>(cityA) * rowStride_ + cityB];
+            case DistanceStorage::FULL_FLOAT:
+                return distanceFloatData_[static_cast<std::size_t>(cityA) * rowStride_ + cityB];
+            case DistanceStorage::TRIANGULAR_DOUBLE:
+                return (cityA == cityB) ? 0.0 : distanceData_[triangularIndex(cityA, cityB)];
+            case DistanceStorage::TRIANGULAR_FLOAT:
+                return (cityA == cityB) ? 0.0 : distanceFloatData_[triangularIndex(cityA, cityB)];
+            case DistanceStorage::ON_THE_FLY:
+                return computeDistance(cityA, cityB);
+        }
+        return 0.0;
+    }
+
+    /**
+     * @brief Compute the distance between two cities from their coordinates
+     * @param cityA Index of first city (0-based, must be valid)
+     * @param cityB Index of second city (0-based, must be valid)
+     * @return double Distance under getDistanceMetric(), ignoring any matrix
+     *         (except for EXPLICIT graphs, where the matrix is the only source)
+     *
+     * Time complexity: O(1), but one sqrt (or trigonometry for GEO) per call
+     */
+    double computeDistance(int cityA, int cityB) const {
+        if (cityA == cityB) {
+            return 0.0;
+        }
+        if (metric_ == DistanceMetric::EXPLICIT) {
+            return getDistanceUnchecked(cityA, cityB);
+        }
+        return dispatchMetric(metric_, [&](auto metric) {
+            return computeDistance(metric, cityA, cityB);
+        });
+    }
+
+    /**
+     * @brief Compute a distance with the metric fixed at compile time
+     * @tparam Metric Policy from namespace metric matching getDistanceMetric()
+     * @param cityA Index of first city (0-based, must be valid)
+     * @param cityB Index of second city (0-based, must be valid)
+     * @return double Same value as computeDistance(cityA, cityB)
+     */
+    template <typename Metric>
+    double computeDistance(Metric, int cityA, int cityB) const {
+        if (cityA == cityB) {
+            return 0.0;
+        }
+        return Metric::distance(coordX_[cityA], coordY_[cityA], coordX_[cityB], coordY_[cityB]);
+    }
+
+    /**
+     * @brief Call a function with a distance functor specialized for this graph
+     * @param function Generic callable taking a functor d with d(a, b) equal to
+     *        getDistanceUnchecked(a, b)
+     * @return Whatever function returns
+     *
+     * Full double matrices get a plain row-major lookup and on-the-fly graphs
+     * the formula of their metric, so templated hot loops (local search
+     * deltas) carry neither the storage nor the metric switch. The other
+     * layouts get a functor calling getDistanceUnchecked().
+     */
+    template <typename Function>
+    decltype(auto) dispatchDistances(Function&& function) const;
+
+    /**
+     * @brief Get a pointer to the distance row of a city
+     * @param city City index (0-based, must be valid)
+     * @return const double* getNumCities() contiguous distances from city,
+     *         or nullptr unless the storage is DistanceStorage::FULL_DOUBLE
+     */
+    const double* getDistanceRow(int city) const {
+        if (storage_ != DistanceStorage::FULL_DOUBLE) {
+            return nullptr;
+        }
+        return distanceData_ + static_cast<std::size_t>(city) * rowStride_;
+    }
+
+    /**
+     * @brief Get the double distance buffer
+     * @return const double* Start of the matrix for FULL_DOUBLE (rows
+     *         getDistanceRowStride() apart) or of the upper triangle for
+     *         TRIANGULAR_DOUBLE; nullptr for the other layouts
+     */
+    const double* getDistanceData() const { return distanceData_; }
+
+    /**
+     * @brief Get the float distance buffer
+     * @return const float* Start of the matrix for FULL_FLOAT or of the upper
+     *         triangle for TRIANGULAR_FLOAT; nullptr for the other layouts
+     */
+    const float* getDistanceFloatData() const { return distanceFloatData_; }
+
+    /**
+     * @brief Get the padded row length of a full distance matrix
+     * @return std::size_t Entries between the starts of consecutive rows
+     *         (>= getNumCities()), or 0 unless the storage is FULL_DOUBLE or FULL_FLOAT
+     */
+    std::size_t getDistanceRowStride() const {
+        const bool full = storage_ == DistanceStorage::FULL_DOUBLE ||
+                          storage_ == DistanceStorage::FULL_FLOAT;
+        return full ? rowStride_ : 0;
+    }
+
+    /**
+     * @brief Get the distance storage layout of this graph
+     * @return DistanceStorage The layout chosen at construction
+     */
+    DistanceStorage getDistanceStorage() const { return storage_; }
+
+    /**
+     * @brief Get the distance metric of this graph
+     * @return DistanceMetric The metric chosen at construction
+     */
+    DistanceMetric getDistanceMetric() const { return metric_; }
+
+    /**
+     * @brief Get the memory used by the distance matrix
+     * @return std::size_t Size of the distance buffer in bytes (0 for ON_THE_FLY),
+     *         including a buffer mapped from a cache file
+     */
+    std::size_t getDistanceMemoryBytes() const;
+
+    /**
+     * @brief Check whether the graph reads from a cache file mapping
+     * @return true if loaded by GraphCache::load()
+     */
+    bool isMapped() const { return mapping_ != nullptr; }
+
     /**
      * @brief Get the total number of cities in the graph
      * @return int Number of cities
@@ -83,23 +295,221 @@ public:
      *
      * This is used to compute a reasonable initial pheromone value.
      * The nearest neighbor heuristic builds a tour by always visiting
-     * the closest unvisited city next.
+     * the closest unvisited city next. When neighbor lists have been built
+     * they are checked first, so the full O(n) scan is only needed once a
+     * city's whole list has been visited.
      */
     double nearestNeighborTourLength(int startCity = 0) const;
 
+    /**
+     * @brief Build the nearest neighbor tour itself
+     * @param startCity Starting city for the tour construction (default: 0)
+     * @return std::vector<int> City sequence (empty for an empty graph)
+     *
+     * Same construction as nearestNeighborTourLength(); used as the
+     * fallback result of a solve that is stopped before its first iteration.
+     */
+    std::vector<int> nearestNeighborTour(int startCity = 0) const;
+
+    /**
+     * @brief Precompute the k nearest neighbors of every city
+     * @param k Number of neighbors per city (clamped to numCities - 1)
+     *
+     * Neighbor lists are the basis of candidate-list tour construction:
+     * ants only evaluate the k closest unvisited cities instead of all n,
+     * reducing construction cost from O(n²) to roughly O(n·k) per ant.
+     * Lists are stored in a flat n×k array, nearest neighbor first.
+     * Time complexity: O(n·k log k) expected for planar metrics (grid
+     * spatial index), O(n² log k) for GEO and EXPLICIT
+     */
+    void buildNeighborLists(int k);
+
+    /**
+     * @brief Compute k-nearest-neighbor lists without storing them
+     * @param k Number of neighbors per city (clamped to numCities - 1)
+     * @return std::vector<int> Flat n×k' lists (k' = clamped k), nearest first
+     *
+     * Const counterpart of buildNeighborLists() for callers that share a
+     * read-only graph (e.g. several AntColony instances).
+     *
+     * Graphs loaded from a cache return prefixes of the cached lists in O(n·k)
+     * when k does not exceed the cached list size; buildNeighborLists() then
+     * uses the cached rows in place.
+     */
+    std::vector<int> computeNeighborLists(int k) const;
+
+    /**
+     * @brief Get the nearest-neighbor list of a city
+     * @param city The city index (0-based)
+     * @return const int* Pointer to getNeighborListSize() city indices, nearest first
+     *
+     * Note: No bounds checking - only valid after buildNeighborLists()
+     */
+    const int* getNeighbors(int city) const;
+
+    /**
+     * @brief Get the number of neighbors stored per city
+     * @return int Neighbor list size (0 if lists have not been built)
+     */
+    int getNeighborListSize() const;
+
+    /**
+     * @brief Get the distance between consecutive lists in memory
+     * @return int Row stride of getNeighbors(0) (>= getNeighborListSize(); larger
+     *         when the lists are prefixes of longer cached rows)
+     */
+    int getNeighborListStride() const { return neighborListStride_; }
+
 private:
     std::vector<City> cities_;                          ///< All cities in the problem
-    std::vector<std::vector<double>> distanceMatrix_;   ///< Precomputed n×n distance matrix
     int numCities_;                                     ///< Number of cities (cached for efficiency)
+    DistanceStorage storage_ = DistanceStorage::FULL_DOUBLE;  ///< Distance matrix layout
+    DistanceMetric metric_ = DistanceMetric::EUCLIDEAN;       ///< Distance function
+    std::vector<double> coordX_;                        ///< X (GEO: latitude in radians)
+    std::vector<double> coordY_;                        ///< Y (GEO: longitude in radians)
+    std::size_t rowStride_ = 0;                         ///< Padded row length (full layouts)
+    AlignedVector<double> distances_;                   ///< Double-precision distances
+    AlignedVector<float> distancesFloat_;               ///< Single-precision distances
+    std::vector<int> neighborLists_;                    ///< Flat n×k nearest-neighbor lists
+    int neighborListSize_ = 0;                          ///< Neighbors per city (k)
+
+    // Views used for lookups: the owned buffers above or a cache mapping
+    const double* distanceData_ = nullptr;              ///< distances_ or mapped doubles
+    const float* distanceFloatData_ = nullptr;          ///< distancesFloat_ or mapped floats
+    const int* neighborData_ = nullptr;                 ///< neighborLists_ or mapped lists
+    int neighborListStride_ = 0;                        ///< Row stride of neighborData_
+
+    // Precomputed data from a cache file (see GraphCache)
+    std::shared_ptr<const MappedFile> mapping_;         ///< Keeps the mapping alive
+    std::size_t mappedDistanceBytes_ = 0;               ///< Size of the mapped matrix
+    const int* cachedNeighbors_ = nullptr;              ///< Mapped n×cachedNeighborStride_ lists
+    int cachedNeighborStride_ = 0;                      ///< Neighbors per city in the cache
+    double cachedNearestNeighborLength_ = -1.0;         ///< NN tour from city 0 (< 0: unknown)
+
+    friend class GraphCache;
+
+    /// Point the lookup views at the owned buffers
+    void bindOwnedStorage();
+
+    /**
+     * @brief Nearest neighbor tour length using the given lists
+     * @param startCity Starting city
+     * @param lists Flat neighbor lists (nullptr: full scans only)
+     * @param stride Row stride of lists
+     * @param size Entries used per row
+     * @param sequence If not null, receives the visited cities in order
+     */
+    double nearestNeighborTourLength(int startCity, const int* lists, int stride, int size,
+                                     std::vector<int>* sequence = nullptr) const;
 
     /**
      * @brief Build the symmetric distance matrix
      *
      * Computes distances between all pairs of cities. Since the matrix is
      * symmetric, only the upper triangle is computed and then mirrored.
+     * Rows are independent and computed in parallel when OpenMP is available.
      * Time complexity: O(n²) where n is the number of cities
      */
     void buildDistanceMatrix();
+
+    /**
+     * @brief Allocate the owned distance buffer and zero it (parallel first touch)
+     * @param size Number of elements
+     * @param useFloat Allocate distancesFloat_ instead of distances_
+     * @param triangular Triangular layout (else numCities_ rows of rowStride_)
+     */
+    void allocateDistances(size_t size, bool useFloat, bool triangular);
+
+    /**
+     * @brief Fill a zeroed distance buffer (full or triangular layout)
+     * @tparam T Element type of the layout (double or float)
+     */
+    template <typename T>
+    void fillDistanceMatrix(T* data, bool triangular) const;
+
+    /**
+     * @brief Fill the distance matrix from a strict upper triangle
+     * @param upperTriangle Distances in triangularIndex() order (released
+     *        afterwards if the storage is TRIANGULAR_DOUBLE)
+     */
+    void storeExplicitDistances(std::vector<double>& upperTriangle);
+
+    /**
+     * @brief Copy city coordinates into contiguous arrays for computeDistance()
+     *
+     * GEO coordinates are converted from DDD.MM to radians once here.
+     */
+    void buildCoordinates();
+
+    /**
+     * @brief k-nearest-neighbor lists via a uniform grid over the coordinates
+     * @param listSize Neighbors per city (already clamped, > 0)
+     *
+     * Valid for every planar metric, since they are all non-decreasing
+     * functions of the Euclidean distance.
+     */
+    std::vector<int> computeNeighborListsSpatial(int listSize) const;
+
+    /**
+     * @brief Offset of edge (a, b), a != b, in the strict upper triangle
+     *
+     * Row i holds cities i+1 .. n-1 and starts at i(2n - i - 1)/2.
+     */
+    std::size_t triangularIndex(int cityA, int cityB) const {
+        std::size_t i = static_cast<std::size_t>(cityA < cityB ? cityA : cityB);
+        std::size_t j = static_cast<std::size_t>(cityA < cityB ? cityB : cityA);
+        std::size_t n = static_cast<std::size_t>(numCities_);
+        return i * (2 * n - i - 1) / 2 + (j - i - 1);
+    }
+};
+
+/**
+ * @struct MatrixDistance
+ * @brief Distance functor reading a row-major full matrix
+ */
+template <typename T>
+struct MatrixDistance {
+    const T* data;
+    std::size_t stride;
+    double operator()(int cityA, int cityB) const {
+        return data[static_cast<std::size_t>(cityA) * stride + cityB];
+    }
 };
 
+/**
+ * @struct CoordinateDistance
+ * @brief Distance functor computing a metric from the coordinates
+ */
+template <typename Metric>
+struct CoordinateDistance {
+    const Graph* graph;
+    double operator()(int cityA, int cityB) const {
+        return graph->computeDistance(Metric{}, cityA, cityB);
+    }
+};
+
+/**
+ * @struct GraphDistance
+ * @brief Distance functor for any layout, via Graph::getDistanceUnchecked()
+ */
+struct GraphDistance {
+    const Graph* graph;
+    double operator()(int cityA, int cityB) const {
+        return graph->getDistanceUnchecked(cityA, cityB);
+    }
+};
+
+template <typename Function>
+decltype(auto) Graph::dispatchDistances(Function&& function) const {
+    if (storage_ == DistanceStorage::FULL_DOUBLE) {
+        return function(MatrixDistance<double>{distanceData_, rowStride_});
+    }
+    if (storage_ == DistanceStorage::ON_THE_FLY && metric_ != DistanceMetric::EXPLICIT) {
+        return dispatchMetric(metric_, [&](auto metric) {
+            return function(CoordinateDistance<decltype(metric)>{this});
+        });
+    }
+    return function(GraphDistance{this});
+}
+
 #endif // GRAPH_H
@@ -0,0 +1,83 @@
+/**
+ * @file GraphCache.h
+ * @brief Binary cache of preprocessed instances for instant startup
+ *
+ * A cache file holds everything Graph derives from an instance file: the
+ * city coordinates, the distance matrix in its packed storage layout, the
+ * k-nearest-neighbor lists and the nearest neighbor tour length. Loading
+ * maps the file read-only and the Graph reads the matrix and lists in
+ * place, so several processes on one host share a single copy through the
+ * page cache.
+ */
+
+#ifndef GRAPHCACHE_H
+#define GRAPHCACHE_H
+
+#include <cstdint>
+#include <string>
+#include "Graph.h"
+
+/**
+ * @class GraphCache
+ * @brief Writes and maps versioned binary graph caches
+ *
+ * File layout (native byte order, every section 64-byte aligned):
+ * - header: magic "ACOGRAPH", format version, byte-order mark, city count,
+ *   metric, storage, row stride, neighbor list size, nearest neighbor tour
+ *   length, size and modification time of the source file, section offsets
+ * - cities: n × {x, y, id}
+ * - distances: the Graph buffer exactly as stored (none for ON_THE_FLY)
+ * - neighbor lists: n × k city indices, nearest first
+ *
+ * A cache is fresh if its version and byte order match this build and the
+ * source file still has the recorded size and modification time. Files are
+ * written to a temporary name and renamed, so readers never see a partial
+ * cache, and concurrent writers simply replace each other's identical file.
+ */
+class GraphCache {
+public:
+    /// Version of the file layout; caches of other versions are ignored
+    static constexpr std::uint32_t FORMAT_VERSION = 1;
+
+    /// Neighbors per city stored by default (covers --candidates up to 16)
+    static constexpr int DEFAULT_NEIGHBORS = 16;
+
+    /**
+     * @brief Path of the cache file of an instance and storage layout
+     * @param sourcePath Instance file the cache is built from
+     * @param storage Distance storage layout of the cached graph
+     * @param cacheDirectory Directory for cache files ("" = next to the source)
+     * @return "<source>.<storage>.acocache" next to the source, or
+     *         "<dir>/<name>-<path hash>.<storage>.acocache" in a cache directory
+     *         (the hash keeps same-named files from different directories apart)
+     */
+    static std::string cachePath(const std::string& sourcePath, DistanceStorage storage,
+                                 const std::string& cacheDirectory = "");
+
+    /**
+     * @brief Write a graph to a cache file
+     * @param graph Graph to store
+     * @param cachePath Destination file (its directory is created if needed)
+     * @param sourcePath Instance file whose size and modification time are recorded
+     * @param neighbors Neighbors per city to store (at least the graph's own lists)
+     * @return true on success
+     *
+     * Computes the neighbor lists (and with them the nearest neighbor tour)
+     * unless the graph already has long enough lists.
+     */
+    static bool write(const Graph& graph, const std::string& cachePath,
+                      const std::string& sourcePath, int neighbors = DEFAULT_NEIGHBORS);
+
+    /**
+     * @brief Map a cache file as a graph
+     * @param cachePath Cache file to read
+     * @param sourcePath Instance file the cache must be fresh for ("" = no check)
+     * @param storage Expected storage layout
+     * @return Graph reading from the mapping, or an empty Graph (isValid() false)
+     *         if the file is missing, stale, corrupt or has another layout
+     */
+    static Graph load(const std::string& cachePath, const std::string& sourcePath,
+                      DistanceStorage storage);
+};
+
+#endif // GRAPHCACHE_H
@@ -13,6 +13,60 @@
 
 #include "Tour.h"
 #include "Graph.h"
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @enum LocalSearchOperator
+ * @brief Which family of moves LocalSearch::improve() applies
+ */
+enum class LocalSearchOperator {
+    EXHAUSTIVE,     ///< Full-scan 2-opt (+ 3-opt): tries every edge pair
+    NEIGHBOR_LIST,  ///< 2-opt, Or-opt and or-3opt on nearest neighbors with don't-look bits
+    LIN_KERNIGHAN   ///< Lin-Kernighan-style variable-depth search (+ Or-opt) on nearest neighbors
+};
+
+/**
+ * @struct NeighborLists
+ * @brief Read-only view of flat nearest-neighbor lists (nearest first)
+ *
+ * Row c holds the neighbors of city c; only the first size entries of
+ * each row are used. Matches Graph::getNeighbors() and the candidate
+ * lists kept by AntColony.
+ */
+struct NeighborLists {
+    const int* data = nullptr;  ///< Row-major lists, one row per city
+    int stride = 0;             ///< Entries between consecutive rows (>= size)
+    int size = 0;               ///< Neighbors used per city
+
+    /// Neighbor row of a city (no bounds checking)
+    const int* of(int city) const {
+        return data + static_cast<std::size_t>(city) * stride;
+    }
+
+    /// View of the lists stored on a graph (empty if none were built)
+    static NeighborLists fromGraph(const Graph& graph) {
+        NeighborLists lists;
+        lists.size = graph.getNeighborListSize();
+        lists.stride = graph.getNeighborListStride();
+        lists.data = (lists.size > 0) ? graph.getNeighbors(0) : nullptr;
+        return lists;
+    }
+};
+
+/**
+ * @struct LocalSearchCounters
+ * @brief Work done by the local search operators on one thread
+ *
+ * Operators count in locals and add to the calling thread's counters once
+ * when they return (the parallel scans count on the calling thread too), so
+ * the inner loops pay nothing. Read the difference around a call to
+ * attribute work to it.
+ */
+struct LocalSearchCounters {
+    std::uint64_t moves = 0;        ///< Improving moves applied
+    std::uint64_t evaluations = 0;  ///< Candidate moves scanned (delta evaluations)
+};
 
 /**
  * @class LocalSearch
@@ -21,6 +75,11 @@
  * Provides 2-opt and 3-opt algorithms for post-processing tours.
  * These algorithms iteratively improve tours by swapping edges until
  * a local optimum is reached.
+ *
+ * Each operator is compiled for every distance functor of
+ * Graph::dispatchDistances() and selects one per call, so full double
+ * matrices and on-the-fly metrics evaluate move deltas without a storage
+ * or metric switch per distance.
  */
 class LocalSearch {
 public:
@@ -57,6 +116,118 @@ public:
      */
     static bool threeOpt(Tour& tour, const Graph& graph);
 
+    /**
+     * @brief Improve a tour using 2-opt with the scan split across threads
+     * @param tour The tour to improve (will be modified in-place)
+     * @param graph The graph containing distance information
+     * @return true if any improvement was made, false if already at local optimum
+     *
+     * Each pass splits the O(n²) delta scan into a fixed number of row
+     * blocks that run in parallel (OpenMP) and reduce to the best move of
+     * each block. The block moves are then applied in block order, each
+     * re-checked against the current tour, so one pass applies many moves.
+     * The block layout does not depend on the thread count, so neither
+     * does the result. Without OpenMP the same search runs serially.
+     *
+     * Time complexity: O(n²/threads) per pass
+     * Note: Reaches a full 2-opt local optimum, usually a different one than twoOpt()
+     */
+    static bool twoOptParallel(Tour& tour, const Graph& graph);
+
+    /**
+     * @brief Improve a tour using 3-opt with the scan split across threads
+     * @param tour The tour to improve (will be modified in-place)
+     * @param graph The graph containing distance information
+     * @return true if any improvement was made, false if already at local optimum
+     *
+     * Same reconnections as threeOpt() and the same block scheme as
+     * twoOptParallel(): every pass applies the (re-checked) best move of
+     * each block instead of one best move for the whole tour.
+     *
+     * Time complexity: O(n³/threads) per pass, far fewer passes than threeOpt()
+     */
+    static bool threeOptParallel(Tour& tour, const Graph& graph);
+
+    /**
+     * @brief Improve a tour using neighbor-list 2-opt with don't-look bits
+     * @param tour The tour to improve (will be modified in-place)
+     * @param graph The graph containing distance information
+     * @param neighbors Nearest-neighbor lists of every city
+     * @return true if any improvement was made, false if already at local optimum
+     *
+     * For each active city a, only moves that create an edge (a, c) to one
+     * of a's nearest neighbors are tried, and the scan of a's list stops as
+     * soon as d(a, c) exceeds the edge being removed. Cities whose
+     * neighborhood yielded no improvement are switched off (don't-look bit)
+     * until a move touches them again. A position index lets each move
+     * reverse whichever side of the tour is shorter.
+     *
+     * Time complexity: roughly O(n·k) per sweep instead of O(n²)
+     * Note: Reaches a (slightly weaker) 2-opt local optimum w.r.t. the lists
+     */
+    static bool twoOptNeighbor(Tour& tour, const Graph& graph,
+                               const NeighborLists& neighbors);
+
+    /**
+     * @brief Improve a tour using neighbor-list Or-opt with don't-look bits
+     * @param tour The tour to improve (will be modified in-place)
+     * @param graph The graph containing distance information
+     * @param neighbors Nearest-neighbor lists of every city
+     * @return true if any improvement was made, false if already at local optimum
+     *
+     * Moves a segment of 1-3 consecutive cities to another place in the
+     * tour, in either orientation, so that one segment end becomes adjacent
+     * to one of its nearest neighbors. The first improving move is applied
+     * in place.
+     *
+     * Time complexity: roughly O(n·k) per sweep
+     * Note: Requires neighbor lists; returns false if none are given
+     */
+    static bool orOpt(Tour& tour, const Graph& graph, const NeighborLists& neighbors);
+
+    /**
+     * @brief Improve a tour using neighbor-list segment-insertion 3-opt
+     * @param tour The tour to improve (will be modified in-place)
+     * @param graph The graph containing distance information
+     * @param neighbors Nearest-neighbor lists of every city
+     * @return true if any improvement was made, false if already at local optimum
+     *
+     * Applies the pure 3-opt move ("or-3opt") that swaps two adjacent
+     * segments of any length without reversing them: edges (t1,t2),
+     * (t4,t3), (t5,t6) become (t1,t3), (t2,t5), (t4,t6), where t3 is a
+     * neighbor of t1 and t5 a neighbor of t2. Both partial gains must stay
+     * positive, which prunes most of the k² candidates. The first
+     * improving move is applied in place, moving the two shortest of the
+     * three resulting blocks.
+     *
+     * Time complexity: roughly O(n·k²) per sweep instead of O(n³)
+     * Note: Falls back to threeOpt() when no lists are given
+     */
+    static bool threeOptNeighbor(Tour& tour, const Graph& graph,
+                                 const NeighborLists& neighbors);
+
+    /**
+     * @brief Improve a tour using a Lin-Kernighan-style variable-depth search
+     * @param tour The tour to improve (will be modified in-place)
+     * @param graph The graph containing distance information
+     * @param neighbors Nearest-neighbor lists of every city
+     * @return true if any improvement was made, false if already at local optimum
+     *
+     * Starting from an edge (t1, t2), repeatedly replaces the open edge at
+     * t2 with an edge to one of t2's nearest neighbors and closes the tour
+     * with a 2-opt flip, so each step is a sequential 2-opt move. The chain
+     * continues greedily while the cumulative gain stays positive (up to a
+     * fixed depth) and is then rolled back to its best prefix. Every
+     * neighbor of t2 is tried as the first step; edges added by the chain
+     * are never removed again. Uses don't-look bits and the array tour's
+     * O(1) next/prev/between queries.
+     *
+     * Time complexity: roughly O(n·k²·depth) per sweep, plus the flips
+     * Note: Falls back to twoOpt() when no lists are given
+     */
+    static bool linKernighan(Tour& tour, const Graph& graph,
+                             const NeighborLists& neighbors);
+
     /**
      * @brief Apply both 2-opt and 3-opt in sequence
      * @param tour The tour to improve (will be modified in-place)
@@ -69,38 +240,41 @@ public:
      */
     static bool improve(Tour& tour, const Graph& graph, bool use3opt = true);
 
-private:
     /**
-     * @brief Calculate the change in tour distance from a 2-opt swap
-     * @param sequence Current tour sequence
-     * @param graph Graph with distance information
-     * @param i First edge start index
-     * @param j Second edge start index
-     * @return Negative value means improvement, positive means worse
-     *
-     * Computes delta = new_distance - old_distance without reconstructing tour
+     * @brief Parallel counterpart of improve(tour, graph, use3opt)
+     * @param tour The tour to improve (will be modified in-place)
+     * @param graph The graph containing distance information
+     * @param use3opt If false, only apply 2-opt (default: true)
+     * @return true if any improvement was made
+     *
+     * Runs twoOptParallel(), then optionally threeOptParallel(). Meant for a
+     * single tour (e.g. the best tour) while the other cores would be idle.
      */
-    static double calculate2OptDelta(const std::vector<int>& sequence,
-                                     const Graph& graph, int i, int j);
+    static bool improveParallel(Tour& tour, const Graph& graph, bool use3opt = true);
 
     /**
-     * @brief Reverse a segment of the tour in-place
-     * @param sequence Tour sequence to modify
-     * @param i Start index of segment (inclusive)
-     * @param j End index of segment (inclusive)
+     * @brief Improve a tour with the selected operator family
+     * @param tour The tour to improve (will be modified in-place)
+     * @param graph The graph containing distance information
+     * @param use3opt Also apply the operator's 3-opt style moves
+     * @param op Move family to use
+     * @param neighbors Nearest-neighbor lists (required unless op is EXHAUSTIVE)
+     * @return true if any improvement was made
      *
-     * Helper function for applying 2-opt swaps
+     * EXHAUSTIVE behaves exactly like improve(tour, graph, use3opt).
+     * NEIGHBOR_LIST runs twoOptNeighbor(), then, if use3opt is set, orOpt()
+     * and threeOptNeighbor() in place of the exhaustive 3-opt.
+     * LIN_KERNIGHAN runs linKernighan(), then, if use3opt is set, orOpt()
+     * followed by another linKernighan() pass when Or-opt changed the tour.
      */
-    static void reverseTourSegment(std::vector<int>& sequence, int i, int j);
+    static bool improve(Tour& tour, const Graph& graph, bool use3opt,
+                        LocalSearchOperator op, const NeighborLists& neighbors);
 
-    /**
-     * @brief Calculate total tour distance given a sequence
-     * @param sequence Tour sequence (city IDs)
-     * @param graph Graph with distance information
-     * @return Total tour distance including return to start
-     */
-    static double calculateTourDistance(const std::vector<int>& sequence,
-                                        const Graph& graph);
+    /// Counters of the calling thread (never reset; take differences)
+    static LocalSearchCounters& threadCounters();
+
+    /// Neighbors per city used when no candidate lists are available
+    static constexpr int DEFAULT_NEIGHBORS = 10;
 };
 
 #endif // LOCALSEARCH_H
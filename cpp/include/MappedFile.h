@@ -0,0 +1,59 @@
+/**
+ * @file MappedFile.h
+ * @brief Read-only view of a whole file, memory-mapped where possible
+ */
+
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+/**
+ * @class MappedFile
+ * @brief Read-only contents of a file
+ *
+ * On POSIX systems the file is mapped with mmap (shared, read-only), so
+ * several processes reading the same file share its pages in the page
+ * cache. Elsewhere, or if mapping fails, the file is read into an owned
+ * buffer. Empty files are "open" with size 0.
+ */
+class MappedFile {
+public:
+    /**
+     * @brief Open and map a file
+     * @param path File to read; check isOpen() for success
+     */
+    explicit MappedFile(const std::string& path);
+
+    /// Unmaps the file (or frees the fallback buffer)
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /// True if the file could be opened
+    bool isOpen() const { return open_; }
+
+    /// True if the contents are an actual memory mapping (not a copy)
+    bool isMapped() const { return mapped_; }
+
+    /// First byte of the contents (page aligned when mapped)
+    const char* data() const { return data_; }
+
+    /// Size of the file in bytes
+    std::size_t size() const { return size_; }
+
+    /// The whole contents
+    std::string_view view() const { return std::string_view(data_, size_); }
+
+private:
+    const char* data_ = nullptr;
+    std::size_t size_ = 0;
+    bool mapped_ = false;
+    bool open_ = false;
+    std::string contents_;  ///< Fallback when the file is not mapped
+};
+
+#endif // MAPPEDFILE_H
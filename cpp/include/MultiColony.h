@@ -0,0 +1,137 @@
+#ifndef MULTICOLONY_H
+#define MULTICOLONY_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+#include "AntColony.h"
+#include "Graph.h"
+#include "Tour.h"
+
+// Island model: N independent colonies, each with its own pheromone matrix and
+// random stream, run on separate threads and exchange their best tours every
+// migrationInterval iterations. Colonies share the read-only graph and never
+// touch each other's trails between migrations, so there is no contention.
+class MultiColony {
+public:
+    using ProgressCallback = AntColony::ProgressCallback;
+
+    // Constructor (copies the graph once into storage shared by all colonies)
+    MultiColony(const Graph& graph, int numColonies, int numAnts, double alpha, double beta,
+                double rho, double Q, bool useDistinctStartCities = false);
+
+    // Constructor sharing a read-only graph between all colonies without copying it
+    MultiColony(std::shared_ptr<const Graph> graph, int numColonies, int numAnts, double alpha,
+                double beta, double rho, double Q, bool useDistinctStartCities = false);
+
+    // Apply the same settings to every colony (local search, pheromone mode, ...).
+    // Colonies run serially inside their own thread by default (setUseParallel(false)).
+    void configure(const std::function<void(AntColony&)>& setup);
+
+    // Run all colonies for maxIterations iterations each, migrating every
+    // migrationInterval iterations (or until the best tour has not improved for
+    // convergenceThreshold iterations if maxIterations < 0). The callback sees the
+    // best tour over all colonies and the per-iteration best over all colonies.
+    // The time limit, target distance and requestStop() end the run early: every
+    // colony checks them before each of its iterations, so a stop or an expired
+    // budget does not wait for the next migration. getStopReason() tells which
+    // criterion ended the run.
+    Tour solve(int maxIterations, ProgressCallback callback = nullptr);
+
+    // Wall-clock budget for solve() in seconds, setup included (default: 0 = none).
+    // A colony does not start an iteration its previous one suggests would
+    // overrun the budget. The colonies' own limits are not used.
+    void setTimeLimit(double seconds);
+
+    // Stop solve() once any colony's best tour is at most this long (default: 0 = none)
+    void setTargetDistance(double distance);
+
+    // Ask solve() to return after the colonies' current iterations. Safe to call
+    // from any thread, also before solve() starts; solve() clears the request
+    // when it returns.
+    void requestStop();
+
+    // Why the last solve() returned: "iterations", "convergence", "time-limit",
+    // "target" or "stopped" (empty before the first solve())
+    const std::string& getStopReason() const { return stopReason_; }
+
+    // Seed the colonies (default: non-deterministic). Colony i gets its own seed
+    // derived from this one, so a seeded solve() gives the same result for any
+    // thread count.
+    void setSeed(std::uint64_t seed);
+
+    // Iterations between migrations (default: 10, 0 = never migrate)
+    void setMigrationInterval(int iterations);
+
+    // Migration topology: "ring" (colony i sends its best tour to colony i+1) or
+    // "broadcast" (every colony receives the overall best tour). Default: "ring"
+    void setMigrationTopology(const std::string& topology);
+
+    // Number of threads running colonies (default: 0 = OpenMP default)
+    void setNumThreads(int numThreads);
+
+    // Set progress callback (alternative to passing to solve())
+    void setProgressCallback(ProgressCallback callback);
+
+    // Set callback interval (default: 10 iterations)
+    void setCallbackInterval(int interval);
+
+    // Set convergence threshold (default: 200 iterations without improvement)
+    void setConvergenceThreshold(int threshold);
+
+    // Getters
+    int getNumColonies() const { return static_cast<int>(colonies_.size()); }
+    AntColony& getColony(int index) { return *colonies_[index]; }
+    const AntColony& getColony(int index) const { return *colonies_[index]; }
+    const Tour& getBestTour() const { return bestTour_; }
+    int getBestColony() const { return bestColony_; }
+    const std::vector<double>& getConvergenceData() const { return iterationBestDistances_; }
+    int getMigrationInterval() const { return migrationInterval_; }
+    const std::string& getMigrationTopology() const { return migrationTopology_; }
+    int getNumMigrations() const { return numMigrations_; }
+    double getTimeLimit() const { return timeLimit_; }
+    double getTargetDistance() const { return targetDistance_; }
+
+private:
+    std::vector<std::unique_ptr<AntColony>> colonies_;
+    int migrationInterval_ = 10;          // Iterations between migrations (0 = never)
+    std::string migrationTopology_ = "ring";  // "ring" or "broadcast"
+    int numThreads_ = 0;                  // Threads running colonies (0 = OpenMP default)
+    ProgressCallback progressCallback_;
+    int callbackInterval_ = 10;
+    int convergenceThreshold_ = 200;
+    double timeLimit_ = 0.0;              // Wall-clock budget of solve() in seconds (0 = none)
+    double targetDistance_ = 0.0;         // Stop once the best tour is this short (0 = none)
+    std::string stopReason_;              // Criterion that ended the last solve()
+    std::atomic<bool> stopRequested_{false};  // Set by requestStop(), possibly from another thread
+    std::chrono::steady_clock::time_point startTime_;  // When the running solve() was entered
+    std::vector<double> lastIterationSeconds_;  // Duration of each colony's latest iteration
+
+    Tour bestTour_;
+    int bestColony_ = -1;
+    int numMigrations_ = 0;
+    std::vector<double> iterationBestDistances_;  // Best over all colonies, per iteration
+    std::vector<Tour> migrants_;          // Snapshot of every colony's best tour (reused)
+
+    // Early stop criterion that holds now ("stopped", "target", "time-limit"),
+    // or nullptr; bestDistance is the best tour length to test the target with
+    // and nextIterationSeconds the expected length of the next iteration
+    const char* earlyStopReason(double bestDistance, double nextIterationSeconds) const;
+
+    // Run every colony for up to the given number of iterations, one colony per
+    // thread. Returns the most iterations any colony completed: fewer than asked
+    // when an early stop criterion ended the epoch (stopReason_ is then set)
+    int runEpoch(int iterations);
+
+    // Merge the colonies' latest convergence entries and best tours
+    void collectResults(int fromIteration, int toIteration);
+
+    // Exchange best tours according to the topology
+    void migrate();
+};
+
+#endif // MULTICOLONY_H
@@ -0,0 +1,157 @@
+/**
+ * @file NumaPlacement.h
+ * @brief First-touch placement of the large matrices and thread binding
+ *
+ * On a multi-socket machine the kernel places each page of a buffer on the
+ * node of the thread that first writes it. A matrix filled by one thread
+ * therefore lives entirely on that thread's node, and the threads of every
+ * other socket read it across the interconnect. firstTouchRows() fills a
+ * fresh row-major matrix with the static row split of the compute loops:
+ * the fused pheromone update, the deposit merge and the heuristic and
+ * choice-info rebuilds all run schedule(static) over the same rows, so each
+ * thread finds its row block on its own node. Tour construction reads rows
+ * at random; for it (and for the distance matrix, which is mostly read that
+ * way) the placement only spreads the traffic over all memory controllers.
+ *
+ * That placement only pays off if OpenMP threads stay on their cores:
+ * bindThreads() pins them ("close": fill one socket first, "spread": deal
+ * threads round-robin over the nodes). Linux only; elsewhere, and without
+ * OpenMP, binding is unavailable and firstTouch() is a plain fill.
+ */
+
+#ifndef NUMAPLACEMENT_H
+#define NUMAPLACEMENT_H
+
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace numa {
+
+/// Buffers smaller than this are filled by the calling thread (bytes)
+constexpr std::size_t FIRST_TOUCH_MIN_BYTES = 1 << 22;
+
+/**
+ * @enum ThreadBinding
+ * @brief Where bindThreads() pins the OpenMP threads
+ */
+enum class ThreadBinding {
+    NONE,    ///< Leave placement to the OS (and OMP_PROC_BIND / OMP_PLACES)
+    CLOSE,   ///< Thread t on the t-th allowed CPU: one node is filled first
+    SPREAD   ///< Threads dealt round-robin over the nodes: all sockets from two threads on
+};
+
+/**
+ * @brief Enable or disable parallel first touch (default: enabled)
+ *
+ * Disabled, firstTouch() fills on the calling thread, which reproduces the
+ * single-node placement (useful to measure what the placement is worth).
+ */
+void setFirstTouchEnabled(bool enabled);
+bool isFirstTouchEnabled();
+
+/**
+ * @brief Fill a freshly allocated buffer, each thread writing its static share
+ * @tparam T Element type
+ * @param data Buffer start (not yet written, e.g. AlignedVector::resize())
+ * @param count Number of elements
+ * @param value Value written to every element
+ *
+ * Thread t of the team writes the t-th of equal contiguous element blocks.
+ * For layouts without equal rows (the triangular distances) this spreads
+ * the pages over the nodes but does not match any row loop; use
+ * firstTouchRows() for row-major matrices.
+ */
+template <typename T>
+void firstTouch(T* data, std::size_t count, T value) {
+#ifdef _OPENMP
+    if (isFirstTouchEnabled() && count * sizeof(T) >= FIRST_TOUCH_MIN_BYTES) {
+        const std::ptrdiff_t size = static_cast<std::ptrdiff_t>(count);
+        #pragma omp parallel for schedule(static)
+        for (std::ptrdiff_t i = 0; i < size; ++i) {
+            data[i] = value;
+        }
+        return;
+    }
+#endif
+    std::fill(data, data + count, value);
+}
+
+/**
+ * @brief Fill a fresh row-major matrix, each thread writing its static share of rows
+ * @tparam T Element type
+ * @param data Matrix start (not yet written)
+ * @param rows Number of rows
+ * @param stride Elements per row, padding included
+ * @param value Value written to every element
+ *
+ * Thread t writes the rows "#pragma omp for schedule(static)" over the rows
+ * gives it: the first rows % threads threads get one row more. The row
+ * blocks of PheromoneDeposits are cut the same way.
+ */
+template <typename T>
+void firstTouchRows(T* data, std::size_t rows, std::size_t stride, T value) {
+#ifdef _OPENMP
+    if (isFirstTouchEnabled() && rows * stride * sizeof(T) >= FIRST_TOUCH_MIN_BYTES) {
+        const std::ptrdiff_t numRows = static_cast<std::ptrdiff_t>(rows);
+        #pragma omp parallel for schedule(static)
+        for (std::ptrdiff_t row = 0; row < numRows; ++row) {
+            std::fill(data + row * stride, data + (row + 1) * stride, value);
+        }
+        return;
+    }
+#endif
+    std::fill(data, data + rows * stride, value);
+}
+
+/**
+ * @brief Parse a binding name: "none", "close" or "spread"
+ * @return bool False (binding unchanged) for any other name
+ */
+bool parseThreadBinding(const std::string& name, ThreadBinding& binding);
+
+/// Name of a binding, as accepted by parseThreadBinding()
+const char* threadBindingName(ThreadBinding binding);
+
+/**
+ * @brief CPUs of each NUMA node, restricted to the CPUs this process may use
+ * @return One list per node with usable CPUs (a single list if the topology
+ *         is unknown); empty if the allowed CPUs cannot be determined
+ */
+std::vector<std::vector<int>> nodeCpus();
+
+/// Number of NUMA nodes this process can run on (at least 1)
+int numNodes();
+
+/**
+ * @brief CPU for each of numThreads threads under a binding
+ * @param nodes CPUs per node (see nodeCpus())
+ * @param binding CLOSE or SPREAD (NONE gives an empty list)
+ * @param numThreads Threads to place; CPUs are reused cyclically if there
+ *        are more threads than CPUs
+ */
+std::vector<int> threadCpus(const std::vector<std::vector<int>>& nodes,
+                            ThreadBinding binding, int numThreads);
+
+/**
+ * @brief Pin the OpenMP threads of the calling thread's teams
+ * @param binding CLOSE or SPREAD; NONE does nothing
+ * @param numThreads Team size to bind (0 = omp_get_max_threads())
+ * @return bool True if every thread was pinned
+ *
+ * Runs one parallel region of numThreads threads in which thread t pins
+ * itself to threadCpus()[t]. OpenMP keeps its worker threads between
+ * regions, so later regions of up to numThreads threads started from the
+ * same thread run on the same cores. Call it before the graph is built so
+ * first touch and computation use the same cores.
+ */
+bool bindThreads(ThreadBinding binding, int numThreads = 0);
+
+}  // namespace numa
+
+#endif // NUMAPLACEMENT_H
@@ -1,8 +1,24 @@
 #ifndef PHEROMONEMATRIX_H
 #define PHEROMONEMATRIX_H
 
+#include <cstddef>
+#include <utility>
 #include <vector>
+#include "AlignedAllocator.h"
 
+class PheromoneDeposits;
+
+// Dense choice-info matrix refreshed by PheromoneMatrix::fusedUpdate():
+// choice[i][j] = tau(i,j)^alpha * heuristic[i][j], both numCities × stride
+struct ChoiceInfoView {
+    double* choice = nullptr;
+    const double* heuristic = nullptr;
+    std::size_t stride = 0;
+    double alpha = 1.0;
+};
+
+// Pheromone levels are stored in one contiguous, cache-line aligned row-major
+// buffer (rows padded to 64 bytes) so whole-matrix passes are a single linear sweep.
 class PheromoneMatrix {
 public:
     // Constructor
@@ -11,8 +27,10 @@ public:
     // Reset all pheromones to initial value
     void initialize(double value);
 
-    // Get pheromone level between two cities
-    double getPheromone(int cityA, int cityB) const;
+    // Get pheromone level between two cities (no bounds checking)
+    double getPheromone(int cityA, int cityB) const {
+        return pheromones_[index(cityA, cityB)];
+    }
 
     // Set pheromone level between two cities
     void setPheromone(int cityA, int cityB, double value);
@@ -23,24 +41,108 @@ public:
     // Add pheromone to edge
     void depositPheromone(int cityA, int cityB, double amount);
 
+    // Apply buffered deposits without atomics: each row block is merged by
+    // one thread, so every cell has a single writer. Per cell, amounts are
+    // added in source order, giving the same sums as depositing serially.
+    void depositPheromones(const PheromoneDeposits& deposits, bool parallel = true);
+
     // Enforce min/max bounds (optional, for MMAS variant)
     void clampPheromones();
 
+    // One pass per iteration instead of evaporate + deposit + clamp (+ choice
+    // info rebuild): every cell becomes clamp(tau * (1 - rho) + deposits)
+    // and, if choiceInfo is given, its choice entry is refreshed while the
+    // row is still in cache. Row blocks of the deposits run in parallel and
+    // each row is one streaming sweep, so every cell is read and written
+    // once; (i,j) and (j,i) get identical inputs and stay symmetric.
+    void fusedUpdate(double rho, const PheromoneDeposits& deposits,
+                     const ChoiceInfoView* choiceInfo = nullptr, bool parallel = true);
+
     // Getters
     int getNumCities() const { return numCities_; }
     double getMinPheromone() const { return minPheromone_; }
     double getMaxPheromone() const { return maxPheromone_; }
 
+    // Raw row access for hot loops: row holds getNumCities() values
+    const double* getRow(int city) const { return pheromones_.data() + static_cast<std::size_t>(city) * rowStride_; }
+
     // Setters for bounds
     void setMinPheromone(double minPheromone) { minPheromone_ = minPheromone; }
     void setMaxPheromone(double maxPheromone) { maxPheromone_ = maxPheromone; }
 
 private:
-    std::vector<std::vector<double>> pheromones_;
+    std::size_t index(int cityA, int cityB) const {
+        return static_cast<std::size_t>(cityA) * rowStride_ + cityB;
+    }
+
     int numCities_;
+    std::size_t rowStride_;              // Padded row length (multiple of 64 bytes)
+    AlignedVector<double> pheromones_;   // Flat row-major n×stride matrix
     double initialPheromone_;
     double minPheromone_;
     double maxPheromone_;
 };
 
+// Pheromone contributions gathered per source (e.g. per ant) before being
+// merged into a PheromoneMatrix. Edges are stored as (low, high) city pairs
+// in the bucket of each endpoint's row block (once if both share a block),
+// so a block finds every deposit touching its rows in its own buckets.
+// Blocks are contiguous ranges of equal row counts.
+class PheromoneDeposits {
+public:
+    // Canonical edge (cityA < cityB) and the amount it receives
+    struct EdgeDeposit {
+        int cityA;
+        int cityB;
+        double amount;
+    };
+
+    // Clear all buckets (capacity is kept) and size them for numSources
+    // sources over numBlocks row blocks of an n-city matrix
+    void reset(int numSources, int numCities, int numBlocks);
+
+    // Record a deposit; concurrent calls are safe for distinct sources
+    void add(int source, int cityA, int cityB, double amount) {
+        if (cityA == cityB) {
+            return;
+        }
+        if (cityB < cityA) {
+            std::swap(cityA, cityB);
+        }
+        const int blockA = rowBlock_[cityA];
+        const int blockB = rowBlock_[cityB];
+        mutableBucket(source, blockA).push_back({cityA, cityB, amount});
+        if (blockB != blockA) {
+            mutableBucket(source, blockB).push_back({cityA, cityB, amount});
+        }
+    }
+
+    // Record amount on every edge of a closed tour
+    void addTour(int source, const std::vector<int>& tour, double amount);
+
+    int getNumSources() const { return numSources_; }
+    int getNumBlocks() const { return numBlocks_; }
+    int getNumCities() const { return numCities_; }
+
+    // First row of a block (block == getNumBlocks() gives the row count)
+    int getBlockBegin(int block) const { return blockBegin_[block]; }
+
+    // Deposits of one source with an endpoint in one block
+    const std::vector<EdgeDeposit>& bucket(int source, int block) const {
+        return buckets_[static_cast<std::size_t>(source) * numBlocks_ + block];
+    }
+
+private:
+    std::vector<EdgeDeposit>& mutableBucket(int source, int block) {
+        return buckets_[static_cast<std::size_t>(source) * numBlocks_ + block];
+    }
+
+    int numSources_ = 0;
+    int numCities_ = 0;
+    int numBlocks_ = 0;
+    std::vector<int> rowBlock_;                       // Block owning each row
+    std::vector<int> blockBegin_;                     // First row of each block (+ end)
+    std::vector<std::vector<EdgeDeposit>> buckets_;   // [source * numBlocks + block]
+};
+
 #endif // PHEROMONEMATRIX_H
@@ -0,0 +1,65 @@
+#ifndef POWER_H
+#define POWER_H
+
+#include <cmath>
+
+// x^N for a small positive integer N, as multiplications (x^2 = x*x, x^4 = (x*x)^2).
+// Inlines and vectorizes where std::pow is a library call per element; the result
+// may differ from std::pow in the last bit.
+template <int N>
+struct IntegerPower {
+    static_assert(N >= 1, "IntegerPower needs a positive exponent");
+
+    double operator()(double x) const {
+        if constexpr (N == 1) {
+            return x;
+        } else if constexpr (N % 2 == 0) {
+            double half = IntegerPower<N / 2>{}(x);
+            return half * half;
+        } else {
+            return x * IntegerPower<N - 1>{}(x);
+        }
+    }
+};
+
+// x^exponent for any other exponent
+struct RealPower {
+    double exponent;
+
+    double operator()(double x) const { return std::pow(x, exponent); }
+};
+
+// Call function with the power functor for an exponent: IntegerPower<N> for
+// N = 1..5 (alpha = 1 and beta = 2, 3 or 5 in practice), RealPower otherwise.
+// Dispatch once outside a loop, so the loop body is compiled for that exponent.
+template <typename Function>
+decltype(auto) dispatchPower(double exponent, Function&& function) {
+    if (exponent == 1.0) {
+        return function(IntegerPower<1>{});
+    }
+    if (exponent == 2.0) {
+        return function(IntegerPower<2>{});
+    }
+    if (exponent == 3.0) {
+        return function(IntegerPower<3>{});
+    }
+    if (exponent == 4.0) {
+        return function(IntegerPower<4>{});
+    }
+    if (exponent == 5.0) {
+        return function(IntegerPower<5>{});
+    }
+    return function(RealPower{exponent});
+}
+
+// Both exponents of the ant decision rule at once: function(alphaPower, betaPower)
+template <typename Function>
+decltype(auto) dispatchPowers(double alpha, double beta, Function&& function) {
+    return dispatchPower(alpha, [&](auto alphaPower) {
+        return dispatchPower(beta, [&](auto betaPower) {
+            return function(alphaPower, betaPower);
+        });
+    });
+}
+
+#endif // POWER_H
@@ -0,0 +1,67 @@
+#ifndef PROGRESSREPORTER_H
+#define PROGRESSREPORTER_H
+
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "ColonyStats.h"
+
+// What changed since the previous incremental progress update
+struct ProgressUpdate {
+    int iteration = 0;                   // Iterations completed
+    double bestDistance = 0.0;           // Best-so-far tour length
+    bool tourImproved = false;           // The best tour changed; bestTour holds it
+    std::vector<int> bestTour;           // New best tour (empty unless tourImproved)
+    int convergenceOffset = 0;           // Iteration index of newConvergence[0]
+    std::vector<double> newConvergence;  // Iteration bests since the previous update
+    PhaseStats profile;                  // Profile totals so far (zero unless profiling)
+    bool final = false;                  // Last update of the run
+};
+
+// Delivers progress updates to a callback, either directly on the publishing
+// thread or on a worker thread of its own. Asynchronous delivery never makes
+// the publisher wait for the callback: an update the callback has not picked
+// up yet is merged with the next one (convergence points appended, the newer
+// tour kept), so a slow consumer sees fewer, larger updates and loses nothing.
+class ProgressReporter {
+public:
+    using Callback = std::function<void(const ProgressUpdate&)>;
+
+    ProgressReporter(Callback callback, bool asynchronous);
+
+    // Joins the worker; updates still pending are dropped
+    ~ProgressReporter();
+
+    ProgressReporter(const ProgressReporter&) = delete;
+    ProgressReporter& operator=(const ProgressReporter&) = delete;
+
+    // Hand an update over (synchronous mode: call the callback now)
+    void publish(ProgressUpdate&& update);
+
+    // Deliver what is pending and stop the worker. Rethrows the first
+    // exception the callback raised on the worker thread.
+    void finish();
+
+private:
+    // Worker loop: wait for a pending update, deliver it outside the lock
+    void run();
+
+    // Fold a newer update into an undelivered one
+    static void merge(ProgressUpdate& pending, ProgressUpdate&& update);
+
+    Callback callback_;
+    bool asynchronous_;
+    std::mutex mutex_;                   // Guards the members below
+    std::condition_variable ready_;
+    ProgressUpdate pending_;
+    bool hasPending_ = false;
+    bool finishing_ = false;             // Deliver the rest, then exit
+    bool stopping_ = false;              // Exit without delivering
+    std::exception_ptr error_;           // First exception thrown by the callback
+    std::thread worker_;
+};
+
+#endif // PROGRESSREPORTER_H
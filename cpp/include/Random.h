@@ -0,0 +1,120 @@
+/**
+ * @file Random.h
+ * @brief Small, fast pseudo-random number generator for per-ant streams
+ *
+ * Every ant owns one generator, so threads never share generator state
+ * and a run is reproducible from a single seed regardless of how ants
+ * are scheduled across threads.
+ */
+
+#ifndef RANDOM_H
+#define RANDOM_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+/**
+ * @class Xoshiro256
+ * @brief xoshiro256** generator (Blackman & Vigna), 256 bits of state
+ *
+ * Satisfies UniformRandomBitGenerator, so it also works with the standard
+ * <random> distributions. The state is seeded from a 64-bit value through
+ * SplitMix64, which turns nearby seeds (0, 1, 2, ...) into unrelated streams.
+ */
+class Xoshiro256 {
+public:
+    using result_type = std::uint64_t;
+
+    /**
+     * @brief Construct a generator from a 64-bit seed
+     * @param value Any value; equal seeds give equal sequences
+     */
+    explicit Xoshiro256(std::uint64_t value = 0) { seed(value); }
+
+    /**
+     * @brief Reset the generator to the start of the stream for a seed
+     * @param value Any value; equal seeds give equal sequences
+     */
+    void seed(std::uint64_t value) {
+        for (std::uint64_t& word : state_) {
+            word = splitMix64(value);
+        }
+    }
+
+    /**
+     * @brief Get the position in the stream
+     * @return std::array<std::uint64_t, 4> The 256-bit state (e.g. for a checkpoint)
+     */
+    std::array<std::uint64_t, 4> getState() const {
+        return {state_[0], state_[1], state_[2], state_[3]};
+    }
+
+    /**
+     * @brief Continue the stream from a saved position
+     * @param state A state returned by getState() (not all zero)
+     */
+    void setState(const std::array<std::uint64_t, 4>& state) {
+        for (std::size_t i = 0; i < state.size(); ++i) {
+            state_[i] = state[i];
+        }
+    }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    /// Next 64 random bits
+    result_type operator()() {
+        const std::uint64_t result = rotl(state_[1] * 5, 7) * 9;
+        const std::uint64_t t = state_[1] << 17;
+
+        state_[2] ^= state_[0];
+        state_[3] ^= state_[1];
+        state_[1] ^= state_[2];
+        state_[0] ^= state_[3];
+        state_[2] ^= t;
+        state_[3] = rotl(state_[3], 45);
+
+        return result;
+    }
+
+    /// Uniform double in [0, 1) with 53 random bits
+    double nextDouble() {
+        return static_cast<double>((*this)() >> 11) * 0x1.0p-53;
+    }
+
+    /**
+     * @brief Uniform integer in [0, bound)
+     * @param bound Exclusive upper limit (must be > 0)
+     *
+     * Multiply-shift mapping (Lemire); the bias is below 2^-32 for any
+     * bound that fits in an int, which is irrelevant for roulette selection.
+     */
+    int nextInt(int bound) {
+        std::uint64_t high = (*this)() >> 32;
+        return static_cast<int>((high * static_cast<std::uint64_t>(bound)) >> 32);
+    }
+
+    /**
+     * @brief Mix a 64-bit value into a well-distributed 64-bit value
+     * @param x In/out SplitMix64 state, advanced by one step
+     *
+     * Also handy for deriving per-ant seeds from a colony seed.
+     */
+    static std::uint64_t splitMix64(std::uint64_t& x) {
+        std::uint64_t z = (x += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+private:
+    std::uint64_t state_[4];
+
+    static std::uint64_t rotl(std::uint64_t x, int k) {
+        return (x << k) | (x >> (64 - k));
+    }
+};
+
+#endif // RANDOM_H
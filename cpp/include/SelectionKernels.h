@@ -0,0 +1,64 @@
+#ifndef SELECTIONKERNELS_H
+#define SELECTIONKERNELS_H
+
+#include <cstdint>
+
+// SIMD kernels behind Ant::selectNextCity(choiceRow): the masked sums and
+// maxima of a choice-info row over the unvisited cities. The kernel set is
+// picked at runtime from what the CPU supports (AVX-512, AVX2, NEON or plain
+// scalar code), so one binary runs everywhere.
+//
+// Every kernel sums in the same fixed order: 8 lanes, element i going to lane
+// i % 8 of its block, lanes combined pairwise. Scalar and SIMD results are
+// therefore bit-identical, and a seeded run picks the same tours on every
+// machine.
+namespace selection {
+
+// Instruction sets with their own kernels
+enum class Isa { SCALAR, AVX2, AVX512, NEON };
+
+// Cities per block of blockSums(): roulette selection first finds the block,
+// then scans at most this many cities
+constexpr int BLOCK_SIZE = 64;
+
+// Number of blocks of a row of n cities
+inline int numBlocks(int n) { return (n + BLOCK_SIZE - 1) / BLOCK_SIZE; }
+
+struct Kernels {
+    // Writes the sum of the unvisited weights of each block to sums
+    // (numBlocks(n) entries) and returns the total of all blocks, added in
+    // block order
+    double (*blockSums)(const double* weights, const std::uint8_t* visited, int n, double* sums);
+
+    // Largest unvisited weight (weights are >= 0), or -1.0 if every city is visited
+    double (*maxWeight)(const double* weights, const std::uint8_t* visited, int n);
+
+    Isa isa;
+    const char* name;
+};
+
+// Whether this build and CPU can run the kernels of an instruction set
+bool isSupported(Isa isa);
+
+// Kernels of an instruction set (the scalar ones if it is not supported)
+const Kernels& kernels(Isa isa);
+
+// Kernels used by the ants: the best supported set, detected on first use
+const Kernels& activeKernels();
+
+// Force an instruction set (benchmarks, tests); false if it is not supported
+bool setActiveIsa(Isa isa);
+
+// Roulette pick given the block sums of a row: the first unvisited city whose
+// running weight (blocks in order, then cities in order) reaches target.
+// Returns the last unvisited city of the block the target falls into if
+// rounding leaves the running sum short, and -1 if target exceeds the total.
+int pickFromBlocks(const double* weights, const std::uint8_t* visited, int n,
+                   const double* sums, double target);
+
+// First unvisited city whose weight equals best (as returned by maxWeight), or -1
+int findWeight(const double* weights, const std::uint8_t* visited, int n, double best);
+
+}  // namespace selection
+
+#endif // SELECTIONKERNELS_H
@@ -0,0 +1,106 @@
+#ifndef SOLVERPOOL_H
+#define SOLVERPOOL_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <vector>
+#include "AntColony.h"
+#include "Graph.h"
+#include "Tour.h"
+
+// One solve submitted to a SolverPool
+struct SolverJob {
+    std::shared_ptr<const Graph> graph;  // Read-only, shared with other jobs (never copied)
+    int numAnts = 20;
+    double alpha = 1.0;
+    double beta = 2.0;
+    double rho = 0.5;
+    double Q = 100.0;
+    int maxIterations = 100;             // < 0: until convergence (see AntColony::solve)
+    int threads = 1;                     // Thread budget (clamped to the pool size)
+    int priority = 0;                    // Higher starts first; FIFO within a priority
+
+    // Further settings (seed, local search, time limit, ...), applied on the
+    // worker thread before the solve. The thread settings are the pool's.
+    std::function<void(AntColony&)> configure;
+};
+
+// What a job's future delivers
+struct SolverResult {
+    Tour tour;                           // Best tour found
+    std::vector<double> convergence;     // Iteration bests
+    std::string stopReason;              // AntColony::getStopReason()
+    double waitSeconds = 0.0;            // Time spent queued
+    double solveSeconds = 0.0;           // Time spent running
+};
+
+// Runs many independent solves on one fixed set of worker threads. Each job
+// holds `threads` of the pool's thread slots while it runs (its OpenMP
+// regions use exactly that many threads), so concurrent jobs never
+// oversubscribe the cores. Queued jobs start by priority, then submission
+// order; a job waits until enough slots are free, and jobs behind it wait
+// too, so wide jobs are not starved by a stream of narrow ones.
+class SolverPool {
+public:
+    // numThreads = 0: one slot per hardware thread
+    explicit SolverPool(int numThreads = 0);
+
+    // Finishes every queued and running job, then joins the workers
+    ~SolverPool();
+
+    SolverPool(const SolverPool&) = delete;
+    SolverPool& operator=(const SolverPool&) = delete;
+
+    // Queue a job. Invalid jobs (no or empty graph, numAnts < 1) and
+    // exceptions thrown while solving are reported through the future.
+    std::future<SolverResult> submit(SolverJob job);
+
+    // Block until no job is queued or running
+    void waitIdle();
+
+    int getNumThreads() const { return numThreads_; }
+    int getQueuedJobs() const;
+    int getRunningJobs() const;
+
+private:
+    struct Entry {
+        SolverJob job;
+        std::promise<SolverResult> promise;
+        std::uint64_t sequence = 0;
+        std::chrono::steady_clock::time_point submitted;
+    };
+
+    // Priority order: higher priority first, then lower sequence
+    struct EntryOrder {
+        bool operator()(const std::shared_ptr<Entry>& a, const std::shared_ptr<Entry>& b) const;
+    };
+
+    // Worker loop: start the head job once its budget fits
+    void run();
+
+    // Solve one job on the calling worker thread
+    static SolverResult execute(SolverJob& job, int threads);
+
+    int budget(const SolverJob& job) const;
+
+    int numThreads_;
+    mutable std::mutex mutex_;           // Guards the members below
+    std::condition_variable changed_;    // Queue, free slots or stop flag changed
+    std::priority_queue<std::shared_ptr<Entry>, std::vector<std::shared_ptr<Entry>>,
+                        EntryOrder> queue_;
+    int freeSlots_;
+    int running_ = 0;
+    std::uint64_t nextSequence_ = 0;
+    bool stopping_ = false;
+    std::vector<std::thread> workers_;
+};
+
+#endif // SOLVERPOOL_H
@@ -2,9 +2,16 @@
  * @file TSPLoader.h
  * @brief Loads TSP problem instances from files
  *
- * This class supports loading TSP problems from two file formats:
+ * This class supports loading TSP problems from three file formats:
  * 1. Coordinate format: City ID, X, Y coordinates
  * 2. Distance matrix format: Precomputed distance matrix
+ * 3. TSPLIB: EUC_2D, CEIL_2D, GEO, ATT and EXPLICIT instances
+ *
+ * Files are memory-mapped (read into memory where mapping is unavailable)
+ * and numbers are parsed with std::from_chars straight from the mapping,
+ * without per-line strings or streams. Large distance matrices are parsed
+ * in parallel chunks. loadGraph() skips parsing altogether when a fresh
+ * binary cache of the instance exists (see GraphCache).
  */
 
 #ifndef TSPLOADER_H
@@ -13,6 +20,7 @@
 #include "City.h"
 #include "Graph.h"
 #include <string>
+#include <string_view>
 #include <vector>
 
 /**
@@ -20,7 +28,8 @@
  * @brief Loads and parses TSP problem instances from files
  *
  * The loader can auto-detect file format or load specific formats directly.
- * Performs validation and error checking during loading.
+ * Performs validation and error checking during loading. Each load reads
+ * the file exactly once.
  */
 class TSPLoader {
 public:
@@ -34,49 +43,104 @@ public:
 
   /**
    * @brief Load graph from file with automatic format detection
+   * @param storage Distance matrix layout of the resulting graph
    * @return Graph object containing cities and distances
    *
+   * If a fresh cache file for this file and storage exists (see
+   * getCachePath()), the graph is mapped from it instead of parsed. With
+   * setWriteCache(true) a cache is written after parsing.
    * Returns empty Graph if loading fails.
    */
-  Graph loadGraph();
+  Graph loadGraph(DistanceStorage storage = DistanceStorage::FULL_DOUBLE);
+
+  /**
+   * @brief Set where cache files are looked up and written
+   * @param directory Cache directory ("" = next to the instance file, default)
+   */
+  void setCacheDirectory(const std::string &directory);
+
+  /**
+   * @brief Write a cache file whenever loadGraph() had to parse the file
+   * @param enabled true to write caches (default: false, caches are only read)
+   */
+  void setWriteCache(bool enabled);
+
+  /**
+   * @brief Cache file used by loadGraph() for a storage layout
+   * @param storage Distance matrix layout
+   * @return Path of the cache file (which may not exist)
+   */
+  std::string getCachePath(DistanceStorage storage = DistanceStorage::FULL_DOUBLE) const;
+
+  /**
+   * @brief Check whether the last loadGraph() call used the cache
+   * @return true if the graph was mapped from a cache file
+   */
+  bool wasLoadedFromCache() const { return loadedFromCache_; }
 
   /**
    * @brief Load from coordinate format file
    * @param filename Path to coordinate format file
+   * @param storage Distance matrix layout of the resulting graph
    * @return Graph constructed from city coordinates
    *
    * Expected format:
    * Line 1: Number of cities (n)
    * Lines 2 to n+1: City_ID X_coordinate Y_coordinate
    */
-  static Graph loadFromCoordinates(const std::string &filename);
+  static Graph loadFromCoordinates(const std::string &filename,
+                                   DistanceStorage storage = DistanceStorage::FULL_DOUBLE);
 
   /**
    * @brief Load from distance matrix format file
    * @param filename Path to distance matrix format file
-   * @return Graph with synthetic coordinates approximating distances
+   * @param storage Distance matrix layout of the resulting graph
+   * @return Graph with the given distances and synthetic coordinates
    *
    * Expected format:
    * Line 1: Number of cities (n)
    * Lines 2 to n+1: n distance values per line (n×n matrix)
    *
-   * Note: Since Graph requires City objects with coordinates, this method
-   * generates synthetic coordinates. Exact distances may not be preserved.
+   * The graph uses the given distances exactly (DistanceMetric::EXPLICIT);
+   * the upper triangle is used if the matrix is not symmetric. Since Graph
+   * requires City objects, synthetic coordinates are generated for display.
    */
-  static Graph loadFromDistanceMatrix(const std::string &filename);
+  static Graph loadFromDistanceMatrix(const std::string &filename,
+                                      DistanceStorage storage = DistanceStorage::FULL_DOUBLE);
 
   /**
    * @brief Load from TSPLIB format file
    * @param filename Path to TSPLIB format file
+   * @param storage Distance matrix layout of the resulting graph
    * @return Graph constructed from TSPLIB data
    *
-   * Supports TSPLIB format with NODE_COORD_SECTION.
-   * Automatically detects and parses header information.
+   * Supports NODE_COORD_SECTION instances (EUC_2D, CEIL_2D, GEO, ATT) and
+   * EXPLICIT instances with an EDGE_WEIGHT_SECTION in FULL_MATRIX,
+   * UPPER_ROW, LOWER_ROW, UPPER_DIAG_ROW or LOWER_DIAG_ROW format. EXPLICIT
+   * instances take their display coordinates from DISPLAY_DATA_SECTION (or
+   * NODE_COORD_SECTION) when present.
+   */
+  static Graph loadFromTSPLIB(const std::string &filename,
+                              DistanceStorage storage = DistanceStorage::FULL_DOUBLE);
+
+  /**
+   * @brief Generate display coordinates for a distance-only instance
+   * @param numCities Number of cities
+   * @param upperTriangle Strict upper triangle of the distance matrix, row by row
+   * @return Cities with city 0 at the origin and every other city at its
+   *         distance from city 0, on evenly spaced angles
+   *
+   * Only for visualization: a graph built from these cities together with
+   * the distances keeps the real distances.
    */
-  static Graph loadFromTSPLIB(const std::string &filename);
+  static std::vector<City> syntheticCities(int numCities,
+                                           const std::vector<double> &upperTriangle);
 
 private:
-  std::string filename_;  ///< Path to the file to load
+  std::string filename_;         ///< Path to the file to load
+  std::string cacheDirectory_;   ///< Cache file directory ("" = next to the file)
+  bool writeCache_ = false;      ///< Write a cache after parsing
+  bool loadedFromCache_ = false; ///< Last loadGraph() used the cache
 
   /**
    * @enum FileFormat
@@ -91,14 +155,23 @@ private:
 
   /**
    * @brief Auto-detect the file format by analyzing content
+   * @param contents Complete file contents
    * @return FileFormat enum indicating the detected format
    *
    * Detection strategy:
+   * - If one of the first two lines has a TSPLIB keyword → TSPLIB
    * - If second line has 3 fields → COORDINATES
    * - If second line has >3 fields → DISTANCE_MATRIX
    * - Otherwise → UNKNOWN
    */
-  FileFormat detectFormat() const;
+  static FileFormat detectFormat(std::string_view contents);
+
+  /**
+   * @brief Parse the file (no cache) with automatic format detection
+   * @param storage Distance matrix layout of the resulting graph
+   * @return Parsed graph, or empty Graph on failure
+   */
+  Graph parseGraph(DistanceStorage storage) const;
 };
 
 #endif // TSPLOADER_H
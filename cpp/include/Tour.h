@@ -34,6 +34,13 @@ public:
      */
     Tour(const std::vector<int>& sequence, double distance);
 
+    /**
+     * @brief Construct a tour taking ownership of a sequence (no copy)
+     * @param sequence Ordered list of city IDs to visit (moved from)
+     * @param distance Total tour length (including return to start)
+     */
+    Tour(std::vector<int>&& sequence, double distance);
+
     /**
      * @brief Set the tour data
      * @param sequence Ordered list of city IDs to visit
@@ -41,6 +48,16 @@ public:
      */
     void setTour(const std::vector<int>& sequence, double distance);
 
+    /**
+     * @brief Set the tour data, taking ownership of the sequence
+     * @param sequence Ordered list of city IDs to visit (moved from)
+     * @param distance Total tour length
+     *
+     * The copying overload reuses this tour's existing capacity, so it is
+     * the allocation-free choice when refreshing a tour of the same size.
+     */
+    void setTour(std::vector<int>&& sequence, double distance);
+
     /**
      * @brief Get the total distance of the tour
      * @return double Total tour length
@@ -0,0 +1,260 @@
+#include "DistributedColony.h"
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include "Random.h"
+
+namespace {
+// Neighbors per city whose edges are tracked for pheromone sharing when the
+// graph has no neighbor lists of its own
+constexpr int TRACKED_NEIGHBORS = 8;
+}
+
+DistributedColony::DistributedColony(std::shared_ptr<const Graph> graph, MPI_Comm comm,
+                                     int totalAnts, double alpha, double beta, double rho,
+                                     double Q, bool useDistinctStartCities)
+    : graph_(std::move(graph)),
+      comm_(comm),
+      bestTour_(std::vector<int>(), std::numeric_limits<double>::max()) {
+    MPI_Comm_rank(comm_, &rank_);
+    MPI_Comm_size(comm_, &numRanks_);
+
+    // Spread the ants as evenly as possible, lower ranks take the remainder
+    totalAnts = std::max(1, totalAnts);
+    int antsHere = totalAnts / numRanks_ + (rank_ < totalAnts % numRanks_ ? 1 : 0);
+    colony_ = std::make_unique<AntColony>(graph_, std::max(1, antsHere), alpha, beta, rho, Q,
+                                          useDistinctStartCities);
+}
+
+void DistributedColony::configure(const std::function<void(AntColony&)>& setup) {
+    setup(*colony_);
+}
+
+Tour DistributedColony::solve(int maxIterations, ProgressCallback callback) {
+    colony_->initialize();
+
+    bestTour_ = Tour(std::vector<int>(), std::numeric_limits<double>::max());
+    numSyncs_ = 0;
+    commSeconds_ = 0.0;
+    computeSeconds_ = 0.0;
+    lastSyncSeconds_ = 0.0;
+    activeSyncInterval_ = syncInterval_;
+    iterationBestDistances_.clear();
+
+    if (pheromoneSyncEdges_ > 0 && numRanks_ > 1) {
+        if (trackedEdges_.empty()) {
+            buildTrackedEdges();
+        }
+        snapshotTrails();
+    }
+
+    int iteration = 0;
+    int iterationsWithoutImprovement = 0;
+    double runningBest = std::numeric_limits<double>::max();
+
+    // Every rank sees the same global history, so all ranks take the same branches
+    while (maxIterations >= 0 ? iteration < maxIterations
+                              : iterationsWithoutImprovement < convergenceThreshold_) {
+        int target = (maxIterations >= 0) ? maxIterations
+                                          : iteration + convergenceThreshold_ - iterationsWithoutImprovement;
+        if (activeSyncInterval_ > 0) {
+            target = std::min(target, iteration + activeSyncInterval_);
+        }
+
+        double epochStart = MPI_Wtime();
+        for (int t = iteration; t < target; ++t) {
+            colony_->runIteration();
+        }
+        double epochSeconds = MPI_Wtime() - epochStart;
+        computeSeconds_ += epochSeconds;
+
+        synchronize(iteration, target, epochSeconds);
+
+        for (int t = iteration; t < target; ++t) {
+            if (iterationBestDistances_[t] < runningBest) {
+                runningBest = iterationBestDistances_[t];
+                iterationsWithoutImprovement = 0;
+            } else {
+                iterationsWithoutImprovement++;
+            }
+        }
+        iteration = target;
+
+        if (callback) {
+            callback(iteration, bestTour_.getDistance(), bestTour_.getSequence(),
+                     iterationBestDistances_);
+        }
+    }
+
+    return bestTour_;
+}
+
+void DistributedColony::synchronize(int fromIteration, int toIteration, double epochSeconds) {
+    double syncStart = MPI_Wtime();
+
+    // One reduction carries the epoch's iteration bests plus the timings of the
+    // slowest rank (negated, so MPI_MIN yields the maximum)
+    int count = toIteration - fromIteration;
+    const std::vector<double>& history = colony_->getConvergenceData();
+    reduceBuffer_.resize(count + 2);
+    for (int t = 0; t < count; ++t) {
+        reduceBuffer_[t] = history[fromIteration + t];
+    }
+    reduceBuffer_[count] = -lastSyncSeconds_;
+    reduceBuffer_[count + 1] = -epochSeconds;
+    MPI_Allreduce(MPI_IN_PLACE, reduceBuffer_.data(), count + 2, MPI_DOUBLE, MPI_MIN, comm_);
+    iterationBestDistances_.insert(iterationBestDistances_.end(), reduceBuffer_.begin(),
+                                   reduceBuffer_.begin() + count);
+    double slowestSync = -reduceBuffer_[count];
+    double slowestEpoch = -reduceBuffer_[count + 1];
+
+    // Trail deltas first: they describe this epoch, before any imported tour is deposited
+    if (pheromoneSyncEdges_ > 0 && numRanks_ > 1) {
+        exchangePheromoneDeltas();
+    }
+
+    // Best tour: MINLOC picks the lowest rank on ties, so every rank agrees on the source
+    struct {
+        double distance;
+        int rank;
+    } local{colony_->getBestTour().getDistance(), rank_}, global{0.0, 0};
+    MPI_Allreduce(&local, &global, 1, MPI_DOUBLE_INT, MPI_MINLOC, comm_);
+
+    if (global.distance < bestTour_.getDistance()) {
+        int numCities = graph_->getNumCities();
+        if (rank_ == global.rank) {
+            tourBuffer_ = colony_->getBestTour().getSequence();
+        }
+        tourBuffer_.resize(numCities);
+        MPI_Bcast(tourBuffer_.data(), numCities, MPI_INT, global.rank, comm_);
+        bestTour_ = Tour(tourBuffer_, global.distance);
+        if (rank_ != global.rank) {
+            colony_->importTour(bestTour_);
+        }
+    }
+
+    if (pheromoneSyncEdges_ > 0 && numRanks_ > 1) {
+        snapshotTrails();
+    }
+
+    numSyncs_++;
+    lastSyncSeconds_ = MPI_Wtime() - syncStart;
+    commSeconds_ += lastSyncSeconds_;
+
+    // Synchronize less often while communication is too expensive; the decision
+    // uses reduced values only, so all ranks keep the same interval
+    if (maxCommFraction_ > 0.0 && activeSyncInterval_ > 0 &&
+        slowestSync > maxCommFraction_ * slowestEpoch) {
+        activeSyncInterval_ *= 2;
+    }
+}
+
+void DistributedColony::exchangePheromoneDeltas() {
+    const PheromoneMatrix& trails = colony_->getPheromones();
+    int numEdges = static_cast<int>(trackedEdges_.size());
+    int numShared = std::min(pheromoneSyncEdges_, numEdges);
+
+    edgeDeltas_.resize(numEdges);
+    for (int e = 0; e < numEdges; ++e) {
+        edgeDeltas_[e] = trails.getPheromone(trackedEdges_[e].first, trackedEdges_[e].second) -
+                         trailSnapshot_[e];
+    }
+
+    // Largest increases first, lower edge index on ties
+    edgeOrder_.resize(numEdges);
+    std::iota(edgeOrder_.begin(), edgeOrder_.end(), 0);
+    std::nth_element(edgeOrder_.begin(), edgeOrder_.begin() + numShared, edgeOrder_.end(),
+                     [this](int a, int b) {
+                         return edgeDeltas_[a] > edgeDeltas_[b] ||
+                                (edgeDeltas_[a] == edgeDeltas_[b] && a < b);
+                     });
+
+    // Edge indices travel as doubles (exact below 2^53) so one collective suffices
+    sendBuffer_.resize(2 * static_cast<size_t>(numShared));
+    for (int i = 0; i < numShared; ++i) {
+        int e = edgeOrder_[i];
+        bool grew = edgeDeltas_[e] > 0.0;
+        sendBuffer_[2 * i] = grew ? static_cast<double>(e) : -1.0;
+        sendBuffer_[2 * i + 1] = grew ? edgeDeltas_[e] : 0.0;
+    }
+    recvBuffer_.resize(sendBuffer_.size() * numRanks_);
+    MPI_Allgather(sendBuffer_.data(), 2 * numShared, MPI_DOUBLE, recvBuffer_.data(),
+                  2 * numShared, MPI_DOUBLE, comm_);
+
+    // Other ranks' growth is added in full, as if their ants had deposited here
+    mergeEdges_.clear();
+    mergeAmounts_.clear();
+    for (int r = 0; r < numRanks_; ++r) {
+        if (r == rank_) {
+            continue;
+        }
+        const double* entries = recvBuffer_.data() + 2 * static_cast<size_t>(r) * numShared;
+        for (int i = 0; i < numShared; ++i) {
+            int e = static_cast<int>(entries[2 * i]);
+            if (e >= 0 && e < numEdges) {
+                mergeEdges_.push_back(trackedEdges_[e]);
+                mergeAmounts_.push_back(entries[2 * i + 1]);
+            }
+        }
+    }
+    colony_->addPheromoneEdges(mergeEdges_, mergeAmounts_);
+}
+
+void DistributedColony::buildTrackedEdges() {
+    int numCities = graph_->getNumCities();
+    std::vector<int> computed;
+    int listSize = graph_->getNeighborListSize();
+    if (listSize == 0 && numCities > 1) {
+        computed = graph_->computeNeighborLists(TRACKED_NEIGHBORS);
+        listSize = static_cast<int>(computed.size()) / numCities;
+    }
+
+    trackedEdges_.clear();
+    trackedEdges_.reserve(static_cast<size_t>(numCities) * listSize);
+    for (int city = 0; city < numCities; ++city) {
+        const int* neighbors = computed.empty() ? graph_->getNeighbors(city)
+                                                : computed.data() + static_cast<size_t>(city) * listSize;
+        for (int k = 0; k < listSize; ++k) {
+            trackedEdges_.emplace_back(std::min(city, neighbors[k]), std::max(city, neighbors[k]));
+        }
+    }
+
+    // Mutual neighbors appear twice; the sorted order is identical on every rank
+    std::sort(trackedEdges_.begin(), trackedEdges_.end());
+    trackedEdges_.erase(std::unique(trackedEdges_.begin(), trackedEdges_.end()), trackedEdges_.end());
+}
+
+void DistributedColony::snapshotTrails() {
+    const PheromoneMatrix& trails = colony_->getPheromones();
+    trailSnapshot_.resize(trackedEdges_.size());
+    for (size_t e = 0; e < trackedEdges_.size(); ++e) {
+        trailSnapshot_[e] = trails.getPheromone(trackedEdges_[e].first, trackedEdges_[e].second);
+    }
+}
+
+void DistributedColony::setSeed(std::uint64_t seed) {
+    // Same derivation as MultiColony: rank r uses the (r+1)-th SplitMix64 output
+    std::uint64_t state = seed;
+    std::uint64_t rankSeed = 0;
+    for (int r = 0; r <= rank_; ++r) {
+        rankSeed = Xoshiro256::splitMix64(state);
+    }
+    colony_->setSeed(rankSeed);
+}
+
+void DistributedColony::setSyncInterval(int iterations) {
+    syncInterval_ = std::max(0, iterations);
+    activeSyncInterval_ = syncInterval_;
+}
+
+void DistributedColony::setPheromoneSyncEdges(int numEdges) {
+    pheromoneSyncEdges_ = std::max(0, numEdges);
+}
+
+void DistributedColony::setMaxCommFraction(double fraction) {
+    maxCommFraction_ = std::max(0.0, fraction);
+}
+
+void DistributedColony::setConvergenceThreshold(int threshold) {
+    convergenceThreshold_ = threshold;
+}
@@ -0,0 +1,121 @@
+#ifndef DISTRIBUTEDCOLONY_H
+#define DISTRIBUTEDCOLONY_H
+
+#include <mpi.h>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+#include "AntColony.h"
+#include "Graph.h"
+#include "Tour.h"
+
+// One logical colony spread over the ranks of an MPI communicator. Every rank
+// runs an AntColony with its share of the ants and, every syncInterval
+// iterations, all ranks agree on the best tour (all-reduce, then a broadcast
+// from the winning rank) and optionally exchange the pheromone edges whose
+// trails grew most since the previous synchronization. Between synchronizations
+// ranks never communicate, so the sync interval bounds the network cost.
+class DistributedColony {
+public:
+    // Called on every rank after each synchronization with the global best tour
+    // and the per-iteration best over all ranks
+    using ProgressCallback = AntColony::ProgressCallback;
+
+    // Constructor: totalAnts are split over the ranks of comm (at least one per rank).
+    // Every rank must pass the same graph and parameters.
+    DistributedColony(std::shared_ptr<const Graph> graph, MPI_Comm comm, int totalAnts,
+                      double alpha, double beta, double rho, double Q,
+                      bool useDistinctStartCities = false);
+
+    // Apply settings to this rank's colony (local search, pheromone mode, threads, ...)
+    void configure(const std::function<void(AntColony&)>& setup);
+
+    // Run maxIterations iterations on every rank (or until the global best has not
+    // improved for convergenceThreshold iterations if maxIterations < 0). Collective:
+    // all ranks must call it, and all return the same best tour.
+    Tour solve(int maxIterations, ProgressCallback callback = nullptr);
+
+    // Seed the ranks (default: non-deterministic). Rank r gets its own seed derived
+    // from this one, so a seeded run is reproducible for a fixed number of ranks.
+    void setSeed(std::uint64_t seed);
+
+    // Iterations between synchronizations (default: 10, 0 = only at the end)
+    void setSyncInterval(int iterations);
+
+    // Pheromone edges each rank shares per synchronization (default: 0 = best tour only).
+    // Each rank sends the edges whose trail grew most since the last synchronization;
+    // the others add that growth to their own trails.
+    void setPheromoneSyncEdges(int numEdges);
+
+    // Upper bound on communication time relative to computation time (default: 0 = off).
+    // When the slowest rank exceeds it, the sync interval is doubled.
+    void setMaxCommFraction(double fraction);
+
+    // Set convergence threshold (default: 200 iterations without improvement)
+    void setConvergenceThreshold(int threshold);
+
+    // Getters
+    int getRank() const { return rank_; }
+    int getNumRanks() const { return numRanks_; }
+    AntColony& getColony() { return *colony_; }
+    const AntColony& getColony() const { return *colony_; }
+    const Tour& getBestTour() const { return bestTour_; }
+    const std::vector<double>& getConvergenceData() const { return iterationBestDistances_; }
+    int getSyncInterval() const { return syncInterval_; }
+    int getActiveSyncInterval() const { return activeSyncInterval_; }
+    int getPheromoneSyncEdges() const { return pheromoneSyncEdges_; }
+    double getMaxCommFraction() const { return maxCommFraction_; }
+    int getNumSyncs() const { return numSyncs_; }
+    double getCommSeconds() const { return commSeconds_; }
+    double getComputeSeconds() const { return computeSeconds_; }
+
+private:
+    std::shared_ptr<const Graph> graph_;
+    MPI_Comm comm_;
+    int rank_ = 0;
+    int numRanks_ = 1;
+    std::unique_ptr<AntColony> colony_;
+
+    int syncInterval_ = 10;          // Iterations between synchronizations (0 = end only)
+    int activeSyncInterval_ = 10;    // Interval in use (grows under maxCommFraction_)
+    int pheromoneSyncEdges_ = 0;     // Edges shared per rank and synchronization
+    double maxCommFraction_ = 0.0;   // Communication / computation limit (0 = off)
+    int convergenceThreshold_ = 200;
+
+    Tour bestTour_;
+    int numSyncs_ = 0;
+    double commSeconds_ = 0.0;
+    double computeSeconds_ = 0.0;
+    double lastSyncSeconds_ = 0.0;   // Duration of the previous synchronization
+    std::vector<double> iterationBestDistances_;  // Best over all ranks, per iteration
+
+    // Pheromone delta tracking: nearest-neighbor edges (a < b, same order on every rank)
+    std::vector<std::pair<int, int>> trackedEdges_;
+    std::vector<double> trailSnapshot_;   // Trail of each tracked edge at the last sync
+
+    // Scratch buffers reused across synchronizations
+    std::vector<double> reduceBuffer_;
+    std::vector<int> tourBuffer_;
+    std::vector<double> edgeDeltas_;
+    std::vector<int> edgeOrder_;
+    std::vector<double> sendBuffer_;     // (edge index, delta) pairs, index -1 = unused
+    std::vector<double> recvBuffer_;
+    std::vector<std::pair<int, int>> mergeEdges_;
+    std::vector<double> mergeAmounts_;
+
+    // Exchange iteration bests, best tour and (optionally) trail deltas
+    void synchronize(int fromIteration, int toIteration, double epochSeconds);
+
+    // Share the largest trail increases and add the other ranks' increases
+    void exchangePheromoneDeltas();
+
+    // Build trackedEdges_ from the graph's neighbor lists
+    void buildTrackedEdges();
+
+    // Record the current trail of every tracked edge
+    void snapshotTrails();
+};
+
+#endif // DISTRIBUTEDCOLONY_H
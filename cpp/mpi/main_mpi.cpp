@@ -0,0 +1,331 @@
+/**
+ * @file main_mpi.cpp
+ * @brief Entry point for the distributed (MPI) Ant Colony Optimization TSP solver
+ *
+ * Every rank loads the instance, runs a colony with its share of the ants and
+ * synchronizes with the other ranks every --sync-every iterations. Only rank 0
+ * prints. Launch with e.g. `mpirun -np 8 ./ant_colony_tsp_mpi d18512.tsp ...`.
+ */
+
+#include <mpi.h>
+#include <iostream>
+#include <iomanip>
+#include <memory>
+#include <string>
+#include "TSPLoader.h"
+#include "AntColony.h"
+#include "DistributedColony.h"
+#include "Graph.h"
+#include "Tour.h"
+
+void printUsage(const char* programName) {
+    std::cout << "Usage: mpirun -np <ranks> " << programName << " <input_file> [options]\n";
+    std::cout << "\nAlgorithm Options:\n";
+    std::cout << "  --ants <n>       Total number of ants over all ranks (default: number of cities)\n";
+    std::cout << "  --iterations <n> Iterations per rank (default: until no improvement for 200 iterations)\n";
+    std::cout << "  --alpha <f>      Pheromone importance (default: 1.0)\n";
+    std::cout << "  --beta <f>       Heuristic importance (default: 2.0)\n";
+    std::cout << "  --rho <f>        Evaporation rate (default: 0.5)\n";
+    std::cout << "  --Q <f>          Pheromone deposit factor (default: 100.0)\n";
+    std::cout << "  --candidates <k> Only consider the k nearest neighbors per step (0=all cities, default: 0)\n";
+    std::cout << "  --seed <n>       Random seed for reproducible runs (default: random)\n";
+    std::cout << "  --distance-storage <mode> 'full', 'full-float', 'triangular', 'triangular-float'\n";
+    std::cout << "                   or 'on-the-fly' (default: full)\n";
+    std::cout << "  --pheromone-mode <mode> 'all', 'best-iteration', 'best-so-far', 'rank', 'mmas'\n";
+    std::cout << "                   or 'acs' (default: all)\n";
+    std::cout << "\nLocal Search Options:\n";
+    std::cout << "  --local-search   Enable 2-opt/3-opt local search (default: disabled)\n";
+    std::cout << "  --2opt-only      Use only 2-opt (skip 3-opt, default: use both)\n";
+    std::cout << "  --ls-mode <mode> 'best', 'all', 'top-k' or 'none' (default: best)\n";
+    std::cout << "  --ls-operator <op> 'exhaustive', 'neighbor' or 'lk' (default: exhaustive)\n";
+    std::cout << "\nDistribution Options:\n";
+    std::cout << "  --threads <n>    OpenMP threads per rank (0=auto, 1=serial, default: 0)\n";
+    std::cout << "  --sync-every <n> Iterations between synchronizations (default: 10, 0 = only at the end)\n";
+    std::cout << "  --sync-edges <n> Pheromone edges each rank shares per synchronization (default: 0 = tours only)\n";
+    std::cout << "  --max-comm-fraction <f> Double the sync interval whenever communication takes more than\n";
+    std::cout << "                   this fraction of computation time (default: 0 = fixed interval)\n";
+}
+
+namespace {
+// Parse and validate the command line. Returns false (after printing the
+// error) if the arguments are invalid.
+struct Options {
+    std::string inputFile;
+    int numAnts = -1;  // -1 means use number of cities (set after loading graph)
+    int iterations = -1;  // -1 means run until no improvement for 200 iterations
+    double alpha = 1.0;
+    double beta = 2.0;
+    double rho = 0.5;
+    double Q = 100.0;
+    int candidateListSize = 0;
+    bool useSeed = false;
+    unsigned long long seed = 0;
+    DistanceStorage distanceStorage = DistanceStorage::FULL_DOUBLE;
+    std::string distanceStorageName = "full";
+    std::string pheromoneMode = "all";
+    bool useLocalSearch = false;
+    bool use3opt = true;
+    std::string localSearchMode = "best";
+    std::string localSearchOperator = "exhaustive";
+    int numThreads = 0;
+    int syncEvery = 10;
+    int syncEdges = 0;
+    double maxCommFraction = 0.0;
+};
+
+bool parseOptions(int argc, char** argv, Options& opts) {
+    if (argc < 2) {
+        printUsage(argv[0]);
+        return false;
+    }
+    opts.inputFile = argv[1];
+
+    for (int i = 2; i < argc; ) {
+        std::string option = argv[i];
+
+        // Handle flags that don't require arguments
+        if (option == "--local-search") {
+            opts.useLocalSearch = true;
+            i++;
+            continue;
+        }
+        if (option == "--2opt-only") {
+            opts.use3opt = false;
+            i++;
+            continue;
+        }
+
+        // All other options require a value
+        if (i + 1 >= argc) {
+            std::cerr << "Error: Missing value for option " << argv[i] << std::endl;
+            return false;
+        }
+
+        std::string value = argv[i + 1];
+        i += 2;
+
+        try {
+            if (option == "--ants") {
+                opts.numAnts = std::stoi(value);
+                if (opts.numAnts <= 0) {
+                    std::cerr << "Error: Number of ants must be positive" << std::endl;
+                    return false;
+                }
+            } else if (option == "--iterations") {
+                opts.iterations = std::stoi(value);
+                if (opts.iterations <= 0) {
+                    std::cerr << "Error: Number of iterations must be positive" << std::endl;
+                    return false;
+                }
+            } else if (option == "--alpha") {
+                opts.alpha = std::stod(value);
+            } else if (option == "--beta") {
+                opts.beta = std::stod(value);
+            } else if (option == "--rho") {
+                opts.rho = std::stod(value);
+                if (opts.rho < 0.0 || opts.rho > 1.0) {
+                    std::cerr << "Error: Rho must be between 0 and 1" << std::endl;
+                    return false;
+                }
+            } else if (option == "--Q") {
+                opts.Q = std::stod(value);
+                if (opts.Q <= 0.0) {
+                    std::cerr << "Error: Q must be positive" << std::endl;
+                    return false;
+                }
+            } else if (option == "--candidates") {
+                opts.candidateListSize = std::stoi(value);
+                if (opts.candidateListSize < 0) {
+                    std::cerr << "Error: Candidate list size must be non-negative" << std::endl;
+                    return false;
+                }
+            } else if (option == "--seed") {
+                opts.seed = std::stoull(value);
+                opts.useSeed = true;
+            } else if (option == "--distance-storage") {
+                if (value == "full") {
+                    opts.distanceStorage = DistanceStorage::FULL_DOUBLE;
+                } else if (value == "full-float") {
+                    opts.distanceStorage = DistanceStorage::FULL_FLOAT;
+                } else if (value == "triangular") {
+                    opts.distanceStorage = DistanceStorage::TRIANGULAR_DOUBLE;
+                } else if (value == "triangular-float") {
+                    opts.distanceStorage = DistanceStorage::TRIANGULAR_FLOAT;
+                } else if (value == "on-the-fly") {
+                    opts.distanceStorage = DistanceStorage::ON_THE_FLY;
+                } else {
+                    std::cerr << "Error: --distance-storage must be 'full', 'full-float', 'triangular', 'triangular-float', or 'on-the-fly'" << std::endl;
+                    return false;
+                }
+                opts.distanceStorageName = value;
+            } else if (option == "--pheromone-mode") {
+                if (value == "all" || value == "best-iteration" || value == "best-so-far" || value == "rank" ||
+                    value == "mmas" || value == "acs") {
+                    opts.pheromoneMode = value;
+                } else {
+                    std::cerr << "Error: --pheromone-mode must be 'all', 'best-iteration', 'best-so-far', 'rank', 'mmas', or 'acs'" << std::endl;
+                    return false;
+                }
+            } else if (option == "--ls-mode") {
+                if (value == "best" || value == "all" || value == "top-k" || value == "none") {
+                    opts.localSearchMode = value;
+                } else {
+                    std::cerr << "Error: --ls-mode must be 'best', 'all', 'top-k', or 'none'" << std::endl;
+                    return false;
+                }
+            } else if (option == "--ls-operator") {
+                if (value == "exhaustive" || value == "neighbor" || value == "lk") {
+                    opts.localSearchOperator = value;
+                } else {
+                    std::cerr << "Error: --ls-operator must be 'exhaustive', 'neighbor' or 'lk'" << std::endl;
+                    return false;
+                }
+            } else if (option == "--threads") {
+                opts.numThreads = std::stoi(value);
+                if (opts.numThreads < 0) {
+                    std::cerr << "Error: Number of threads must be non-negative" << std::endl;
+                    return false;
+                }
+            } else if (option == "--sync-every") {
+                opts.syncEvery = std::stoi(value);
+                if (opts.syncEvery < 0) {
+                    std::cerr << "Error: Sync interval must be non-negative" << std::endl;
+                    return false;
+                }
+            } else if (option == "--sync-edges") {
+                opts.syncEdges = std::stoi(value);
+                if (opts.syncEdges < 0) {
+                    std::cerr << "Error: Number of shared edges must be non-negative" << std::endl;
+                    return false;
+                }
+            } else if (option == "--max-comm-fraction") {
+                opts.maxCommFraction = std::stod(value);
+                if (opts.maxCommFraction < 0.0 || opts.maxCommFraction > 1.0) {
+                    std::cerr << "Error: Max communication fraction must be between 0 and 1" << std::endl;
+                    return false;
+                }
+            } else {
+                std::cerr << "Error: Unknown option " << option << std::endl;
+                printUsage(argv[0]);
+                return false;
+            }
+        } catch (const std::exception& e) {
+            std::cerr << "Error: Invalid value for option " << option << ": " << value << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+}
+
+int main(int argc, char** argv) {
+    MPI_Init(&argc, &argv);
+    int rank = 0;
+    int numRanks = 1;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &numRanks);
+
+    // Only rank 0 prints; the other ranks run the same code with muted streams
+    if (rank != 0) {
+        std::cout.setstate(std::ios_base::failbit);
+        std::cerr.setstate(std::ios_base::failbit);
+    }
+
+    // Every rank parses the same arguments, so all of them fail or succeed together
+    Options opts;
+    if (!parseOptions(argc, argv, opts)) {
+        MPI_Finalize();
+        return 1;
+    }
+
+    std::cout << "========================================\n";
+    std::cout << "Ant Colony Optimization - Distributed TSP Solver\n";
+    std::cout << "========================================\n\n";
+
+    // Each rank loads the instance itself (the file must be visible on every node)
+    std::cout << "Loading TSP instance from: " << opts.inputFile << std::endl;
+    TSPLoader loader(opts.inputFile);
+    Graph loadedGraph = loader.loadGraph(opts.distanceStorage);
+
+    int loaded = loadedGraph.isValid() ? 1 : 0;
+    MPI_Allreduce(MPI_IN_PLACE, &loaded, 1, MPI_INT, MPI_MIN, MPI_COMM_WORLD);
+    if (!loaded) {
+        std::cerr << "Error: Failed to load TSP instance from " << opts.inputFile << std::endl;
+        MPI_Finalize();
+        return 1;
+    }
+
+    if (opts.candidateListSize > 0) {
+        loadedGraph.buildNeighborLists(opts.candidateListSize);
+    }
+    std::shared_ptr<const Graph> graph = std::make_shared<const Graph>(std::move(loadedGraph));
+
+    bool useDistinctStartCities = false;
+    if (opts.numAnts == -1) {
+        opts.numAnts = graph->getNumCities();
+        useDistinctStartCities = true;
+    }
+
+    std::cout << "Successfully loaded " << graph->getNumCities() << " cities"
+              << " (distance matrix: " << opts.distanceStorageName << ")\n\n";
+    std::cout << "Distribution Parameters:\n";
+    std::cout << "  Ranks:                " << numRanks << "\n";
+    std::cout << "  Total ants:           " << opts.numAnts << "\n";
+    std::cout << "  Sync interval:        ";
+    if (opts.syncEvery > 0) {
+        std::cout << opts.syncEvery << " iterations";
+        if (opts.maxCommFraction > 0.0) {
+            std::cout << " (doubled while communication > " << opts.maxCommFraction * 100.0 << "%)";
+        }
+        std::cout << "\n";
+    } else {
+        std::cout << "End of run only\n";
+    }
+    std::cout << "  Shared trail edges:   " << opts.syncEdges << " per rank\n";
+    std::cout << "  Pheromone Mode:       " << opts.pheromoneMode << "\n\n";
+
+    DistributedColony colony(graph, MPI_COMM_WORLD, opts.numAnts, opts.alpha, opts.beta,
+                             opts.rho, opts.Q, useDistinctStartCities);
+    colony.configure([&opts](AntColony& c) {
+        c.setCandidateListSize(opts.candidateListSize);
+        c.setUseLocalSearch(opts.useLocalSearch);
+        c.setUse3Opt(opts.use3opt);
+        c.setLocalSearchMode(opts.localSearchMode);
+        c.setLocalSearchOperator(opts.localSearchOperator);
+        c.setPheromoneMode(opts.pheromoneMode);
+        c.setUseParallel(opts.numThreads != 1);
+        c.setNumThreads(opts.numThreads);
+    });
+    if (opts.useSeed) {
+        colony.setSeed(opts.seed);
+    }
+    colony.setSyncInterval(opts.syncEvery);
+    colony.setPheromoneSyncEdges(opts.syncEdges);
+    colony.setMaxCommFraction(opts.maxCommFraction);
+
+    std::cout << "Running distributed Ant Colony Optimization...\n";
+    Tour bestTour = colony.solve(opts.iterations, [](int iteration, double bestDistance,
+                                                     const std::vector<int>& /*bestTour*/,
+                                                     const std::vector<double>& /*convergence*/) {
+        std::cout << "  Iteration " << std::setw(5) << iteration
+                  << " | Best distance: " << std::fixed << std::setprecision(2)
+                  << bestDistance << "\n";
+        std::cout.flush();
+    });
+
+    std::cout << "\n========================================\n";
+    std::cout << "Results\n";
+    std::cout << "========================================\n\n";
+    std::cout << "Best tour distance: " << std::fixed << std::setprecision(2)
+              << bestTour.getDistance() << "\n";
+    double total = colony.getCommSeconds() + colony.getComputeSeconds();
+    std::cout << "Synchronizations:   " << colony.getNumSyncs()
+              << " (final interval: " << colony.getActiveSyncInterval() << " iterations)\n";
+    std::cout << "Communication time: " << std::setprecision(3) << colony.getCommSeconds() << " s ("
+              << std::setprecision(1) << (total > 0.0 ? 100.0 * colony.getCommSeconds() / total : 0.0)
+              << "% of rank 0 run time)\n";
+    std::cout << "\n========================================\n";
+
+    MPI_Finalize();
+    return 0;
+}
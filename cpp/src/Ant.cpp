@@ -1,39 +1,75 @@
 #include "Ant.h"
+#include "Power.h"
+#include "SelectionKernels.h"
 #include <cmath>
 #include <random>
 #include <algorithm>
 #include <stdexcept>
 
-// Shared random number generator for all Ant instances
-std::mt19937& Ant::getRandomGenerator() {
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
-    return gen;
+// Per-thread scratch for the uncached selection methods, reused across calls
+// so that tour construction does not allocate once warmed up
+namespace {
+struct SelectionScratch {
+    std::vector<int> cities;
+    std::vector<double> weights;
+    std::vector<double> blockSums;  // selection::blockSums() of a choice-info row
+};
+
+SelectionScratch& selectionScratch() {
+    thread_local SelectionScratch scratch;
+    return scratch;
+}
+}
+
+// Non-deterministic seed for ants created without an explicit one
+static std::uint64_t randomSeed() {
+    std::random_device rd;
+    return (static_cast<std::uint64_t>(rd()) << 32) ^ rd();
 }
 
 Ant::Ant(int startCity, int numCities)
+    : Ant(startCity, numCities, randomSeed()) {}
+
+Ant::Ant(int startCity, int numCities, std::uint64_t seed)
     : currentCity_(startCity),
-      visited_(numCities, false),
+      visited_(numCities, 0),
       tourLength_(0.0),
-      numCities_(numCities) {
+      numCities_(numCities),
+      rng_(seed) {
     tour_.reserve(numCities);
     tour_.push_back(startCity);
-    visited_[startCity] = true;
+    visited_[startCity] = 1;
+}
+
+template <typename AlphaPower, typename BetaPower>
+double Ant::edgeWeight(int city, const Graph& graph, const PheromoneMatrix& pheromones,
+                       AlphaPower alphaPower, BetaPower betaPower) const {
+    double distance = graph.getDistanceUnchecked(currentCity_, city);
+
+    // Avoid division by zero
+    if (distance == 0.0) {
+        distance = EPSILON_DISTANCE;
+    }
+
+    return alphaPower(pheromones.getPheromone(currentCity_, city)) * betaPower(1.0 / distance);
 }
 
 void Ant::reset(int startCity) {
     currentCity_ = startCity;
-    std::fill(visited_.begin(), visited_.end(), false);
+    std::fill(visited_.begin(), visited_.end(), 0);
     tour_.clear();
     tour_.push_back(startCity);
-    visited_[startCity] = true;
+    visited_[startCity] = 1;
     tourLength_ = 0.0;
+    candidateFallbacks_ = 0;
 }
 
 int Ant::selectNextCity(const Graph& graph, const PheromoneMatrix& pheromones,
                        double alpha, double beta) {
     // Build list of unvisited cities
-    std::vector<int> unvisited;
+    SelectionScratch& scratch = selectionScratch();
+    std::vector<int>& unvisited = scratch.cities;
+    unvisited.clear();
     for (int i = 0; i < numCities_; ++i) {
         if (!visited_[i]) {
             unvisited.push_back(i);
@@ -46,43 +82,28 @@ int Ant::selectNextCity(const Graph& graph, const PheromoneMatrix& pheromones,
     }
 
     // Calculate probabilities for each unvisited city
-    std::vector<double> probabilities;
-    probabilities.reserve(unvisited.size());
+    std::vector<double>& probabilities = scratch.weights;
+    probabilities.clear();
     double totalProbability = 0.0;
 
-    for (int city : unvisited) {
-        double pheromone = pheromones.getPheromone(currentCity_, city);
-        double distance = graph.getDistance(currentCity_, city);
-
-        // Avoid division by zero
-        if (distance == 0.0) {
-            distance = EPSILON_DISTANCE;
+    // Probability: pheromone^alpha * heuristic^beta, with multiplications
+    // instead of std::pow for small integer exponents
+    dispatchPowers(alpha, beta, [&](auto alphaPower, auto betaPower) {
+        for (int city : unvisited) {
+            double probability = edgeWeight(city, graph, pheromones, alphaPower, betaPower);
+            probabilities.push_back(probability);
+            totalProbability += probability;
         }
-
-        double heuristic = 1.0 / distance;
-
-        // Probability: pheromone^alpha * heuristic^beta
-        double probability = std::pow(pheromone, alpha) * std::pow(heuristic, beta);
-
-        probabilities.push_back(probability);
-        totalProbability += probability;
-    }
+    });
 
     // Handle edge case where all probabilities are 0
     if (totalProbability == 0.0) {
         // Select randomly
-        std::uniform_int_distribution<> dist(0, unvisited.size() - 1);
-        return unvisited[dist(getRandomGenerator())];
+        return unvisited[rng_.nextInt(static_cast<int>(unvisited.size()))];
     }
 
-    // Normalize probabilities
-    for (double& prob : probabilities) {
-        prob /= totalProbability;
-    }
-
-    // Roulette wheel selection
-    std::uniform_real_distribution<> dist(0.0, 1.0);
-    double random = dist(getRandomGenerator());
+    // Roulette wheel selection without normalization
+    double random = rng_.nextDouble() * totalProbability;
 
     double cumulativeProbability = 0.0;
     for (size_t i = 0; i < unvisited.size(); ++i) {
@@ -96,17 +117,198 @@ int Ant::selectNextCity(const Graph& graph, const PheromoneMatrix& pheromones,
     return unvisited.back();
 }
 
+int Ant::selectNextCityFromCandidates(const Graph& graph, const PheromoneMatrix& pheromones,
+                                      double alpha, double beta,
+                                      const int* candidates, int numCandidates) {
+    // Gather unvisited candidates and their weights
+    SelectionScratch& scratch = selectionScratch();
+    std::vector<int>& feasible = scratch.cities;
+    std::vector<double>& weights = scratch.weights;
+    feasible.clear();
+    weights.clear();
+    double totalWeight = 0.0;
+
+    dispatchPowers(alpha, beta, [&](auto alphaPower, auto betaPower) {
+        for (int c = 0; c < numCandidates; ++c) {
+            int city = candidates[c];
+            if (!visited_[city]) {
+                double weight = edgeWeight(city, graph, pheromones, alphaPower, betaPower);
+                feasible.push_back(city);
+                weights.push_back(weight);
+                totalWeight += weight;
+            }
+        }
+    });
+
+    // All candidates already visited: take the best remaining city
+    if (feasible.empty()) {
+        return selectBestRemainingCity(graph, pheromones, alpha, beta);
+    }
+
+    // Handle edge case where all weights are 0
+    if (totalWeight == 0.0) {
+        return feasible[rng_.nextInt(static_cast<int>(feasible.size()))];
+    }
+
+    // Roulette wheel selection over the feasible candidates
+    double random = rng_.nextDouble() * totalWeight;
+
+    double cumulativeWeight = 0.0;
+    for (size_t i = 0; i < feasible.size(); ++i) {
+        cumulativeWeight += weights[i];
+        if (random <= cumulativeWeight) {
+            return feasible[i];
+        }
+    }
+
+    return feasible.back();
+}
+
+int Ant::selectNextCity(const double* choiceRow, double q0) {
+    const selection::Kernels& kernels = selection::activeKernels();
+    const std::uint8_t* visited = visited_.data();
+
+    // Exploitation step: deterministic argmax over the unvisited cities
+    // (no random draw at all when q0 = 0, keeping Ant System streams unchanged)
+    if (q0 > 0.0 && rng_.nextDouble() < q0) {
+        double bestWeight = kernels.maxWeight(choiceRow, visited, numCities_);
+        return selection::findWeight(choiceRow, visited, numCities_, bestWeight);
+    }
+
+    // If no unvisited cities, return -1
+    int numUnvisited = numCities_ - static_cast<int>(tour_.size());
+    if (numUnvisited <= 0) {
+        return -1;
+    }
+
+    // One SIMD pass: masked weight total of every block of the row
+    std::vector<double>& blockSums = selectionScratch().blockSums;
+    blockSums.resize(selection::numBlocks(numCities_));
+    double totalWeight = kernels.blockSums(choiceRow, visited, numCities_, blockSums.data());
+
+    // Handle edge case where all weights are 0: select (uniformly) at random
+    if (totalWeight == 0.0) {
+        int skip = rng_.nextInt(numUnvisited);
+        for (int i = 0; i < numCities_; ++i) {
+            if (!visited_[i] && skip-- == 0) {
+                return i;
+            }
+        }
+    }
+
+    // Roulette wheel selection without normalization: skip whole blocks by
+    // their sums, then scan one block
+    double random = rng_.nextDouble() * totalWeight;
+    int city = selection::pickFromBlocks(choiceRow, visited, numCities_, blockSums.data(), random);
+    if (city != -1) {
+        return city;
+    }
+
+    // Floating point rounding: return last unvisited city as fallback
+    for (int i = numCities_ - 1; i >= 0; --i) {
+        if (!visited_[i]) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+int Ant::selectNextCityFromCandidates(const int* candidates, const double* candidateChoice,
+                                      int numCandidates, const Graph& graph,
+                                      const PheromoneMatrix& pheromones,
+                                      double alpha, double beta, double q0) {
+    // Exploitation step over the unvisited candidates
+    if (q0 > 0.0 && rng_.nextDouble() < q0) {
+        int bestCandidate = -1;
+        double bestWeight = -1.0;
+        for (int c = 0; c < numCandidates; ++c) {
+            if (!visited_[candidates[c]] && candidateChoice[c] > bestWeight) {
+                bestWeight = candidateChoice[c];
+                bestCandidate = c;
+            }
+        }
+        return (bestCandidate != -1) ? candidates[bestCandidate]
+                                     : selectBestRemainingCity(graph, pheromones, alpha, beta);
+    }
+
+    double totalWeight = 0.0;
+    int numFeasible = 0;
+    int lastFeasible = -1;
+    for (int c = 0; c < numCandidates; ++c) {
+        if (!visited_[candidates[c]]) {
+            totalWeight += candidateChoice[c];
+            lastFeasible = c;
+            numFeasible++;
+        }
+    }
+
+    // All candidates already visited: take the best remaining city
+    if (lastFeasible == -1) {
+        return selectBestRemainingCity(graph, pheromones, alpha, beta);
+    }
+
+    // Handle edge case where all weights are 0: select a candidate randomly
+    if (totalWeight == 0.0) {
+        int skip = rng_.nextInt(numFeasible);
+        for (int c = 0; c < numCandidates; ++c) {
+            if (!visited_[candidates[c]] && skip-- == 0) {
+                return candidates[c];
+            }
+        }
+    }
+
+    // Roulette wheel selection over the unvisited candidates
+    double random = rng_.nextDouble() * totalWeight;
+
+    double cumulativeWeight = 0.0;
+    for (int c = 0; c < numCandidates; ++c) {
+        if (!visited_[candidates[c]]) {
+            cumulativeWeight += candidateChoice[c];
+            if (random <= cumulativeWeight) {
+                return candidates[c];
+            }
+        }
+    }
+
+    return candidates[lastFeasible];
+}
+
+int Ant::selectBestRemainingCity(const Graph& graph, const PheromoneMatrix& pheromones,
+                                 double alpha, double beta) {
+    int bestCity = -1;
+    double bestWeight = -1.0;
+
+    // Scans every unvisited city: the powers must not be library calls here
+    dispatchPowers(alpha, beta, [&](auto alphaPower, auto betaPower) {
+        for (int i = 0; i < numCities_; ++i) {
+            if (!visited_[i]) {
+                double weight = edgeWeight(i, graph, pheromones, alphaPower, betaPower);
+                if (weight > bestWeight) {
+                    bestWeight = weight;
+                    bestCity = i;
+                }
+            }
+        }
+    });
+
+    // -1 if every city has been visited
+    if (bestCity != -1) {
+        ++candidateFallbacks_;
+    }
+    return bestCity;
+}
+
 void Ant::visitCity(int city, const Graph& graph) {
     if (visited_[city]) {
         throw std::runtime_error("City already visited");
     }
 
     // Add distance from current city to new city
-    tourLength_ += graph.getDistance(currentCity_, city);
+    tourLength_ += graph.getDistanceUnchecked(currentCity_, city);
 
     // Update state
     currentCity_ = city;
-    visited_[city] = true;
+    visited_[city] = 1;
     tour_.push_back(city);
 }
 
@@ -126,6 +328,16 @@ Tour Ant::completeTour(const Graph& graph) {
     return Tour(tour_, totalDistance);
 }
 
+void Ant::completeTour(const Graph& graph, Tour& tour) const {
+    if (!hasVisitedAll()) {
+        throw std::runtime_error("Tour is not complete");
+    }
+
+    // Copy-assignment keeps the destination's capacity (no allocation once sized)
+    double returnDistance = graph.getDistance(currentCity_, tour_[0]);
+    tour.setTour(tour_, tourLength_ + returnDistance);
+}
+
 double Ant::calculateTourLength(const Graph& graph) const {
     if (tour_.empty()) {
         return 0.0;
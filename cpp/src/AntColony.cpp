@@ -1,23 +1,158 @@
 #include "AntColony.h"
+#include "Power.h"
+#include <array>
+#include <chrono>
 #include <limits>
 #include <random>
 #include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <numeric>
+#include <stdexcept>
+#include <system_error>
+#include <utility>
 
 #ifdef _OPENMP
 #include <omp.h>
 #endif
 
-// Shared random number generator for AntColony
-std::mt19937& AntColony::getRandomGenerator() {
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
-    return gen;
+namespace {
+
+// Adds the wall time from construction to stop() (or destruction) to *target.
+// A null target reads no clock, so disabled profiling costs one branch.
+class PhaseTimer {
+public:
+    explicit PhaseTimer(double* target) : target_(target) {
+        if (target_) {
+            start_ = std::chrono::steady_clock::now();
+        }
+    }
+    ~PhaseTimer() { stop(); }
+
+    PhaseTimer(const PhaseTimer&) = delete;
+    PhaseTimer& operator=(const PhaseTimer&) = delete;
+
+    void stop() {
+        if (target_) {
+            *target_ += std::chrono::duration<double>(std::chrono::steady_clock::now() - start_).count();
+            target_ = nullptr;
+        }
+    }
+
+private:
+    double* target_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+// Sizes the OpenMP regions the calling thread starts while in scope, then
+// restores the previous count. omp_set_num_threads() only changes the
+// calling thread's setting, so colonies solved on different threads (a
+// SolverPool, a server's worker threads) each keep their own count.
+class ScopedThreadCount {
+public:
+    explicit ScopedThreadCount(int numThreads) {
+        #ifdef _OPENMP
+        if (numThreads > 0) {
+            previous_ = omp_get_max_threads();
+            omp_set_num_threads(numThreads);
+        }
+        #else
+        (void)numThreads;
+        #endif
+    }
+    ~ScopedThreadCount() {
+        #ifdef _OPENMP
+        if (previous_ > 0) {
+            omp_set_num_threads(previous_);
+        }
+        #endif
+    }
+
+    ScopedThreadCount(const ScopedThreadCount&) = delete;
+    ScopedThreadCount& operator=(const ScopedThreadCount&) = delete;
+
+private:
+    int previous_ = 0;
+};
+
+// Binary checkpoint layout: header, best tour (int32 per city), iteration
+// history (one double per iteration), then the trails of the upper triangle
+// including the diagonal, row by row (n * (n + 1) / 2 doubles)
+constexpr char CHECKPOINT_MAGIC[8] = {'A', 'C', 'O', 'S', 'T', 'A', 'T', 'E'};
+constexpr std::uint32_t CHECKPOINT_VERSION = 1;
+constexpr std::uint32_t CHECKPOINT_BYTE_ORDER = 0x01020304u;  // Reads differently on other endianness
+
+struct CheckpointHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t byteOrder;
+    std::uint32_t numCities;
+    std::int32_t numAnts;
+    std::uint64_t iterations;
+    std::uint64_t seed;
+    std::uint64_t rngState[4];
+    double alpha;
+    double beta;
+    double rho;
+    double Q;
+    char pheromoneMode[16];
+    std::int32_t useDistinctStartCities;
+    std::int32_t useElitist;
+    double elitistWeight;
+    std::int32_t rankSize;
+    std::int32_t mmasRestartIterations;
+    double q0;
+    double xi;
+    double acsTau0;
+    std::int32_t candidateListSize;
+    std::int32_t mmasIteration;
+    std::int32_t mmasStagnation;
+    std::int32_t reserved;
+    double mmasBestDistance;
+    double minPheromone;
+    double maxPheromone;
+    double bestDistance;
+};
+
+bool isPheromoneMode(const std::string& mode) {
+    return mode == "all" || mode == "best-iteration" || mode == "best-so-far" || mode == "rank" ||
+           mode == "mmas" || mode == "acs";
+}
+
+// Length of the closed tour through sequence
+double closedTourLength(const Graph& graph, const std::vector<int>& sequence) {
+    double length = 0.0;
+    for (std::size_t i = 0; i < sequence.size(); ++i) {
+        length += graph.getDistanceUnchecked(sequence[i], sequence[(i + 1) % sequence.size()]);
+    }
+    return length;
+}
+
+std::string toHex(std::uint64_t value) {
+    const char* digits = "0123456789abcdef";
+    std::string text(16, '0');
+    for (int i = 15; i >= 0; --i) {
+        text[i] = digits[value & 0xF];
+        value >>= 4;
+    }
+    return text;
 }
 
+}  // namespace
+
 AntColony::AntColony(const Graph& graph, int numAnts, double alpha, double beta,
                      double rho, double Q, bool useDistinctStartCities)
-    : graph_(graph),
-      pheromones_(graph.getNumCities(), 1.0),  // Will be properly initialized in initialize()
+    : AntColony(std::make_shared<const Graph>(graph), numAnts, alpha, beta, rho, Q,
+                useDistinctStartCities) {
+}
+
+AntColony::AntColony(std::shared_ptr<const Graph> graph, int numAnts, double alpha, double beta,
+                     double rho, double Q, bool useDistinctStartCities)
+    : graph_(std::move(graph)),
+      pheromones_(graph_->getNumCities(), 1.0),  // Will be properly initialized in initialize()
       numAnts_(numAnts),
       alpha_(alpha),
       beta_(beta),
@@ -25,14 +160,23 @@ AntColony::AntColony(const Graph& graph, int numAnts, double alpha, double beta,
       Q_(Q),
       useDistinctStartCities_(useDistinctStartCities),
       bestTour_(std::vector<int>(), std::numeric_limits<double>::max()) {
+    // Non-deterministic seed unless setSeed() is called
+    std::random_device rd;
+    seed_ = (static_cast<std::uint64_t>(rd()) << 32) ^ rd();
+    rng_.seed(seed_);
+
     // Create ants
     ants_.reserve(numAnts);
 }
 
 void AntColony::initialize() {
+    ScopedThreadCount threadCount(numThreads_);
+    // Restart the random stream so every solve() with the same seed repeats
+    rng_.seed(seed_);
+
     // Calculate initial pheromone value using τ₀ = m / C^nn
     // where m is the number of ants and C^nn is the nearest neighbor tour length
-    double nearestNeighborLength = graph_.nearestNeighborTourLength();
+    double nearestNeighborLength = graph_->nearestNeighborTourLength();
     double initialPheromone = 1.0;  // Default fallback
 
     if (nearestNeighborLength > 0.0) {
@@ -40,128 +184,408 @@ void AntColony::initialize() {
     }
 
     // Initialize pheromone matrix with calculated value
-    pheromones_.initialize(initialPheromone);
+    if (pheromoneMode_ == "mmas") {
+        // MMAS starts every trail at tau_max, estimated from the nearest neighbor tour
+        updateMMASLimits(nearestNeighborLength > 0.0 ? nearestNeighborLength : 1.0);
+        pheromones_.initialize(pheromones_.getMaxPheromone());
+    } else {
+        pheromones_.setMinPheromone(0.0);
+        pheromones_.setMaxPheromone(std::numeric_limits<double>::max());
+        if (pheromoneMode_ == "acs") {
+            // ACS uses tau0 = Q / (n * C^nn) both as initial trail and local update target
+            int numCities = std::max(1, graph_->getNumCities());
+            acsTau0_ = Q_ / (numCities * (nearestNeighborLength > 0.0 ? nearestNeighborLength : 1.0));
+            initialPheromone = acsTau0_;
+        }
+        pheromones_.initialize(initialPheromone);
+    }
+    mmasIteration_ = 0;
+    mmasStagnation_ = 0;
+    mmasBestDistance_ = std::numeric_limits<double>::max();
 
     // Clear iteration history
     iterationBestDistances_.clear();
+    stats_ = ColonyStats();
+    currentPhases_ = PhaseStats();
+    profileMoves_.store(0, std::memory_order_relaxed);
+    profileEvaluations_.store(0, std::memory_order_relaxed);
 
-    // Reset best tour
+    // Reset best tour; a fresh start drops a restored checkpoint
     bestTour_ = Tour(std::vector<int>(), std::numeric_limits<double>::max());
+    resumePending_ = false;
+
+    prepareSearch();
+
+    if (!warmStartTour_.empty()) {
+        importTour(Tour(warmStartTour_, closedTourLength(*graph_, warmStartTour_)));
+    }
+}
+
+void AntColony::prepareSearch() {
+    // Select (or compute) nearest-neighbor candidate lists if enabled
+    prepareCandidateLists();
+    prepareLocalSearchNeighbors();
+
+    // Heuristic information only depends on the graph and beta: compute it once,
+    // then derive the choice info used by the ants from the current pheromones
+    computeHeuristicInfo();
+    computeChoiceInfo();
+
+    // GPU backend: device copies of the dense heuristic and the current trails
+    gpu_.reset();
+    if (backend_ == "cuda") {
+        if (pheromoneMode_ == "acs" || choiceInfoUsesCandidates_) {
+            throw std::invalid_argument("cuda backend does not support ACS or candidate lists");
+        }
+        gpu_ = std::make_unique<GpuColony>(*graph_, numAnts_, heuristicInfo_, alpha_);
+        gpu_->uploadTrails(pheromones_);
+    }
 }
 
 void AntColony::constructSolutions() {
-    int numCities = graph_.getNumCities();
+    ScopedThreadCount threadCount(numThreads_);
+    if (gpu_) {
+        constructGpuSolutions();
+        return;
+    }
 
-    // Clear ants and recreate them
-    ants_.clear();
-    antTours_.clear();
-    antTours_.resize(numAnts_);
+    PhaseTimer constructionTimer(profilePhase(&PhaseStats::construction));
+    int numCities = graph_->getNumCities();
 
-    if (useDistinctStartCities_) {
-        // Assign each ant to a different starting city
-        // If numAnts <= numCities, each ant gets a unique city
-        // If numAnts > numCities, use cyclic assignment
-        for (int i = 0; i < numAnts_; ++i) {
-            int startCity = i % numCities;
-            ants_.emplace_back(startCity, numCities);
-        }
-    } else {
-        // Create ants starting from random cities
-        std::uniform_int_distribution<> dist(0, numCities - 1);
+    // Ants and tour slots persist across iterations: after the first iteration,
+    // reset() and Tour copy-assignment reuse their buffers instead of reallocating
+    bool rebuildAnts = ants_.size() != static_cast<size_t>(numAnts_) ||
+        (!ants_.empty() && ants_[0].getNumCities() != numCities);
+    if (rebuildAnts) {
+        ants_.clear();
+        ants_.reserve(numAnts_);
+    }
+    if (antTours_.size() != static_cast<size_t>(numAnts_)) {
+        antTours_.resize(numAnts_);
+    }
 
-        for (int i = 0; i < numAnts_; ++i) {
-            int startCity = dist(getRandomGenerator());
-            ants_.emplace_back(startCity, numCities);
+    // Start city and seed of every ant, drawn serially from the colony stream
+    for (int i = 0; i < numAnts_; ++i) {
+        // With distinct start cities each ant gets a different city
+        // (cyclic assignment if numAnts > numCities), otherwise a random one
+        int startCity = useDistinctStartCities_ ? (i % numCities) : rng_.nextInt(numCities);
+        std::uint64_t antSeed = rng_();
+        if (rebuildAnts) {
+            ants_.emplace_back(startCity, numCities, antSeed);
+        } else {
+            ants_[i].reset(startCity);
+            ants_[i].setSeed(antSeed);
         }
     }
+    // Each ant draws from its own stream, so the tours only depend on the
+    // colony seed, not on how ants are spread over threads
 
-    // Each ant constructs a complete tour
-    // Parallelize this loop - each ant operates independently
-    #ifdef _OPENMP
-    #pragma omp parallel for schedule(dynamic) if(useParallel_ && numAnts_ >= 8)
-    #endif
-    for (int i = 0; i < numAnts_; ++i) {
-        Ant& ant = ants_[i];
-        while (!ant.hasVisitedAll()) {
-            int nextCity = ant.selectNextCity(graph_, pheromones_, alpha_, beta_);
+    // Number of candidates per step (0 = evaluate every unvisited city)
+    int numCandidates = (candidateListSize_ > 0) ? numCandidates_ : 0;
 
-            if (nextCity == -1) {
-                // No more cities to visit (should not happen in normal operation)
-                break;
+    // Use cached choice info when it matches the current configuration
+    int expectedStride = (numCandidates > 0) ? numCandidates : numCities;
+    bool useChoiceInfo = choiceInfoStride_ == expectedStride &&
+        choiceInfoUsesCandidates_ == (numCandidates > 0) &&
+        choiceInfo_.size() == static_cast<size_t>(numCities) * expectedStride;
+
+    if (pheromoneMode_ == "acs") {
+        // Ant Colony System: ants move in lock step so local updates can be applied
+        constructACSTours(useChoiceInfo, numCandidates);
+    } else {
+        // Each ant constructs a complete tour
+        // Parallelize this loop - each ant operates independently
+        #ifdef _OPENMP
+        #pragma omp parallel for schedule(dynamic) if(useParallel_ && numAnts_ >= 8)
+        #endif
+        for (int i = 0; i < numAnts_; ++i) {
+            Ant& ant = ants_[i];
+            while (!ant.hasVisitedAll()) {
+                int nextCity = selectNextCity(ant, useChoiceInfo, numCandidates, 0.0);
+                if (nextCity == -1) {
+                    // No more cities to visit (should not happen in normal operation)
+                    break;
+                }
+
+                ant.visitCity(nextCity, *graph_);
             }
 
-            ant.visitCity(nextCity, graph_);
+            // Complete tour and store it in place
+            // (local search will be applied later if mode is "all")
+            completeAntTour(i);
         }
-
-        // Complete tour and store it
-        if (ant.hasVisitedAll()) {
-            Tour tour = ant.completeTour(graph_);
-            // Store the tour (local search will be applied later if mode is "all")
-            antTours_[i] = tour;
+    }
+    if (profiling_) {
+        for (const Ant& ant : ants_) {
+            currentPhases_.candidateFallbacks += static_cast<std::uint64_t>(ant.getCandidateFallbacks());
         }
     }
+    constructionTimer.stop();
 
     // Apply local search to all tours in parallel if enabled and mode is "all"
-    if (useLocalSearch_ && localSearchMode_ == "all" && graph_.getNumCities() > 3) {
+    PhaseTimer localSearchTimer(profilePhase(&PhaseStats::localSearch));
+    if (useLocalSearch_ && localSearchMode_ == "all" && graph_->getNumCities() > 3) {
         #ifdef _OPENMP
         #pragma omp parallel for schedule(dynamic) if(useParallel_ && antTours_.size() >= 4)
         #endif
         for (size_t i = 0; i < antTours_.size(); ++i) {
             if (!antTours_[i].getSequence().empty()) {
-                LocalSearch::improve(antTours_[i], graph_, use3opt_);
+                applyLocalSearch(antTours_[i]);
             }
         }
+    } else if (useLocalSearch_ && localSearchMode_ == "top-k" && graph_->getNumCities() > 3) {
+        // Improve only the k shortest tours of this iteration, one per thread
+        std::vector<int>& topTours = topTourIndices_;
+        topTours.clear();
+        for (int i = 0; i < static_cast<int>(antTours_.size()); ++i) {
+            if (!antTours_[i].getSequence().empty()) {
+                topTours.push_back(i);
+            }
+        }
+        int count = std::min(effectiveLocalSearchTopK(), static_cast<int>(topTours.size()));
+        std::partial_sort(topTours.begin(), topTours.begin() + count, topTours.end(),
+                          [this](int a, int b) {
+                              double da = antTours_[a].getDistance();
+                              double db = antTours_[b].getDistance();
+                              return da < db || (da == db && a < b);
+                          });
+
+        #ifdef _OPENMP
+        #pragma omp parallel for schedule(dynamic, 1) if(useParallel_ && count >= 2)
+        #endif
+        for (int t = 0; t < count; ++t) {
+            applyLocalSearch(antTours_[topTours[t]]);
+        }
+    }
+}
+
+int AntColony::effectiveLocalSearchTopK() const {
+    if (localSearchTopK_ > 0) {
+        return localSearchTopK_;
+    }
+    int threads = 1;
+    #ifdef _OPENMP
+    if (useParallel_) {
+        threads = omp_get_max_threads();
+    }
+    #endif
+    return std::max(1, threads);
+}
+
+int AntColony::selectNextCity(Ant& ant, bool useChoiceInfo, int numCandidates, double q0) {
+    int current = ant.getCurrentCity();
+    if (useChoiceInfo) {
+        const double* choiceRow = &choiceInfo_[static_cast<size_t>(current) * choiceInfoStride_];
+        return (numCandidates > 0)
+            ? ant.selectNextCityFromCandidates(getCandidates(current), choiceRow,
+                                               numCandidates, *graph_, pheromones_,
+                                               alpha_, beta_, q0)
+            : ant.selectNextCity(choiceRow, q0);
+    }
+    return (numCandidates > 0)
+        ? ant.selectNextCityFromCandidates(*graph_, pheromones_, alpha_, beta_,
+                                           getCandidates(current), numCandidates)
+        : ant.selectNextCity(*graph_, pheromones_, alpha_, beta_);
+}
+
+void AntColony::completeAntTour(int antIndex) {
+    const Ant& ant = ants_[antIndex];
+    if (ant.hasVisitedAll()) {
+        ant.completeTour(*graph_, antTours_[antIndex]);
+    } else {
+        antTours_[antIndex] = Tour();
+    }
+}
+
+void AntColony::constructACSTours(bool useChoiceInfo, int numCandidates) {
+    int numCities = graph_->getNumCities();
+    acsMoves_.assign(numAnts_, std::make_pair(-1, -1));
+
+    // Every step, all ants choose their next city in parallel against the same
+    // trails, then the local updates of that step are applied in ant order.
+    // Concurrent ants never race on a trail, and the tours are the same for
+    // any thread count.
+    #ifdef _OPENMP
+    #pragma omp parallel if(useParallel_ && numAnts_ >= 8)
+    #endif
+    {
+        for (int step = 1; step < numCities; ++step) {
+            #ifdef _OPENMP
+            #pragma omp for schedule(static)
+            #endif
+            for (int i = 0; i < numAnts_; ++i) {
+                Ant& ant = ants_[i];
+                int current = ant.getCurrentCity();
+                int nextCity = ant.hasVisitedAll() ? -1 : selectNextCity(ant, useChoiceInfo, numCandidates, q0_);
+                if (nextCity == -1) {
+                    acsMoves_[i] = std::make_pair(-1, -1);
+                    continue;
+                }
+                ant.visitCity(nextCity, *graph_);
+                acsMoves_[i] = std::make_pair(current, nextCity);
+            }
+
+            #ifdef _OPENMP
+            #pragma omp single
+            #endif
+            {
+                for (const auto& move : acsMoves_) {
+                    if (move.first != -1) {
+                        acsLocalUpdate(move.first, move.second);
+                    }
+                }
+            }
+        }
+
+        #ifdef _OPENMP
+        #pragma omp for schedule(static)
+        #endif
+        for (int i = 0; i < numAnts_; ++i) {
+            completeAntTour(i);
+        }
+    }
+
+    // Closing edge back to the start city
+    for (int i = 0; i < numAnts_; ++i) {
+        const std::vector<int>& sequence = ants_[i].getTour();
+        if (ants_[i].hasVisitedAll() && sequence.size() > 1) {
+            acsLocalUpdate(sequence.back(), sequence.front());
+        }
+    }
+}
+
+void AntColony::acsLocalUpdate(int cityA, int cityB) {
+    // tau <- (1 - xi) * tau + xi * tau0: used edges become less attractive to
+    // the following ants, which keeps construction diverse
+    double pheromone = (1.0 - xi_) * pheromones_.getPheromone(cityA, cityB) + xi_ * acsTau0_;
+    pheromones_.setPheromone(cityA, cityB, pheromone);
+    refreshChoiceInfo(cityA, cityB);
+    refreshChoiceInfo(cityB, cityA);
+}
+
+void AntColony::refreshChoiceInfo(int from, int to) {
+    int numCities = graph_->getNumCities();
+    if (heuristicInfo_.size() != static_cast<size_t>(numCities) * choiceInfoStride_) {
+        return;  // Not initialized yet
+    }
+
+    int column = to;
+    if (choiceInfoUsesCandidates_) {
+        // Entry exists only if 'to' is one of the candidates of 'from'
+        const int* neighbors = getCandidates(from);
+        column = -1;
+        for (int c = 0; c < choiceInfoStride_; ++c) {
+            if (neighbors[c] == to) {
+                column = c;
+                break;
+            }
+        }
+        if (column == -1) {
+            return;
+        }
+    }
+
+    size_t index = static_cast<size_t>(from) * choiceInfoStride_ + column;
+    double pheromone = pheromones_.getPheromone(from, to);
+    double weight = dispatchPower(alpha_, [pheromone](auto power) { return power(pheromone); });
+    choiceInfo_[index] = weight * heuristicInfo_[index];
+}
+
+void AntColony::updateACSPheromones(const Tour& tour) {
+    // Global update on one tour only: tau <- (1 - rho) * tau + rho * Q / L.
+    // Touches n edges instead of evaporating the whole matrix.
+    const std::vector<int>& sequence = tour.getSequence();
+    if (sequence.size() < 2 || tour.getDistance() <= 0.0) {
+        return;
+    }
+
+    double deposit = Q_ / tour.getDistance();
+    for (size_t k = 0; k < sequence.size(); ++k) {
+        int cityA = sequence[k];
+        int cityB = sequence[(k + 1) % sequence.size()];
+        double pheromone = (1.0 - rho_) * pheromones_.getPheromone(cityA, cityB) + rho_ * deposit;
+        pheromones_.setPheromone(cityA, cityB, pheromone);
+        refreshChoiceInfo(cityA, cityB);
+        refreshChoiceInfo(cityB, cityA);
     }
 }
 
 void AntColony::updatePheromones() {
-    // Evaporate pheromones
-    pheromones_.evaporate(rho_);
+    ScopedThreadCount threadCount(numThreads_);
+    if (pheromoneMode_ == "acs") {
+        // Global update on the best-so-far tour (n edges, counted as deposit)
+        PhaseTimer depositTimer(profilePhase(&PhaseStats::deposit));
+        updateACSPheromones(bestTour_);
+        return;
+    }
+    if (gpu_) {
+        updateGpuPheromones();
+        return;
+    }
+    PhaseTimer depositTimer(profilePhase(&PhaseStats::deposit));
+
+    // Deposits are buffered per source tour and applied together with
+    // evaporation in one fused pass; the last source is reserved for the
+    // elitist deposit
+    int numBlocks = 1;
+    #ifdef _OPENMP
+    if (useParallel_) {
+        numBlocks = omp_get_max_threads();
+    }
+    #endif
+    const int numCities = graph_->getNumCities();
 
     // Helper function to deposit pheromones from a tour
-    auto depositTourPheromones = [&](const Tour& tour, double weight = 1.0) {
+    auto depositTourPheromones = [&](int source, const Tour& tour, double weight) {
         if (tour.getSequence().empty() || tour.getDistance() <= 0.0) {
             return;
         }
+        deposits_.addTour(source, tour.getSequence(), (Q_ / tour.getDistance()) * weight);
+    };
 
-        double depositAmount = (Q_ / tour.getDistance()) * weight;
-        const std::vector<int>& tourSequence = tour.getSequence();
-
-        for (size_t i = 0; i < tourSequence.size(); ++i) {
-            int cityA = tourSequence[i];
-            int cityB = tourSequence[(i + 1) % tourSequence.size()];
-            pheromones_.depositPheromone(cityA, cityB, depositAmount);
+    // Best tour of this iteration (nullptr if there is none)
+    auto findIterationBest = [&]() {
+        const Tour* iterationBest = nullptr;
+        double bestDist = std::numeric_limits<double>::max();
+        for (const Tour& tour : antTours_) {
+            if (!tour.getSequence().empty() && tour.getDistance() < bestDist) {
+                bestDist = tour.getDistance();
+                iterationBest = &tour;
+            }
         }
+        return iterationBest;
     };
 
     // Determine which tours deposit pheromones based on pheromoneMode_
     if (pheromoneMode_ == "best-iteration") {
         // Only the best tour from this iteration deposits pheromones
-        if (!antTours_.empty()) {
-            // Find iteration best
-            const Tour* iterationBest = nullptr;
-            double bestDist = std::numeric_limits<double>::max();
-            for (const Tour& tour : antTours_) {
-                if (!tour.getSequence().empty() && tour.getDistance() < bestDist) {
-                    bestDist = tour.getDistance();
-                    iterationBest = &tour;
-                }
-            }
-            if (iterationBest) {
-                depositTourPheromones(*iterationBest);
-            }
+        deposits_.reset(2, numCities, numBlocks);
+        if (const Tour* iterationBest = findIterationBest()) {
+            depositTourPheromones(0, *iterationBest, 1.0);
+        }
+    } else if (pheromoneMode_ == "mmas") {
+        // MAX-MIN Ant System: a single tour deposits, alternating between the
+        // iteration best and (increasingly often) the best-so-far tour
+        deposits_.reset(2, numCities, numBlocks);
+        const Tour* iterationBest = findIterationBest();
+        const Tour& depositor = (mmasUseBestSoFar() || !iterationBest) ? bestTour_ : *iterationBest;
+        depositTourPheromones(0, depositor, 1.0);
+
+        // Trail limits follow the best-so-far length; the fused pass clamps to them
+        if (!bestTour_.getSequence().empty() && bestTour_.getDistance() > 0.0) {
+            updateMMASLimits(bestTour_.getDistance());
         }
     } else if (pheromoneMode_ == "best-so-far") {
         // Only the global best tour deposits pheromones
-        if (!bestTour_.getSequence().empty()) {
-            depositTourPheromones(bestTour_);
-        }
+        deposits_.reset(2, numCities, numBlocks);
+        depositTourPheromones(0, bestTour_, 1.0);
     } else if (pheromoneMode_ == "rank") {
         // Only top-k ants deposit pheromones (rank-based)
         int effectiveRankSize = (rankSize_ > 0) ? rankSize_ : std::max(1, numAnts_ / 2);
 
-        // Sort tours by distance
-        std::vector<std::pair<double, const Tour*>> rankedTours;
+        // Sort tours by distance (member scratch, reused every iteration)
+        std::vector<std::pair<double, const Tour*>>& rankedTours = rankedTours_;
+        rankedTours.clear();
         for (const Tour& tour : antTours_) {
             if (!tour.getSequence().empty() && tour.getDistance() > 0.0) {
                 rankedTours.emplace_back(tour.getDistance(), &tour);
@@ -171,74 +595,436 @@ void AntColony::updatePheromones() {
 
         // Deposit from top-k tours with decreasing weights
         int count = std::min(effectiveRankSize, static_cast<int>(rankedTours.size()));
+        deposits_.reset(count + 1, numCities, numBlocks);
         for (int rank = 0; rank < count; ++rank) {
             // Weight decreases with rank: (rankSize - rank) / rankSize
             double weight = static_cast<double>(count - rank) / count;
-            depositTourPheromones(*rankedTours[rank].second, weight);
+            depositTourPheromones(rank, *rankedTours[rank].second, weight);
         }
     } else {
         // Default: "all" - all ants deposit pheromones (classic Ant Cycle)
-        // Use adaptive threading: cap threads at 2× ants to reduce atomic contention
+        // Ants fill their own deposit buckets in parallel, so no atomics are needed
+        int numTours = static_cast<int>(antTours_.size());
+        deposits_.reset(numTours + 1, numCities, numBlocks);
+
         #ifdef _OPENMP
-        int max_threads = omp_get_max_threads();
-        int effective_threads = std::min(max_threads, static_cast<int>(antTours_.size()) * 2);
-        #pragma omp parallel for num_threads(effective_threads) if(useParallel_ && antTours_.size() >= 8)
+        #pragma omp parallel for schedule(static) if(useParallel_ && numTours >= 8)
         #endif
-        for (size_t antIdx = 0; antIdx < antTours_.size(); ++antIdx) {
-            const Tour& tour = antTours_[antIdx];
+        for (int antIdx = 0; antIdx < numTours; ++antIdx) {
+            // Pheromone deposit amount: Q / tourLength
+            depositTourPheromones(antIdx, antTours_[antIdx], 1.0);
+        }
+    }
 
-            // Skip invalid tours (but allow distance 0 for single-city case)
-            if (tour.getSequence().empty()) {
-                continue;
-            }
+    // Elitist strategy: best-so-far tour deposits additional weighted pheromones
+    if (useElitist_ && !bestTour_.getSequence().empty()) {
+        // Calculate effective weight (default = numAnts)
+        double effectiveWeight = (elitistWeight_ > 0.0) ? elitistWeight_ : static_cast<double>(numAnts_);
+        depositTourPheromones(deposits_.getNumSources() - 1, bestTour_, effectiveWeight);
+    }
+    depositTimer.stop();
+
+    // Pheromones only change here: evaporate, deposit, clamp and refresh the
+    // dense choice info in a single pass over the matrix
+    bool denseChoiceInfo = !choiceInfoUsesCandidates_ &&
+                           heuristicInfo_.size() == static_cast<size_t>(numCities) * numCities;
+    PhaseTimer evaporationTimer(profilePhase(&PhaseStats::evaporation));
+    ChoiceInfoView choiceInfo;
+    if (denseChoiceInfo) {
+        choiceInfo.choice = choiceInfo_.data();
+        choiceInfo.heuristic = heuristicInfo_.data();
+        choiceInfo.stride = static_cast<size_t>(numCities);
+        choiceInfo.alpha = alpha_;
+    }
+    pheromones_.fusedUpdate(rho_, deposits_, denseChoiceInfo ? &choiceInfo : nullptr, useParallel_);
 
-            double tourLength = tour.getDistance();
+    // Candidate-list choice info is only n×k entries: rebuild it separately
+    if (!denseChoiceInfo) {
+        computeChoiceInfo();
+    }
 
-            // Skip tours with zero distance (single city case)
-            if (tourLength <= 0.0) {
-                continue;
-            }
+    // Stagnation: forget the learned trails and restart exploration at tau_max
+    if (pheromoneMode_ == "mmas" && advanceMMASStagnation()) {
+        pheromones_.initialize(pheromones_.getMaxPheromone());
+        computeChoiceInfo();
+    }
+}
 
-            // Pheromone deposit amount: Q / tourLength
-            double depositAmount = Q_ / tourLength;
+void AntColony::constructGpuSolutions() {
+    PhaseTimer constructionTimer(profilePhase(&PhaseStats::construction));
+    int numCities = graph_->getNumCities();
 
-            const std::vector<int>& tourSequence = tour.getSequence();
+    // Start cities and seeds come from the colony stream exactly as on the host
+    gpuStartCities_.resize(numAnts_);
+    gpuSeeds_.resize(numAnts_);
+    for (int i = 0; i < numAnts_; ++i) {
+        gpuStartCities_[i] = useDistinctStartCities_ ? (i % numCities) : rng_.nextInt(numCities);
+        gpuSeeds_[i] = rng_();
+    }
+    gpu_->constructTours(gpuStartCities_, gpuSeeds_, gpuLengths_);
+
+    // Only the shortest tours come back: the iteration best, or as many as
+    // local search improves ("all" copies every tour, so it gains least)
+    int numCopied = 1;
+    if (useLocalSearch_ && numCities > 3) {
+        if (localSearchMode_ == "all") {
+            numCopied = numAnts_;
+        } else if (localSearchMode_ == "top-k") {
+            numCopied = std::min(effectiveLocalSearchTopK(), numAnts_);
+        }
+    }
+    numCopied = std::max(1, std::min(numCopied, numAnts_));
+
+    std::vector<int>& order = gpuTourAnts_;
+    order.resize(numAnts_);
+    std::iota(order.begin(), order.end(), 0);
+    std::partial_sort(order.begin(), order.begin() + numCopied, order.end(), [this](int a, int b) {
+        return gpuLengths_[a] < gpuLengths_[b] || (gpuLengths_[a] == gpuLengths_[b] && a < b);
+    });
+    order.resize(numCopied);
+
+    antTours_.resize(numCopied);
+    gpuTourSlots_.assign(numAnts_, -1);
+    std::vector<int> sequence;
+    for (int t = 0; t < numCopied; ++t) {
+        gpu_->copyTour(order[t], sequence);
+        antTours_[t].setTour(sequence, gpuLengths_[order[t]]);
+        gpuTourSlots_[order[t]] = t;
+    }
+    constructionTimer.stop();
 
-            // Deposit pheromones on each edge in the tour
-            // depositPheromone already uses atomic operations for thread safety
-            for (size_t i = 0; i < tourSequence.size(); ++i) {
-                int cityA = tourSequence[i];
-                int cityB = tourSequence[(i + 1) % tourSequence.size()]; // Wrap around to start
+    PhaseTimer localSearchTimer(profilePhase(&PhaseStats::localSearch));
+    if (useLocalSearch_ && numCities > 3 && (localSearchMode_ == "all" || localSearchMode_ == "top-k")) {
+        #ifdef _OPENMP
+        #pragma omp parallel for schedule(dynamic, 1) if(useParallel_ && numCopied >= 2)
+        #endif
+        for (int t = 0; t < numCopied; ++t) {
+            applyLocalSearch(antTours_[t]);
+        }
+        for (int t = 0; t < numCopied; ++t) {
+            gpuLengths_[order[t]] = antTours_[t].getDistance();
+        }
+    }
+}
 
-                pheromones_.depositPheromone(cityA, cityB, depositAmount);
-            }
+void AntColony::updateGpuPheromones() {
+    // Device tours deposit by ant; tours the host holds (improved copies,
+    // the best-so-far tour) are uploaded with their amounts
+    PhaseTimer depositTimer(profilePhase(&PhaseStats::deposit));
+    gpuAmounts_.assign(numAnts_, 0.0);
+    std::vector<GpuColony::HostDeposit> hostDeposits;
+    auto depositHostTour = [&](const Tour& tour, double weight) {
+        if (!tour.getSequence().empty() && tour.getDistance() > 0.0) {
+            hostDeposits.push_back({&tour.getSequence(), (Q_ / tour.getDistance()) * weight});
+        }
+    };
+    auto depositAnt = [&](int ant, double weight) {
+        if (gpuTourSlots_[ant] >= 0) {
+            depositHostTour(antTours_[gpuTourSlots_[ant]], weight);
+        } else if (gpuLengths_[ant] > 0.0) {
+            gpuAmounts_[ant] = (Q_ / gpuLengths_[ant]) * weight;
+        }
+    };
+
+    // Ants by (possibly improved) tour length, lowest index first on ties
+    std::vector<int> ranked(numAnts_);
+    std::iota(ranked.begin(), ranked.end(), 0);
+    std::stable_sort(ranked.begin(), ranked.end(),
+                     [this](int a, int b) { return gpuLengths_[a] < gpuLengths_[b]; });
+
+    if (pheromoneMode_ == "best-iteration") {
+        depositAnt(ranked[0], 1.0);
+    } else if (pheromoneMode_ == "mmas") {
+        if (mmasUseBestSoFar()) {
+            depositHostTour(bestTour_, 1.0);
+        } else {
+            depositAnt(ranked[0], 1.0);
+        }
+        if (!bestTour_.getSequence().empty() && bestTour_.getDistance() > 0.0) {
+            updateMMASLimits(bestTour_.getDistance());
+        }
+    } else if (pheromoneMode_ == "best-so-far") {
+        depositHostTour(bestTour_, 1.0);
+    } else if (pheromoneMode_ == "rank") {
+        int effectiveRankSize = (rankSize_ > 0) ? rankSize_ : std::max(1, numAnts_ / 2);
+        int count = std::min(effectiveRankSize, numAnts_);
+        for (int rank = 0; rank < count; ++rank) {
+            depositAnt(ranked[rank], static_cast<double>(count - rank) / count);
+        }
+    } else {
+        for (int ant = 0; ant < numAnts_; ++ant) {
+            depositAnt(ant, 1.0);
         }
     }
 
-    // Elitist strategy: best-so-far tour deposits additional weighted pheromones
     if (useElitist_ && !bestTour_.getSequence().empty()) {
-        // Calculate effective weight (default = numAnts)
         double effectiveWeight = (elitistWeight_ > 0.0) ? elitistWeight_ : static_cast<double>(numAnts_);
-        depositTourPheromones(bestTour_, effectiveWeight);
+        depositHostTour(bestTour_, effectiveWeight);
+    }
+    depositTimer.stop();
+
+    // Device deposits are applied by updateTrails, so they count as evaporation here
+    PhaseTimer evaporationTimer(profilePhase(&PhaseStats::evaporation));
+    gpu_->updateTrails(rho_, gpuAmounts_, hostDeposits, pheromones_.getMinPheromone(),
+                       pheromones_.getMaxPheromone());
+
+    if (pheromoneMode_ == "mmas" && advanceMMASStagnation()) {
+        gpu_->resetTrails(pheromones_.getMaxPheromone());
+    }
+}
+
+bool AntColony::advanceMMASStagnation() {
+    mmasIteration_++;
+    if (bestTour_.getDistance() < mmasBestDistance_) {
+        mmasBestDistance_ = bestTour_.getDistance();
+        mmasStagnation_ = 0;
+    } else {
+        mmasStagnation_++;
+    }
+    if (mmasRestartIterations_ > 0 && mmasStagnation_ >= mmasRestartIterations_) {
+        mmasIteration_ = 0;
+        mmasStagnation_ = 0;
+        return true;
+    }
+    return false;
+}
+
+void AntColony::importTour(const Tour& tour) {
+    ScopedThreadCount threadCount(numThreads_);
+    int numCities = graph_->getNumCities();
+    if (tour.getSequence().size() != static_cast<size_t>(numCities) ||
+        tour.getDistance() >= bestTour_.getDistance()) {
+        return;
+    }
+
+    bestTour_ = tour;
+
+    // Reinforce the migrant's edges once, the way this colony's own update rule
+    // would reward a best tour, so construction starts exploiting it right away
+    if (pheromoneMode_ == "acs") {
+        updateACSPheromones(bestTour_);
+        return;
+    }
+    if (gpu_) {
+        // Deposit only: no evaporation, trail limits kept
+        gpu_->updateTrails(0.0, {}, {{&bestTour_.getSequence(), Q_ / bestTour_.getDistance()}},
+                           pheromones_.getMinPheromone(), pheromones_.getMaxPheromone());
+        return;
+    }
+    deposits_.reset(1, numCities, 1);
+    deposits_.addTour(0, bestTour_.getSequence(), Q_ / bestTour_.getDistance());
+    pheromones_.depositPheromones(deposits_, false);
+    pheromones_.clampPheromones();  // MMAS keeps its trail limits
+    computeChoiceInfo();
+}
+
+void AntColony::addPheromoneEdges(const std::vector<std::pair<int, int>>& edges,
+                                  const std::vector<double>& amounts) {
+    ScopedThreadCount threadCount(numThreads_);
+    int numCities = graph_->getNumCities();
+    if (gpu_) {
+        gpu_->downloadTrails(pheromones_);  // Rare (distributed sync): edit on the host
+    }
+    size_t count = std::min(edges.size(), amounts.size());
+    for (size_t e = 0; e < count; ++e) {
+        int a = edges[e].first;
+        int b = edges[e].second;
+        if (a < 0 || b < 0 || a >= numCities || b >= numCities || a == b) {
+            continue;
+        }
+        pheromones_.depositPheromone(a, b, amounts[e]);
+    }
+    pheromones_.clampPheromones();
+    if (gpu_) {
+        gpu_->uploadTrails(pheromones_);
+        return;
+    }
+    computeChoiceInfo();
+}
+
+void AntColony::updateMMASLimits(double bestDistance) {
+    // tau_max = 1 / (rho * L_best), scaled by Q like the deposits
+    double tauMax = Q_ / (rho_ * bestDistance);
+
+    // tau_min from the probability pbest of reconstructing the best tour once
+    // the trails have converged (Stuetzle & Hoos, avg = n/2 choices per step)
+    int numCities = graph_->getNumCities();
+    double pDec = std::pow(MMAS_PBEST, 1.0 / std::max(1, numCities));
+    double avg = numCities / 2.0;
+    double tauMin = (avg > 1.0) ? tauMax * (1.0 - pDec) / ((avg - 1.0) * pDec) : tauMax;
+
+    pheromones_.setMaxPheromone(tauMax);
+    pheromones_.setMinPheromone(std::min(tauMin, tauMax));
+}
+
+bool AntColony::mmasUseBestSoFar() const {
+    // Schedule for MMAS with local search: iteration best only at first, then
+    // the best-so-far tour every 5th, 3rd, 2nd and finally every iteration
+    int iteration = mmasIteration_ + 1;
+    int period = (iteration <= 25) ? 0 : (iteration <= 75) ? 5 : (iteration <= 125) ? 3
+                                       : (iteration <= 250) ? 2 : 1;
+    return period > 0 && iteration % period == 0;
+}
+
+void AntColony::prepareCandidateLists() {
+    numCandidates_ = 0;
+    candidateStride_ = 0;
+    candidateData_ = nullptr;
+
+    if (candidateListSize_ <= 0) {
+        return;
+    }
+
+    int k = std::min(candidateListSize_, graph_->getNumCities() - 1);
+    if (k <= 0) {
+        return;
+    }
+
+    if (graph_->getNeighborListSize() >= k) {
+        // Reuse lists precomputed on the (possibly shared) graph
+        candidateStride_ = graph_->getNeighborListStride();
+        candidateData_ = graph_->getNeighbors(0);
+    } else {
+        // Graph is read-only: keep a colony-owned copy of the lists
+        if (candidateLists_.size() != static_cast<size_t>(graph_->getNumCities()) * k) {
+            candidateLists_ = graph_->computeNeighborLists(k);
+        }
+        candidateStride_ = k;
+        candidateData_ = candidateLists_.data();
+    }
+    numCandidates_ = k;
+}
+
+void AntColony::prepareLocalSearchNeighbors() {
+    localSearchNeighbors_ = NeighborLists();
+
+    if (!useLocalSearch_ || localSearchOperator_ == "exhaustive" || graph_->getNumCities() < 5) {
+        return;
+    }
+
+    if (numCandidates_ > 0) {
+        // Same lists as tour construction
+        localSearchNeighbors_.data = candidateData_;
+        localSearchNeighbors_.stride = candidateStride_;
+        localSearchNeighbors_.size = numCandidates_;
+        return;
+    }
+
+    int k = std::min(LocalSearch::DEFAULT_NEIGHBORS, graph_->getNumCities() - 1);
+    if (graph_->getNeighborListSize() >= k) {
+        localSearchNeighbors_ = NeighborLists::fromGraph(*graph_);
+    } else {
+        if (localSearchLists_.size() != static_cast<size_t>(graph_->getNumCities()) * k) {
+            localSearchLists_ = graph_->computeNeighborLists(k);
+        }
+        localSearchNeighbors_.data = localSearchLists_.data();
+        localSearchNeighbors_.stride = k;
+    }
+    localSearchNeighbors_.size = k;
+}
+
+void AntColony::applyLocalSearch(Tour& tour, bool parallelScan) const {
+    // Parallel scans count their work on the calling thread, so the
+    // difference of its counters covers the whole call
+    LocalSearchCounters before;
+    if (profiling_) {
+        before = LocalSearch::threadCounters();
+    }
+
+    if (localSearchNeighbors_.size > 0) {
+        LocalSearchOperator op = (localSearchOperator_ == "lk")
+                                     ? LocalSearchOperator::LIN_KERNIGHAN
+                                     : LocalSearchOperator::NEIGHBOR_LIST;
+        LocalSearch::improve(tour, *graph_, use3opt_, op, localSearchNeighbors_);
+    } else if (parallelScan) {
+        LocalSearch::improveParallel(tour, *graph_, use3opt_);
+    } else {
+        LocalSearch::improve(tour, *graph_, use3opt_);
+    }
+
+    if (profiling_) {
+        const LocalSearchCounters& after = LocalSearch::threadCounters();
+        profileMoves_.fetch_add(after.moves - before.moves, std::memory_order_relaxed);
+        profileEvaluations_.fetch_add(after.evaluations - before.evaluations, std::memory_order_relaxed);
+    }
+}
+
+void AntColony::computeHeuristicInfo() {
+    int numCities = graph_->getNumCities();
+    int numCandidates = (candidateListSize_ > 0) ? numCandidates_ : 0;
+    int stride = (numCandidates > 0) ? numCandidates : numCities;
+
+    choiceInfoStride_ = stride;
+    choiceInfoUsesCandidates_ = numCandidates > 0;
+    heuristicInfo_.resize(static_cast<size_t>(numCities) * stride);
+    choiceInfo_.resize(heuristicInfo_.size());
+
+    // n² entries in the dense case: integer beta becomes multiplications
+    dispatchPower(beta_, [&](auto power) {
+        #ifdef _OPENMP
+        #pragma omp parallel for schedule(static) if(useParallel_ && numCities >= 200)
+        #endif
+        for (int i = 0; i < numCities; ++i) {
+            const int* neighbors = (numCandidates > 0) ? getCandidates(i) : nullptr;
+            double* row = &heuristicInfo_[static_cast<size_t>(i) * stride];
+            for (int c = 0; c < stride; ++c) {
+                int j = neighbors ? neighbors[c] : c;
+                double distance = graph_->getDistanceUnchecked(i, j);
+
+                // Avoid division by zero (same convention as Ant::selectNextCity)
+                if (distance == 0.0) {
+                    distance = Ant::EPSILON_DISTANCE;
+                }
+                row[c] = power(1.0 / distance);
+            }
+        }
+    });
+}
+
+void AntColony::computeChoiceInfo() {
+    int numCities = graph_->getNumCities();
+    int stride = choiceInfoStride_;
+    if (heuristicInfo_.size() != static_cast<size_t>(numCities) * stride) {
+        return;  // Not initialized yet
     }
+
+    // pheromone^alpha without std::pow for integer alpha (alpha = 1: a copy)
+    dispatchPower(alpha_, [&](auto power) {
+        #ifdef _OPENMP
+        #pragma omp parallel for schedule(static) if(useParallel_ && numCities >= 200)
+        #endif
+        for (int i = 0; i < numCities; ++i) {
+            const int* neighbors = choiceInfoUsesCandidates_ ? getCandidates(i) : nullptr;
+            const double* heuristicRow = &heuristicInfo_[static_cast<size_t>(i) * stride];
+            double* choiceRow = &choiceInfo_[static_cast<size_t>(i) * stride];
+            for (int c = 0; c < stride; ++c) {
+                int j = neighbors ? neighbors[c] : c;
+                choiceRow[c] = power(pheromones_.getPheromone(i, j)) * heuristicRow[c];
+            }
+        }
+    });
 }
 
 void AntColony::runIteration() {
+    ScopedThreadCount threadCount(numThreads_);
     // Construct solutions (stores tours in antTours_)
     constructSolutions();
 
-    // Find best tour in this iteration from stored tours
+    PhaseTimer selectionTimer(profilePhase(&PhaseStats::selection));
+
+    // Find best tour in this iteration from stored tours. Only indices are
+    // tracked; the winning tour is copied once, into bestTour_'s storage
     double iterationBest = std::numeric_limits<double>::max();
-    Tour iterationBestTour;
+    size_t iterationBestIndex = antTours_.size();
 
     // Process all stored tours to find the best - can be parallelized
     #ifdef _OPENMP
     if (useParallel_ && antTours_.size() >= 8) {
         #pragma omp parallel
         {
-            // Each thread tracks its own best
+            // Each thread tracks its own best (lowest index wins ties)
             double threadBest = std::numeric_limits<double>::max();
-            Tour threadBestTour;
+            size_t threadBestIndex = antTours_.size();
 
             #pragma omp for nowait
             for (size_t i = 0; i < antTours_.size(); ++i) {
@@ -249,54 +1035,54 @@ void AntColony::runIteration() {
                     continue;
                 }
 
-                double tourLength = tour.getDistance();
-
-                if (tourLength < threadBest) {
-                    threadBest = tourLength;
-                    threadBestTour = tour;
+                if (tour.getDistance() < threadBest) {
+                    threadBest = tour.getDistance();
+                    threadBestIndex = i;
                 }
             }
 
-            // Merge thread results into global best
+            // Merge thread results; ties resolve to the lowest ant index like
+            // the serial loop, keeping seeded runs independent of thread timing
             #pragma omp critical
             {
-                if (threadBest < iterationBest) {
+                if (threadBest < iterationBest ||
+                    (threadBest == iterationBest && threadBestIndex < iterationBestIndex)) {
                     iterationBest = threadBest;
-                    iterationBestTour = threadBestTour;
-                }
-                if (threadBest < bestTour_.getDistance()) {
-                    bestTour_ = threadBestTour;
+                    iterationBestIndex = threadBestIndex;
                 }
             }
         }
     } else {
     #endif
         // Serial version (no OpenMP or disabled)
-        for (const Tour& tour : antTours_) {
+        for (size_t i = 0; i < antTours_.size(); ++i) {
+            const Tour& tour = antTours_[i];
+
             // Skip invalid tours (but allow distance 0 for single-city case)
             if (tour.getSequence().empty()) {
                 continue;
             }
 
-            double tourLength = tour.getDistance();
-
-            if (tourLength < iterationBest) {
-                iterationBest = tourLength;
-                iterationBestTour = tour;
-            }
-
-            // Update global best
-            if (tourLength < bestTour_.getDistance()) {
-                bestTour_ = tour;
+            if (tour.getDistance() < iterationBest) {
+                iterationBest = tour.getDistance();
+                iterationBestIndex = i;
             }
         }
     #ifdef _OPENMP
     }
     #endif
 
+    // Update global best
+    if (iterationBestIndex < antTours_.size() && iterationBest < bestTour_.getDistance()) {
+        bestTour_ = antTours_[iterationBestIndex];
+    }
+    selectionTimer.stop();
+
     // Apply local search to best tour if enabled and mode is "best"
+    // (exhaustive moves split their scan across threads, nothing else runs now)
     if (useLocalSearch_ && localSearchMode_ == "best") {
-        LocalSearch::improve(bestTour_, graph_, use3opt_);
+        PhaseTimer localSearchTimer(profilePhase(&PhaseStats::localSearch));
+        applyLocalSearch(bestTour_, useParallel_);
     }
 
     // Record iteration best (use improved bestTour distance if local search was applied)
@@ -307,60 +1093,416 @@ void AntColony::runIteration() {
 
     // Update pheromones (uses antTours_ which may be improved by local search in mode "all")
     updatePheromones();
+
+    if (profiling_) {
+        currentPhases_.localSearchMoves += profileMoves_.exchange(0, std::memory_order_relaxed);
+        currentPhases_.localSearchEvaluations += profileEvaluations_.exchange(0, std::memory_order_relaxed);
+        stats_.total += currentPhases_;
+        stats_.iterations.push_back(currentPhases_);
+        currentPhases_ = PhaseStats();
+    }
 }
 
 Tour AntColony::solve(int maxIterations, ProgressCallback callback) {
-    initialize();
-
-    if (maxIterations < 0) {
-        // Run until no improvement for convergenceThreshold_ iterations
-        int iterationsWithoutImprovement = 0;
-        int iteration = 0;
-        double lastBestDistance = std::numeric_limits<double>::max();
-
-        while (iterationsWithoutImprovement < convergenceThreshold_) {
-            runIteration();
-            iteration++;
-
-            double currentBestDistance = bestTour_.getDistance();
+    // The time limit covers the setup below (heuristic, choice info, warm start)
+    auto startTime = std::chrono::steady_clock::now();
+    ScopedThreadCount threadCount(numThreads_);
+
+    // A restored checkpoint keeps its trails, best tour and history; only the
+    // structures derived from the settings are rebuilt
+    const bool resume = resumePending_;
+    if (resume) {
+        resumePending_ = false;
+        prepareSearch();
+    } else {
+        initialize();
+    }
 
-            // Check if we found a better solution
-            if (currentBestDistance < lastBestDistance) {
+    int iteration = static_cast<int>(iterationBestDistances_.size());
+    int iterationsWithoutImprovement = 0;
+    double lastBestDistance = std::numeric_limits<double>::max();
+    if (resume) {
+        // Iterations since the running best of the history last improved
+        double runningBest = std::numeric_limits<double>::max();
+        for (double distance : iterationBestDistances_) {
+            if (distance < runningBest) {
+                runningBest = distance;
                 iterationsWithoutImprovement = 0;
-                lastBestDistance = currentBestDistance;
             } else {
                 iterationsWithoutImprovement++;
             }
+        }
+        lastBestDistance = bestTour_.getDistance();
+    }
 
-            // Call progress callback if provided and at the right interval
-            ProgressCallback activeCallback = callback ? callback : progressCallback_;
-            if (activeCallback && (iteration % callbackInterval_ == 0)) {
-                activeCallback(iteration, currentBestDistance,
-                             bestTour_.getSequence(), iterationBestDistances_);
-            }
+    completedIterations_.store(iteration, std::memory_order_relaxed);
+    {
+        std::lock_guard<std::mutex> lock(snapshotMutex_);
+        bestTourSnapshot_ = bestTour_;
+    }
+
+    ProgressCallback activeCallback = callback ? callback : progressCallback_;
+
+    // Incremental updates: convergence points and the best tour not reported yet
+    std::unique_ptr<ProgressReporter> reporter;
+    if (incrementalCallback_) {
+        reporter = std::make_unique<ProgressReporter>(incrementalCallback_, asynchronousIncremental_);
+    }
+    size_t reportedConvergence = 0;
+    double reportedDistance = std::numeric_limits<double>::max();
+    auto reportIncrement = [&](int iteration, bool final) {
+        ProgressUpdate update;
+        update.iteration = iteration;
+        update.bestDistance = bestTour_.getDistance();
+        if (bestTour_.getDistance() < reportedDistance) {
+            update.tourImproved = true;
+            update.bestTour = bestTour_.getSequence();
+            reportedDistance = bestTour_.getDistance();
         }
-    } else {
-        // Run for fixed number of iterations
-        for (int i = 0; i < maxIterations; ++i) {
-            runIteration();
-
-            // Call progress callback if provided and at the right interval
-            int iteration = i + 1;
-            ProgressCallback activeCallback = callback ? callback : progressCallback_;
-            if (activeCallback && (iteration % callbackInterval_ == 0)) {
-                activeCallback(iteration, bestTour_.getDistance(),
-                             bestTour_.getSequence(), iterationBestDistances_);
-            }
+        update.convergenceOffset = static_cast<int>(reportedConvergence);
+        update.newConvergence.assign(iterationBestDistances_.begin() + reportedConvergence,
+                                     iterationBestDistances_.end());
+        reportedConvergence = iterationBestDistances_.size();
+        update.profile = stats_.total;
+        update.final = final;
+        reporter->publish(std::move(update));
+    };
+
+    double lastIterationSeconds = 0.0;
+    int checkpointedIteration = -1;      // Last automatic checkpoint
+
+    while (true) {
+        // Fixed iteration count, or no improvement for convergenceThreshold_ iterations
+        if (maxIterations >= 0 && iteration >= maxIterations) {
+            stopReason_ = "iterations";
+            break;
         }
+        if (maxIterations < 0 && iterationsWithoutImprovement >= convergenceThreshold_) {
+            stopReason_ = "convergence";
+            break;
+        }
+
+        // Early stopping criteria, also before the first iteration (a stop
+        // requested during setup, a budget the setup used up, a warm start
+        // already at the target)
+        if (stopRequested_.load()) {
+            stopReason_ = "stopped";
+            break;
+        }
+        if (targetDistance_ > 0.0 && bestTour_.getDistance() <= targetDistance_) {
+            stopReason_ = "target";
+            break;
+        }
+        double elapsed = std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - startTime).count();
+        if (timeLimit_ > 0.0 && elapsed + lastIterationSeconds > timeLimit_) {
+            stopReason_ = "time-limit";
+            break;
+        }
+
+        auto iterationStart = std::chrono::steady_clock::now();
+        runIteration();
+        iteration++;
+        lastIterationSeconds = std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - iterationStart).count();
+
+        double currentBestDistance = bestTour_.getDistance();
+
+        // Check if we found a better solution
+        if (currentBestDistance < lastBestDistance) {
+            iterationsWithoutImprovement = 0;
+            lastBestDistance = currentBestDistance;
+            publishBestTour();
+        } else {
+            iterationsWithoutImprovement++;
+        }
+        completedIterations_.store(iteration, std::memory_order_relaxed);
+
+        // Call progress callback if provided and at the right interval
+        if (activeCallback && (iteration % callbackInterval_ == 0)) {
+            activeCallback(iteration, currentBestDistance,
+                           bestTour_.getSequence(), iterationBestDistances_);
+        }
+        if (reporter && (iteration % callbackInterval_ == 0)) {
+            reportIncrement(iteration, false);
+        }
+        if (!checkpointPath_.empty() && checkpointInterval_ > 0 &&
+            iteration % checkpointInterval_ == 0) {
+            writeAutomaticCheckpoint();
+            checkpointedIteration = iteration;
+        }
+    }
+
+    // Stopped before any iteration and without a warm start: return the
+    // nearest neighbor tour rather than an empty one
+    if (bestTour_.getSequence().empty() && graph_->getNumCities() > 0) {
+        std::vector<int> sequence = graph_->nearestNeighborTour();
+        bestTour_ = Tour(sequence, closedTourLength(*graph_, sequence));
+        publishBestTour();
+    }
+
+    // The host trails are stale while the device ones evolve
+    if (gpu_) {
+        gpu_->downloadTrails(pheromones_);
+        computeChoiceInfo();
+    }
+
+    if (!checkpointPath_.empty() && iteration != checkpointedIteration) {
+        writeAutomaticCheckpoint();
+    }
+
+    if (reporter) {
+        reportIncrement(iteration, true);
+        reporter->finish();
     }
 
+    // A request consumed by this run (or arriving too late for it) must not
+    // stop the next one
+    stopRequested_.store(false);
     return bestTour_;
 }
 
+void AntColony::publishBestTour() {
+    std::lock_guard<std::mutex> lock(snapshotMutex_);
+    bestTourSnapshot_ = bestTour_;
+}
+
+Tour AntColony::getBestTourSnapshot() const {
+    std::lock_guard<std::mutex> lock(snapshotMutex_);
+    return bestTourSnapshot_;
+}
+
+bool AntColony::checkpoint(const std::string& path) const {
+    namespace fs = std::filesystem;
+    const int numCities = graph_->getNumCities();
+    if (numCities <= 0 || bestTour_.getSequence().size() != static_cast<size_t>(numCities)) {
+        return false;
+    }
+
+    // During a GPU solve only the device trails are current
+    std::unique_ptr<PheromoneMatrix> deviceTrails;
+    if (gpu_) {
+        deviceTrails = std::make_unique<PheromoneMatrix>(pheromones_);
+        gpu_->downloadTrails(*deviceTrails);
+    }
+    const PheromoneMatrix& trails = deviceTrails ? *deviceTrails : pheromones_;
+
+    CheckpointHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC));
+    header.version = CHECKPOINT_VERSION;
+    header.byteOrder = CHECKPOINT_BYTE_ORDER;
+    header.numCities = static_cast<std::uint32_t>(numCities);
+    header.numAnts = numAnts_;
+    header.iterations = iterationBestDistances_.size();
+    header.seed = seed_;
+    std::array<std::uint64_t, 4> state = rng_.getState();
+    std::copy(state.begin(), state.end(), header.rngState);
+    header.alpha = alpha_;
+    header.beta = beta_;
+    header.rho = rho_;
+    header.Q = Q_;
+    std::strncpy(header.pheromoneMode, pheromoneMode_.c_str(), sizeof(header.pheromoneMode) - 1);
+    header.useDistinctStartCities = useDistinctStartCities_ ? 1 : 0;
+    header.useElitist = useElitist_ ? 1 : 0;
+    header.elitistWeight = elitistWeight_;
+    header.rankSize = rankSize_;
+    header.mmasRestartIterations = mmasRestartIterations_;
+    header.q0 = q0_;
+    header.xi = xi_;
+    header.acsTau0 = acsTau0_;
+    header.candidateListSize = candidateListSize_;
+    header.mmasIteration = mmasIteration_;
+    header.mmasStagnation = mmasStagnation_;
+    header.mmasBestDistance = mmasBestDistance_;
+    header.minPheromone = trails.getMinPheromone();
+    header.maxPheromone = trails.getMaxPheromone();
+    header.bestDistance = bestTour_.getDistance();
+
+    std::error_code error;
+    fs::path target(path);
+    if (target.has_parent_path()) {
+        fs::create_directories(target.parent_path(), error);
+    }
+
+    // Unique temporary name in the target directory, renamed into place at the end
+    std::random_device device;
+    std::string temporary = path + ".tmp-" + toHex((std::uint64_t(device()) << 32) | device());
+    {
+        std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+        if (!out.is_open()) {
+            return false;
+        }
+        auto put = [&](const void* data, std::size_t bytes) {
+            out.write(static_cast<const char*>(data), static_cast<std::streamsize>(bytes));
+        };
+
+        put(&header, sizeof(header));
+        std::vector<std::int32_t> sequence(bestTour_.getSequence().begin(), bestTour_.getSequence().end());
+        put(sequence.data(), sequence.size() * sizeof(std::int32_t));
+        put(iterationBestDistances_.data(), iterationBestDistances_.size() * sizeof(double));
+        for (int i = 0; i < numCities; ++i) {
+            put(trails.getRow(i) + i, static_cast<std::size_t>(numCities - i) * sizeof(double));
+        }
+
+        out.close();
+        if (!out) {
+            fs::remove(temporary, error);
+            return false;
+        }
+    }
+
+    fs::rename(temporary, path, error);
+    if (error) {
+        fs::remove(temporary, error);
+        return false;
+    }
+    return true;
+}
+
+bool AntColony::restore(const std::string& path) {
+    namespace fs = std::filesystem;
+    const int numCities = graph_->getNumCities();
+    std::ifstream in(path, std::ios::binary);
+    if (!in.is_open() || numCities <= 0) {
+        return false;
+    }
+
+    CheckpointHeader header;
+    if (!in.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+        std::memcmp(header.magic, CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC)) != 0 ||
+        header.version != CHECKPOINT_VERSION || header.byteOrder != CHECKPOINT_BYTE_ORDER ||
+        header.numCities != static_cast<std::uint32_t>(numCities) || header.numAnts < 1) {
+        return false;
+    }
+    const char* modeEnd = std::find(header.pheromoneMode, header.pheromoneMode + sizeof(header.pheromoneMode), '\0');
+    std::string mode(static_cast<const char*>(header.pheromoneMode), modeEnd);
+    if (!isPheromoneMode(mode)) {
+        return false;
+    }
+
+    // The file must hold exactly the sections the header announces, so a
+    // truncated file is rejected before the trails are touched
+    const std::uint64_t n = static_cast<std::uint64_t>(numCities);
+    std::error_code error;
+    auto fileBytes = fs::file_size(path, error);
+    if (error || header.iterations > fileBytes ||
+        fileBytes != sizeof(header) + n * sizeof(std::int32_t) + header.iterations * sizeof(double) +
+                      n * (n + 1) / 2 * sizeof(double)) {
+        return false;
+    }
+
+    std::vector<std::int32_t> stored(numCities);
+    std::vector<double> history(header.iterations);
+    if (!in.read(reinterpret_cast<char*>(stored.data()), stored.size() * sizeof(std::int32_t)) ||
+        !in.read(reinterpret_cast<char*>(history.data()), history.size() * sizeof(double))) {
+        return false;
+    }
+
+    // The best tour must be a tour of this graph with the recorded length
+    Tour best(std::vector<int>(stored.begin(), stored.end()), header.bestDistance);
+    if (!best.validate(numCities)) {
+        return false;
+    }
+    double length = closedTourLength(*graph_, best.getSequence());
+    if (std::abs(length - header.bestDistance) > 1e-6 * std::max(1.0, std::abs(length))) {
+        return false;
+    }
+
+    // Trails, one row of the upper triangle at a time (mirrored below the diagonal)
+    std::vector<double> row(numCities);
+    for (int i = 0; i < numCities; ++i) {
+        std::size_t count = static_cast<std::size_t>(numCities - i);
+        if (!in.read(reinterpret_cast<char*>(row.data()), count * sizeof(double))) {
+            return false;
+        }
+        for (std::size_t k = 0; k < count; ++k) {
+            pheromones_.setPheromone(i, i + static_cast<int>(k), row[k]);
+        }
+    }
+    pheromones_.setMinPheromone(header.minPheromone);
+    pheromones_.setMaxPheromone(header.maxPheromone);
+
+    numAnts_ = header.numAnts;
+    alpha_ = header.alpha;
+    beta_ = header.beta;
+    rho_ = header.rho;
+    Q_ = header.Q;
+    pheromoneMode_ = mode;
+    useDistinctStartCities_ = header.useDistinctStartCities != 0;
+    useElitist_ = header.useElitist != 0;
+    elitistWeight_ = header.elitistWeight;
+    rankSize_ = header.rankSize;
+    mmasRestartIterations_ = header.mmasRestartIterations;
+    q0_ = header.q0;
+    xi_ = header.xi;
+    acsTau0_ = header.acsTau0;
+    candidateListSize_ = header.candidateListSize;
+    mmasIteration_ = header.mmasIteration;
+    mmasStagnation_ = header.mmasStagnation;
+    mmasBestDistance_ = header.mmasBestDistance;
+    seed_ = header.seed;
+    std::array<std::uint64_t, 4> state;
+    std::copy(header.rngState, header.rngState + 4, state.begin());
+    rng_.setState(state);
+
+    bestTour_ = best;
+    iterationBestDistances_ = std::move(history);
+    stats_ = ColonyStats();
+    currentPhases_ = PhaseStats();
+    profileMoves_.store(0, std::memory_order_relaxed);
+    profileEvaluations_.store(0, std::memory_order_relaxed);
+    completedIterations_.store(static_cast<int>(iterationBestDistances_.size()), std::memory_order_relaxed);
+    publishBestTour();
+    resumePending_ = true;
+    return true;
+}
+
+void AntColony::setCheckpointFile(const std::string& path, int interval) {
+    checkpointPath_ = path;
+    checkpointInterval_ = std::max(0, interval);
+}
+
+void AntColony::writeAutomaticCheckpoint() {
+    if (!checkpoint(checkpointPath_)) {
+        std::cerr << "Warning: could not write checkpoint " << checkpointPath_ << std::endl;
+    }
+}
+
+bool AntColony::setWarmStartTour(const std::vector<int>& sequence) {
+    if (!Tour(sequence, 0.0).validate(graph_->getNumCities())) {
+        warmStartTour_.clear();
+        return false;
+    }
+    warmStartTour_ = sequence;
+    return true;
+}
+
+void AntColony::setTimeLimit(double seconds) {
+    timeLimit_ = std::max(0.0, seconds);
+}
+
+void AntColony::setTargetDistance(double distance) {
+    targetDistance_ = std::max(0.0, distance);
+}
+
+void AntColony::requestStop() {
+    stopRequested_.store(true);
+}
+
+void AntColony::setProfiling(bool profiling) {
+    profiling_ = profiling;
+}
+
 void AntColony::setProgressCallback(ProgressCallback callback) {
     progressCallback_ = callback;
 }
 
+void AntColony::setIncrementalCallback(IncrementalCallback callback, bool asynchronous) {
+    incrementalCallback_ = std::move(callback);
+    asynchronousIncremental_ = asynchronous;
+}
+
 void AntColony::setCallbackInterval(int interval) {
     callbackInterval_ = interval;
 }
@@ -369,17 +1511,17 @@ void AntColony::setConvergenceThreshold(int threshold) {
     convergenceThreshold_ = threshold;
 }
 
+void AntColony::setSeed(std::uint64_t seed) {
+    seed_ = seed;
+    rng_.seed(seed_);
+}
+
 void AntColony::setUseParallel(bool useParallel) {
     useParallel_ = useParallel;
 }
 
 void AntColony::setNumThreads(int numThreads) {
     numThreads_ = numThreads;
-#ifdef _OPENMP
-    if (numThreads > 0) {
-        omp_set_num_threads(numThreads);
-    }
-#endif
 }
 
 void AntColony::setUseLocalSearch(bool useLocalSearch) {
@@ -391,11 +1533,21 @@ void AntColony::setUse3Opt(bool use3opt) {
 }
 
 void AntColony::setLocalSearchMode(const std::string& mode) {
-    if (mode == "best" || mode == "all" || mode == "none") {
+    if (mode == "best" || mode == "all" || mode == "top-k" || mode == "none") {
         localSearchMode_ = mode;
     }
 }
 
+void AntColony::setLocalSearchTopK(int k) {
+    localSearchTopK_ = std::max(0, k);
+}
+
+void AntColony::setLocalSearchOperator(const std::string& op) {
+    if (op == "exhaustive" || op == "neighbor" || op == "lk") {
+        localSearchOperator_ = op;
+    }
+}
+
 void AntColony::setUseElitist(bool useElitist) {
     useElitist_ = useElitist;
 }
@@ -405,7 +1557,7 @@ void AntColony::setElitistWeight(double weight) {
 }
 
 void AntColony::setPheromoneMode(const std::string& mode) {
-    if (mode == "all" || mode == "best-iteration" || mode == "best-so-far" || mode == "rank") {
+    if (isPheromoneMode(mode)) {
         pheromoneMode_ = mode;
     }
 }
@@ -413,3 +1565,29 @@ void AntColony::setPheromoneMode(const std::string& mode) {
 void AntColony::setRankSize(int rankSize) {
     rankSize_ = rankSize;
 }
+
+void AntColony::setMMASRestartIterations(int iterations) {
+    mmasRestartIterations_ = std::max(0, iterations);
+}
+
+void AntColony::setQ0(double q0) {
+    q0_ = std::min(1.0, std::max(0.0, q0));
+}
+
+void AntColony::setXi(double xi) {
+    xi_ = std::min(1.0, std::max(0.0, xi));
+}
+
+void AntColony::setBackend(const std::string& backend) {
+    if (backend == "cpu" || backend == "cuda") {
+        backend_ = backend;
+    }
+}
+
+bool AntColony::isBackendAvailable(const std::string& backend) {
+    return backend == "cpu" || (backend == "cuda" && GpuColony::isAvailable());
+}
+
+void AntColony::setCandidateListSize(int candidateListSize) {
+    candidateListSize_ = std::max(0, candidateListSize);
+}
@@ -15,10 +15,7 @@ City::City(int id, double x, double y) : id_(id), x_(x), y_(y) {}
  * Time complexity: O(1)
  */
 double City::distanceTo(const City& other) const {
-    double dx = x_ - other.x_;  // Calculate horizontal difference
-    double dy = y_ - other.y_;  // Calculate vertical difference
-    // Apply Pythagorean theorem: distance = sqrt(dx^2 + dy^2)
-    return std::sqrt(dx * dx + dy * dy);
+    return distanceTo(other, metric::Euclidean{});
 }
 
 // Simple getter - returns city ID
@@ -0,0 +1,35 @@
+// Host-only GpuColony: no device implementation is part of this tree yet,
+// so the "cuda" backend reports itself unavailable
+
+#include "GpuColony.h"
+#include <stdexcept>
+
+struct GpuColony::Device {};
+
+bool GpuColony::isAvailable() {
+    return false;
+}
+
+std::string GpuColony::deviceName() {
+    return "";
+}
+
+GpuColony::GpuColony(const Graph&, int, const AlignedVector<double>&, double) {
+    throw std::runtime_error("CUDA backend not available in this build");
+}
+
+GpuColony::~GpuColony() = default;
+
+void GpuColony::uploadTrails(const PheromoneMatrix&) {}
+
+void GpuColony::downloadTrails(PheromoneMatrix&) const {}
+
+void GpuColony::resetTrails(double) {}
+
+void GpuColony::constructTours(const std::vector<int>&, const std::vector<std::uint64_t>&,
+                               std::vector<double>&) {}
+
+void GpuColony::copyTour(int, std::vector<int>&) const {}
+
+void GpuColony::updateTrails(double, const std::vector<double>&, const std::vector<HostDeposit>&,
+                             double, double) {}
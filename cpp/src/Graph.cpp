@@ -4,7 +4,13 @@
  */
 
 #include "Graph.h"
+#include "MappedFile.h"
+#include "NumaPlacement.h"
+#include <algorithm>
+#include <cmath>
 #include <limits>
+#include <numeric>
+#include <utility>
 
 /**
  * Main constructor - builds the graph and precomputes all distances.
@@ -12,9 +18,34 @@
  */
 Graph::Graph(const std::vector<City>& cities)
     : cities_(cities), numCities_(cities.size()) {
+    buildCoordinates();
     buildDistanceMatrix();
 }
 
+/**
+ * Constructor with an explicit distance storage layout and metric.
+ */
+Graph::Graph(const std::vector<City>& cities, DistanceStorage storage, DistanceMetric metric)
+    : cities_(cities), numCities_(cities.size()), storage_(storage), metric_(metric) {
+    buildCoordinates();
+    buildDistanceMatrix();
+}
+
+/**
+ * Constructor for EXPLICIT instances: distances come from the caller, not
+ * from the coordinates.
+ */
+Graph::Graph(const std::vector<City>& cities, std::vector<double> upperTriangle,
+             DistanceStorage storage)
+    : cities_(cities), numCities_(cities.size()), storage_(storage),
+      metric_(DistanceMetric::EXPLICIT) {
+    if (storage_ == DistanceStorage::ON_THE_FLY) {
+        storage_ = DistanceStorage::TRIANGULAR_DOUBLE;
+    }
+    buildCoordinates();
+    storeExplicitDistances(upperTriangle);
+}
+
 /**
  * Default constructor for empty graph.
  * Useful when file loading fails or for initialization before loading.
@@ -22,7 +53,73 @@ Graph::Graph(const std::vector<City>& cities)
 Graph::Graph() : numCities_(0) {}
 
 /**
- * Build the distance matrix by computing Euclidean distances between
+ * Copy constructor. Views into the other graph's own buffers are moved to
+ * the copied buffers; views into a cache mapping keep pointing there.
+ */
+Graph::Graph(const Graph& other)
+    : cities_(other.cities_), numCities_(other.numCities_), storage_(other.storage_),
+      metric_(other.metric_), coordX_(other.coordX_), coordY_(other.coordY_),
+      rowStride_(other.rowStride_), distances_(other.distances_),
+      distancesFloat_(other.distancesFloat_), neighborLists_(other.neighborLists_),
+      neighborListSize_(other.neighborListSize_), distanceData_(other.distanceData_),
+      distanceFloatData_(other.distanceFloatData_), neighborData_(other.neighborData_),
+      neighborListStride_(other.neighborListStride_), mapping_(other.mapping_),
+      mappedDistanceBytes_(other.mappedDistanceBytes_), cachedNeighbors_(other.cachedNeighbors_),
+      cachedNeighborStride_(other.cachedNeighborStride_),
+      cachedNearestNeighborLength_(other.cachedNearestNeighborLength_) {
+    if (other.distanceData_ == other.distances_.data()) {
+        distanceData_ = distances_.data();
+    }
+    if (other.distanceFloatData_ == other.distancesFloat_.data()) {
+        distanceFloatData_ = distancesFloat_.data();
+    }
+    if (other.neighborData_ == other.neighborLists_.data()) {
+        neighborData_ = neighborLists_.data();
+    }
+}
+
+Graph& Graph::operator=(const Graph& other) {
+    if (this != &other) {
+        Graph copy(other);
+        *this = std::move(copy);
+    }
+    return *this;
+}
+
+// Lookups go through the owned buffers (after building or filling them)
+void Graph::bindOwnedStorage() {
+    distanceData_ = distances_.empty() ? nullptr : distances_.data();
+    distanceFloatData_ = distancesFloat_.empty() ? nullptr : distancesFloat_.data();
+}
+
+/**
+ * Copy coordinates into flat arrays so computeDistance() does not have to
+ * go through City objects. For GEO the DDD.MM values are converted to
+ * radians as specified by TSPLIB (integer degrees, then minutes).
+ */
+void Graph::buildCoordinates() {
+    const double PI = 3.141592;  // Value prescribed by TSPLIB
+    auto toRadians = [PI](double value) {
+        double degrees = static_cast<int>(value);
+        double minutes = value - degrees;
+        return PI * (degrees + 5.0 * minutes / 3.0) / 180.0;
+    };
+
+    coordX_.resize(numCities_);
+    coordY_.resize(numCities_);
+    for (int i = 0; i < numCities_; ++i) {
+        if (metric_ == DistanceMetric::GEO) {
+            coordX_[i] = toRadians(cities_[i].getX());
+            coordY_[i] = toRadians(cities_[i].getY());
+        } else {
+            coordX_[i] = cities_[i].getX();
+            coordY_[i] = cities_[i].getY();
+        }
+    }
+}
+
+/**
+ * Build the distance matrix by computing distances between
  * all pairs of cities. This is done once at construction to enable
  * O(1) distance lookups during the ACO algorithm.
  *
@@ -34,20 +131,130 @@ Graph::Graph() : numCities_(0) {}
  * Space complexity: O(n²) for the distance matrix
  */
 void Graph::buildDistanceMatrix() {
-    // Allocate n×n matrix initialized with zeros
-    distanceMatrix_.resize(numCities_, std::vector<double>(numCities_, 0.0));
+    // Nothing to precompute: every lookup goes through computeDistance()
+    if (storage_ == DistanceStorage::ON_THE_FLY) {
+        return;
+    }
+
+    const size_t n = static_cast<size_t>(numCities_);
+    const bool triangular = storage_ == DistanceStorage::TRIANGULAR_DOUBLE ||
+                            storage_ == DistanceStorage::TRIANGULAR_FLOAT;
+    const bool useFloat = storage_ == DistanceStorage::FULL_FLOAT ||
+                          storage_ == DistanceStorage::TRIANGULAR_FLOAT;
+
+    // Allocate one contiguous buffer and zero it in parallel, so its pages
+    // are spread over the NUMA nodes of the compute threads (diagonal
+    // entries of the full layouts stay 0.0)
+    rowStride_ = useFloat ? alignedRowStride<float>(n) : alignedRowStride<double>(n);
+    size_t size = triangular ? n * (n > 0 ? n - 1 : 0) / 2 : n * rowStride_;
+    allocateDistances(size, useFloat, triangular);
 
-    // Calculate distances between all pairs of cities
-    // Note: diagonal (i==i) remains 0.0 (distance from city to itself)
+    // Dispatch on layout and metric once: the pair loop is compiled for this
+    // formula and element type, with no switch per distance
+    if (useFloat) {
+        fillDistanceMatrix(distancesFloat_.data(), triangular);
+    } else {
+        fillDistanceMatrix(distances_.data(), triangular);
+    }
+    bindOwnedStorage();
+}
+
+void Graph::allocateDistances(size_t size, bool useFloat, bool triangular) {
+    // Full layouts by static row blocks, like the heuristic info computed
+    // from them; triangular rows differ in length, so those by elements
+    const size_t n = static_cast<size_t>(numCities_);
+    if (useFloat) {
+        distancesFloat_.clear();
+        distancesFloat_.resize(size);
+        if (triangular) {
+            numa::firstTouch(distancesFloat_.data(), size, 0.0f);
+        } else {
+            numa::firstTouchRows(distancesFloat_.data(), n, rowStride_, 0.0f);
+        }
+    } else {
+        distances_.clear();
+        distances_.resize(size);
+        if (triangular) {
+            numa::firstTouch(distances_.data(), size, 0.0);
+        } else {
+            numa::firstTouchRows(distances_.data(), n, rowStride_, 0.0);
+        }
+    }
+}
+
+template <typename T>
+void Graph::fillDistanceMatrix(T* data, bool triangular) const {
+    dispatchMetric(metric_, [&](auto metric) {
+        const int n = numCities_;
+        const size_t stride = rowStride_;
+
+        // Distances between all pairs of cities, upper triangle only. Every
+        // (i, j) owns its slots, so rows can be computed by different threads
+        // (later rows are shorter, hence the dynamic schedule)
+        #ifdef _OPENMP
+        #pragma omp parallel for schedule(dynamic, 16)
+        #endif
+        for (int i = 0; i < n; ++i) {
+            // Row i of the upper triangle is contiguous in both layouts
+            T* row = triangular ? data + triangularIndex(i, i + 1)
+                                : data + static_cast<size_t>(i) * stride + (i + 1);
+            for (int j = i + 1; j < n; ++j) {
+                row[j - i - 1] = static_cast<T>(computeDistance(metric, i, j));
+            }
+            if (!triangular) {
+                // Mirror into column i for the symmetric full matrix
+                for (int j = i + 1; j < n; ++j) {
+                    data[static_cast<size_t>(j) * stride + i] = row[j - i - 1];
+                }
+            }
+        }
+    });
+}
+
+void Graph::storeExplicitDistances(std::vector<double>& upperTriangle) {
+    const size_t n = static_cast<size_t>(numCities_);
+    upperTriangle.resize(n * (n > 0 ? n - 1 : 0) / 2, 0.0);
+
+    // The given buffer already has the triangular double layout
+    if (storage_ == DistanceStorage::TRIANGULAR_DOUBLE) {
+        distances_.assign(upperTriangle.begin(), upperTriangle.end());
+        upperTriangle.clear();
+        upperTriangle.shrink_to_fit();
+        bindOwnedStorage();
+        return;
+    }
+
+    const bool triangular = storage_ == DistanceStorage::TRIANGULAR_FLOAT;
+    const bool useFloat = storage_ == DistanceStorage::FULL_FLOAT || triangular;
+    rowStride_ = useFloat ? alignedRowStride<float>(n) : alignedRowStride<double>(n);
+    size_t size = triangular ? upperTriangle.size() : n * rowStride_;
+    allocateDistances(size, useFloat, triangular);
+
+    #ifdef _OPENMP
+    #pragma omp parallel for schedule(dynamic, 16)
+    #endif
     for (int i = 0; i < numCities_; ++i) {
         for (int j = i + 1; j < numCities_; ++j) {
-            // Compute distance once using City::distanceTo()
-            double distance = cities_[i].distanceTo(cities_[j]);
-            // Store in both positions for symmetric matrix
-            distanceMatrix_[i][j] = distance;
-            distanceMatrix_[j][i] = distance;
+            size_t source = triangularIndex(i, j);
+            double distance = upperTriangle[source];
+            if (triangular) {
+                distancesFloat_[source] = static_cast<float>(distance);
+            } else if (useFloat) {
+                distancesFloat_[static_cast<size_t>(i) * rowStride_ + j] = static_cast<float>(distance);
+                distancesFloat_[static_cast<size_t>(j) * rowStride_ + i] = static_cast<float>(distance);
+            } else {
+                distances_[static_cast<size_t>(i) * rowStride_ + j] = distance;
+                distances_[static_cast<size_t>(j) * rowStride_ + i] = distance;
+            }
         }
     }
+    bindOwnedStorage();
+}
+
+// Size of the distance buffer in bytes
+size_t Graph::getDistanceMemoryBytes() const {
+    return distances_.size() * sizeof(double) + distancesFloat_.size() * sizeof(float) +
+           mappedDistanceBytes_;
 }
 
 /**
@@ -61,7 +268,7 @@ double Graph::getDistance(int cityA, int cityB) const {
     if (cityA < 0 || cityA >= numCities_ || cityB < 0 || cityB >= numCities_) {
         return 0.0; // Basic error handling - return 0 for invalid indices
     }
-    return distanceMatrix_[cityA][cityB];
+    return getDistanceUnchecked(cityA, cityB);
 }
 
 // Return total number of cities in the problem
@@ -97,45 +304,310 @@ bool Graph::isValid() const {
  * @return The total tour length using nearest neighbor heuristic
  */
 double Graph::nearestNeighborTourLength(int startCity) const {
+    // Stored with the cache (computed when it was written)
+    if (startCity == 0 && cachedNearestNeighborLength_ >= 0.0) {
+        return cachedNearestNeighborLength_;
+    }
+    return nearestNeighborTourLength(startCity, neighborData_, neighborListStride_, neighborListSize_);
+}
+
+std::vector<int> Graph::nearestNeighborTour(int startCity) const {
+    std::vector<int> sequence;
+    nearestNeighborTourLength(startCity, neighborData_, neighborListStride_, neighborListSize_, &sequence);
+    return sequence;
+}
+
+double Graph::nearestNeighborTourLength(int startCity, const int* lists, int stride, int size,
+                                        std::vector<int>* sequence) const {
+    if (sequence) {
+        sequence->clear();
+        if (numCities_ == 1) {
+            sequence->push_back(0);
+        }
+    }
     if (numCities_ <= 1) {
         return 0.0;
     }
 
+    // Unvisited cities kept compact (swap-remove) so fallback scans shrink
+    std::vector<int> unvisited(numCities_);
+    std::vector<int> position(numCities_);
+    std::iota(unvisited.begin(), unvisited.end(), 0);
+    std::iota(position.begin(), position.end(), 0);
     std::vector<bool> visited(numCities_, false);
+
+    auto markVisited = [&](int city) {
+        if (sequence) {
+            sequence->push_back(city);
+        }
+        visited[city] = true;
+        int last = unvisited.back();
+        unvisited[position[city]] = last;
+        position[last] = position[city];
+        unvisited.pop_back();
+    };
+
     int currentCity = startCity;
-    visited[currentCity] = true;
+    markVisited(currentCity);
     double totalLength = 0.0;
-    int citiesVisited = 1;
 
     // Build tour by always selecting nearest unvisited city
-    while (citiesVisited < numCities_) {
+    while (!unvisited.empty()) {
         double minDistance = std::numeric_limits<double>::max();
         int nearestCity = -1;
 
-        // Find the nearest unvisited city
-        for (int i = 0; i < numCities_; ++i) {
-            if (!visited[i]) {
-                double distance = getDistance(currentCity, i);
+        // Neighbor lists are sorted: the first unvisited entry is the nearest
+        const int* neighbors = (size > 0) ? lists + static_cast<size_t>(currentCity) * stride : nullptr;
+        for (int r = 0; r < size; ++r) {
+            if (!visited[neighbors[r]]) {
+                nearestCity = neighbors[r];
+                minDistance = getDistanceUnchecked(currentCity, nearestCity);
+                break;
+            }
+        }
+
+        // Otherwise find the nearest unvisited city by a full scan
+        if (nearestCity == -1) {
+            for (int city : unvisited) {
+                double distance = getDistanceUnchecked(currentCity, city);
                 if (distance < minDistance) {
                     minDistance = distance;
-                    nearestCity = i;
+                    nearestCity = city;
                 }
             }
         }
 
         // Move to nearest city
-        if (nearestCity != -1) {
-            totalLength += minDistance;
-            currentCity = nearestCity;
-            visited[currentCity] = true;
-            citiesVisited++;
-        } else {
-            break; // Should not happen if graph is valid
-        }
+        totalLength += minDistance;
+        currentCity = nearestCity;
+        markVisited(currentCity);
     }
 
     // Add distance to return to start city
-    totalLength += getDistance(currentCity, startCity);
+    totalLength += getDistanceUnchecked(currentCity, startCity);
 
     return totalLength;
 }
+
+// Precompute and store the k-nearest-neighbor lists of every city
+void Graph::buildNeighborLists(int k) {
+    neighborListSize_ = std::max(0, std::min(k, numCities_ - 1));
+
+    // Cached lists are sorted, so their first k entries are the k nearest
+    if (neighborListSize_ > 0 && neighborListSize_ <= cachedNeighborStride_) {
+        neighborLists_.clear();
+        neighborData_ = cachedNeighbors_;
+        neighborListStride_ = cachedNeighborStride_;
+        return;
+    }
+
+    neighborLists_ = computeNeighborLists(k);
+    neighborData_ = neighborLists_.empty() ? nullptr : neighborLists_.data();
+    neighborListStride_ = neighborListSize_;
+}
+
+/**
+ * Build the k-nearest-neighbor list of every city.
+ *
+ * Planar metrics use the grid spatial index. For GEO and EXPLICIT, the remaining n-1
+ * cities are partially sorted by distance so that the k closest come first
+ * (in increasing order). Rows are independent, so the outer loop is
+ * parallelized when OpenMP is available.
+ *
+ * Time complexity: O(n·k log k) expected (planar), O(n² log k) (GEO, EXPLICIT)
+ * Space complexity: O(n·k) for the neighbor lists
+ */
+std::vector<int> Graph::computeNeighborLists(int k) const {
+    int listSize = std::max(0, std::min(k, numCities_ - 1));
+
+    if (listSize == 0) {
+        return std::vector<int>();
+    }
+    if (listSize <= cachedNeighborStride_) {
+        std::vector<int> lists(static_cast<size_t>(numCities_) * listSize);
+        for (int i = 0; i < numCities_; ++i) {
+            const int* row = cachedNeighbors_ + static_cast<size_t>(i) * cachedNeighborStride_;
+            std::copy(row, row + listSize, lists.begin() + static_cast<size_t>(i) * listSize);
+        }
+        return lists;
+    }
+    if (metric_ != DistanceMetric::GEO && metric_ != DistanceMetric::EXPLICIT) {
+        return computeNeighborListsSpatial(listSize);
+    }
+
+    std::vector<int> lists(static_cast<size_t>(numCities_) * listSize, 0);
+
+    #ifdef _OPENMP
+    #pragma omp parallel
+    #endif
+    {
+        // Per-thread scratch buffer of (distance, city) pairs
+        std::vector<std::pair<double, int>> candidates;
+        candidates.reserve(numCities_ - 1);
+
+        #ifdef _OPENMP
+        #pragma omp for schedule(static)
+        #endif
+        for (int i = 0; i < numCities_; ++i) {
+            candidates.clear();
+            for (int j = 0; j < numCities_; ++j) {
+                if (j != i) {
+                    candidates.emplace_back(getDistanceUnchecked(i, j), j);
+                }
+            }
+
+            // Only the k closest need to be ordered
+            std::partial_sort(candidates.begin(), candidates.begin() + listSize,
+                              candidates.end());
+
+            int* row = &lists[static_cast<size_t>(i) * listSize];
+            for (int r = 0; r < listSize; ++r) {
+                row[r] = candidates[r].second;
+            }
+        }
+    }
+
+    return lists;
+}
+
+/**
+ * k-nearest-neighbor search on a uniform grid.
+ *
+ * Cities are bucketed into square cells holding about two cities each.
+ * Each query scans rings of cells around its own cell, keeping the k best
+ * (squared Euclidean distance, city) pairs in a max-heap, and stops once
+ * the k-th best is closer than anything in the unscanned rings can be.
+ * All planar metrics are monotone in the Euclidean distance, so this
+ * ordering is also valid for EUC_2D, CEIL_2D and ATT.
+ *
+ * Time complexity: O(n·k log k) expected for reasonably spread points
+ * Space complexity: O(n) for the grid plus O(n·k) for the lists
+ */
+std::vector<int> Graph::computeNeighborListsSpatial(int listSize) const {
+    const int n = numCities_;
+    std::vector<int> lists(static_cast<size_t>(n) * listSize, 0);
+
+    // Bounding box of all cities
+    auto xRange = std::minmax_element(coordX_.begin(), coordX_.end());
+    auto yRange = std::minmax_element(coordY_.begin(), coordY_.end());
+    const double minX = *xRange.first;
+    const double minY = *yRange.first;
+    const double width = *xRange.second - minX;
+    const double height = *yRange.second - minY;
+
+    // ~2 cities per cell; never more cells along one axis than cities
+    double cellSize = std::sqrt(2.0 * width * height / n);
+    cellSize = std::max(cellSize, std::max(width, height) / n);
+    if (!(cellSize > 0.0)) {
+        cellSize = 1.0;  // All cities share one location
+    }
+    const int gridX = static_cast<int>(width / cellSize) + 1;
+    const int gridY = static_cast<int>(height / cellSize) + 1;
+
+    auto cellOf = [&](int city, int& cx, int& cy) {
+        cx = std::min(gridX - 1, static_cast<int>((coordX_[city] - minX) / cellSize));
+        cy = std::min(gridY - 1, static_cast<int>((coordY_[city] - minY) / cellSize));
+    };
+
+    // Bucket cities by cell (counting sort into CSR arrays)
+    std::vector<int> cellStart(static_cast<size_t>(gridX) * gridY + 1, 0);
+    std::vector<int> cellCities(n);
+    std::vector<int> cityCell(n);
+    for (int i = 0; i < n; ++i) {
+        int cx, cy;
+        cellOf(i, cx, cy);
+        cityCell[i] = cy * gridX + cx;
+        cellStart[cityCell[i] + 1]++;
+    }
+    std::partial_sum(cellStart.begin(), cellStart.end(), cellStart.begin());
+    {
+        std::vector<int> fill(cellStart.begin(), cellStart.end() - 1);
+        for (int i = 0; i < n; ++i) {
+            cellCities[fill[cityCell[i]]++] = i;
+        }
+    }
+
+    #ifdef _OPENMP
+    #pragma omp parallel
+    #endif
+    {
+        // Per-thread max-heap of the best (squared distance, city) pairs
+        std::vector<std::pair<double, int>> heap;
+        heap.reserve(listSize + 1);
+
+        #ifdef _OPENMP
+        #pragma omp for schedule(dynamic, 64)
+        #endif
+        for (int i = 0; i < n; ++i) {
+            heap.clear();
+            int cx, cy;
+            cellOf(i, cx, cy);
+            const int maxRing = std::max(std::max(cx, gridX - 1 - cx),
+                                         std::max(cy, gridY - 1 - cy));
+
+            auto scanCell = [&](int x, int y) {
+                if (x < 0 || x >= gridX || y < 0 || y >= gridY) {
+                    return;
+                }
+                int cell = y * gridX + x;
+                for (int c = cellStart[cell]; c < cellStart[cell + 1]; ++c) {
+                    int j = cellCities[c];
+                    if (j == i) {
+                        continue;
+                    }
+                    double dx = coordX_[i] - coordX_[j];
+                    double dy = coordY_[i] - coordY_[j];
+                    std::pair<double, int> entry(dx * dx + dy * dy, j);
+                    if (static_cast<int>(heap.size()) < listSize) {
+                        heap.push_back(entry);
+                        std::push_heap(heap.begin(), heap.end());
+                    } else if (entry < heap.front()) {
+                        std::pop_heap(heap.begin(), heap.end());
+                        heap.back() = entry;
+                        std::push_heap(heap.begin(), heap.end());
+                    }
+                }
+            };
+
+            for (int ring = 0; ring <= maxRing; ++ring) {
+                if (ring == 0) {
+                    scanCell(cx, cy);
+                } else {
+                    for (int x = cx - ring; x <= cx + ring; ++x) {
+                        scanCell(x, cy - ring);
+                        scanCell(x, cy + ring);
+                    }
+                    for (int y = cy - ring + 1; y <= cy + ring - 1; ++y) {
+                        scanCell(cx - ring, y);
+                        scanCell(cx + ring, y);
+                    }
+                }
+
+                // Cities outside the scanned rings are at least ring*cellSize away
+                double reach = ring * cellSize;
+                if (static_cast<int>(heap.size()) == listSize &&
+                    heap.front().first <= reach * reach) {
+                    break;
+                }
+            }
+
+            std::sort_heap(heap.begin(), heap.end());
+            int* row = &lists[static_cast<size_t>(i) * listSize];
+            for (int r = 0; r < listSize; ++r) {
+                row[r] = heap[r].second;
+            }
+        }
+    }
+
+    return lists;
+}
+
+// Return pointer to the neighbor list of a city (no bounds checking)
+const int* Graph::getNeighbors(int city) const {
+    return neighborData_ + static_cast<size_t>(city) * neighborListStride_;
+}
+
+// Return number of neighbors stored per city
+int Graph::getNeighborListSize() const {
+    return neighborListSize_;
+}
@@ -0,0 +1,342 @@
+/**
+ * @file GraphCache.cpp
+ * @brief Implementation of the binary graph cache
+ */
+
+#include "GraphCache.h"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <system_error>
+#include <vector>
+#include "MappedFile.h"
+
+namespace {
+
+namespace fs = std::filesystem;
+
+constexpr char MAGIC[8] = {'A', 'C', 'O', 'G', 'R', 'A', 'P', 'H'};
+constexpr std::uint32_t BYTE_ORDER_MARK = 0x01020304u;  // Reads differently on other endianness
+constexpr std::uint64_t SECTION_ALIGNMENT = 64;         // Cache line (and AlignedVector) alignment
+
+// Fixed-size header at offset 0 (all sections are located through it)
+struct CacheHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t byteOrder;
+    std::uint32_t numCities;
+    std::uint32_t metric;
+    std::uint32_t storage;
+    std::int32_t neighborListSize;
+    std::uint64_t rowStride;
+    double nearestNeighborLength;
+    std::uint64_t sourceSize;
+    std::int64_t sourceModified;
+    std::uint64_t citiesOffset;
+    std::uint64_t distancesOffset;
+    std::uint64_t distancesBytes;
+    std::uint64_t neighborsOffset;
+    std::uint64_t fileBytes;
+};
+
+struct CacheCity {
+    double x;
+    double y;
+    std::int64_t id;
+};
+
+std::uint64_t alignUp(std::uint64_t offset) {
+    return (offset + SECTION_ALIGNMENT - 1) / SECTION_ALIGNMENT * SECTION_ALIGNMENT;
+}
+
+// Size and modification time identify the version of the source file
+bool sourceStamp(const std::string& path, std::uint64_t& size, std::int64_t& modified) {
+    std::error_code error;
+    auto fileSize = fs::file_size(path, error);
+    if (error) {
+        return false;
+    }
+    auto time = fs::last_write_time(path, error);
+    if (error) {
+        return false;
+    }
+    size = static_cast<std::uint64_t>(fileSize);
+    modified = static_cast<std::int64_t>(time.time_since_epoch().count());
+    return true;
+}
+
+// Same names as the --distance-storage option
+const char* storageName(DistanceStorage storage) {
+    switch (storage) {
+        case DistanceStorage::FULL_DOUBLE:
+            return "full";
+        case DistanceStorage::FULL_FLOAT:
+            return "full-float";
+        case DistanceStorage::TRIANGULAR_DOUBLE:
+            return "triangular";
+        case DistanceStorage::TRIANGULAR_FLOAT:
+            return "triangular-float";
+        case DistanceStorage::ON_THE_FLY:
+            return "on-the-fly";
+    }
+    return "unknown";
+}
+
+// FNV-1a, stable across platforms and standard libraries
+std::uint64_t pathHash(const std::string& path) {
+    std::uint64_t hash = 14695981039346656037ull;
+    for (unsigned char c : path) {
+        hash ^= c;
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+std::string toHex(std::uint64_t value) {
+    const char* digits = "0123456789abcdef";
+    std::string text(16, '0');
+    for (int i = 15; i >= 0; --i) {
+        text[i] = digits[value & 0xF];
+        value >>= 4;
+    }
+    return text;
+}
+
+// Expected size of the distance section for a layout
+std::uint64_t distanceBytes(DistanceStorage storage, std::uint64_t numCities, std::uint64_t rowStride) {
+    std::uint64_t triangle = numCities * (numCities - 1) / 2;
+    switch (storage) {
+        case DistanceStorage::FULL_DOUBLE:
+            return numCities * rowStride * sizeof(double);
+        case DistanceStorage::FULL_FLOAT:
+            return numCities * rowStride * sizeof(float);
+        case DistanceStorage::TRIANGULAR_DOUBLE:
+            return triangle * sizeof(double);
+        case DistanceStorage::TRIANGULAR_FLOAT:
+            return triangle * sizeof(float);
+        case DistanceStorage::ON_THE_FLY:
+            return 0;
+    }
+    return 0;
+}
+
+}  // namespace
+
+std::string GraphCache::cachePath(const std::string& sourcePath, DistanceStorage storage,
+                                  const std::string& cacheDirectory) {
+    std::string suffix = std::string(".") + storageName(storage) + ".acocache";
+    if (cacheDirectory.empty()) {
+        return sourcePath + suffix;
+    }
+
+    std::error_code error;
+    fs::path absolute = fs::absolute(sourcePath, error);
+    std::string key = error ? sourcePath : absolute.lexically_normal().string();
+    std::string name = fs::path(sourcePath).filename().string() + "-" + toHex(pathHash(key)) + suffix;
+    return (fs::path(cacheDirectory) / name).string();
+}
+
+bool GraphCache::write(const Graph& graph, const std::string& cachePath,
+                       const std::string& sourcePath, int neighbors) {
+    const int numCities = graph.getNumCities();
+    if (numCities <= 0) {
+        return false;
+    }
+
+    CacheHeader header;
+    std::memset(&header, 0, sizeof(header));
+    if (!sourceStamp(sourcePath, header.sourceSize, header.sourceModified)) {
+        return false;
+    }
+
+    // Neighbor lists: the graph's own if long enough, otherwise computed
+    int k = std::min(std::max(std::max(0, neighbors), graph.getNeighborListSize()), numCities - 1);
+    std::vector<int> lists;
+    if (k > 0 && graph.getNeighborListSize() >= k) {
+        lists.resize(static_cast<std::size_t>(numCities) * k);
+        for (int i = 0; i < numCities; ++i) {
+            const int* row = graph.getNeighbors(i);
+            std::copy(row, row + k, lists.begin() + static_cast<std::size_t>(i) * k);
+        }
+    } else if (k > 0) {
+        lists = graph.computeNeighborLists(k);
+    }
+
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = FORMAT_VERSION;
+    header.byteOrder = BYTE_ORDER_MARK;
+    header.numCities = static_cast<std::uint32_t>(numCities);
+    header.metric = static_cast<std::uint32_t>(graph.getDistanceMetric());
+    header.storage = static_cast<std::uint32_t>(graph.getDistanceStorage());
+    header.neighborListSize = k;
+    header.rowStride = graph.rowStride_;
+    header.nearestNeighborLength = graph.nearestNeighborTourLength(0, lists.data(), k, k);
+    header.citiesOffset = alignUp(sizeof(CacheHeader));
+    header.distancesOffset = alignUp(header.citiesOffset + numCities * sizeof(CacheCity));
+    header.distancesBytes = graph.getDistanceMemoryBytes();
+    header.neighborsOffset = alignUp(header.distancesOffset + header.distancesBytes);
+    header.fileBytes = header.neighborsOffset + lists.size() * sizeof(int);
+
+    std::error_code error;
+    fs::path target(cachePath);
+    if (target.has_parent_path()) {
+        fs::create_directories(target.parent_path(), error);
+    }
+
+    // Unique temporary name in the target directory, renamed into place at the end
+    std::random_device device;
+    std::string temporary = cachePath + ".tmp-" + toHex((std::uint64_t(device()) << 32) | device());
+    {
+        std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+        if (!out.is_open()) {
+            return false;
+        }
+
+        std::uint64_t written = 0;
+        auto put = [&](const void* data, std::uint64_t bytes) {
+            out.write(static_cast<const char*>(data), static_cast<std::streamsize>(bytes));
+            written += bytes;
+        };
+        auto padTo = [&](std::uint64_t offset) {
+            static const char zeros[SECTION_ALIGNMENT] = {};
+            put(zeros, offset - written);
+        };
+
+        put(&header, sizeof(header));
+
+        padTo(header.citiesOffset);
+        std::vector<CacheCity> cities(numCities);
+        for (int i = 0; i < numCities; ++i) {
+            const City& city = graph.getCity(i);
+            cities[i] = CacheCity{city.getX(), city.getY(), city.getId()};
+        }
+        put(cities.data(), cities.size() * sizeof(CacheCity));
+
+        padTo(header.distancesOffset);
+        if (graph.distanceData_ != nullptr) {
+            put(graph.distanceData_, header.distancesBytes);
+        } else if (graph.distanceFloatData_ != nullptr) {
+            put(graph.distanceFloatData_, header.distancesBytes);
+        }
+
+        padTo(header.neighborsOffset);
+        put(lists.data(), lists.size() * sizeof(int));
+
+        out.close();
+        if (!out) {
+            fs::remove(temporary, error);
+            return false;
+        }
+    }
+
+    fs::rename(temporary, cachePath, error);
+    if (error) {
+        fs::remove(temporary, error);
+        return false;
+    }
+    return true;
+}
+
+Graph GraphCache::load(const std::string& cachePath, const std::string& sourcePath,
+                       DistanceStorage storage) {
+    std::error_code error;
+    if (!fs::exists(cachePath, error)) {
+        return Graph();
+    }
+
+    auto file = std::make_shared<const MappedFile>(cachePath);
+    // The sections are read in place, so the base must keep their alignment
+    // (always true for a mapping; the copy fallback may not be aligned)
+    if (!file->isOpen() || file->size() < sizeof(CacheHeader) ||
+        reinterpret_cast<std::uintptr_t>(file->data()) % SECTION_ALIGNMENT != 0) {
+        return Graph();
+    }
+
+    CacheHeader header;
+    std::memcpy(&header, file->data(), sizeof(header));
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != FORMAT_VERSION ||
+        header.byteOrder != BYTE_ORDER_MARK || header.fileBytes != file->size()) {
+        return Graph();
+    }
+
+    // Layout: EXPLICIT graphs keep a triangle when on-the-fly storage is requested
+    if (header.metric > static_cast<std::uint32_t>(DistanceMetric::EXPLICIT) ||
+        header.storage > static_cast<std::uint32_t>(DistanceStorage::ON_THE_FLY)) {
+        return Graph();
+    }
+    auto metric = static_cast<DistanceMetric>(header.metric);
+    auto cachedStorage = static_cast<DistanceStorage>(header.storage);
+    bool explicitTriangle = storage == DistanceStorage::ON_THE_FLY &&
+                            metric == DistanceMetric::EXPLICIT &&
+                            cachedStorage == DistanceStorage::TRIANGULAR_DOUBLE;
+    if (cachedStorage != storage && !explicitTriangle) {
+        return Graph();
+    }
+
+    // Freshness: the source must be unchanged since the cache was written
+    if (!sourcePath.empty()) {
+        std::uint64_t size;
+        std::int64_t modified;
+        if (!sourceStamp(sourcePath, size, modified) || size != header.sourceSize ||
+            modified != header.sourceModified) {
+            return Graph();
+        }
+    }
+
+    // Section bounds
+    const std::uint64_t n = header.numCities;
+    const bool full = cachedStorage == DistanceStorage::FULL_DOUBLE ||
+                      cachedStorage == DistanceStorage::FULL_FLOAT;
+    const std::int64_t k = header.neighborListSize;
+    if (n == 0 || k < 0 || static_cast<std::uint64_t>(k) > n - 1 ||
+        (full && header.rowStride < n) ||
+        header.distancesBytes != distanceBytes(cachedStorage, n, header.rowStride) ||
+        header.citiesOffset % SECTION_ALIGNMENT != 0 || header.distancesOffset % SECTION_ALIGNMENT != 0 ||
+        header.neighborsOffset % SECTION_ALIGNMENT != 0 ||
+        header.citiesOffset + n * sizeof(CacheCity) > header.distancesOffset ||
+        header.distancesOffset + header.distancesBytes > header.neighborsOffset ||
+        header.neighborsOffset + n * k * sizeof(int) != header.fileBytes) {
+        return Graph();
+    }
+
+    const char* base = file->data();
+    const int* lists = (k > 0) ? reinterpret_cast<const int*>(base + header.neighborsOffset) : nullptr;
+    for (std::uint64_t e = 0; e < n * k; ++e) {
+        if (lists[e] < 0 || static_cast<std::uint64_t>(lists[e]) >= n) {
+            return Graph();
+        }
+    }
+
+    Graph graph;
+    graph.cities_.reserve(n);
+    for (std::uint64_t i = 0; i < n; ++i) {
+        CacheCity city;
+        std::memcpy(&city, base + header.citiesOffset + i * sizeof(CacheCity), sizeof(city));
+        graph.cities_.push_back(City(static_cast<int>(city.id), city.x, city.y));
+    }
+    graph.numCities_ = static_cast<int>(n);
+    graph.storage_ = cachedStorage;
+    graph.metric_ = metric;
+    graph.buildCoordinates();
+
+    // Matrix and lists stay in the mapping
+    graph.rowStride_ = header.rowStride;
+    if (header.distancesBytes > 0) {
+        const char* distances = base + header.distancesOffset;
+        if (cachedStorage == DistanceStorage::FULL_FLOAT ||
+            cachedStorage == DistanceStorage::TRIANGULAR_FLOAT) {
+            graph.distanceFloatData_ = reinterpret_cast<const float*>(distances);
+        } else {
+            graph.distanceData_ = reinterpret_cast<const double*>(distances);
+        }
+    }
+    graph.mappedDistanceBytes_ = header.distancesBytes;
+    graph.cachedNeighbors_ = lists;
+    graph.cachedNeighborStride_ = static_cast<int>(k);
+    graph.cachedNearestNeighborLength_ = header.nearestNeighborLength;
+    graph.mapping_ = std::move(file);
+    return graph;
+}
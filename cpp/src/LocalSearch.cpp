@@ -5,9 +5,338 @@
 
 #include "LocalSearch.h"
 #include <algorithm>
+#include <cstdint>
 #include <limits>
+#include <utility>
+#include <vector>
 
-bool LocalSearch::twoOpt(Tour& tour, const Graph& graph) {
+namespace {
+
+// Minimum gain for a move to count as an improvement (floating point noise)
+constexpr double IMPROVEMENT_EPSILON = 1e-9;
+
+// Longest segment Or-opt moves (1, 2 or 3 consecutive cities)
+constexpr int OR_OPT_MAX_SEGMENT = 3;
+
+// Longest chain of flips tried by one Lin-Kernighan move
+constexpr int LK_MAX_DEPTH = 50;
+
+// Fixed number of scan blocks of the parallel 2-opt/3-opt. Independent of the
+// thread count, so the moves found (and the resulting tour) are too.
+constexpr int PARALLEL_SCAN_BLOCKS = 64;
+
+// Best move found by one scan block (i == -1: none)
+struct ScanMove {
+    double delta = -IMPROVEMENT_EPSILON;
+    int i = -1;
+    int j = -1;
+    int k = -1;
+    int reconnection = 0;
+};
+
+// Length change of one 3-opt reconnection of edges (i,i+1), (j,j+1), (k,k+1)
+// (cases as in LocalSearch::threeOpt: 1/2 reverse one segment, 3 both, 4 swap)
+template <typename Distance>
+double threeOptCaseDelta(const std::vector<int>& sequence, Distance distance,
+                         int i, int j, int k, int reconnection) {
+    int n = static_cast<int>(sequence.size());
+    int a = sequence[i], b = sequence[i + 1];
+    int c = sequence[j], d = sequence[j + 1];
+    int e = sequence[k], f = sequence[(k + 1) % n];
+    double removed = distance(a, b) + distance(c, d) + distance(e, f);
+    double added = 0.0;
+    switch (reconnection) {
+        case 1:
+            added = distance(a, c) + distance(b, d) + distance(e, f);
+            break;
+        case 2:
+            added = distance(a, b) + distance(c, e) + distance(d, f);
+            break;
+        case 3:
+            added = distance(a, c) + distance(b, e) + distance(d, f);
+            break;
+        case 4:
+            added = distance(a, d) + distance(e, b) + distance(c, f);
+            break;
+    }
+    return added - removed;
+}
+
+// Length change of the 2-opt move replacing (i,i+1), (j,j+1) by (i,j), (i+1,j+1)
+template <typename Distance>
+double twoOptDelta(const std::vector<int>& sequence, Distance distance, int i, int j) {
+    int n = static_cast<int>(sequence.size());
+
+    // Current edges: (i, i+1) and (j, j+1)
+    int city_i = sequence[i];
+    int city_i_plus_1 = sequence[i + 1];
+    int city_j = sequence[j];
+    int city_j_plus_1 = sequence[(j + 1) % n];  // Wrap around for last city
+
+    // Old distance: i->i+1 and j->j+1
+    double oldDistance = distance(city_i, city_i_plus_1) + distance(city_j, city_j_plus_1);
+
+    // New distance after reversing segment: i->j and i+1->j+1
+    double newDistance = distance(city_i, city_j) + distance(city_i_plus_1, city_j_plus_1);
+
+    return newDistance - oldDistance;
+}
+
+// Reverse sequence[i..j] in place
+void reverseTourSegment(std::vector<int>& sequence, int i, int j) {
+    while (i < j) {
+        std::swap(sequence[i], sequence[j]);
+        ++i;
+        --j;
+    }
+}
+
+// Length of the closed tour
+template <typename Distance>
+double tourDistance(const std::vector<int>& sequence, Distance distance) {
+    double totalDistance = 0.0;
+    int n = static_cast<int>(sequence.size());
+
+    for (int i = 0; i < n; ++i) {
+        int fromCity = sequence[i];
+        int toCity = sequence[(i + 1) % n];  // Wrap around to first city
+        totalDistance += distance(fromCity, toCity);
+    }
+
+    return totalDistance;
+}
+
+// Apply a 3-opt reconnection in place (same case numbering)
+void applyThreeOptMove(std::vector<int>& sequence, int i, int j, int k, int reconnection) {
+    auto begin = sequence.begin();
+    switch (reconnection) {
+        case 1:  // Reverse (i+1, j)
+            std::reverse(begin + i + 1, begin + j + 1);
+            break;
+
+        case 2:  // Reverse (j+1, k)
+            std::reverse(begin + j + 1, begin + k + 1);
+            break;
+
+        case 3:  // Reverse both segments
+            std::reverse(begin + i + 1, begin + j + 1);
+            std::reverse(begin + j + 1, begin + k + 1);
+            break;
+
+        case 4:  // Swap segments
+            std::rotate(begin + i + 1, begin + j + 1, begin + k + 1);
+            break;
+    }
+}
+
+/**
+ * Array representation of a tour with a position index.
+ * next/prev/between are O(1); reversePath() flips whichever side of the
+ * cycle is shorter, which yields the same cyclic tour (possibly traversed
+ * in the opposite direction). exchangeSegments() keeps the orientation.
+ */
+class ArrayTour {
+public:
+    ArrayTour(std::vector<int>& order, std::vector<int>& position, std::vector<int>& buffer)
+        : order_(order), pos_(position), buffer_(buffer), n_(static_cast<int>(order.size())) {
+        pos_.resize(n_);
+        for (int i = 0; i < n_; ++i) {
+            pos_[order_[i]] = i;
+        }
+    }
+
+    int next(int city) const {
+        int p = pos_[city] + 1;
+        return order_[p == n_ ? 0 : p];
+    }
+
+    int prev(int city) const {
+        int p = pos_[city];
+        return order_[p == 0 ? n_ - 1 : p - 1];
+    }
+
+    // True if b lies on the forward path from a to c (inclusive)
+    bool between(int a, int b, int c) const {
+        int pa = pos_[a], pb = pos_[b], pc = pos_[c];
+        if (pa <= pc) {
+            return pa <= pb && pb <= pc;
+        }
+        return pb >= pa || pb <= pc;
+    }
+
+    // Number of cities on the forward path from a to b (inclusive)
+    int pathLength(int a, int b) const {
+        int length = pos_[b] - pos_[a];
+        return (length < 0 ? length + n_ : length) + 1;
+    }
+
+    // Reverse the forward path from city a to city b (both inclusive)
+    void reversePath(int a, int b) {
+        int i = pos_[a];
+        int j = pos_[b];
+        int length = pathLength(a, b);
+
+        // Reversing the complement gives the same cycle with less work
+        if (2 * length > n_) {
+            i = (j + 1 == n_) ? 0 : j + 1;
+            length = n_ - length;
+        }
+        reverseWindow(i, length);
+    }
+
+    // Reverse the forward path from a to b in place, keeping the orientation
+    // of the rest of the tour (meant for short segments)
+    void reverseSegment(int a, int b) {
+        reverseWindow(pos_[a], pathLength(a, b));
+    }
+
+    /**
+     * 2-opt move on tour edges (a, b) and (c, d), where b follows a and d
+     * follows c in the same direction: they become (a, c) and (b, d)
+     */
+    void twoOptMove(int a, int b, int c, int d) {
+        if (next(a) == b) {
+            reversePath(b, c);  // a b ... c d -> a c ... b d
+        } else {
+            reversePath(a, d);  // b a ... d c -> b d ... a c
+        }
+    }
+
+    /**
+     * Swap the adjacent forward paths X = a..b and Y = next(b)..c, so that
+     * prev(a) X Y next(c) becomes prev(a) Y X next(c). With Z the rest of
+     * the cycle, XYZ -> YXZ is the same cycle as XZY and ZYX, so only the
+     * two shortest blocks are moved.
+     */
+    void exchangeSegments(int a, int b, int c) {
+        int lengthX = pathLength(a, b);
+        int lengthY = pathLength(next(b), c);
+        int lengthZ = n_ - lengthX - lengthY;
+
+        if (lengthZ >= lengthX && lengthZ >= lengthY) {
+            rotateWindow(pos_[a], lengthX + lengthY, lengthX);        // XY -> YX
+        } else if (lengthX >= lengthY) {
+            rotateWindow(pos_[next(b)], lengthY + lengthZ, lengthY);  // YZ -> ZY
+        } else {
+            rotateWindow(pos_[next(c)], lengthZ + lengthX, lengthZ);  // ZX -> XZ
+        }
+    }
+
+private:
+    std::vector<int>& order_;
+    std::vector<int>& pos_;
+    std::vector<int>& buffer_;
+    int n_;
+
+    void reverseWindow(int i, int length) {
+        int j = i + length - 1;
+        if (j >= n_) {
+            j -= n_;
+        }
+        for (int step = 0; step < length / 2; ++step) {
+            std::swap(order_[i], order_[j]);
+            pos_[order_[i]] = i;
+            pos_[order_[j]] = j;
+            i = (i + 1 == n_) ? 0 : i + 1;
+            j = (j == 0) ? n_ - 1 : j - 1;
+        }
+    }
+
+    // Cyclic window of length cities starting at index start: move its first
+    // shift cities to the end
+    void rotateWindow(int start, int length, int shift) {
+        buffer_.resize(length);
+        for (int k = 0, i = start; k < length; ++k) {
+            buffer_[k] = order_[i];
+            i = (i + 1 == n_) ? 0 : i + 1;
+        }
+        for (int k = 0, i = start; k < length; ++k) {
+            int source = k + shift;
+            int city = buffer_[source >= length ? source - length : source];
+            order_[i] = city;
+            pos_[city] = i;
+            i = (i + 1 == n_) ? 0 : i + 1;
+        }
+    }
+};
+
+// FIFO of cities whose don't-look bit is off
+class ActiveQueue {
+public:
+    ActiveQueue(std::vector<int>& ring, std::vector<std::uint8_t>& queued, const std::vector<int>& order)
+        : ring_(ring), queued_(queued), n_(static_cast<int>(order.size())) {
+        ring_.assign(order.begin(), order.end());
+        queued_.assign(n_, 1);
+        head_ = 0;
+        count_ = n_;
+    }
+
+    bool empty() const { return count_ == 0; }
+
+    int pop() {
+        int city = ring_[head_];
+        head_ = (head_ + 1 == n_) ? 0 : head_ + 1;
+        count_--;
+        queued_[city] = 0;
+        return city;
+    }
+
+    void push(int city) {
+        if (queued_[city]) {
+            return;
+        }
+        int tail = head_ + count_;
+        ring_[tail >= n_ ? tail - n_ : tail] = city;
+        count_++;
+        queued_[city] = 1;
+    }
+
+private:
+    std::vector<int>& ring_;
+    std::vector<std::uint8_t>& queued_;
+    int n_;
+    int head_ = 0;
+    int count_ = 0;
+};
+
+// Per-thread buffers for the neighbor-list operators (reused across calls)
+struct SearchScratch {
+    std::vector<int> order;
+    std::vector<int> position;
+    std::vector<int> ring;
+    std::vector<std::uint8_t> queued;
+    std::vector<int> buffer;
+    std::vector<int> chain;
+};
+
+SearchScratch& searchScratch() {
+    thread_local SearchScratch scratch;
+    return scratch;
+}
+
+// An operator's moves and evaluations, added to the thread's counters once
+// when the operator returns
+struct WorkCount {
+    std::uint64_t moves = 0;
+    std::uint64_t evaluations = 0;
+
+    ~WorkCount() {
+        LocalSearchCounters& counters = LocalSearch::threadCounters();
+        counters.moves += moves;
+        counters.evaluations += evaluations;
+    }
+};
+
+}  // namespace
+
+namespace {
+
+// The operators are compiled once per distance functor of
+// Graph::dispatchDistances(), so their delta evaluations inline the lookup
+// (or the metric formula) instead of switching on storage per distance
+
+template <typename Distance>
+bool twoOptWith(Tour& tour, Distance distance) {
     std::vector<int> sequence = tour.getSequence();
     int n = static_cast<int>(sequence.size());
 
@@ -18,6 +347,7 @@ bool LocalSearch::twoOpt(Tour& tour, const Graph& graph) {
 
     bool improved = true;
     bool anyImprovement = false;
+    WorkCount work;
 
     // Keep trying until no more improvements found
     while (improved) {
@@ -25,6 +355,7 @@ bool LocalSearch::twoOpt(Tour& tour, const Graph& graph) {
 
         // Try all pairs of edges (i,i+1) and (j,j+1)
         for (int i = 0; i < n - 2; ++i) {
+            work.evaluations += n - i - 2;
             for (int j = i + 2; j < n; ++j) {
                 // Skip if j is the last city and i is the first (already connected)
                 if (i == 0 && j == n - 1) {
@@ -32,11 +363,12 @@ bool LocalSearch::twoOpt(Tour& tour, const Graph& graph) {
                 }
 
                 // Calculate improvement delta
-                double delta = calculate2OptDelta(sequence, graph, i, j);
+                double delta = twoOptDelta(sequence, distance, i, j);
 
                 // If improvement found, apply it
                 if (delta < -1e-9) {  // Use epsilon for floating point comparison
                     reverseTourSegment(sequence, i + 1, j);
+                    ++work.moves;
                     improved = true;
                     anyImprovement = true;
                     // Don't break - continue searching for more improvements in this iteration
@@ -47,57 +379,15 @@ bool LocalSearch::twoOpt(Tour& tour, const Graph& graph) {
 
     // Update tour if any improvements were made
     if (anyImprovement) {
-        double newDistance = calculateTourDistance(sequence, graph);
-        tour.setTour(sequence, newDistance);
+        double newDistance = tourDistance(sequence, distance);
+        tour.setTour(std::move(sequence), newDistance);
     }
 
     return anyImprovement;
 }
 
-double LocalSearch::calculate2OptDelta(const std::vector<int>& sequence,
-                                       const Graph& graph, int i, int j) {
-    int n = static_cast<int>(sequence.size());
-
-    // Current edges: (i, i+1) and (j, j+1)
-    int city_i = sequence[i];
-    int city_i_plus_1 = sequence[i + 1];
-    int city_j = sequence[j];
-    int city_j_plus_1 = sequence[(j + 1) % n];  // Wrap around for last city
-
-    // Old distance: i->i+1 and j->j+1
-    double oldDistance = graph.getDistance(city_i, city_i_plus_1) +
-                        graph.getDistance(city_j, city_j_plus_1);
-
-    // New distance after reversing segment: i->j and i+1->j+1
-    double newDistance = graph.getDistance(city_i, city_j) +
-                        graph.getDistance(city_i_plus_1, city_j_plus_1);
-
-    return newDistance - oldDistance;
-}
-
-void LocalSearch::reverseTourSegment(std::vector<int>& sequence, int i, int j) {
-    while (i < j) {
-        std::swap(sequence[i], sequence[j]);
-        ++i;
-        --j;
-    }
-}
-
-double LocalSearch::calculateTourDistance(const std::vector<int>& sequence,
-                                          const Graph& graph) {
-    double totalDistance = 0.0;
-    int n = static_cast<int>(sequence.size());
-
-    for (int i = 0; i < n; ++i) {
-        int fromCity = sequence[i];
-        int toCity = sequence[(i + 1) % n];  // Wrap around to first city
-        totalDistance += graph.getDistance(fromCity, toCity);
-    }
-
-    return totalDistance;
-}
-
-bool LocalSearch::threeOpt(Tour& tour, const Graph& graph) {
+template <typename Distance>
+bool threeOptWith(Tour& tour, Distance distance) {
     std::vector<int> sequence = tour.getSequence();
     int n = static_cast<int>(sequence.size());
 
@@ -108,6 +398,7 @@ bool LocalSearch::threeOpt(Tour& tour, const Graph& graph) {
 
     bool improved = true;
     bool anyImprovement = false;
+    WorkCount work;
 
     while (improved) {
         improved = false;
@@ -118,6 +409,7 @@ bool LocalSearch::threeOpt(Tour& tour, const Graph& graph) {
         // Try all combinations of 3 edges
         for (int i = 0; i < n - 4; ++i) {
             for (int j = i + 2; j < n - 2; ++j) {
+                work.evaluations += n - j - 2;
                 for (int k = j + 2; k < n; ++k) {
                     // Skip if k wraps to include i
                     if (i == 0 && k == n - 1) {
@@ -133,30 +425,30 @@ bool LocalSearch::threeOpt(Tour& tour, const Graph& graph) {
                     int city_k1 = sequence[(k + 1) % n];
 
                     // Current distance of the 3 edges
-                    double oldDist = graph.getDistance(city_i, city_i1) +
-                                    graph.getDistance(city_j, city_j1) +
-                                    graph.getDistance(city_k, city_k1);
+                    double oldDist = distance(city_i, city_i1) +
+                                    distance(city_j, city_j1) +
+                                    distance(city_k, city_k1);
 
                     // Try all 7 possible reconnection patterns (case 0 is original)
                     // Case 1: Reverse segment (i+1, j)
-                    double case1 = graph.getDistance(city_i, city_j) +
-                                  graph.getDistance(city_i1, city_j1) +
-                                  graph.getDistance(city_k, city_k1);
+                    double case1 = distance(city_i, city_j) +
+                                  distance(city_i1, city_j1) +
+                                  distance(city_k, city_k1);
 
                     // Case 2: Reverse segment (j+1, k)
-                    double case2 = graph.getDistance(city_i, city_i1) +
-                                  graph.getDistance(city_j, city_k) +
-                                  graph.getDistance(city_j1, city_k1);
+                    double case2 = distance(city_i, city_i1) +
+                                  distance(city_j, city_k) +
+                                  distance(city_j1, city_k1);
 
                     // Case 3: Reverse both segments
-                    double case3 = graph.getDistance(city_i, city_j) +
-                                  graph.getDistance(city_i1, city_k) +
-                                  graph.getDistance(city_j1, city_k1);
+                    double case3 = distance(city_i, city_j) +
+                                  distance(city_i1, city_k) +
+                                  distance(city_j1, city_k1);
 
                     // Case 4: Swap segments (i+1,j) and (j+1,k)
-                    double case4 = graph.getDistance(city_i, city_j1) +
-                                  graph.getDistance(city_k, city_i1) +
-                                  graph.getDistance(city_j, city_k1);
+                    double case4 = distance(city_i, city_j1) +
+                                  distance(city_k, city_i1) +
+                                  distance(city_j, city_k1);
 
                     // Find best case
                     double cases[] = {case1, case2, case3, case4};
@@ -179,54 +471,690 @@ bool LocalSearch::threeOpt(Tour& tour, const Graph& graph) {
             improved = true;
             anyImprovement = true;
 
-            // Apply the transformation based on best case
-            std::vector<int> newSequence;
+            // Apply the transformation in place based on best case
+            applyThreeOptMove(sequence, best_i, best_j, best_k, bestCase);
+            ++work.moves;
+        }
+    }
+
+    // Update tour if any improvements were made
+    if (anyImprovement) {
+        double newDistance = tourDistance(sequence, distance);
+        tour.setTour(std::move(sequence), newDistance);
+    }
+
+    return anyImprovement;
+}
+
+template <typename Distance>
+bool twoOptParallelWith(Tour& tour, Distance distance) {
+    std::vector<int> sequence = tour.getSequence();
+    int n = static_cast<int>(sequence.size());
+    if (n < 4) {
+        return false;
+    }
+
+    // Block b scans the rows i = b, b + numBlocks, ... (interleaved rows
+    // balance the triangular i < j workload)
+    const int numBlocks = std::min(PARALLEL_SCAN_BLOCKS, n - 2);
+    std::vector<ScanMove> blockBest(numBlocks);
+    bool anyImprovement = false;
+
+    // Pairs per sweep, counted here rather than in the worker threads
+    WorkCount work;
+    const std::uint64_t pairsPerSweep = static_cast<std::uint64_t>(n - 2) * (n - 1) / 2;
+
+    while (true) {
+        work.evaluations += pairsPerSweep;
+        #ifdef _OPENMP
+        #pragma omp parallel for schedule(dynamic)
+        #endif
+        for (int b = 0; b < numBlocks; ++b) {
+            ScanMove best;
+            for (int i = b; i < n - 2; i += numBlocks) {
+                for (int j = i + 2; j < n; ++j) {
+                    if (i == 0 && j == n - 1) {
+                        continue;
+                    }
+                    double delta = twoOptDelta(sequence, distance, i, j);
+                    if (delta < best.delta) {
+                        best.delta = delta;
+                        best.i = i;
+                        best.j = j;
+                    }
+                }
+            }
+            blockBest[b] = best;
+        }
+
+        // Apply the blocks' moves in block order; earlier moves may have
+        // changed the edges at these positions, so each one is re-checked
+        bool improved = false;
+        for (const ScanMove& move : blockBest) {
+            if (move.i != -1 && twoOptDelta(sequence, distance, move.i, move.j) < -IMPROVEMENT_EPSILON) {
+                reverseTourSegment(sequence, move.i + 1, move.j);
+                ++work.moves;
+                improved = true;
+            }
+        }
+        if (!improved) {
+            break;
+        }
+        anyImprovement = true;
+    }
+
+    if (anyImprovement) {
+        double newDistance = tourDistance(sequence, distance);
+        tour.setTour(std::move(sequence), newDistance);
+    }
+    return anyImprovement;
+}
+
+template <typename Distance>
+bool threeOptParallelWith(Tour& tour, Distance distance) {
+    std::vector<int> sequence = tour.getSequence();
+    int n = static_cast<int>(sequence.size());
+    if (n < 6) {
+        return false;
+    }
+
+    const int numBlocks = std::min(PARALLEL_SCAN_BLOCKS, n - 4);
+    std::vector<ScanMove> blockBest(numBlocks);
+    bool anyImprovement = false;
+
+    // Triples per sweep, counted here rather than in the worker threads
+    WorkCount work;
+    std::uint64_t triplesPerSweep = 0;
+    for (int i = 0; i < n - 4; ++i) {
+        for (int j = i + 2; j < n - 2; ++j) {
+            triplesPerSweep += n - j - 2;
+        }
+    }
+
+    while (true) {
+        work.evaluations += triplesPerSweep;
+        #ifdef _OPENMP
+        #pragma omp parallel for schedule(dynamic)
+        #endif
+        for (int b = 0; b < numBlocks; ++b) {
+            ScanMove best;
+            for (int i = b; i < n - 4; i += numBlocks) {
+                for (int j = i + 2; j < n - 2; ++j) {
+                    for (int k = j + 2; k < n; ++k) {
+                        if (i == 0 && k == n - 1) {
+                            continue;
+                        }
+                        // Same four reconnections as threeOptCaseDelta(), sharing the loads
+                        int a = sequence[i], b = sequence[i + 1];
+                        int c = sequence[j], d = sequence[j + 1];
+                        int e = sequence[k], f = sequence[(k + 1) % n];
+                        double ab = distance(a, b);
+                        double cd = distance(c, d);
+                        double ef = distance(e, f);
+                        double ac = distance(a, c);
+                        double df = distance(d, f);
+                        double removed = ab + cd + ef;
+                        double deltas[4] = {
+                            ac + distance(b, d) + ef - removed,
+                            ab + distance(c, e) + df - removed,
+                            ac + distance(b, e) + df - removed,
+                            distance(a, d) + distance(e, b) +
+                                distance(c, f) - removed
+                        };
+                        for (int r = 0; r < 4; ++r) {
+                            if (deltas[r] < best.delta) {
+                                best.delta = deltas[r];
+                                best.i = i;
+                                best.j = j;
+                                best.k = k;
+                                best.reconnection = r + 1;
+                            }
+                        }
+                    }
+                }
+            }
+            blockBest[b] = best;
+        }
+
+        bool improved = false;
+        for (const ScanMove& move : blockBest) {
+            if (move.i != -1 &&
+                threeOptCaseDelta(sequence, distance, move.i, move.j, move.k, move.reconnection) < -IMPROVEMENT_EPSILON) {
+                applyThreeOptMove(sequence, move.i, move.j, move.k, move.reconnection);
+                ++work.moves;
+                improved = true;
+            }
+        }
+        if (!improved) {
+            break;
+        }
+        anyImprovement = true;
+    }
+
+    if (anyImprovement) {
+        double newDistance = tourDistance(sequence, distance);
+        tour.setTour(std::move(sequence), newDistance);
+    }
+    return anyImprovement;
+}
+
+template <typename Distance>
+bool twoOptNeighborWith(Tour& tour, Distance distance, const NeighborLists& neighbors) {
+    int n = static_cast<int>(tour.getSequence().size());
+    if (n < 4) {
+        return false;
+    }
+    if (neighbors.size <= 0) {
+        // Nothing to restrict the search to
+        return twoOptWith(tour, distance);
+    }
+
+    SearchScratch& scratch = searchScratch();
+    scratch.order.assign(tour.getSequence().begin(), tour.getSequence().end());
+    ArrayTour t(scratch.order, scratch.position, scratch.buffer);
+    ActiveQueue active(scratch.ring, scratch.queued, scratch.order);
 
-            switch (bestCase) {
-                case 1:  // Reverse (i+1, j)
-                    newSequence.insert(newSequence.end(), sequence.begin(), sequence.begin() + best_i + 1);
-                    newSequence.insert(newSequence.end(), sequence.rbegin() + (n - best_j - 1),
-                                      sequence.rbegin() + (n - best_i - 1));
-                    newSequence.insert(newSequence.end(), sequence.begin() + best_j + 1, sequence.end());
+    bool anyImprovement = false;
+    WorkCount work;
+
+    while (!active.empty()) {
+        int a = active.pop();
+
+        // Try both tour neighbors of a as the end of the removed edge
+        bool moved = false;
+        for (int direction = 0; direction < 2 && !moved; ++direction) {
+            int b = (direction == 0) ? t.next(a) : t.prev(a);
+            double removedAB = distance(a, b);
+            const int* candidates = neighbors.of(a);
+
+            for (int r = 0; r < neighbors.size; ++r) {
+                int c = candidates[r];
+                double addedAC = distance(a, c);
+
+                // Lists are sorted: no later neighbor can give a positive gain
+                if (addedAC >= removedAB) {
                     break;
+                }
 
-                case 2:  // Reverse (j+1, k)
-                    newSequence.insert(newSequence.end(), sequence.begin(), sequence.begin() + best_j + 1);
-                    newSequence.insert(newSequence.end(), sequence.rbegin() + (n - best_k - 1),
-                                      sequence.rbegin() + (n - best_j - 1));
-                    newSequence.insert(newSequence.end(), sequence.begin() + best_k + 1, sequence.end());
+                int d = (direction == 0) ? t.next(c) : t.prev(c);
+                if (c == b || d == a) {
+                    continue;
+                }
+
+                double delta = addedAC + distance(b, d) -
+                               removedAB - distance(c, d);
+                ++work.evaluations;
+                if (delta < -IMPROVEMENT_EPSILON) {
+                    ++work.moves;
+                    // Replace (a,b),(c,d) with (a,c),(b,d)
+                    if (direction == 0) {
+                        t.reversePath(b, c);  // a b ... c d -> a c ... b d
+                    } else {
+                        t.reversePath(a, d);  // b a ... d c -> b d ... a c
+                    }
+
+                    // Endpoints of changed edges get their don't-look bits cleared
+                    active.push(a);
+                    active.push(b);
+                    active.push(c);
+                    active.push(d);
+                    anyImprovement = true;
+                    moved = true;
                     break;
+                }
+            }
+        }
+    }
+
+    if (anyImprovement) {
+        double newDistance = tourDistance(scratch.order, distance);
+        tour.setTour(scratch.order, newDistance);
+    }
+
+    return anyImprovement;
+}
+
+template <typename Distance>
+bool orOptWith(Tour& tour, Distance distance, const NeighborLists& neighbors) {
+    int n = static_cast<int>(tour.getSequence().size());
+    if (n < 5 || neighbors.size <= 0) {
+        return false;
+    }
+
+    SearchScratch& scratch = searchScratch();
+    scratch.order.assign(tour.getSequence().begin(), tour.getSequence().end());
+    ArrayTour t(scratch.order, scratch.position, scratch.buffer);
+    ActiveQueue active(scratch.ring, scratch.queued, scratch.order);
+
+    bool anyImprovement = false;
+    WorkCount work;
+
+    while (!active.empty()) {
+        int a = active.pop();
 
-                case 3:  // Reverse both segments
-                    newSequence.insert(newSequence.end(), sequence.begin(), sequence.begin() + best_i + 1);
-                    newSequence.insert(newSequence.end(), sequence.rbegin() + (n - best_j - 1),
-                                      sequence.rbegin() + (n - best_i - 1));
-                    newSequence.insert(newSequence.end(), sequence.rbegin() + (n - best_k - 1),
-                                      sequence.rbegin() + (n - best_j - 1));
-                    newSequence.insert(newSequence.end(), sequence.begin() + best_k + 1, sequence.end());
+        // Segments s..e of 1-3 cities that start or end at a
+        bool moved = false;
+        for (int length = 1; length <= OR_OPT_MAX_SEGMENT && length + 3 <= n && !moved; ++length) {
+            for (int atStart = 1; atStart >= 0 && !moved; --atStart) {
+                if (length == 1 && !atStart) {
                     break;
+                }
 
-                case 4:  // Swap segments
-                    newSequence.insert(newSequence.end(), sequence.begin(), sequence.begin() + best_i + 1);
-                    newSequence.insert(newSequence.end(), sequence.begin() + best_j + 1, sequence.begin() + best_k + 1);
-                    newSequence.insert(newSequence.end(), sequence.begin() + best_i + 1, sequence.begin() + best_j + 1);
-                    newSequence.insert(newSequence.end(), sequence.begin() + best_k + 1, sequence.end());
+                int s = a, e = a;
+                for (int k = 1; k < length; ++k) {
+                    if (atStart) {
+                        e = t.next(e);
+                    } else {
+                        s = t.prev(s);
+                    }
+                }
+                int p = t.prev(s);
+                int nx = t.next(e);
+                int other = atStart ? e : s;
+
+                // Gain of cutting the segment out and closing the gap (p, nx)
+                double removeGain = distance(p, s) +
+                                    distance(e, nx) -
+                                    distance(p, nx);
+                if (removeGain <= IMPROVEMENT_EPSILON) {
+                    continue;
+                }
+
+                const int* candidates = neighbors.of(a);
+                for (int r = 0; r < neighbors.size && !moved; ++r) {
+                    int c = candidates[r];
+                    double addedAC = distance(a, c);
+                    if (addedAC >= removeGain) {
+                        break;
+                    }
+                    if (t.between(s, c, e)) {
+                        continue;
+                    }
+
+                    // Insert between (x, y) with a next to c: c after or before the segment
+                    for (int side = 0; side < 2; ++side) {
+                        int x = (side == 0) ? c : t.prev(c);
+                        int y = (side == 0) ? t.next(c) : c;
+                        if (y == s || x == e) {
+                            continue;  // (x, y) is one of the segment's own edges
+                        }
+
+                        int farEnd = (side == 0) ? y : x;
+                        double delta = addedAC + distance(other, farEnd) -
+                                       distance(x, y) - removeGain;
+                        ++work.evaluations;
+                        if (delta < -IMPROVEMENT_EPSILON) {
+                            ++work.moves;
+                            // p s..e nx .. x y -> p nx .. x s..e y, then fix orientation
+                            t.exchangeSegments(s, e, x);
+                            if ((side == 0) != (atStart == 1)) {
+                                t.reverseSegment(s, e);
+                            }
+
+                            active.push(p);
+                            active.push(nx);
+                            active.push(s);
+                            active.push(e);
+                            active.push(x);
+                            active.push(y);
+                            anyImprovement = true;
+                            moved = true;
+                            break;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    if (anyImprovement) {
+        double newDistance = tourDistance(scratch.order, distance);
+        tour.setTour(scratch.order, newDistance);
+    }
+
+    return anyImprovement;
+}
+
+template <typename Distance>
+bool threeOptNeighborWith(Tour& tour, Distance distance, const NeighborLists& neighbors) {
+    int n = static_cast<int>(tour.getSequence().size());
+    if (n < 6) {
+        return false;
+    }
+    if (neighbors.size <= 0) {
+        // Nothing to restrict the search to
+        return threeOptWith(tour, distance);
+    }
+
+    SearchScratch& scratch = searchScratch();
+    scratch.order.assign(tour.getSequence().begin(), tour.getSequence().end());
+    ArrayTour t(scratch.order, scratch.position, scratch.buffer);
+    ActiveQueue active(scratch.ring, scratch.queued, scratch.order);
+
+    bool anyImprovement = false;
+    WorkCount work;
+
+    while (!active.empty()) {
+        int t1 = active.pop();
+
+        bool moved = false;
+        for (int direction = 0; direction < 2 && !moved; ++direction) {
+            auto succ = [&](int city) { return direction == 0 ? t.next(city) : t.prev(city); };
+            auto pred = [&](int city) { return direction == 0 ? t.prev(city) : t.next(city); };
+
+            int t2 = succ(t1);
+            double removed12 = distance(t1, t2);
+            const int* candidates1 = neighbors.of(t1);
+
+            for (int r1 = 0; r1 < neighbors.size && !moved; ++r1) {
+                // New edge (t1, t3) replaces (t4, t3)
+                int t3 = candidates1[r1];
+                double gain1 = removed12 - distance(t1, t3);
+                if (gain1 <= IMPROVEMENT_EPSILON) {
                     break;
+                }
+                if (t3 == t2) {
+                    continue;
+                }
+                int t4 = pred(t3);
+                gain1 += distance(t4, t3);
+
+                const int* candidates2 = neighbors.of(t2);
+                for (int r2 = 0; r2 < neighbors.size; ++r2) {
+                    // New edge (t2, t5) replaces (t5, t6); t5 must follow t3
+                    int t5 = candidates2[r2];
+                    double gain2 = gain1 - distance(t2, t5);
+                    if (gain2 <= IMPROVEMENT_EPSILON) {
+                        break;
+                    }
+                    if (t5 == t1 ||
+                        !(direction == 0 ? t.between(t3, t5, t1) : t.between(t1, t5, t3))) {
+                        continue;
+                    }
+                    int t6 = succ(t5);
+
+                    double delta = distance(t4, t6) -
+                                   distance(t5, t6) - gain2;
+                    ++work.evaluations;
+                    if (delta < -IMPROVEMENT_EPSILON) {
+                        ++work.moves;
+                        // t1 [t2..t4] [t3..t5] t6 -> t1 [t3..t5] [t2..t4] t6
+                        if (direction == 0) {
+                            t.exchangeSegments(t2, t4, t5);
+                        } else {
+                            t.exchangeSegments(t5, t3, t2);
+                        }
+
+                        active.push(t1);
+                        active.push(t2);
+                        active.push(t3);
+                        active.push(t4);
+                        active.push(t5);
+                        active.push(t6);
+                        anyImprovement = true;
+                        moved = true;
+                        break;
+                    }
+                }
+            }
+        }
+    }
+
+    if (anyImprovement) {
+        double newDistance = tourDistance(scratch.order, distance);
+        tour.setTour(scratch.order, newDistance);
+    }
+
+    return anyImprovement;
+}
+
+template <typename Distance>
+bool linKernighanWith(Tour& tour, Distance distance, const NeighborLists& neighbors) {
+    int n = static_cast<int>(tour.getSequence().size());
+    if (n < 4) {
+        return false;
+    }
+    if (neighbors.size <= 0) {
+        // Nothing to restrict the search to
+        return twoOptWith(tour, distance);
+    }
+
+    SearchScratch& scratch = searchScratch();
+    scratch.order.assign(tour.getSequence().begin(), tour.getSequence().end());
+    ArrayTour t(scratch.order, scratch.position, scratch.buffer);
+    ActiveQueue active(scratch.ring, scratch.queued, scratch.order);
+
+    // Flips of the current chain, four cities (t1, t2, t3, t4) per step
+    std::vector<int>& chain = scratch.chain;
+    WorkCount work;
+
+    // Edge (a, b) was added earlier in the chain and must not be removed
+    auto addedInChain = [&](int a, int b) {
+        for (size_t i = 0; i < chain.size(); i += 4) {
+            int u = chain[i + 1], v = chain[i + 2];
+            if ((u == a && v == b) || (u == b && v == a)) {
+                return true;
             }
+        }
+        return false;
+    };
+
+    // Remove (t1,t2),(t4,t3), add (t2,t3),(t1,t4); t4 becomes t1's new neighbor
+    auto step = [&](int t1, int t2, int t3, int t4) {
+        t.twoOptMove(t1, t2, t4, t3);
+        chain.insert(chain.end(), {t1, t2, t3, t4});
+    };
+
+    // Undo steps until only keep of them remain
+    auto rollback = [&](size_t keep) {
+        while (chain.size() > 4 * keep) {
+            size_t i = chain.size() - 4;
+            t.twoOptMove(chain[i], chain[i + 3], chain[i + 1], chain[i + 2]);
+            chain.resize(i);
+        }
+    };
 
-            sequence = newSequence;
+    // Best t3 for the open end t2, given t2 follows t1; -1 if none keeps a positive gain
+    auto chooseNext = [&](int t1, int t2, double openGain, int& bestT4) {
+        bool forward = (t.next(t1) == t2);
+        const int* candidates = neighbors.of(t2);
+        int bestT3 = -1;
+        double bestValue = -std::numeric_limits<double>::infinity();
+
+        for (int r = 0; r < neighbors.size; ++r) {
+            int t3 = candidates[r];
+            double added = distance(t2, t3);
+            if (added >= openGain) {
+                break;
+            }
+            int t4 = forward ? t.prev(t3) : t.next(t3);
+            if (t3 == t1 || t4 == t2 || addedInChain(t4, t3)) {
+                continue;
+            }
+            double value = distance(t4, t3) - added;
+            ++work.evaluations;
+            if (value > bestValue) {
+                bestValue = value;
+                bestT3 = t3;
+                bestT4 = t4;
+            }
+        }
+        return bestT3;
+    };
+
+    bool anyImprovement = false;
+
+    while (!active.empty()) {
+        int t1 = active.pop();
+
+        bool moved = false;
+        for (int direction = 0; direction < 2 && !moved; ++direction) {
+            int firstT2 = (direction == 0) ? t.next(t1) : t.prev(t1);
+            double removed12 = distance(t1, firstT2);
+            const int* candidates = neighbors.of(firstT2);
+
+            // Breadth at the first level, greedy deepening afterwards
+            for (int r = 0; r < neighbors.size && !moved; ++r) {
+                int t3 = candidates[r];
+                double added = distance(firstT2, t3);
+                if (added >= removed12) {
+                    break;
+                }
+                // A rolled-back chain may leave the array in the other orientation
+                bool forward = (t.next(t1) == firstT2);
+                int t4 = forward ? t.prev(t3) : t.next(t3);
+                if (t3 == t1 || t4 == firstT2) {
+                    continue;
+                }
+
+                chain.clear();
+                ++work.evaluations;
+                step(t1, firstT2, t3, t4);
+                double gain = removed12 - added + distance(t4, t3);
+                double bestGain = gain - distance(t1, t4);
+                size_t bestDepth = 1;
+
+                int t2 = t4;
+                for (int depth = 1; depth < LK_MAX_DEPTH; ++depth) {
+                    // gain counts the open edge (t1, t2) as already removed
+                    int nextT4 = -1;
+                    int nextT3 = chooseNext(t1, t2, gain, nextT4);
+                    if (nextT3 < 0) {
+                        break;
+                    }
+                    step(t1, t2, nextT3, nextT4);
+                    gain += distance(nextT4, nextT3) -
+                            distance(t2, nextT3);
+                    t2 = nextT4;
+
+                    double closedGain = gain - distance(t1, t2);
+                    if (closedGain > bestGain) {
+                        bestGain = closedGain;
+                        bestDepth = chain.size() / 4;
+                    }
+                }
+
+                if (bestGain > IMPROVEMENT_EPSILON) {
+                    rollback(bestDepth);
+                    ++work.moves;  // One move per improving chain
+                    for (int city : chain) {
+                        active.push(city);
+                    }
+                    anyImprovement = true;
+                    moved = true;
+                } else {
+                    rollback(0);
+                }
+            }
         }
     }
 
-    // Update tour if any improvements were made
     if (anyImprovement) {
-        double newDistance = calculateTourDistance(sequence, graph);
-        tour.setTour(sequence, newDistance);
+        double newDistance = tourDistance(scratch.order, distance);
+        tour.setTour(scratch.order, newDistance);
     }
 
     return anyImprovement;
 }
 
+}  // namespace
+
+LocalSearchCounters& LocalSearch::threadCounters() {
+    thread_local LocalSearchCounters counters;
+    return counters;
+}
+
+bool LocalSearch::twoOpt(Tour& tour, const Graph& graph) {
+    return graph.dispatchDistances([&](auto distance) {
+        return twoOptWith(tour, distance);
+    });
+}
+
+bool LocalSearch::threeOpt(Tour& tour, const Graph& graph) {
+    return graph.dispatchDistances([&](auto distance) {
+        return threeOptWith(tour, distance);
+    });
+}
+
+bool LocalSearch::twoOptParallel(Tour& tour, const Graph& graph) {
+    return graph.dispatchDistances([&](auto distance) {
+        return twoOptParallelWith(tour, distance);
+    });
+}
+
+bool LocalSearch::threeOptParallel(Tour& tour, const Graph& graph) {
+    return graph.dispatchDistances([&](auto distance) {
+        return threeOptParallelWith(tour, distance);
+    });
+}
+
+bool LocalSearch::twoOptNeighbor(Tour& tour, const Graph& graph,
+                                 const NeighborLists& neighbors) {
+    return graph.dispatchDistances([&](auto distance) {
+        return twoOptNeighborWith(tour, distance, neighbors);
+    });
+}
+
+bool LocalSearch::orOpt(Tour& tour, const Graph& graph, const NeighborLists& neighbors) {
+    return graph.dispatchDistances([&](auto distance) {
+        return orOptWith(tour, distance, neighbors);
+    });
+}
+
+bool LocalSearch::threeOptNeighbor(Tour& tour, const Graph& graph,
+                                   const NeighborLists& neighbors) {
+    return graph.dispatchDistances([&](auto distance) {
+        return threeOptNeighborWith(tour, distance, neighbors);
+    });
+}
+
+bool LocalSearch::linKernighan(Tour& tour, const Graph& graph,
+                               const NeighborLists& neighbors) {
+    return graph.dispatchDistances([&](auto distance) {
+        return linKernighanWith(tour, distance, neighbors);
+    });
+}
+
+bool LocalSearch::improve(Tour& tour, const Graph& graph, bool use3opt,
+                          LocalSearchOperator op, const NeighborLists& neighbors) {
+    if (op == LocalSearchOperator::EXHAUSTIVE || neighbors.size <= 0) {
+        return improve(tour, graph, use3opt);
+    }
+
+    if (op == LocalSearchOperator::LIN_KERNIGHAN) {
+        bool improved = linKernighan(tour, graph, neighbors);
+
+        // Or-opt catches segment moves that chains of 2-opt flips miss
+        if (use3opt && orOpt(tour, graph, neighbors)) {
+            improved = true;
+            linKernighan(tour, graph, neighbors);
+        }
+        return improved;
+    }
+
+    bool improved = twoOptNeighbor(tour, graph, neighbors);
+
+    // Optionally refine with segment moves: Or-opt, then or-3opt
+    if (use3opt) {
+        if (orOpt(tour, graph, neighbors)) {
+            improved = true;
+        }
+        if (threeOptNeighbor(tour, graph, neighbors)) {
+            improved = true;
+        }
+    }
+
+    return improved;
+}
+
+bool LocalSearch::improveParallel(Tour& tour, const Graph& graph, bool use3opt) {
+    bool improved = twoOptParallel(tour, graph);
+    if (use3opt && threeOptParallel(tour, graph)) {
+        improved = true;
+    }
+    return improved;
+}
+
 bool LocalSearch::improve(Tour& tour, const Graph& graph, bool use3opt) {
     bool improved = false;
 
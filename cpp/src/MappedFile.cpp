@@ -0,0 +1,55 @@
+/**
+ * @file MappedFile.cpp
+ * @brief Implementation of read-only file mapping
+ */
+
+#include "MappedFile.h"
+#include <fstream>
+#include <iterator>
+#include <sys/stat.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define MAPPEDFILE_HAVE_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile(const std::string& path) {
+#ifdef MAPPEDFILE_HAVE_MMAP
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd >= 0) {
+        struct stat info;
+        if (::fstat(fd, &info) == 0 && info.st_size > 0) {
+            // MAP_SHARED: other processes mapping the same file use the same pages
+            void* address = ::mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ,
+                                   MAP_SHARED, fd, 0);
+            if (address != MAP_FAILED) {
+                data_ = static_cast<const char*>(address);
+                size_ = static_cast<std::size_t>(info.st_size);
+                mapped_ = true;
+                open_ = true;
+                ::madvise(address, size_, MADV_WILLNEED);
+            }
+        }
+        ::close(fd);
+    }
+#endif
+    if (!open_) {
+        std::ifstream file(path, std::ios::binary);
+        if (file.is_open()) {
+            contents_.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+            data_ = contents_.data();
+            size_ = contents_.size();
+            open_ = true;
+        }
+    }
+}
+
+MappedFile::~MappedFile() {
+#ifdef MAPPEDFILE_HAVE_MMAP
+    if (mapped_) {
+        ::munmap(const_cast<char*>(data_), size_);
+    }
+#endif
+}
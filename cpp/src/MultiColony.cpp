@@ -0,0 +1,291 @@
+#include "MultiColony.h"
+#include <algorithm>
+#include <limits>
+#include <utility>
+#include "Random.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+MultiColony::MultiColony(const Graph& graph, int numColonies, int numAnts, double alpha,
+                         double beta, double rho, double Q, bool useDistinctStartCities)
+    : MultiColony(std::make_shared<const Graph>(graph), numColonies, numAnts, alpha, beta, rho, Q,
+                  useDistinctStartCities) {
+}
+
+MultiColony::MultiColony(std::shared_ptr<const Graph> graph, int numColonies, int numAnts,
+                         double alpha, double beta, double rho, double Q,
+                         bool useDistinctStartCities)
+    : bestTour_(std::vector<int>(), std::numeric_limits<double>::max()) {
+    numColonies = std::max(1, numColonies);
+    colonies_.reserve(numColonies);
+    for (int c = 0; c < numColonies; ++c) {
+        colonies_.push_back(std::make_unique<AntColony>(graph, numAnts, alpha, beta, rho, Q,
+                                                        useDistinctStartCities));
+        // Parallelism comes from running colonies side by side
+        colonies_.back()->setUseParallel(false);
+    }
+}
+
+void MultiColony::configure(const std::function<void(AntColony&)>& setup) {
+    for (auto& colony : colonies_) {
+        setup(*colony);
+    }
+}
+
+const char* MultiColony::earlyStopReason(double bestDistance, double nextIterationSeconds) const {
+    if (stopRequested_.load()) {
+        return "stopped";
+    }
+    if (targetDistance_ > 0.0 && bestDistance <= targetDistance_) {
+        return "target";
+    }
+    if (timeLimit_ > 0.0) {
+        double elapsed = std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - startTime_).count();
+        if (elapsed + nextIterationSeconds > timeLimit_) {
+            return "time-limit";
+        }
+    }
+    return nullptr;
+}
+
+int MultiColony::runEpoch(int iterations) {
+    int numColonies = static_cast<int>(colonies_.size());
+    std::vector<int> completed(numColonies, 0);
+    std::atomic<const char*> halt{nullptr};  // First early stop reason seen by any colony
+
+    #ifdef _OPENMP
+    int threads = (numThreads_ > 0) ? numThreads_ : omp_get_max_threads();
+    threads = std::max(1, std::min(threads, numColonies));
+    #pragma omp parallel for schedule(dynamic, 1) num_threads(threads)
+    #endif
+    for (int c = 0; c < numColonies; ++c) {
+        AntColony& colony = *colonies_[c];
+        for (int i = 0; i < iterations; ++i) {
+            // One colony's stop holds the others too
+            if (halt.load()) {
+                break;
+            }
+            if (const char* reason = earlyStopReason(colony.getBestTour().getDistance(),
+                                                     lastIterationSeconds_[c])) {
+                const char* none = nullptr;
+                halt.compare_exchange_strong(none, reason);
+                break;
+            }
+            auto iterationStart = std::chrono::steady_clock::now();
+            colony.runIteration();
+            lastIterationSeconds_[c] = std::chrono::duration<double>(
+                std::chrono::steady_clock::now() - iterationStart).count();
+            completed[c] = i + 1;
+        }
+    }
+
+    if (const char* reason = halt.load()) {
+        stopReason_ = reason;
+    }
+    return *std::max_element(completed.begin(), completed.end());
+}
+
+void MultiColony::collectResults(int fromIteration, int toIteration) {
+    for (int t = fromIteration; t < toIteration; ++t) {
+        double best = std::numeric_limits<double>::max();
+        for (const auto& colony : colonies_) {
+            const std::vector<double>& history = colony->getConvergenceData();
+            if (t < static_cast<int>(history.size())) {
+                best = std::min(best, history[t]);
+            }
+        }
+        iterationBestDistances_.push_back(best);
+    }
+
+    // Lowest colony index wins ties, independent of thread timing
+    for (int c = 0; c < static_cast<int>(colonies_.size()); ++c) {
+        const Tour& candidate = colonies_[c]->getBestTour();
+        if (!candidate.getSequence().empty() && candidate.getDistance() < bestTour_.getDistance()) {
+            bestTour_ = candidate;
+            bestColony_ = c;
+        }
+    }
+}
+
+void MultiColony::migrate() {
+    int numColonies = static_cast<int>(colonies_.size());
+    if (numColonies < 2) {
+        return;
+    }
+
+    // Snapshot first: every colony sends the tour it had before this migration
+    migrants_.resize(numColonies);
+    int bestIndex = 0;
+    for (int c = 0; c < numColonies; ++c) {
+        migrants_[c] = colonies_[c]->getBestTour();
+        if (migrants_[c].getDistance() < migrants_[bestIndex].getDistance()) {
+            bestIndex = c;
+        }
+    }
+
+    #ifdef _OPENMP
+    int threads = (numThreads_ > 0) ? numThreads_ : omp_get_max_threads();
+    threads = std::max(1, std::min(threads, numColonies));
+    #pragma omp parallel for schedule(dynamic, 1) num_threads(threads)
+    #endif
+    for (int c = 0; c < numColonies; ++c) {
+        int source = (migrationTopology_ == "broadcast") ? bestIndex
+                                                         : (c + numColonies - 1) % numColonies;
+        if (source != c) {
+            colonies_[c]->importTour(migrants_[source]);
+        }
+    }
+    numMigrations_++;
+}
+
+Tour MultiColony::solve(int maxIterations, ProgressCallback callback) {
+    // The time limit covers the colonies' setup below
+    startTime_ = std::chrono::steady_clock::now();
+    ProgressCallback activeCallback = callback ? callback : progressCallback_;
+    int numColonies = static_cast<int>(colonies_.size());
+
+    // Colonies rebuild their own pheromone and choice matrices in parallel
+    #ifdef _OPENMP
+    int threads = (numThreads_ > 0) ? numThreads_ : omp_get_max_threads();
+    threads = std::max(1, std::min(threads, numColonies));
+    #pragma omp parallel for schedule(dynamic, 1) num_threads(threads)
+    #endif
+    for (int c = 0; c < numColonies; ++c) {
+        colonies_[c]->initialize();
+    }
+
+    bestTour_ = Tour(std::vector<int>(), std::numeric_limits<double>::max());
+    bestColony_ = -1;
+    numMigrations_ = 0;
+    iterationBestDistances_.clear();
+    lastIterationSeconds_.assign(numColonies, 0.0);
+    stopReason_.clear();
+
+    int iteration = 0;
+    int iterationsWithoutImprovement = 0;
+    double runningBest = std::numeric_limits<double>::max();
+
+    while (true) {
+        if (maxIterations >= 0 && iteration >= maxIterations) {
+            stopReason_ = "iterations";
+            break;
+        }
+        if (maxIterations < 0 && iterationsWithoutImprovement >= convergenceThreshold_) {
+            stopReason_ = "convergence";
+            break;
+        }
+        // Also before the first epoch: a stop requested during setup, or a
+        // budget the setup used up
+        if (const char* reason = earlyStopReason(bestTour_.getDistance(), 0.0)) {
+            stopReason_ = reason;
+            break;
+        }
+
+        // Run up to the next migration, callback or stopping point
+        int target = (maxIterations >= 0) ? maxIterations
+                                          : iteration + convergenceThreshold_ - iterationsWithoutImprovement;
+        if (migrationInterval_ > 0) {
+            target = std::min(target, (iteration / migrationInterval_ + 1) * migrationInterval_);
+        }
+        if (activeCallback && callbackInterval_ > 0) {
+            target = std::min(target, (iteration / callbackInterval_ + 1) * callbackInterval_);
+        }
+
+        int completed = iteration + runEpoch(target - iteration);
+        bool halted = completed < target || !stopReason_.empty();
+        target = completed;
+        collectResults(iteration, target);
+
+        for (int t = iteration; t < target; ++t) {
+            if (iterationBestDistances_[t] < runningBest) {
+                runningBest = iterationBestDistances_[t];
+                iterationsWithoutImprovement = 0;
+            } else {
+                iterationsWithoutImprovement++;
+            }
+        }
+        iteration = target;
+
+        if (halted) {
+            break;
+        }
+
+        bool finished = (maxIterations >= 0) ? iteration >= maxIterations
+                                             : iterationsWithoutImprovement >= convergenceThreshold_;
+        if (!finished && migrationInterval_ > 0 && iteration % migrationInterval_ == 0) {
+            migrate();
+        }
+
+        if (activeCallback && callbackInterval_ > 0 && iteration % callbackInterval_ == 0) {
+            activeCallback(iteration, bestTour_.getDistance(), bestTour_.getSequence(),
+                           iterationBestDistances_);
+        }
+    }
+
+    // Stopped before any iteration: the colonies' warm starts, or the nearest
+    // neighbor tour rather than an empty one
+    if (bestTour_.getSequence().empty()) {
+        collectResults(iteration, iteration);
+    }
+    const Graph& graph = colonies_.front()->getGraph();
+    if (bestTour_.getSequence().empty() && graph.getNumCities() > 0) {
+        std::vector<int> sequence = graph.nearestNeighborTour();
+        double length = 0.0;
+        for (size_t i = 0; i < sequence.size(); ++i) {
+            length += graph.getDistanceUnchecked(sequence[i], sequence[(i + 1) % sequence.size()]);
+        }
+        bestTour_ = Tour(sequence, length);
+    }
+
+    // A request consumed by this run must not stop the next one
+    stopRequested_.store(false);
+    return bestTour_;
+}
+
+void MultiColony::setTimeLimit(double seconds) {
+    timeLimit_ = std::max(0.0, seconds);
+}
+
+void MultiColony::setTargetDistance(double distance) {
+    targetDistance_ = std::max(0.0, distance);
+}
+
+void MultiColony::requestStop() {
+    stopRequested_.store(true);
+}
+
+void MultiColony::setSeed(std::uint64_t seed) {
+    std::uint64_t state = seed;
+    for (auto& colony : colonies_) {
+        colony->setSeed(Xoshiro256::splitMix64(state));
+    }
+}
+
+void MultiColony::setMigrationInterval(int iterations) {
+    migrationInterval_ = std::max(0, iterations);
+}
+
+void MultiColony::setMigrationTopology(const std::string& topology) {
+    if (topology == "ring" || topology == "broadcast") {
+        migrationTopology_ = topology;
+    }
+}
+
+void MultiColony::setNumThreads(int numThreads) {
+    numThreads_ = std::max(0, numThreads);
+}
+
+void MultiColony::setProgressCallback(ProgressCallback callback) {
+    progressCallback_ = callback;
+}
+
+void MultiColony::setCallbackInterval(int interval) {
+    callbackInterval_ = interval;
+}
+
+void MultiColony::setConvergenceThreshold(int threshold) {
+    convergenceThreshold_ = threshold;
+}
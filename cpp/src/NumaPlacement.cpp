@@ -0,0 +1,202 @@
+/**
+ * @file NumaPlacement.cpp
+ * @brief Topology discovery and OpenMP thread binding (Linux sysfs)
+ */
+
+#include "NumaPlacement.h"
+#include <atomic>
+#include <cctype>
+#include <fstream>
+#include <set>
+#include <sstream>
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+namespace {
+
+std::atomic<bool> firstTouchEnabled{true};
+
+// Parse a sysfs CPU list ("0-3,8,10-11")
+std::vector<int> parseCpuList(const std::string& text) {
+    std::vector<int> cpus;
+    std::stringstream stream(text);
+    std::string range;
+    while (std::getline(stream, range, ',')) {
+        if (range.empty() || !std::isdigit(static_cast<unsigned char>(range[0]))) {
+            continue;
+        }
+        std::size_t dash = range.find('-');
+        int first = std::stoi(range.substr(0, dash));
+        int last = (dash == std::string::npos) ? first : std::stoi(range.substr(dash + 1));
+        for (int cpu = first; cpu <= last; ++cpu) {
+            cpus.push_back(cpu);
+        }
+    }
+    return cpus;
+}
+
+#ifdef __linux__
+// CPUs in the affinity mask the process started with
+std::set<int> allowedCpus() {
+    std::set<int> cpus;
+    cpu_set_t mask;
+    CPU_ZERO(&mask);
+    if (sched_getaffinity(0, sizeof(mask), &mask) != 0) {
+        return cpus;
+    }
+    for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+        if (CPU_ISSET(cpu, &mask)) {
+            cpus.insert(cpu);
+        }
+    }
+    return cpus;
+}
+#endif
+
+}  // namespace
+
+namespace numa {
+
+void setFirstTouchEnabled(bool enabled) {
+    firstTouchEnabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool isFirstTouchEnabled() {
+    return firstTouchEnabled.load(std::memory_order_relaxed);
+}
+
+bool parseThreadBinding(const std::string& name, ThreadBinding& binding) {
+    if (name == "none") {
+        binding = ThreadBinding::NONE;
+    } else if (name == "close") {
+        binding = ThreadBinding::CLOSE;
+    } else if (name == "spread") {
+        binding = ThreadBinding::SPREAD;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+const char* threadBindingName(ThreadBinding binding) {
+    switch (binding) {
+        case ThreadBinding::NONE:
+            return "none";
+        case ThreadBinding::CLOSE:
+            return "close";
+        case ThreadBinding::SPREAD:
+            return "spread";
+    }
+    return "none";
+}
+
+std::vector<std::vector<int>> nodeCpus() {
+    std::vector<std::vector<int>> nodes;
+#ifdef __linux__
+    // Computed once: the topology and the startup mask do not change, and
+    // bindThreads() narrows the mask of the threads it pins
+    static const std::vector<std::vector<int>> topology = [] {
+        std::vector<std::vector<int>> result;
+        std::set<int> allowed = allowedCpus();
+        if (allowed.empty()) {
+            return result;
+        }
+        for (int node = 0;; ++node) {
+            std::ifstream file("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+            if (!file) {
+                break;
+            }
+            std::string text;
+            std::getline(file, text);
+            std::vector<int> cpus;
+            for (int cpu : parseCpuList(text)) {
+                if (allowed.count(cpu) > 0) {
+                    cpus.push_back(cpu);
+                }
+            }
+            if (!cpus.empty()) {
+                result.push_back(std::move(cpus));
+            }
+        }
+        if (result.empty()) {
+            result.emplace_back(allowed.begin(), allowed.end());  // No sysfs topology: one node
+        }
+        return result;
+    }();
+    nodes = topology;
+#endif
+    return nodes;
+}
+
+int numNodes() {
+    return std::max<int>(1, static_cast<int>(nodeCpus().size()));
+}
+
+std::vector<int> threadCpus(const std::vector<std::vector<int>>& nodes,
+                            ThreadBinding binding, int numThreads) {
+    std::vector<int> order;
+    if (binding == ThreadBinding::CLOSE) {
+        for (const std::vector<int>& cpus : nodes) {
+            order.insert(order.end(), cpus.begin(), cpus.end());
+        }
+    } else if (binding == ThreadBinding::SPREAD) {
+        // One CPU of every node in turn, until all nodes are used up
+        for (std::size_t k = 0;; ++k) {
+            bool added = false;
+            for (const std::vector<int>& cpus : nodes) {
+                if (k < cpus.size()) {
+                    order.push_back(cpus[k]);
+                    added = true;
+                }
+            }
+            if (!added) {
+                break;
+            }
+        }
+    }
+
+    std::vector<int> placement;
+    if (order.empty() || numThreads <= 0) {
+        return placement;
+    }
+    placement.reserve(numThreads);
+    for (int t = 0; t < numThreads; ++t) {
+        placement.push_back(order[t % order.size()]);
+    }
+    return placement;
+}
+
+bool bindThreads(ThreadBinding binding, int numThreads) {
+    if (binding == ThreadBinding::NONE) {
+        return true;
+    }
+#if defined(__linux__) && defined(_OPENMP)
+    int team = (numThreads > 0) ? numThreads : omp_get_max_threads();
+    std::vector<int> placement = threadCpus(nodeCpus(), binding, team);
+    if (placement.empty()) {
+        return false;
+    }
+
+    std::atomic<int> pinned{0};
+    #pragma omp parallel num_threads(team)
+    {
+        int thread = omp_get_thread_num();
+        if (thread < static_cast<int>(placement.size())) {
+            cpu_set_t mask;
+            CPU_ZERO(&mask);
+            CPU_SET(placement[thread], &mask);
+            if (sched_setaffinity(0, sizeof(mask), &mask) == 0) {
+                pinned.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    }
+    return pinned.load() == team;
+#else
+    (void)numThreads;
+    return false;
+#endif
+}
+
+}  // namespace numa
@@ -1,39 +1,84 @@
 #include "PheromoneMatrix.h"
+#include "NumaPlacement.h"
+#include "Power.h"
 #include <algorithm>
+#include <cmath>
 #include <limits>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+// Per-thread buffers for fusedUpdate(), reused across iterations
+namespace {
+struct FusedScratch {
+    std::vector<double> rowDeposits;  // Dense deposits of the current row (kept zeroed)
+    std::vector<int> rowStart;        // CSR offsets of the block's deposits by row
+    std::vector<int> columns;
+    std::vector<double> amounts;
+};
+
+FusedScratch& fusedScratch() {
+    thread_local FusedScratch scratch;
+    return scratch;
+}
+
+// Fused row kernel: tau = clamp(tau * factor + pending), pending = 0,
+// choice = tau * heuristic (choice may be null). Kept out of line with
+// restrict parameters so the compiler vectorizes it.
+void updateRow(double* __restrict row, double* __restrict pending,
+               double* __restrict choice, const double* __restrict heuristic,
+               int n, double factor, double lower, double upper) {
+    if (choice) {
+        for (int b = 0; b < n; ++b) {
+            double value = std::max(lower, std::min(upper, row[b] * factor + pending[b]));
+            pending[b] = 0.0;
+            row[b] = value;
+            choice[b] = value * heuristic[b];
+        }
+    } else {
+        for (int b = 0; b < n; ++b) {
+            row[b] = std::max(lower, std::min(upper, row[b] * factor + pending[b]));
+            pending[b] = 0.0;
+        }
+    }
+}
+}
+
 PheromoneMatrix::PheromoneMatrix(int numCities, double initial)
     : numCities_(numCities),
+      rowStride_(alignedRowStride<double>(numCities)),
       initialPheromone_(initial),
       minPheromone_(0.0),
       maxPheromone_(std::numeric_limits<double>::max()) {
-    // Initialize matrix with initial pheromone value
-    pheromones_.resize(numCities_, std::vector<double>(numCities_, initial));
+    // Initialize matrix with initial pheromone value, first touched in the
+    // static row blocks the updates use, so each thread's rows are local
+    pheromones_.resize(static_cast<std::size_t>(numCities_) * rowStride_);
+    numa::firstTouchRows(pheromones_.data(), numCities_, rowStride_, initial);
 }
 
 void PheromoneMatrix::initialize(double value) {
-    for (int i = 0; i < numCities_; ++i) {
-        for (int j = 0; j < numCities_; ++j) {
-            pheromones_[i][j] = value;
-        }
-    }
-}
-
-double PheromoneMatrix::getPheromone(int cityA, int cityB) const {
-    return pheromones_[cityA][cityB];
+    numa::firstTouchRows(pheromones_.data(), numCities_, rowStride_, value);
 }
 
 void PheromoneMatrix::setPheromone(int cityA, int cityB, double value) {
-    pheromones_[cityA][cityB] = value;
+    pheromones_[index(cityA, cityB)] = value;
     // Keep matrix symmetric for undirected TSP
-    pheromones_[cityB][cityA] = value;
+    pheromones_[index(cityB, cityA)] = value;
 }
 
 void PheromoneMatrix::evaporate(double rho) {
-    for (int i = 0; i < numCities_; ++i) {
-        for (int j = 0; j < numCities_; ++j) {
-            pheromones_[i][j] *= (1.0 - rho);
-        }
+    // Single linear sweep over the whole buffer (row padding included),
+    // which the compiler turns into straight vector multiplies
+    const double factor = 1.0 - rho;
+    double* data = pheromones_.data();
+    const std::size_t size = pheromones_.size();
+
+    #ifdef _OPENMP
+    #pragma omp simd
+    #endif
+    for (std::size_t i = 0; i < size; ++i) {
+        data[i] *= factor;
     }
 }
 
@@ -42,22 +87,170 @@ void PheromoneMatrix::depositPheromone(int cityA, int cityB, double amount) {
     #ifdef _OPENMP
     #pragma omp atomic
     #endif
-    pheromones_[cityA][cityB] += amount;
+    pheromones_[index(cityA, cityB)] += amount;
 
     // Keep matrix symmetric for undirected TSP (only if different cities)
     if (cityA != cityB) {
         #ifdef _OPENMP
         #pragma omp atomic
         #endif
-        pheromones_[cityB][cityA] += amount;
+        pheromones_[index(cityB, cityA)] += amount;
+    }
+}
+
+void PheromoneMatrix::depositPheromones(const PheromoneDeposits& deposits, bool parallel) {
+    const int numBlocks = deposits.getNumBlocks();
+    const int numSources = deposits.getNumSources();
+    double* data = pheromones_.data();
+
+    // Block b holds every edge with an endpoint in its rows and writes only
+    // the cells of those rows, so no two blocks share a cell
+    #ifdef _OPENMP
+    #pragma omp parallel for schedule(static) if(parallel && numBlocks > 1)
+    #endif
+    for (int block = 0; block < numBlocks; ++block) {
+        const int firstRow = deposits.getBlockBegin(block);
+        const int endRow = deposits.getBlockBegin(block + 1);
+        for (int source = 0; source < numSources; ++source) {
+            for (const PheromoneDeposits::EdgeDeposit& deposit : deposits.bucket(source, block)) {
+                if (deposit.cityA >= firstRow && deposit.cityA < endRow) {
+                    data[index(deposit.cityA, deposit.cityB)] += deposit.amount;
+                }
+                if (deposit.cityB >= firstRow && deposit.cityB < endRow) {
+                    data[index(deposit.cityB, deposit.cityA)] += deposit.amount;
+                }
+            }
+        }
+    }
+}
+
+void PheromoneMatrix::fusedUpdate(double rho, const PheromoneDeposits& deposits,
+                                  const ChoiceInfoView* choiceInfo, bool parallel) {
+    const int n = numCities_;
+    const double factor = 1.0 - rho;
+    const double lower = minPheromone_;
+    const double upper = maxPheromone_;
+    const bool hasDeposits = deposits.getNumCities() == n && deposits.getNumBlocks() > 0;
+    const int numBlocks = hasDeposits ? deposits.getNumBlocks() : 1;
+    const int numSources = hasDeposits ? deposits.getNumSources() : 0;
+    double* data = pheromones_.data();
+
+    #ifdef _OPENMP
+    #pragma omp parallel for schedule(static) if(parallel && numBlocks > 1)
+    #endif
+    for (int block = 0; block < numBlocks; ++block) {
+        const int firstRow = hasDeposits ? deposits.getBlockBegin(block) : 0;
+        const int endRow = hasDeposits ? deposits.getBlockBegin(block + 1) : n;
+        const int numRows = endRow - firstRow;
+
+        // Gather the block's own deposits (every edge touching its rows),
+        // grouped by row. Visiting them in source order keeps the per-cell
+        // summation order, and so the symmetry, fixed.
+        FusedScratch& scratch = fusedScratch();
+        scratch.rowDeposits.resize(n, 0.0);
+        scratch.rowStart.assign(numRows + 1, 0);
+        auto forEachDeposit = [&](auto&& visit) {
+            for (int source = 0; source < numSources; ++source) {
+                for (const PheromoneDeposits::EdgeDeposit& deposit : deposits.bucket(source, block)) {
+                    if (deposit.cityA >= firstRow && deposit.cityA < endRow) {
+                        visit(deposit.cityA, deposit.cityB, deposit.amount);
+                    }
+                    if (deposit.cityB >= firstRow && deposit.cityB < endRow) {
+                        visit(deposit.cityB, deposit.cityA, deposit.amount);
+                    }
+                }
+            }
+        };
+        forEachDeposit([&](int row, int, double) { scratch.rowStart[row - firstRow + 1]++; });
+        for (int r = 0; r < numRows; ++r) {
+            scratch.rowStart[r + 1] += scratch.rowStart[r];
+        }
+        scratch.columns.resize(scratch.rowStart[numRows]);
+        scratch.amounts.resize(scratch.rowStart[numRows]);
+        forEachDeposit([&](int row, int column, double amount) {
+            int slot = scratch.rowStart[row - firstRow]++;
+            scratch.columns[slot] = column;
+            scratch.amounts[slot] = amount;
+        });
+        // rowStart[r] now holds the end of row r; shift back to starts
+        for (int r = numRows; r > 0; --r) {
+            scratch.rowStart[r] = scratch.rowStart[r - 1];
+        }
+        scratch.rowStart[0] = 0;
+
+        double* rowDeposits = scratch.rowDeposits.data();
+        for (int a = firstRow; a < endRow; ++a) {
+            for (int slot = scratch.rowStart[a - firstRow]; slot < scratch.rowStart[a - firstRow + 1]; ++slot) {
+                rowDeposits[scratch.columns[slot]] += scratch.amounts[slot];
+            }
+
+            // One streaming sweep over the row (choice info too when alpha = 1)
+            double* row = data + static_cast<std::size_t>(a) * rowStride_;
+            bool linearChoice = choiceInfo && choiceInfo->alpha == 1.0;
+            updateRow(row, rowDeposits,
+                      linearChoice ? choiceInfo->choice + static_cast<std::size_t>(a) * choiceInfo->stride : nullptr,
+                      linearChoice ? choiceInfo->heuristic + static_cast<std::size_t>(a) * choiceInfo->stride : nullptr,
+                      n, factor, lower, upper);
+
+            // Other alphas: refresh while the row is in cache (integer alpha as
+            // multiplications, which vectorize; anything else through std::pow)
+            if (choiceInfo && !linearChoice) {
+                double* choiceRow = choiceInfo->choice + static_cast<std::size_t>(a) * choiceInfo->stride;
+                const double* heuristicRow = choiceInfo->heuristic + static_cast<std::size_t>(a) * choiceInfo->stride;
+                dispatchPower(choiceInfo->alpha, [&](auto power) {
+                    for (int b = 0; b < n; ++b) {
+                        choiceRow[b] = power(row[b]) * heuristicRow[b];
+                    }
+                });
+            }
+        }
     }
 }
 
 void PheromoneMatrix::clampPheromones() {
-    for (int i = 0; i < numCities_; ++i) {
-        for (int j = 0; j < numCities_; ++j) {
-            pheromones_[i][j] = std::max(minPheromone_,
-                                        std::min(maxPheromone_, pheromones_[i][j]));
+    const double lower = minPheromone_;
+    const double upper = maxPheromone_;
+    double* data = pheromones_.data();
+    const std::size_t size = pheromones_.size();
+
+    #ifdef _OPENMP
+    #pragma omp simd
+    #endif
+    for (std::size_t i = 0; i < size; ++i) {
+        data[i] = std::max(lower, std::min(upper, data[i]));
+    }
+}
+
+void PheromoneDeposits::reset(int numSources, int numCities, int numBlocks) {
+    numBlocks = std::max(1, std::min(numBlocks, std::max(1, numCities)));
+
+    if (numCities != numCities_ || numBlocks != numBlocks_) {
+        // Every pass sweeps whole rows, so blocks get equal row counts, cut
+        // like schedule(static): the first numCities % numBlocks get one more
+        numCities_ = numCities;
+        numBlocks_ = numBlocks;
+        rowBlock_.assign(numCities, 0);
+        blockBegin_.assign(numBlocks + 1, numCities);
+        const int rows = numCities / numBlocks;
+        const int extra = numCities % numBlocks;
+        for (int block = 0; block < numBlocks; ++block) {
+            blockBegin_[block] = block * rows + std::min(block, extra);
         }
+        for (int block = 0; block < numBlocks; ++block) {
+            std::fill(rowBlock_.begin() + blockBegin_[block], rowBlock_.begin() + blockBegin_[block + 1], block);
+        }
+    }
+
+    numSources_ = numSources;
+    buckets_.resize(static_cast<std::size_t>(numSources) * numBlocks_);
+    for (std::vector<EdgeDeposit>& deposits : buckets_) {
+        deposits.clear();
+    }
+}
+
+void PheromoneDeposits::addTour(int source, const std::vector<int>& tour, double amount) {
+    const std::size_t n = tour.size();
+    for (std::size_t i = 0; i < n; ++i) {
+        add(source, tour[i], tour[i + 1 == n ? 0 : i + 1], amount);
     }
 }
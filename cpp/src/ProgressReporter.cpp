@@ -0,0 +1,95 @@
+#include "ProgressReporter.h"
+#include <iterator>
+#include <utility>
+
+ProgressReporter::ProgressReporter(Callback callback, bool asynchronous)
+    : callback_(std::move(callback)), asynchronous_(asynchronous) {
+    if (asynchronous_) {
+        worker_ = std::thread(&ProgressReporter::run, this);
+    }
+}
+
+ProgressReporter::~ProgressReporter() {
+    if (worker_.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        ready_.notify_one();
+        worker_.join();
+    }
+}
+
+void ProgressReporter::publish(ProgressUpdate&& update) {
+    if (!asynchronous_) {
+        callback_(update);
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (error_) {
+            return;  // The callback failed; finish() reports it
+        }
+        if (hasPending_) {
+            merge(pending_, std::move(update));
+        } else {
+            pending_ = std::move(update);
+            hasPending_ = true;
+        }
+    }
+    ready_.notify_one();
+}
+
+void ProgressReporter::finish() {
+    if (!worker_.joinable()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        finishing_ = true;
+    }
+    ready_.notify_one();
+    worker_.join();
+    if (error_) {
+        std::rethrow_exception(error_);
+    }
+}
+
+void ProgressReporter::run() {
+    ProgressUpdate update;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            ready_.wait(lock, [this] { return hasPending_ || finishing_ || stopping_; });
+            if (stopping_ || (!hasPending_ && finishing_)) {
+                return;
+            }
+            update = std::move(pending_);
+            pending_ = ProgressUpdate();
+            hasPending_ = false;
+        }
+
+        try {
+            callback_(update);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            error_ = std::current_exception();
+            hasPending_ = false;
+            return;
+        }
+    }
+}
+
+void ProgressReporter::merge(ProgressUpdate& pending, ProgressUpdate&& update) {
+    pending.iteration = update.iteration;
+    pending.bestDistance = update.bestDistance;
+    if (update.tourImproved) {
+        pending.tourImproved = true;
+        pending.bestTour = std::move(update.bestTour);
+    }
+    pending.newConvergence.insert(pending.newConvergence.end(),
+                                  std::make_move_iterator(update.newConvergence.begin()),
+                                  std::make_move_iterator(update.newConvergence.end()));
+    pending.profile = update.profile;
+    pending.final = pending.final || update.final;
+}
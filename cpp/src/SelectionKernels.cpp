@@ -0,0 +1,318 @@
+#include "SelectionKernels.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define SELECTION_HAVE_X86 1
+#include <immintrin.h>
+#endif
+
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#define SELECTION_HAVE_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace selection {
+
+namespace {
+
+// Partial sums per block; element i of a block goes to lane i % LANES
+constexpr int LANES = 8;
+
+// Pairwise combination of the lane sums, the same in every kernel
+inline double combineLanes(const double* lanes) {
+    return ((lanes[0] + lanes[1]) + (lanes[2] + lanes[3])) +
+           ((lanes[4] + lanes[5]) + (lanes[6] + lanes[7]));
+}
+
+// Remaining cities of a block after the vector loop (and the scalar kernel)
+inline void addTail(const double* weights, const std::uint8_t* visited, int begin, int from,
+                    int end, double* lanes) {
+    for (int i = from; i < end; ++i) {
+        lanes[(i - begin) % LANES] += visited[i] ? 0.0 : weights[i];
+    }
+}
+
+double blockSumsScalar(const double* weights, const std::uint8_t* visited, int n, double* sums) {
+    double total = 0.0;
+    for (int b = 0, begin = 0; begin < n; ++b, begin += BLOCK_SIZE) {
+        int end = std::min(n, begin + BLOCK_SIZE);
+        double lanes[LANES] = {};
+        addTail(weights, visited, begin, begin, end, lanes);
+        sums[b] = combineLanes(lanes);
+        total += sums[b];
+    }
+    return total;
+}
+
+double maxWeightScalar(const double* weights, const std::uint8_t* visited, int n) {
+    double best = -1.0;
+    for (int i = 0; i < n; ++i) {
+        if (!visited[i] && weights[i] > best) {
+            best = weights[i];
+        }
+    }
+    return best;
+}
+
+#ifdef SELECTION_HAVE_X86
+
+// Unvisited masks of 4 cities: all ones where visited[i] == 0
+__attribute__((target("avx2")))
+inline __m256i unvisitedMask4(__m128i bytes) {
+    return _mm256_cmpeq_epi64(_mm256_cvtepu8_epi64(bytes), _mm256_setzero_si256());
+}
+
+__attribute__((target("avx2")))
+double blockSumsAvx2(const double* weights, const std::uint8_t* visited, int n, double* sums) {
+    double total = 0.0;
+    for (int b = 0, begin = 0; begin < n; ++b, begin += BLOCK_SIZE) {
+        int end = std::min(n, begin + BLOCK_SIZE);
+        __m256d low = _mm256_setzero_pd();   // lanes 0-3
+        __m256d high = _mm256_setzero_pd();  // lanes 4-7
+        int i = begin;
+        for (; i + LANES <= end; i += LANES) {
+            __m128i bytes = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(visited + i));
+            __m256d maskLow = _mm256_castsi256_pd(unvisitedMask4(bytes));
+            __m256d maskHigh = _mm256_castsi256_pd(unvisitedMask4(_mm_srli_si128(bytes, 4)));
+            low = _mm256_add_pd(low, _mm256_and_pd(_mm256_loadu_pd(weights + i), maskLow));
+            high = _mm256_add_pd(high, _mm256_and_pd(_mm256_loadu_pd(weights + i + 4), maskHigh));
+        }
+        alignas(32) double lanes[LANES];
+        _mm256_store_pd(lanes, low);
+        _mm256_store_pd(lanes + 4, high);
+        addTail(weights, visited, begin, i, end, lanes);
+        sums[b] = combineLanes(lanes);
+        total += sums[b];
+    }
+    return total;
+}
+
+__attribute__((target("avx2")))
+double maxWeightAvx2(const double* weights, const std::uint8_t* visited, int n) {
+    const __m256d none = _mm256_set1_pd(-1.0);
+    __m256d best = none;
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        std::int32_t packed;
+        std::memcpy(&packed, visited + i, sizeof(packed));
+        __m256d mask = _mm256_castsi256_pd(unvisitedMask4(_mm_cvtsi32_si128(packed)));
+        best = _mm256_max_pd(best, _mm256_blendv_pd(none, _mm256_loadu_pd(weights + i), mask));
+    }
+    alignas(32) double lanes[4];
+    _mm256_store_pd(lanes, best);
+    double result = std::max(std::max(lanes[0], lanes[1]), std::max(lanes[2], lanes[3]));
+    return std::max(result, maxWeightScalar(weights + i, visited + i, n - i));
+}
+
+// Unvisited bits of 8 cities, from a byte compare (SSE2 only, which also
+// sidesteps the zero-extension intrinsics GCC 12 warns about)
+inline __mmask8 unvisitedMask8(const std::uint8_t* visited) {
+    __m128i bytes = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(visited));
+    return static_cast<__mmask8>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_setzero_si128())));
+}
+
+__attribute__((target("avx512f")))
+double blockSumsAvx512(const double* weights, const std::uint8_t* visited, int n, double* sums) {
+    double total = 0.0;
+    for (int b = 0, begin = 0; begin < n; ++b, begin += BLOCK_SIZE) {
+        int end = std::min(n, begin + BLOCK_SIZE);
+        __m512d acc = _mm512_setzero_pd();
+        int i = begin;
+        for (; i + LANES <= end; i += LANES) {
+            __mmask8 unvisited = unvisitedMask8(visited + i);
+            // Visited lanes keep their sum, exactly like adding 0.0
+            acc = _mm512_mask_add_pd(acc, unvisited, acc, _mm512_loadu_pd(weights + i));
+        }
+        alignas(64) double lanes[LANES];
+        _mm512_store_pd(lanes, acc);
+        addTail(weights, visited, begin, i, end, lanes);
+        sums[b] = combineLanes(lanes);
+        total += sums[b];
+    }
+    return total;
+}
+
+__attribute__((target("avx512f")))
+double maxWeightAvx512(const double* weights, const std::uint8_t* visited, int n) {
+    __m512d best = _mm512_set1_pd(-1.0);
+    int i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __mmask8 unvisited = unvisitedMask8(visited + i);
+        best = _mm512_mask_max_pd(best, unvisited, best, _mm512_loadu_pd(weights + i));
+    }
+    alignas(64) double lanes[8];
+    _mm512_store_pd(lanes, best);
+    double result = *std::max_element(lanes, lanes + 8);
+    return std::max(result, maxWeightScalar(weights + i, visited + i, n - i));
+}
+
+#endif  // SELECTION_HAVE_X86
+
+#ifdef SELECTION_HAVE_NEON
+
+// Unvisited masks of 8 cities, two per register
+inline void unvisitedMasks8(const std::uint8_t* visited, uint64x2_t* masks) {
+    uint16x8_t wide = vmovl_u8(vld1_u8(visited));
+    uint32x4_t low = vmovl_u16(vget_low_u16(wide));
+    uint32x4_t high = vmovl_u16(vget_high_u16(wide));
+    masks[0] = vceqzq_u64(vmovl_u32(vget_low_u32(low)));
+    masks[1] = vceqzq_u64(vmovl_u32(vget_high_u32(low)));
+    masks[2] = vceqzq_u64(vmovl_u32(vget_low_u32(high)));
+    masks[3] = vceqzq_u64(vmovl_u32(vget_high_u32(high)));
+}
+
+double blockSumsNeon(const double* weights, const std::uint8_t* visited, int n, double* sums) {
+    double total = 0.0;
+    for (int b = 0, begin = 0; begin < n; ++b, begin += BLOCK_SIZE) {
+        int end = std::min(n, begin + BLOCK_SIZE);
+        float64x2_t acc[4] = {vdupq_n_f64(0.0), vdupq_n_f64(0.0), vdupq_n_f64(0.0), vdupq_n_f64(0.0)};
+        int i = begin;
+        for (; i + LANES <= end; i += LANES) {
+            uint64x2_t masks[4];
+            unvisitedMasks8(visited + i, masks);
+            for (int r = 0; r < 4; ++r) {
+                uint64x2_t bits = vreinterpretq_u64_f64(vld1q_f64(weights + i + 2 * r));
+                acc[r] = vaddq_f64(acc[r], vreinterpretq_f64_u64(vandq_u64(bits, masks[r])));
+            }
+        }
+        double lanes[LANES];
+        for (int r = 0; r < 4; ++r) {
+            vst1q_f64(lanes + 2 * r, acc[r]);
+        }
+        addTail(weights, visited, begin, i, end, lanes);
+        sums[b] = combineLanes(lanes);
+        total += sums[b];
+    }
+    return total;
+}
+
+double maxWeightNeon(const double* weights, const std::uint8_t* visited, int n) {
+    const float64x2_t none = vdupq_n_f64(-1.0);
+    float64x2_t best = none;
+    int i = 0;
+    for (; i + LANES <= n; i += LANES) {
+        uint64x2_t masks[4];
+        unvisitedMasks8(visited + i, masks);
+        for (int r = 0; r < 4; ++r) {
+            best = vmaxq_f64(best, vbslq_f64(masks[r], vld1q_f64(weights + i + 2 * r), none));
+        }
+    }
+    return std::max(vmaxvq_f64(best), maxWeightScalar(weights + i, visited + i, n - i));
+}
+
+#endif  // SELECTION_HAVE_NEON
+
+const Kernels SCALAR_KERNELS = {blockSumsScalar, maxWeightScalar, Isa::SCALAR, "scalar"};
+#ifdef SELECTION_HAVE_X86
+const Kernels AVX2_KERNELS = {blockSumsAvx2, maxWeightAvx2, Isa::AVX2, "avx2"};
+const Kernels AVX512_KERNELS = {blockSumsAvx512, maxWeightAvx512, Isa::AVX512, "avx512"};
+#endif
+#ifdef SELECTION_HAVE_NEON
+const Kernels NEON_KERNELS = {blockSumsNeon, maxWeightNeon, Isa::NEON, "neon"};
+#endif
+
+const Kernels* detectKernels() {
+    for (Isa isa : {Isa::AVX512, Isa::AVX2, Isa::NEON}) {
+        if (isSupported(isa)) {
+            return &kernels(isa);
+        }
+    }
+    return &SCALAR_KERNELS;
+}
+
+std::atomic<const Kernels*>& activeSlot() {
+    static std::atomic<const Kernels*> active(detectKernels());
+    return active;
+}
+
+}  // namespace
+
+bool isSupported(Isa isa) {
+    switch (isa) {
+        case Isa::SCALAR:
+            return true;
+#ifdef SELECTION_HAVE_X86
+        case Isa::AVX2:
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("avx2");
+        case Isa::AVX512:
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("avx512f");
+#endif
+#ifdef SELECTION_HAVE_NEON
+        case Isa::NEON:
+            return true;
+#endif
+        default:
+            return false;
+    }
+}
+
+const Kernels& kernels(Isa isa) {
+    if (!isSupported(isa)) {
+        return SCALAR_KERNELS;
+    }
+    switch (isa) {
+#ifdef SELECTION_HAVE_X86
+        case Isa::AVX2:
+            return AVX2_KERNELS;
+        case Isa::AVX512:
+            return AVX512_KERNELS;
+#endif
+#ifdef SELECTION_HAVE_NEON
+        case Isa::NEON:
+            return NEON_KERNELS;
+#endif
+        default:
+            return SCALAR_KERNELS;
+    }
+}
+
+const Kernels& activeKernels() {
+    return *activeSlot().load(std::memory_order_relaxed);
+}
+
+bool setActiveIsa(Isa isa) {
+    if (!isSupported(isa)) {
+        return false;
+    }
+    activeSlot().store(&kernels(isa), std::memory_order_relaxed);
+    return true;
+}
+
+int pickFromBlocks(const double* weights, const std::uint8_t* visited, int n,
+                   const double* sums, double target) {
+    double cumulative = 0.0;
+    for (int b = 0, begin = 0; begin < n; ++b, begin += BLOCK_SIZE) {
+        double next = cumulative + sums[b];
+        if (target <= next && sums[b] > 0.0) {
+            int end = std::min(n, begin + BLOCK_SIZE);
+            int last = -1;
+            for (int i = begin; i < end; ++i) {
+                if (!visited[i]) {
+                    cumulative += weights[i];
+                    last = i;
+                    if (target <= cumulative) {
+                        return i;
+                    }
+                }
+            }
+            return last;
+        }
+        cumulative = next;
+    }
+    return -1;
+}
+
+int findWeight(const double* weights, const std::uint8_t* visited, int n, double best) {
+    for (int i = 0; i < n; ++i) {
+        if (!visited[i] && weights[i] == best) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+}  // namespace selection
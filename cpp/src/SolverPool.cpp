@@ -0,0 +1,149 @@
+#include "SolverPool.h"
+#include <algorithm>
+#include <exception>
+#include <stdexcept>
+#include <utility>
+
+namespace {
+
+double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+}  // namespace
+
+bool SolverPool::EntryOrder::operator()(const std::shared_ptr<Entry>& a,
+                                        const std::shared_ptr<Entry>& b) const {
+    if (a->job.priority != b->job.priority) {
+        return a->job.priority < b->job.priority;
+    }
+    return a->sequence > b->sequence;
+}
+
+SolverPool::SolverPool(int numThreads) {
+    if (numThreads <= 0) {
+        numThreads = static_cast<int>(std::thread::hardware_concurrency());
+    }
+    numThreads_ = std::max(1, numThreads);
+    freeSlots_ = numThreads_;
+
+    // A running job holds at least one slot, so numThreads_ workers can
+    // always take the head job once its slots are free
+    workers_.reserve(numThreads_);
+    for (int i = 0; i < numThreads_; ++i) {
+        workers_.emplace_back(&SolverPool::run, this);
+    }
+}
+
+SolverPool::~SolverPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    changed_.notify_all();
+    for (std::thread& worker : workers_) {
+        worker.join();
+    }
+}
+
+std::future<SolverResult> SolverPool::submit(SolverJob job) {
+    auto entry = std::make_shared<Entry>();
+    std::future<SolverResult> future = entry->promise.get_future();
+    if (!job.graph || !job.graph->isValid() || job.numAnts < 1) {
+        entry->promise.set_exception(std::make_exception_ptr(
+            std::invalid_argument("SolverPool job needs a non-empty graph and numAnts >= 1")));
+        return future;
+    }
+
+    entry->job = std::move(job);
+    entry->submitted = std::chrono::steady_clock::now();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        entry->sequence = nextSequence_++;
+        queue_.push(std::move(entry));
+    }
+    changed_.notify_all();
+    return future;
+}
+
+void SolverPool::waitIdle() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    changed_.wait(lock, [this] { return queue_.empty() && running_ == 0; });
+}
+
+int SolverPool::getQueuedJobs() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return static_cast<int>(queue_.size());
+}
+
+int SolverPool::getRunningJobs() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return running_;
+}
+
+int SolverPool::budget(const SolverJob& job) const {
+    return std::clamp(job.threads, 1, numThreads_);
+}
+
+void SolverPool::run() {
+    while (true) {
+        std::shared_ptr<Entry> entry;
+        int slots = 0;
+        {
+            // Only the head job may start, so it is never overtaken
+            std::unique_lock<std::mutex> lock(mutex_);
+            changed_.wait(lock, [this] {
+                return (!queue_.empty() && budget(queue_.top()->job) <= freeSlots_) ||
+                       (stopping_ && queue_.empty());
+            });
+            if (queue_.empty()) {
+                return;  // Stopping and nothing left to run
+            }
+            entry = queue_.top();
+            queue_.pop();
+            slots = budget(entry->job);
+            freeSlots_ -= slots;
+            ++running_;
+        }
+
+        // The next head job may fit into the remaining slots
+        changed_.notify_all();
+
+        const double waitSeconds = secondsSince(entry->submitted);
+        try {
+            SolverResult result = execute(entry->job, slots);
+            result.waitSeconds = waitSeconds;
+            entry->promise.set_value(std::move(result));
+        } catch (...) {
+            entry->promise.set_exception(std::current_exception());
+        }
+
+        // Release the graph and callbacks before the job counts as done
+        entry.reset();
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            freeSlots_ += slots;
+            --running_;
+        }
+        changed_.notify_all();
+    }
+}
+
+SolverResult SolverPool::execute(SolverJob& job, int threads) {
+    const auto start = std::chrono::steady_clock::now();
+    AntColony colony(job.graph, job.numAnts, job.alpha, job.beta, job.rho, job.Q);
+    if (job.configure) {
+        job.configure(colony);
+    }
+
+    // The budget overrides whatever configure() set
+    colony.setUseParallel(threads > 1);
+    colony.setNumThreads(threads);
+
+    SolverResult result;
+    result.tour = colony.solve(job.maxIterations);
+    result.convergence = colony.getConvergenceData();
+    result.stopReason = colony.getStopReason();
+    result.solveSeconds = secondsSince(start);
+    return result;
+}
@@ -4,11 +4,18 @@
  */
 
 #include "TSPLoader.h"
-#include <fstream>
-#include <sstream>
-#include <iostream>
+#include <algorithm>
+#include <charconv>
 #include <cmath>
+#include <cstring>
+#include <iostream>
 #include <sys/stat.h>
+#include "GraphCache.h"
+#include "MappedFile.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 // Helper function to check if a file exists
 static bool fileExists(const std::string& path) {
@@ -40,26 +47,520 @@ static std::string findFile(const std::string& filename) {
     return filename; // Return original name to preserve error messages
 }
 
+namespace {
+
+// Numeric sections smaller than this are parsed by one thread
+constexpr std::size_t PARALLEL_PARSE_BYTES = std::size_t(1) << 20;
+
+inline bool isSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f' || c == '\v';
+}
+
+inline bool isLetter(char c) {
+    return (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z');
+}
+
+// Strip leading and trailing whitespace
+std::string_view trim(std::string_view text) {
+    while (!text.empty() && isSpace(text.front())) {
+        text.remove_prefix(1);
+    }
+    while (!text.empty() && isSpace(text.back())) {
+        text.remove_suffix(1);
+    }
+    return text;
+}
+
+/**
+ * Cursor over the whitespace-separated numbers of a buffer. Numbers are
+ * parsed in place with std::from_chars; a token is only accepted if the
+ * whole token is a number.
+ */
+class Scanner {
+public:
+    Scanner(const char* begin, const char* end) : pos_(begin), end_(end) {}
+
+    bool atEnd() {
+        skipSpace();
+        return pos_ >= end_;
+    }
+
+    template <typename T>
+    bool nextNumber(T& value) {
+        skipSpace();
+        const char* start = pos_;
+        if (start < end_ && *start == '+') {
+            ++start;  // from_chars rejects an explicit plus sign
+        }
+        auto result = std::from_chars(start, end_, value);
+        if (result.ec != std::errc() || (result.ptr < end_ && !isSpace(*result.ptr))) {
+            return false;
+        }
+        pos_ = result.ptr;
+        return true;
+    }
+
+    const char* position() const { return pos_; }
+
+private:
+    const char* pos_;
+    const char* end_;
+
+    void skipSpace() {
+        while (pos_ < end_ && isSpace(*pos_)) {
+            ++pos_;
+        }
+    }
+};
+
+/**
+ * Parse every number in [begin, end) into values. Large ranges are split
+ * at token boundaries into one chunk per thread; each chunk is parsed into
+ * its own buffer and the buffers are concatenated in order.
+ *
+ * @return false if a token is not a number
+ */
+bool parseNumbers(const char* begin, const char* end, std::vector<double>& values) {
+    std::size_t bytes = static_cast<std::size_t>(end - begin);
+    int numChunks = 1;
+#ifdef _OPENMP
+    if (bytes >= PARALLEL_PARSE_BYTES) {
+        std::size_t maxChunks = bytes / (PARALLEL_PARSE_BYTES / 4);
+        numChunks = static_cast<int>(std::min<std::size_t>(omp_get_max_threads(), maxChunks));
+        numChunks = std::max(1, numChunks);
+    }
+#endif
+
+    // Chunk boundaries moved forward to the next whitespace, so no token is split
+    std::vector<const char*> bounds(numChunks + 1);
+    bounds[0] = begin;
+    bounds[numChunks] = end;
+    for (int c = 1; c < numChunks; ++c) {
+        const char* p = begin + bytes * c / numChunks;
+        while (p < end && !isSpace(*p)) {
+            ++p;
+        }
+        bounds[c] = std::max(p, bounds[c - 1]);
+    }
+
+    std::vector<std::vector<double>> parts(numChunks);
+    std::vector<char> valid(numChunks, 1);
+
+    #ifdef _OPENMP
+    #pragma omp parallel for schedule(static, 1) num_threads(numChunks) if (numChunks > 1)
+    #endif
+    for (int c = 0; c < numChunks; ++c) {
+        std::vector<double>& part = parts[c];
+        part.reserve(static_cast<std::size_t>(bounds[c + 1] - bounds[c]) / 4);
+        Scanner scanner(bounds[c], bounds[c + 1]);
+        double value;
+        while (!scanner.atEnd()) {
+            if (!scanner.nextNumber(value)) {
+                valid[c] = 0;
+                break;
+            }
+            part.push_back(value);
+        }
+    }
+
+    if (std::find(valid.begin(), valid.end(), 0) != valid.end()) {
+        return false;
+    }
+
+    if (numChunks == 1) {
+        values.swap(parts[0]);
+        return true;
+    }
+    std::size_t total = 0;
+    for (const auto& part : parts) {
+        total += part.size();
+    }
+    values.clear();
+    values.reserve(total);
+    for (const auto& part : parts) {
+        values.insert(values.end(), part.begin(), part.end());
+    }
+    return true;
+}
+
+// Start of the first line at or after begin whose first character is a
+// letter: the next TSPLIB keyword (or EOF) after a numeric section
+const char* findSectionEnd(const char* begin, const char* end) {
+    const char* line = begin;
+    while (line < end) {
+        const char* p = line;
+        while (p < end && (*p == ' ' || *p == '\t')) {
+            ++p;
+        }
+        if (p < end && isLetter(*p)) {
+            return line;
+        }
+        const void* newline = std::memchr(p, '\n', static_cast<std::size_t>(end - p));
+        if (newline == nullptr) {
+            return end;
+        }
+        line = static_cast<const char*>(newline) + 1;
+    }
+    return end;
+}
+
+// Offset of (i, j), i < j, in a strict upper triangle (Graph's triangular order)
+inline std::size_t upperIndex(std::size_t n, std::size_t i, std::size_t j) {
+    return i * (2 * n - i - 1) / 2 + (j - i - 1);
+}
+
+/**
+ * Rearrange TSPLIB EDGE_WEIGHT_SECTION values into a strict upper triangle.
+ * Diagonal entries are dropped; FULL_MATRIX uses its upper triangle.
+ */
+bool toUpperTriangle(std::vector<double>& values, int numCities, std::string_view format,
+                     std::vector<double>& upper) {
+    const std::size_t n = static_cast<std::size_t>(numCities);
+    const std::size_t triangle = n * (n - 1) / 2;
+
+    std::size_t expected;
+    if (format == "FULL_MATRIX") {
+        expected = n * n;
+    } else if (format == "UPPER_ROW" || format == "LOWER_ROW") {
+        expected = triangle;
+    } else if (format == "UPPER_DIAG_ROW" || format == "LOWER_DIAG_ROW") {
+        expected = triangle + n;
+    } else {
+        std::cerr << "Error: Unsupported EDGE_WEIGHT_FORMAT: " << format << std::endl;
+        return false;
+    }
+    if (values.size() < expected) {
+        std::cerr << "Error: Expected " << expected << " edge weights, but read "
+                  << values.size() << std::endl;
+        return false;
+    }
+
+    // UPPER_ROW already is the target layout
+    if (format == "UPPER_ROW") {
+        values.resize(triangle);
+        upper.swap(values);
+    } else {
+        upper.assign(triangle, 0.0);
+        std::size_t k = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            if (format == "FULL_MATRIX") {
+                for (std::size_t j = i + 1; j < n; ++j) {
+                    upper[upperIndex(n, i, j)] = values[i * n + j];
+                }
+            } else if (format == "UPPER_DIAG_ROW") {
+                k++;  // d(i, i)
+                for (std::size_t j = i + 1; j < n; ++j) {
+                    upper[upperIndex(n, i, j)] = values[k++];
+                }
+            } else {
+                // Row i of a lower triangle holds d(i, 0) .. d(i, i-1) (and d(i, i))
+                for (std::size_t j = 0; j < i; ++j) {
+                    upper[upperIndex(n, j, i)] = values[k++];
+                }
+                if (format == "LOWER_DIAG_ROW") {
+                    k++;
+                }
+            }
+        }
+    }
+
+    for (std::size_t e = 0; e < upper.size(); ++e) {
+        if (!std::isfinite(upper[e]) || upper[e] < 0.0) {
+            std::cerr << "Error: Invalid edge weight in EDGE_WEIGHT_SECTION" << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+// Turn (id, x, y) triples into cities (TSPLIB ids are 1-based)
+bool toCities(const std::vector<double>& triples, std::vector<City>& cities) {
+    if (triples.size() % 3 != 0) {
+        std::cerr << "Error: Coordinate section must hold 'id x y' triples" << std::endl;
+        return false;
+    }
+    cities.clear();
+    cities.reserve(triples.size() / 3);
+    for (std::size_t t = 0; t < triples.size(); t += 3) {
+        int id = static_cast<int>(triples[t]);
+        double x = triples[t + 1];
+        double y = triples[t + 2];
+        if (!std::isfinite(x) || !std::isfinite(y)) {
+            std::cerr << "Error: Invalid coordinates for city " << id << std::endl;
+            return false;
+        }
+        cities.push_back(City(id - 1, x, y));
+    }
+    return true;
+}
+
+Graph parseCoordinates(std::string_view contents, DistanceStorage storage) {
+    Scanner scanner(contents.data(), contents.data() + contents.size());
+
+    // Read number of cities from first line
+    int numCities = 0;
+    if (!scanner.nextNumber(numCities) || numCities <= 0) {
+        std::cerr << "Error: Invalid number of cities: " << numCities << std::endl;
+        return Graph();
+    }
+
+    std::vector<City> cities;
+    cities.reserve(numCities);
+
+    // Read each city's data: ID, X, Y
+    for (int i = 0; i < numCities; ++i) {
+        int id;
+        double x, y;
+        if (!scanner.nextNumber(id) || !scanner.nextNumber(x) || !scanner.nextNumber(y)) {
+            std::cerr << "Error: Failed to read city data at line " << (i + 2) << std::endl;
+            return Graph();
+        }
+
+        // Validate that coordinates are finite numbers (not NaN or infinity)
+        if (!std::isfinite(x) || !std::isfinite(y)) {
+            std::cerr << "Error: Invalid coordinates for city " << id << std::endl;
+            return Graph();
+        }
+
+        cities.push_back(City(id, x, y));
+    }
+
+    // Construct and return graph (distance matrix will be computed automatically)
+    return Graph(cities, storage);
+}
+
+Graph parseDistanceMatrix(std::string_view contents, DistanceStorage storage) {
+    const char* end = contents.data() + contents.size();
+    Scanner scanner(contents.data(), end);
+
+    // Read number of cities
+    int numCities = 0;
+    if (!scanner.nextNumber(numCities) || numCities <= 0) {
+        std::cerr << "Error: Invalid number of cities: " << numCities << std::endl;
+        return Graph();
+    }
+
+    // The n×n values follow; large matrices are parsed in parallel
+    std::vector<double> values;
+    const std::size_t n = static_cast<std::size_t>(numCities);
+    if (!parseNumbers(scanner.position(), end, values) || values.size() < n * n) {
+        std::size_t read = values.size();
+        std::cerr << "Error: Failed to read distance matrix at position [" << read / n << "]["
+                  << read % n << "]" << std::endl;
+        return Graph();
+    }
+
+    // Validate: distances must be finite and non-negative
+    for (std::size_t k = 0; k < n * n; ++k) {
+        if (!std::isfinite(values[k]) || values[k] < 0.0) {
+            std::cerr << "Error: Invalid distance value at [" << k / n << "][" << k % n << "]" << std::endl;
+            return Graph();
+        }
+    }
+
+    // Verify matrix symmetry (expected for undirected TSP)
+    const double EPSILON = 1e-6;  // Tolerance for floating-point comparison
+    for (std::size_t i = 0; i < n; ++i) {
+        for (std::size_t j = i + 1; j < n; ++j) {
+            if (std::abs(values[i * n + j] - values[j * n + i]) > EPSILON) {
+                std::cerr << "Warning: Distance matrix is not symmetric at [" << i << "][" << j
+                          << "], using the upper triangle" << std::endl;
+                i = n;
+                break;
+            }
+        }
+    }
+
+    std::vector<double> upper;
+    toUpperTriangle(values, numCities, "FULL_MATRIX", upper);
+    std::vector<City> cities = TSPLoader::syntheticCities(numCities, upper);
+
+    std::cerr << "Note: Distance matrix loaded. Synthetic coordinates generated (display only)." << std::endl;
+
+    return Graph(cities, std::move(upper), storage);
+}
+
+Graph parseTSPLIB(std::string_view contents, DistanceStorage storage) {
+    const char* pos = contents.data();
+    const char* end = pos + contents.size();
+
+    int dimension = 0;
+    DistanceMetric metric = DistanceMetric::EUCLIDEAN;
+    std::string weightFormat = "FULL_MATRIX";
+    std::vector<double> coordinates;  // NODE_COORD_SECTION triples
+    std::vector<double> display;      // DISPLAY_DATA_SECTION triples
+    std::vector<double> weights;      // EDGE_WEIGHT_SECTION values
+
+    // Header lines are "KEY : value"; sections are numeric blocks after their keyword
+    while (pos < end) {
+        const void* newline = std::memchr(pos, '\n', static_cast<std::size_t>(end - pos));
+        const char* lineEnd = newline ? static_cast<const char*>(newline) : end;
+        const char* next = newline ? lineEnd + 1 : end;
+        std::string_view line = trim(std::string_view(pos, static_cast<std::size_t>(lineEnd - pos)));
+        pos = next;
+
+        if (line.empty()) {
+            continue;
+        }
+        std::size_t colon = line.find(':');
+        std::string_view key = trim(line.substr(0, colon));
+        std::string_view value = (colon == std::string_view::npos) ? std::string_view()
+                                                                   : trim(line.substr(colon + 1));
+
+        if (key == "EOF") {
+            break;
+        }
+        if (key == "DIMENSION") {
+            std::from_chars(value.data(), value.data() + value.size(), dimension);
+        } else if (key == "EDGE_WEIGHT_TYPE") {
+            if (value == "CEIL_2D") {
+                metric = DistanceMetric::CEIL_2D;
+            } else if (value == "GEO") {
+                metric = DistanceMetric::GEO;
+            } else if (value == "ATT") {
+                metric = DistanceMetric::ATT;
+            } else if (value == "EXPLICIT") {
+                metric = DistanceMetric::EXPLICIT;
+            }
+        } else if (key == "EDGE_WEIGHT_FORMAT") {
+            weightFormat = std::string(value);
+        } else if (key.size() > 8 && key.substr(key.size() - 8) == "_SECTION") {
+            const char* sectionEnd = findSectionEnd(pos, end);
+            std::vector<double>* target = nullptr;
+            if (key == "NODE_COORD_SECTION") {
+                target = &coordinates;
+            } else if (key == "DISPLAY_DATA_SECTION") {
+                target = &display;
+            } else if (key == "EDGE_WEIGHT_SECTION") {
+                target = &weights;
+            }
+            // Other sections (TOUR_SECTION, FIXED_EDGES_SECTION, ...) are skipped
+            if (target != nullptr && !parseNumbers(pos, sectionEnd, *target)) {
+                std::cerr << "Error: Invalid number in " << key << std::endl;
+                return Graph();
+            }
+            pos = sectionEnd;
+        }
+    }
+
+    if (metric == DistanceMetric::EXPLICIT) {
+        if (dimension <= 0) {
+            std::cerr << "Error: EXPLICIT TSPLIB instance without DIMENSION" << std::endl;
+            return Graph();
+        }
+        std::vector<double> upper;
+        if (!toUpperTriangle(weights, dimension, weightFormat, upper)) {
+            return Graph();
+        }
+
+        // Display coordinates if the file has them for every city
+        std::vector<City> cities;
+        const std::vector<double>& shown = display.empty() ? coordinates : display;
+        if (shown.size() != 3 * static_cast<std::size_t>(dimension) || !toCities(shown, cities)) {
+            cities = TSPLoader::syntheticCities(dimension, upper);
+        }
+        return Graph(cities, std::move(upper), storage);
+    }
+
+    std::vector<City> cities;
+    if (!toCities(coordinates, cities)) {
+        return Graph();
+    }
+
+    // Validate that we read some cities
+    if (cities.empty()) {
+        std::cerr << "Error: No cities found in TSPLIB file" << std::endl;
+        return Graph();
+    }
+
+    // Validate dimension matches if it was specified
+    if (dimension > 0 && cities.size() != static_cast<size_t>(dimension)) {
+        std::cerr << "Warning: Expected " << dimension << " cities, but read "
+                  << cities.size() << std::endl;
+    }
+
+    return Graph(cities, storage, metric);
+}
+
+}  // namespace
+
+/**
+ * Display coordinates for instances that only have distances: city 0 at
+ * the origin, city 1 on the x-axis and the others on a circle, each at its
+ * distance from city 0. Only for visualization; the graph keeps the real
+ * distances.
+ */
+std::vector<City> TSPLoader::syntheticCities(int numCities, const std::vector<double>& upper) {
+    std::vector<City> cities;
+    cities.reserve(numCities);
+    for (int i = 0; i < numCities; ++i) {
+        double radius = (i == 0) ? 0.0 : upper[i - 1];  // d(0, i)
+        if (i == 1) {
+            cities.push_back(City(1, radius, 0.0));
+        } else {
+            double angle = 2.0 * M_PI * i / numCities;  // Evenly spaced angles
+            cities.push_back(City(i, radius * std::cos(angle), radius * std::sin(angle)));
+        }
+    }
+    return cities;
+}
+
 // Constructor - stores filename for later loading
 TSPLoader::TSPLoader(const std::string& filename) : filename_(findFile(filename)) {}
 
 /**
  * Load a graph by automatically detecting the file format.
  * This is the recommended method for loading files when the format is unknown.
+ * A fresh binary cache is used instead of the file when available.
  *
  * @return Graph object on success, empty Graph on failure
  */
-Graph TSPLoader::loadGraph() {
-    // First, analyze the file to determine its format
-    FileFormat format = detectFormat();
+Graph TSPLoader::loadGraph(DistanceStorage storage) {
+    // A fresh cache replaces parsing and all preprocessing
+    std::string cachePath = getCachePath(storage);
+    Graph cached = GraphCache::load(cachePath, filename_, storage);
+    loadedFromCache_ = cached.isValid();
+    if (loadedFromCache_) {
+        return cached;
+    }
+
+    Graph graph = parseGraph(storage);
+    if (writeCache_ && graph.isValid() && !GraphCache::write(graph, cachePath, filename_)) {
+        std::cerr << "Warning: Could not write cache file: " << cachePath << std::endl;
+    }
+    return graph;
+}
+
+void TSPLoader::setCacheDirectory(const std::string& directory) {
+    cacheDirectory_ = directory;
+}
+
+void TSPLoader::setWriteCache(bool enabled) {
+    writeCache_ = enabled;
+}
 
-    // Route to appropriate loader based on detected format
+std::string TSPLoader::getCachePath(DistanceStorage storage) const {
+    return GraphCache::cachePath(filename_, storage, cacheDirectory_);
+}
+
+// Parse the file, detecting its format first. The file is mapped once and
+// both detection and parsing work on the mapping.
+Graph TSPLoader::parseGraph(DistanceStorage storage) const {
+    MappedFile file(filename_);
+    if (!file.isOpen()) {
+        std::cerr << "Error: Cannot open file: " << filename_ << std::endl;
+    }
+
+    // Analyze the contents to determine the format
+    FileFormat format = file.isOpen() ? detectFormat(file.view()) : FileFormat::UNKNOWN;
+
+    // Route to appropriate parser based on detected format
     if (format == FileFormat::COORDINATES) {
-        return loadFromCoordinates(filename_);
+        return parseCoordinates(file.view(), storage);
     } else if (format == FileFormat::DISTANCE_MATRIX) {
-        return loadFromDistanceMatrix(filename_);
+        return parseDistanceMatrix(file.view(), storage);
     } else if (format == FileFormat::TSPLIB) {
-        return loadFromTSPLIB(filename_);
+        return parseTSPLIB(file.view(), storage);
     } else {
         // Format detection failed or file unreadable
         std::cerr << "Error: Unknown file format or unable to read file: " << filename_ << std::endl;
@@ -68,7 +569,7 @@ Graph TSPLoader::loadGraph() {
 }
 
 /**
- * Detect the file format by examining the first few lines.
+ * Detect the file format by examining the first two lines.
  * Uses heuristics based on the number of fields in the second data line.
  *
  * Format detection logic:
@@ -79,51 +580,47 @@ Graph TSPLoader::loadGraph() {
  *
  * @return FileFormat enum indicating detected format
  */
-TSPLoader::FileFormat TSPLoader::detectFormat() const {
-    std::ifstream file(filename_);
-    if (!file.is_open()) {
-        std::cerr << "Error: Cannot open file: " << filename_ << std::endl;
-        return FileFormat::UNKNOWN;
-    }
-
-    // Read first two lines for analysis
-    std::string firstLine, secondLine;
-    std::getline(file, firstLine);  // Usually contains number of cities
-    std::getline(file, secondLine); // Data line - format depends on file type
+TSPLoader::FileFormat TSPLoader::detectFormat(std::string_view contents) {
+    // Split off the first two lines
+    std::size_t firstEnd = std::min(contents.find('\n'), contents.size());
+    std::string_view firstLine = contents.substr(0, firstEnd);
+    std::string_view rest = contents.substr(std::min(firstEnd + 1, contents.size()));
+    std::string_view secondLine = rest.substr(0, std::min(rest.find('\n'), rest.size()));
 
     // Validate that we have content to analyze
-    if (firstLine.empty() || secondLine.empty()) {
+    if (trim(firstLine).empty() || trim(secondLine).empty()) {
         return FileFormat::UNKNOWN;
     }
 
     // Check for TSPLIB format (has "NAME", "TYPE", "DIMENSION" keywords in first few lines)
-    if (firstLine.find("NAME") != std::string::npos ||
-        firstLine.find("TYPE") != std::string::npos ||
-        secondLine.find("TYPE") != std::string::npos ||
-        secondLine.find("COMMENT") != std::string::npos ||
-        secondLine.find("DIMENSION") != std::string::npos) {
+    if (firstLine.find("NAME") != std::string_view::npos ||
+        firstLine.find("TYPE") != std::string_view::npos ||
+        secondLine.find("TYPE") != std::string_view::npos ||
+        secondLine.find("COMMENT") != std::string_view::npos ||
+        secondLine.find("DIMENSION") != std::string_view::npos) {
         return FileFormat::TSPLIB;
     }
 
-    // Parse second line into fields (whitespace-separated)
-    std::istringstream ss(secondLine);
-    std::vector<std::string> fields;
-    std::string field;
-    while (ss >> field) {
-        fields.push_back(field);
+    // Count whitespace-separated fields of the second line
+    int fields = 0;
+    bool inField = false;
+    for (char c : secondLine) {
+        if (isSpace(c)) {
+            inField = false;
+        } else if (!inField) {
+            inField = true;
+            fields++;
+        }
     }
 
     // Heuristic: count fields to determine format
     // Coordinate format: ID X Y (3 fields)
     // Distance matrix format: d1 d2 d3 ... dn (n fields where n > 3)
-    if (fields.size() == 3) {
-        return FileFormat::COORDINATES;
-    } else if (fields.size() > 3) {
+    if (fields > 3) {
         return FileFormat::DISTANCE_MATRIX;
-    } else {
-        // Ambiguous - default to coordinates for 1-2 fields
-        return FileFormat::COORDINATES;
     }
+    // 3 fields, or ambiguous 1-2 fields: default to coordinates
+    return FileFormat::COORDINATES;
 }
 
 /**
@@ -150,57 +647,14 @@ TSPLoader::FileFormat TSPLoader::detectFormat() const {
  * @param filename Path to the coordinate format file
  * @return Graph constructed from the coordinates, or empty Graph on error
  */
-Graph TSPLoader::loadFromCoordinates(const std::string& filename) {
+Graph TSPLoader::loadFromCoordinates(const std::string& filename, DistanceStorage storage) {
     // Use findFile to search common locations for the file
-    std::string filepath = findFile(filename);
-    std::ifstream file(filepath);
-    if (!file.is_open()) {
+    MappedFile file(findFile(filename));
+    if (!file.isOpen()) {
         std::cerr << "Error: Cannot open file: " << filename << std::endl;
         return Graph();
     }
-
-    // Read number of cities from first line
-    int numCities;
-    file >> numCities;
-
-    if (numCities <= 0) {
-        std::cerr << "Error: Invalid number of cities: " << numCities << std::endl;
-        return Graph();
-    }
-
-    // Pre-allocate vector for efficiency
-    std::vector<City> cities;
-    cities.reserve(numCities);
-
-    // Read each city's data
-    for (int i = 0; i < numCities; ++i) {
-        int id;
-        double x, y;
-
-        // Attempt to read three values: ID, X, Y
-        if (!(file >> id >> x >> y)) {
-            std::cerr << "Error: Failed to read city data at line " << (i + 2) << std::endl;
-            return Graph();
-        }
-
-        // Validate that coordinates are finite numbers (not NaN or infinity)
-        if (!std::isfinite(x) || !std::isfinite(y)) {
-            std::cerr << "Error: Invalid coordinates for city " << id << std::endl;
-            return Graph();
-        }
-
-        // Create and add city to vector
-        cities.push_back(City(id, x, y));
-    }
-
-    // Verify we read the expected number of cities
-    if (cities.size() != static_cast<size_t>(numCities)) {
-        std::cerr << "Error: Expected " << numCities << " cities, but read " << cities.size() << std::endl;
-        return Graph();
-    }
-
-    // Construct and return graph (distance matrix will be computed automatically)
-    return Graph(cities);
+    return parseCoordinates(file.view(), storage);
 }
 
 /**
@@ -216,110 +670,36 @@ Graph TSPLoader::loadFromCoordinates(const std::string& filename) {
  * 10.5 0.0 15.8
  * 20.3 15.8 0.0
  *
- * IMPORTANT LIMITATION:
- * Since the Graph class requires City objects with (x,y) coordinates,
- * this method generates SYNTHETIC coordinates that approximate the distances.
- * The actual distances in the resulting graph may not perfectly match the
- * input distance matrix.
- *
- * A proper implementation would use Multi-Dimensional Scaling (MDS) to
- * reconstruct coordinates that preserve distances as much as possible.
- * This simplified version uses a basic circular placement strategy.
+ * The resulting graph uses these distances exactly (EXPLICIT metric). Since
+ * the Graph class also keeps City objects, synthetic coordinates are placed
+ * on a circle around city 0 (at each city's distance from it) for display.
  *
  * Validation performed:
  * - File accessibility
  * - Positive number of cities
  * - All distances are finite and non-negative
- * - Matrix symmetry (warning if not symmetric)
+ * - Matrix symmetry (warning if not symmetric; the upper triangle is used)
  *
  * @param filename Path to the distance matrix file
- * @return Graph with synthetic coordinates, or empty Graph on error
+ * @return Graph with the given distances, or empty Graph on error
  */
-Graph TSPLoader::loadFromDistanceMatrix(const std::string& filename) {
+Graph TSPLoader::loadFromDistanceMatrix(const std::string& filename, DistanceStorage storage) {
     // Use findFile to search common locations for the file
-    std::string filepath = findFile(filename);
-    std::ifstream file(filepath);
-    if (!file.is_open()) {
+    MappedFile file(findFile(filename));
+    if (!file.isOpen()) {
         std::cerr << "Error: Cannot open file: " << filename << std::endl;
         return Graph();
     }
-
-    // Read number of cities
-    int numCities;
-    file >> numCities;
-
-    if (numCities <= 0) {
-        std::cerr << "Error: Invalid number of cities: " << numCities << std::endl;
-        return Graph();
-    }
-
-    // Allocate n×n distance matrix
-    std::vector<std::vector<double>> distMatrix(numCities, std::vector<double>(numCities));
-
-    // Read all distance values
-    for (int i = 0; i < numCities; ++i) {
-        for (int j = 0; j < numCities; ++j) {
-            if (!(file >> distMatrix[i][j])) {
-                std::cerr << "Error: Failed to read distance matrix at position [" << i << "][" << j << "]" << std::endl;
-                return Graph();
-            }
-
-            // Validate: distances must be finite and non-negative
-            if (!std::isfinite(distMatrix[i][j]) || distMatrix[i][j] < 0.0) {
-                std::cerr << "Error: Invalid distance value at [" << i << "][" << j << "]" << std::endl;
-                return Graph();
-            }
-        }
-    }
-
-    // Verify matrix symmetry (expected for undirected TSP)
-    const double EPSILON = 1e-6;  // Tolerance for floating-point comparison
-    for (int i = 0; i < numCities; ++i) {
-        for (int j = i + 1; j < numCities; ++j) {
-            if (std::abs(distMatrix[i][j] - distMatrix[j][i]) > EPSILON) {
-                std::cerr << "Warning: Distance matrix is not symmetric at [" << i << "][" << j << "]" << std::endl;
-            }
-        }
-    }
-
-    // Generate synthetic city coordinates that approximate the distances
-    // This is a simplified approach - proper MDS would be better
-    std::vector<City> cities;
-    cities.reserve(numCities);
-
-    // Special cases for first two cities
-    if (numCities >= 1) {
-        // Place first city at origin
-        cities.push_back(City(0, 0.0, 0.0));
-    }
-    if (numCities >= 2) {
-        // Place second city on positive x-axis at distance d[0][1]
-        cities.push_back(City(1, distMatrix[0][1], 0.0));
-    }
-
-    // For remaining cities, use circular placement around origin
-    // Radius based on distance from first city
-    // This is a crude approximation and won't preserve exact distances
-    for (int i = 2; i < numCities; ++i) {
-        double angle = 2.0 * M_PI * i / numCities;  // Evenly spaced angles
-        double radius = distMatrix[0][i];           // Distance from city 0
-        double x = radius * std::cos(angle);
-        double y = radius * std::sin(angle);
-        cities.push_back(City(i, x, y));
-    }
-
-    // Warning: distances in the resulting graph will be computed from these
-    // synthetic coordinates and may differ from the input distance matrix
-    std::cerr << "Note: Distance matrix loaded. Synthetic coordinates generated (may not preserve exact distances)." << std::endl;
-
-    return Graph(cities);
+    return parseDistanceMatrix(file.view(), storage);
 }
 
 /**
  * Load a TSP problem from TSPLIB format file.
  *
- * Supports TSPLIB files with NODE_COORD_SECTION and EUC_2D edge weight type.
- * The TSPLIB format includes header information followed by coordinate data.
+ * The EDGE_WEIGHT_TYPE selects the graph's distance metric: CEIL_2D, GEO and
+ * ATT use their TSPLIB definitions, EXPLICIT takes the EDGE_WEIGHT_SECTION
+ * as is, while EUC_2D (and any other type) keeps the unrounded Euclidean
+ * distance used throughout this project.
  *
  * Expected structure:
  * NAME: <instance name>
@@ -331,88 +711,24 @@ Graph TSPLoader::loadFromDistanceMatrix(const std::string& filename) {
  * ...
  * EOF
  *
+ * or, for EXPLICIT instances:
+ * EDGE_WEIGHT_TYPE: EXPLICIT
+ * EDGE_WEIGHT_FORMAT: FULL_MATRIX | UPPER_ROW | LOWER_ROW | UPPER_DIAG_ROW | LOWER_DIAG_ROW
+ * EDGE_WEIGHT_SECTION
+ * <weights>
+ * [DISPLAY_DATA_SECTION
+ *  <city_id> <x> <y>]
+ * EOF
+ *
  * @param filename Path to the TSPLIB format file
  * @return Graph constructed from the TSPLIB data
  */
-Graph TSPLoader::loadFromTSPLIB(const std::string& filename) {
+Graph TSPLoader::loadFromTSPLIB(const std::string& filename, DistanceStorage storage) {
     // Use findFile to search common locations for the file
-    std::string filepath = findFile(filename);
-    std::ifstream file(filepath);
-    if (!file.is_open()) {
+    MappedFile file(findFile(filename));
+    if (!file.isOpen()) {
         std::cerr << "Error: Cannot open file: " << filename << std::endl;
         return Graph();
     }
-
-    std::string line;
-    int dimension = 0;
-    bool inCoordSection = false;
-    std::vector<City> cities;
-
-    // Read file line by line
-    while (std::getline(file, line)) {
-        // Trim whitespace from line
-        line.erase(0, line.find_first_not_of(" \t\r\n"));
-        line.erase(line.find_last_not_of(" \t\r\n") + 1);
-
-        // Skip empty lines
-        if (line.empty()) {
-            continue;
-        }
-
-        // Check for EOF marker
-        if (line == "EOF") {
-            break;
-        }
-
-        // Parse header fields
-        if (line.find("DIMENSION") != std::string::npos) {
-            // Extract dimension value (handles both "DIMENSION:" and "DIMENSION :")
-            size_t colonPos = line.find(':');
-            if (colonPos != std::string::npos) {
-                std::istringstream ss(line.substr(colonPos + 1));
-                ss >> dimension;
-                cities.reserve(dimension);
-            }
-        } else if (line == "NODE_COORD_SECTION") {
-            inCoordSection = true;
-            continue;
-        } else if (line.find("EDGE_WEIGHT_SECTION") != std::string::npos ||
-                   line.find("DISPLAY_DATA_SECTION") != std::string::npos ||
-                   line.find("TOUR_SECTION") != std::string::npos) {
-            // Reached a different section, stop reading coordinates
-            break;
-        }
-
-        // Parse coordinate data if in the NODE_COORD_SECTION
-        if (inCoordSection) {
-            std::istringstream ss(line);
-            int id;
-            double x, y;
-
-            if (ss >> id >> x >> y) {
-                // Validate coordinates
-                if (!std::isfinite(x) || !std::isfinite(y)) {
-                    std::cerr << "Error: Invalid coordinates for city " << id << std::endl;
-                    return Graph();
-                }
-
-                // TSPLIB cities are 1-indexed, convert to 0-indexed
-                cities.push_back(City(id - 1, x, y));
-            }
-        }
-    }
-
-    // Validate that we read some cities
-    if (cities.empty()) {
-        std::cerr << "Error: No cities found in TSPLIB file" << std::endl;
-        return Graph();
-    }
-
-    // Validate dimension matches if it was specified
-    if (dimension > 0 && cities.size() != static_cast<size_t>(dimension)) {
-        std::cerr << "Warning: Expected " << dimension << " cities, but read "
-                  << cities.size() << std::endl;
-    }
-
-    return Graph(cities);
+    return parseTSPLIB(file.view(), storage);
 }
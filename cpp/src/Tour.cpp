@@ -6,6 +6,7 @@
 #include "Tour.h"
 #include <algorithm>
 #include <unordered_set>
+#include <utility>
 
 Tour::Tour()
     : citySequence_(),
@@ -19,12 +20,24 @@ Tour::Tour(const std::vector<int>& sequence, double distance)
       isValid_(true) {
 }
 
+Tour::Tour(std::vector<int>&& sequence, double distance)
+    : citySequence_(std::move(sequence)),
+      totalDistance_(distance),
+      isValid_(true) {
+}
+
 void Tour::setTour(const std::vector<int>& sequence, double distance) {
     citySequence_ = sequence;
     totalDistance_ = distance;
     isValid_ = true;
 }
 
+void Tour::setTour(std::vector<int>&& sequence, double distance) {
+    citySequence_ = std::move(sequence);
+    totalDistance_ = distance;
+    isValid_ = true;
+}
+
 double Tour::getDistance() const {
     return totalDistance_;
 }
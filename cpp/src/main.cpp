@@ -6,13 +6,19 @@
  * the Ant Colony Optimization metaheuristic algorithm.
  */
 
+#include <fstream>
 #include <iostream>
 #include <iomanip>
+#include <memory>
 #include <string>
+#include <vector>
 #include "TSPLoader.h"
 #include "AntColony.h"
+#include "MultiColony.h"
+#include "NumaPlacement.h"
 #include "Graph.h"
 #include "Tour.h"
+#include "SelectionKernels.h"
 
 #ifdef _OPENMP
 #include <omp.h>
@@ -27,25 +33,153 @@ void printUsage(const char* programName) {
     std::cout << "  --beta <f>       Heuristic importance (default: 2.0)\n";
     std::cout << "  --rho <f>        Evaporation rate (default: 0.5)\n";
     std::cout << "  --Q <f>          Pheromone deposit factor (default: 100.0)\n";
+    std::cout << "  --candidates <k> Only consider the k nearest neighbors per step (0=all cities, default: 0)\n";
+    std::cout << "  --seed <n>       Random seed for reproducible runs (default: random)\n";
+    std::cout << "  --time-limit <s> Stop after this many seconds of solving (default: none)\n";
+    std::cout << "  --target <d>     Stop once a tour of at most this length is found (default: none)\n";
+    std::cout << "\nMemory Options:\n";
+    std::cout << "  --distance-storage <mode> Distance matrix layout:\n";
+    std::cout << "                   'full' (n×n doubles, default), 'full-float' (n×n floats),\n";
+    std::cout << "                   'triangular' (upper triangle doubles), 'triangular-float' (upper triangle floats),\n";
+    std::cout << "                   'on-the-fly' (no matrix, computed from coordinates; pair with --candidates)\n";
+    std::cout << "  --cache          Write a binary cache of the preprocessed instance next to the input file;\n";
+    std::cout << "                   later runs map it instead of parsing (default: read existing caches only)\n";
+    std::cout << "  --cache-dir <d>  Like --cache, but keep cache files in directory d\n";
     std::cout << "\nElitist Strategy Options:\n";
     std::cout << "  --elitist        Enable elitist pheromone deposits (default: disabled)\n";
     std::cout << "  --elitist-weight <f> Weight for elitist deposits (default: numAnts)\n";
     std::cout << "  --pheromone-mode <mode> Pheromone update strategy:\n";
     std::cout << "                   'all' (all ants, default), 'best-iteration' (iteration best),\n";
-    std::cout << "                   'best-so-far' (global best), 'rank' (top-k ants)\n";
+    std::cout << "                   'best-so-far' (global best), 'rank' (top-k ants),\n";
+    std::cout << "                   'mmas' (MAX-MIN Ant System: bounded trails, restarts on stagnation),\n";
+    std::cout << "                   'acs' (Ant Colony System: q0 exploitation, local + best-so-far updates)\n";
     std::cout << "  --rank-size <n>  Number of elite ants for rank mode (default: numAnts/2)\n";
+    std::cout << "  --mmas-restart <n> Iterations without improvement before MMAS resets trails (default: 100, 0 = never)\n";
+    std::cout << "  --q0 <f>         ACS probability of taking the best edge (default: 0.9)\n";
+    std::cout << "  --xi <f>         ACS local pheromone update rate (default: 0.1)\n";
     std::cout << "\nLocal Search Options:\n";
     std::cout << "  --local-search   Enable 2-opt/3-opt local search (default: disabled)\n";
     std::cout << "  --2opt-only      Use only 2-opt (skip 3-opt, default: use both)\n";
-    std::cout << "  --ls-mode <mode> When to apply: 'best' (only best tour), 'all' (all tours), 'none' (default: best)\n";
+    std::cout << "  --ls-mode <mode> When to apply: 'best' (only best tour), 'all' (all tours),\n";
+    std::cout << "                   'top-k' (k shortest tours, one per thread), 'none' (default: best)\n";
+    std::cout << "  --ls-top-k <n>   Tours improved per iteration in top-k mode (default: 0 = thread count)\n";
+    std::cout << "  --ls-operator <op> Move family: 'exhaustive' (full-scan 2-opt/3-opt, default),\n";
+    std::cout << "                   'neighbor' (neighbor-list 2-opt, Or-opt, or-3opt with don't-look bits),\n";
+    std::cout << "                   'lk' (Lin-Kernighan-style variable-depth search)\n";
     std::cout << "\nThreading Options:\n";
     std::cout << "  --threads <n>    Number of threads (0=auto, 1=serial, 2+=specific, default: 0)\n";
     std::cout << "  --serial         Force single-threaded execution (same as --threads 1)\n";
+    std::cout << "  --bind <b>       Pin threads to cores: 'none' (default), 'close' (fill one socket first)\n";
+    std::cout << "                   or 'spread' (round-robin over the NUMA nodes); Linux only\n";
+    std::cout << "  --no-first-touch Fill the matrices on one thread (all pages on its NUMA node)\n";
+    std::cout << "  --backend <b>    Execution backend: 'cpu' (default) or 'cuda' (tours and pheromone\n";
+    std::cout << "                   updates on the GPU; not available in this build, no acs/--candidates)\n";
+    std::cout << "\nMulti-Colony Options:\n";
+    std::cout << "  --colonies <n>   Independent colonies run side by side, one per thread (default: 1)\n";
+    std::cout << "  --migrate-every <n> Iterations between best-tour migrations (default: 10, 0 = never)\n";
+    std::cout << "  --migration <t>  Migration topology: 'ring' (default) or 'broadcast'\n";
+    std::cout << "\nProfiling Options:\n";
+    std::cout << "  --profile        Print the time spent per phase and the local search/candidate counters\n";
+    std::cout << "  --profile-csv <file> Also write one CSV row per colony iteration to file\n";
+    std::cout << "\nCheckpoint Options (single colony only):\n";
+    std::cout << "  --checkpoint <file> Save the search state to file periodically and at the end\n";
+    std::cout << "  --checkpoint-every <n> Iterations between checkpoints (default: 100, 0 = only at the end)\n";
+    std::cout << "  --resume <file>  Continue from a checkpoint (its parameters replace the command line's;\n";
+    std::cout << "                   --iterations counts the restored iterations; starts fresh if missing)\n";
+    std::cout << "  --warm-start <file> Start from a tour: whitespace-separated 0-based city indices\n";
     std::cout << "\nInput file format:\n";
     std::cout << "  Coordinate format: n\\n id x y\\n ...\n";
     std::cout << "  Distance matrix format: n\\n d00 d01 ...\\n d10 d11 ...\\n ...\n";
 }
 
+/**
+ * @brief Print the per-phase breakdown of the colonies' profiles
+ * @param profiles Stats of each colony (phase times are summed over them)
+ */
+void printProfile(const std::vector<ColonyStats>& profiles) {
+    PhaseStats total;
+    size_t iterations = 0;
+    for (const ColonyStats& stats : profiles) {
+        total += stats.total;
+        iterations += stats.iterations.size();
+    }
+    double totalSeconds = total.totalSeconds();
+    const std::pair<const char*, double> phases[] = {
+        {"Construction", total.construction},
+        {"Local search", total.localSearch},
+        {"Best selection", total.selection},
+        {"Deposit", total.deposit},
+        {"Evaporation", total.evaporation},
+    };
+
+    std::cout << "Profile (" << iterations << " iterations";
+    if (profiles.size() > 1) {
+        std::cout << " over " << profiles.size() << " colonies";
+    }
+    std::cout << "):\n";
+    std::cout << "  Phase             Total (ms)  Per iter (ms)   Share\n";
+    for (const auto& phase : phases) {
+        double perIteration = iterations > 0 ? phase.second / iterations : 0.0;
+        double share = totalSeconds > 0.0 ? phase.second / totalSeconds * 100.0 : 0.0;
+        std::cout << "  " << std::left << std::setw(16) << phase.first << std::right
+                  << std::fixed << std::setprecision(2)
+                  << std::setw(12) << phase.second * 1e3
+                  << std::setw(15) << std::setprecision(3) << perIteration * 1e3
+                  << std::setw(7) << std::setprecision(1) << share << "%\n";
+    }
+    std::cout << "  Local search moves:       " << total.localSearchMoves << "\n";
+    std::cout << "  Local search evaluations: " << total.localSearchEvaluations << "\n";
+    std::cout << "  Candidate fallbacks:      " << total.candidateFallbacks << "\n";
+}
+
+/**
+ * @brief Write one CSV row per profiled colony iteration
+ * @param path Output file
+ * @param profiles Stats of each colony
+ * @return bool True if the file was written
+ */
+bool writeProfileCsv(const std::string& path, const std::vector<ColonyStats>& profiles) {
+    std::ofstream out(path);
+    if (!out) {
+        return false;
+    }
+    out << "Colony,Iteration,Construction(ms),LocalSearch(ms),Selection(ms),Deposit(ms),"
+           "Evaporation(ms),LSMoves,LSEvaluations,CandidateFallbacks\n";
+    out << std::setprecision(6);
+    for (size_t c = 0; c < profiles.size(); ++c) {
+        const std::vector<PhaseStats>& iterations = profiles[c].iterations;
+        for (size_t i = 0; i < iterations.size(); ++i) {
+            const PhaseStats& phases = iterations[i];
+            out << c << ',' << (i + 1) << ','
+                << phases.construction * 1e3 << ',' << phases.localSearch * 1e3 << ','
+                << phases.selection * 1e3 << ',' << phases.deposit * 1e3 << ','
+                << phases.evaporation * 1e3 << ','
+                << phases.localSearchMoves << ',' << phases.localSearchEvaluations << ','
+                << phases.candidateFallbacks << '\n';
+        }
+    }
+    return static_cast<bool>(out);
+}
+
+/**
+ * @brief Read a warm start tour
+ * @param path File of whitespace-separated 0-based city indices
+ * @param sequence Receives the indices
+ * @return bool True if the file was read and holds only integers
+ */
+bool readTourFile(const std::string& path, std::vector<int>& sequence) {
+    std::ifstream in(path);
+    if (!in) {
+        return false;
+    }
+    sequence.clear();
+    int city = 0;
+    while (in >> city) {
+        sequence.push_back(city);
+    }
+    return in.eof();
+}
+
 /**
  * @brief Main entry point
  * @param argc Number of command-line arguments
@@ -68,13 +202,38 @@ int main(int argc, char** argv) {
     double Q = 100.0;
     int numThreads = 0;  // 0 = auto-detect, 1 = serial, 2+ = specific count
     bool useParallel = true;  // Enable parallel execution by default (if OpenMP available)
+    int numColonies = 1;  // > 1 runs an island-model MultiColony
+    int migrateEvery = 10;  // 0 = colonies never exchange tours
+    std::string migrationTopology = "ring";  // "ring" or "broadcast"
+    std::string backend = "cpu";  // "cpu" or "cuda"
+    numa::ThreadBinding threadBinding = numa::ThreadBinding::NONE;  // --bind
     bool useLocalSearch = false;  // Enable local search (2-opt/3-opt)
     bool use3opt = true;  // Use 3-opt in addition to 2-opt
-    std::string localSearchMode = "best";  // "best", "all", or "none"
+    std::string localSearchMode = "best";  // "best", "all", "top-k", or "none"
+    int localSearchTopK = 0;  // 0 = one tour per thread
+    std::string localSearchOperator = "exhaustive";  // "exhaustive", "neighbor" or "lk"
     bool useElitist = false;  // Enable elitist strategy
     double elitistWeight = -1.0;  // -1 means use numAnts (set after loading graph)
-    std::string pheromoneMode = "all";  // "all", "best-iteration", "best-so-far", "rank"
+    std::string pheromoneMode = "all";  // "all", "best-iteration", "best-so-far", "rank", "mmas"
     int rankSize = -1;  // -1 means use numAnts/2 (auto)
+    int mmasRestartIterations = 100;  // 0 = never reinitialize MMAS trails
+    double q0 = 0.9;  // ACS exploitation probability
+    double xi = 0.1;  // ACS local update rate
+    int candidateListSize = 0;  // 0 = evaluate all unvisited cities at each step
+    bool useSeed = false;  // Seed from std::random_device unless --seed is given
+    unsigned long long seed = 0;
+    double timeLimit = 0.0;  // 0 = no wall-clock budget
+    double targetDistance = 0.0;  // 0 = no target
+    DistanceStorage distanceStorage = DistanceStorage::FULL_DOUBLE;
+    std::string distanceStorageName = "full";
+    bool writeCache = false;  // Fresh caches are always read; --cache also writes them
+    std::string cacheDirectory;
+    bool profile = false;  // Collect and print per-phase timings
+    std::string profileCsv;  // Per-iteration profile output (empty = none)
+    std::string checkpointFile;  // Automatic checkpoints (empty = none)
+    int checkpointEvery = 100;  // 0 = only when the solve ends
+    std::string resumeFile;  // Checkpoint to continue from (empty = fresh start)
+    std::string warmStartFile;  // Initial tour (empty = none)
 
     // Parse command-line arguments
     if (argc < 2) {
@@ -110,6 +269,21 @@ int main(int argc, char** argv) {
             i++;
             continue;
         }
+        if (option == "--cache") {
+            writeCache = true;
+            i++;
+            continue;
+        }
+        if (option == "--profile") {
+            profile = true;
+            i++;
+            continue;
+        }
+        if (option == "--no-first-touch") {
+            numa::setFirstTouchEnabled(false);
+            i++;
+            continue;
+        }
 
         // All other options require a value
         if (i + 1 >= argc) {
@@ -157,6 +331,46 @@ int main(int argc, char** argv) {
                     std::cerr << "Error: Q must be positive" << std::endl;
                     return 1;
                 }
+            } else if (option == "--candidates") {
+                candidateListSize = std::stoi(value);
+                if (candidateListSize < 0) {
+                    std::cerr << "Error: Candidate list size must be non-negative" << std::endl;
+                    return 1;
+                }
+            } else if (option == "--seed") {
+                seed = std::stoull(value);
+                useSeed = true;
+            } else if (option == "--time-limit") {
+                timeLimit = std::stod(value);
+                if (timeLimit <= 0.0) {
+                    std::cerr << "Error: Time limit must be positive" << std::endl;
+                    return 1;
+                }
+            } else if (option == "--target") {
+                targetDistance = std::stod(value);
+                if (targetDistance <= 0.0) {
+                    std::cerr << "Error: Target distance must be positive" << std::endl;
+                    return 1;
+                }
+            } else if (option == "--distance-storage") {
+                if (value == "full") {
+                    distanceStorage = DistanceStorage::FULL_DOUBLE;
+                } else if (value == "full-float") {
+                    distanceStorage = DistanceStorage::FULL_FLOAT;
+                } else if (value == "triangular") {
+                    distanceStorage = DistanceStorage::TRIANGULAR_DOUBLE;
+                } else if (value == "triangular-float") {
+                    distanceStorage = DistanceStorage::TRIANGULAR_FLOAT;
+                } else if (value == "on-the-fly") {
+                    distanceStorage = DistanceStorage::ON_THE_FLY;
+                } else {
+                    std::cerr << "Error: --distance-storage must be 'full', 'full-float', 'triangular', 'triangular-float', or 'on-the-fly'" << std::endl;
+                    return 1;
+                }
+                distanceStorageName = value;
+            } else if (option == "--cache-dir") {
+                cacheDirectory = value;
+                writeCache = true;
             } else if (option == "--threads") {
                 numThreads = std::stoi(value);
                 if (numThreads < 0) {
@@ -166,11 +380,55 @@ int main(int argc, char** argv) {
                 if (numThreads == 1) {
                     useParallel = false;
                 }
+            } else if (option == "--bind") {
+                if (!numa::parseThreadBinding(value, threadBinding)) {
+                    std::cerr << "Error: --bind must be 'none', 'close' or 'spread'" << std::endl;
+                    return 1;
+                }
+            } else if (option == "--colonies") {
+                numColonies = std::stoi(value);
+                if (numColonies < 1) {
+                    std::cerr << "Error: Number of colonies must be at least 1" << std::endl;
+                    return 1;
+                }
+            } else if (option == "--migrate-every") {
+                migrateEvery = std::stoi(value);
+                if (migrateEvery < 0) {
+                    std::cerr << "Error: Migration interval must be non-negative" << std::endl;
+                    return 1;
+                }
+            } else if (option == "--migration") {
+                if (value == "ring" || value == "broadcast") {
+                    migrationTopology = value;
+                } else {
+                    std::cerr << "Error: --migration must be 'ring' or 'broadcast'" << std::endl;
+                    return 1;
+                }
+            } else if (option == "--backend") {
+                if (value == "cpu" || value == "cuda") {
+                    backend = value;
+                } else {
+                    std::cerr << "Error: --backend must be 'cpu' or 'cuda'" << std::endl;
+                    return 1;
+                }
             } else if (option == "--ls-mode") {
-                if (value == "best" || value == "all" || value == "none") {
+                if (value == "best" || value == "all" || value == "top-k" || value == "none") {
                     localSearchMode = value;
                 } else {
-                    std::cerr << "Error: --ls-mode must be 'best', 'all', or 'none'" << std::endl;
+                    std::cerr << "Error: --ls-mode must be 'best', 'all', 'top-k', or 'none'" << std::endl;
+                    return 1;
+                }
+            } else if (option == "--ls-top-k") {
+                localSearchTopK = std::stoi(value);
+                if (localSearchTopK < 0) {
+                    std::cerr << "Error: --ls-top-k must be non-negative" << std::endl;
+                    return 1;
+                }
+            } else if (option == "--ls-operator") {
+                if (value == "exhaustive" || value == "neighbor" || value == "lk") {
+                    localSearchOperator = value;
+                } else {
+                    std::cerr << "Error: --ls-operator must be 'exhaustive', 'neighbor' or 'lk'" << std::endl;
                     return 1;
                 }
             } else if (option == "--elitist-weight") {
@@ -180,10 +438,11 @@ int main(int argc, char** argv) {
                     return 1;
                 }
             } else if (option == "--pheromone-mode") {
-                if (value == "all" || value == "best-iteration" || value == "best-so-far" || value == "rank") {
+                if (value == "all" || value == "best-iteration" || value == "best-so-far" || value == "rank" ||
+                    value == "mmas" || value == "acs") {
                     pheromoneMode = value;
                 } else {
-                    std::cerr << "Error: --pheromone-mode must be 'all', 'best-iteration', 'best-so-far', or 'rank'" << std::endl;
+                    std::cerr << "Error: --pheromone-mode must be 'all', 'best-iteration', 'best-so-far', 'rank', 'mmas', or 'acs'" << std::endl;
                     return 1;
                 }
             } else if (option == "--rank-size") {
@@ -192,6 +451,39 @@ int main(int argc, char** argv) {
                     std::cerr << "Error: Rank size must be non-negative" << std::endl;
                     return 1;
                 }
+            } else if (option == "--mmas-restart") {
+                mmasRestartIterations = std::stoi(value);
+                if (mmasRestartIterations < 0) {
+                    std::cerr << "Error: MMAS restart iterations must be non-negative" << std::endl;
+                    return 1;
+                }
+            } else if (option == "--q0") {
+                q0 = std::stod(value);
+                if (q0 < 0.0 || q0 > 1.0) {
+                    std::cerr << "Error: q0 must be between 0 and 1" << std::endl;
+                    return 1;
+                }
+            } else if (option == "--profile-csv") {
+                profileCsv = value;
+                profile = true;
+            } else if (option == "--checkpoint") {
+                checkpointFile = value;
+            } else if (option == "--checkpoint-every") {
+                checkpointEvery = std::stoi(value);
+                if (checkpointEvery < 0) {
+                    std::cerr << "Error: --checkpoint-every must be non-negative" << std::endl;
+                    return 1;
+                }
+            } else if (option == "--resume") {
+                resumeFile = value;
+            } else if (option == "--warm-start") {
+                warmStartFile = value;
+            } else if (option == "--xi") {
+                xi = std::stod(value);
+                if (xi < 0.0 || xi > 1.0) {
+                    std::cerr << "Error: xi must be between 0 and 1" << std::endl;
+                    return 1;
+                }
             } else {
                 std::cerr << "Error: Unknown option " << option << std::endl;
                 printUsage(argv[0]);
@@ -203,6 +495,35 @@ int main(int argc, char** argv) {
         }
     }
 
+    if (numColonies > 1 && (!checkpointFile.empty() || !resumeFile.empty() || !warmStartFile.empty())) {
+        std::cerr << "Error: --checkpoint, --resume and --warm-start are not supported with --colonies" << std::endl;
+        return 1;
+    }
+
+    if (backend == "cuda") {
+        if (!AntColony::isBackendAvailable("cuda")) {
+            std::cerr << "Error: --backend cuda is not available in this build" << std::endl;
+            return 1;
+        }
+        if (pheromoneMode == "acs" || candidateListSize > 0) {
+            std::cerr << "Error: --backend cuda does not support --pheromone-mode acs or --candidates" << std::endl;
+            return 1;
+        }
+    }
+
+    // Pin the threads before loading, so the matrices are first touched by
+    // the threads (and on the nodes) that later compute on them
+    if (threadBinding != numa::ThreadBinding::NONE) {
+#ifdef _OPENMP
+        if (useParallel && numThreads > 0) {
+            omp_set_num_threads(numThreads);
+        }
+#endif
+        if (!numa::bindThreads(threadBinding, useParallel ? numThreads : 1)) {
+            std::cerr << "Warning: could not bind threads (--bind needs Linux and OpenMP)" << std::endl;
+        }
+    }
+
     // Print header
     std::cout << "========================================\n";
     std::cout << "Ant Colony Optimization - TSP Solver\n";
@@ -211,19 +532,36 @@ int main(int argc, char** argv) {
     // Load TSP problem
     std::cout << "Loading TSP instance from: " << inputFile << std::endl;
     TSPLoader loader(inputFile);
-    Graph graph = loader.loadGraph();
+    loader.setCacheDirectory(cacheDirectory);
+    loader.setWriteCache(writeCache);
+    Graph loadedGraph = loader.loadGraph(distanceStorage);
 
-    if (!graph.isValid()) {
+    if (!loadedGraph.isValid()) {
         std::cerr << "Error: Failed to load TSP instance from " << inputFile << std::endl;
         return 1;
     }
 
-    std::cout << "Successfully loaded " << graph.getNumCities() << " cities\n\n";
+    // Build candidate lists on the graph itself so the nearest neighbor tour
+    // used for tau0 also benefits (avoids an O(n²) scan on large instances)
+    if (candidateListSize > 0) {
+        loadedGraph.buildNeighborLists(candidateListSize);
+    }
+
+    // Loaded once and shared read-only with the colony (no copy of the distance matrix)
+    std::shared_ptr<const Graph> graph = std::make_shared<const Graph>(std::move(loadedGraph));
+
+    std::cout << "Successfully loaded " << graph->getNumCities() << " cities"
+              << (loader.wasLoadedFromCache() ? " from cache" : "")
+              << " (distance matrix: " << distanceStorageName << ", "
+              << std::fixed << std::setprecision(1)
+              << graph->getDistanceMemoryBytes() / (1024.0 * 1024.0) << " MB)\n\n";
+    std::cout.unsetf(std::ios_base::floatfield);
+    std::cout << std::setprecision(6);
 
     // If numAnts not specified, use one ant per city with distinct start positions
     bool useDistinctStartCities = false;
     if (numAnts == -1) {
-        numAnts = graph.getNumCities();
+        numAnts = graph->getNumCities();
         useDistinctStartCities = true;
     }
 
@@ -244,6 +582,24 @@ int main(int argc, char** argv) {
     std::cout << "  Beta (heuristic):     " << beta << "\n";
     std::cout << "  Rho (evaporation):    " << rho << "\n";
     std::cout << "  Q (deposit factor):   " << Q << "\n";
+    std::cout << "  Candidate lists:      ";
+    if (candidateListSize > 0) {
+        std::cout << candidateListSize << " nearest neighbors\n";
+    } else {
+        std::cout << "Disabled (all cities)\n";
+    }
+    if (timeLimit > 0.0) {
+        std::cout << "  Time limit:           " << timeLimit << " s\n";
+    }
+    if (targetDistance > 0.0) {
+        std::cout << "  Target distance:      " << targetDistance << "\n";
+    }
+    std::cout << "  Random seed:          ";
+    if (useSeed) {
+        std::cout << seed << "\n";
+    } else {
+        std::cout << "Random\n";
+    }
     std::cout << "  Threading:            ";
 #ifdef _OPENMP
     if (!useParallel || numThreads == 1) {
@@ -256,10 +612,32 @@ int main(int argc, char** argv) {
 #else
     std::cout << "Serial (OpenMP not available)\n";
 #endif
+    std::cout << "  NUMA placement:       " << numa::numNodes() << " node(s), "
+              << (numa::isFirstTouchEnabled() ? "parallel" : "single-threaded") << " first touch, "
+              << "binding: " << numa::threadBindingName(threadBinding) << "\n";
+    std::cout << "  Backend:              " << backend;
+    if (backend == "cuda") {
+        std::cout << " (" << GpuColony::deviceName() << ")";
+    }
+    std::cout << "\n";
+    std::cout << "  Selection kernels:    " << selection::activeKernels().name << "\n";
+    if (numColonies > 1) {
+        std::cout << "  Colonies:             " << numColonies << " (migration: ";
+        if (migrateEvery > 0) {
+            std::cout << migrationTopology << " every " << migrateEvery << " iterations)\n";
+        } else {
+            std::cout << "never)\n";
+        }
+    }
     std::cout << "  Local Search:         ";
     if (useLocalSearch) {
         std::cout << "Enabled (" << (use3opt ? "2-opt + 3-opt" : "2-opt only")
-                  << ", mode: " << localSearchMode << ")\n";
+                  << ", mode: " << localSearchMode;
+        if (localSearchMode == "top-k") {
+            std::cout << " (k = " << (localSearchTopK > 0 ? std::to_string(localSearchTopK) : "threads") << ")";
+        }
+        std::cout
+                  << ", operator: " << localSearchOperator << ")\n";
     } else {
         std::cout << "Disabled\n";
     }
@@ -274,32 +652,49 @@ int main(int argc, char** argv) {
     if (pheromoneMode == "rank") {
         int effectiveRankSize = (rankSize >= 0) ? rankSize : (numAnts / 2);
         std::cout << " (top " << effectiveRankSize << " ants)";
+    } else if (pheromoneMode == "mmas") {
+        std::cout << " (restart after ";
+        if (mmasRestartIterations > 0) {
+            std::cout << mmasRestartIterations << " stagnant iterations)";
+        } else {
+            std::cout << "never)";
+        }
+    } else if (pheromoneMode == "acs") {
+        std::cout << " (q0: " << q0 << ", xi: " << xi << ")";
     }
     std::cout << "\n";
     std::cout << "\n";
 
     // Initialize and run ACO
     std::cout << "Running Ant Colony Optimization...\n";
-    AntColony colony(graph, numAnts, alpha, beta, rho, Q, useDistinctStartCities);
 
-    // Configure threading
-    colony.setUseParallel(useParallel);
-    colony.setNumThreads(numThreads);
+    // Algorithm settings shared by the single colony and every island colony
+    auto configureColony = [&](AntColony& colony) {
+        // Configure candidate lists
+        colony.setCandidateListSize(candidateListSize);
 
-    // Configure local search
-    colony.setUseLocalSearch(useLocalSearch);
-    colony.setUse3Opt(use3opt);
-    colony.setLocalSearchMode(localSearchMode);
+        // Configure local search
+        colony.setUseLocalSearch(useLocalSearch);
+        colony.setUse3Opt(use3opt);
+        colony.setLocalSearchMode(localSearchMode);
+        colony.setLocalSearchTopK(localSearchTopK);
+        colony.setLocalSearchOperator(localSearchOperator);
 
-    // Configure elitist strategy
-    colony.setUseElitist(useElitist);
-    if (elitistWeight >= 0.0) {
-        colony.setElitistWeight(elitistWeight);
-    }
-    colony.setPheromoneMode(pheromoneMode);
-    if (rankSize >= 0) {
-        colony.setRankSize(rankSize);
-    }
+        // Configure elitist strategy
+        colony.setUseElitist(useElitist);
+        if (elitistWeight >= 0.0) {
+            colony.setElitistWeight(elitistWeight);
+        }
+        colony.setPheromoneMode(pheromoneMode);
+        if (rankSize >= 0) {
+            colony.setRankSize(rankSize);
+        }
+        colony.setMMASRestartIterations(mmasRestartIterations);
+        colony.setQ0(q0);
+        colony.setXi(xi);
+        colony.setBackend(backend);
+        colony.setProfiling(profile);
+    };
 
     // Progress callback to show updates every 10 iterations
     int lastReportedIteration = 0;
@@ -316,11 +711,84 @@ int main(int argc, char** argv) {
         }
     };
 
-    Tour bestTour = colony.solve(iterations, progressCallback);
+    Tour bestTour;
+    std::vector<double> convergenceData;
+    std::string stopReason;
+    std::vector<ColonyStats> profiles;  // One per colony with --profile
+    if (numColonies > 1) {
+        MultiColony islands(graph, numColonies, numAnts, alpha, beta, rho, Q, useDistinctStartCities);
+        islands.configure(configureColony);
+        if (useSeed) {
+            islands.setSeed(seed);
+        }
+        islands.setNumThreads(useParallel ? numThreads : 1);
+        islands.setMigrationInterval(migrateEvery);
+        islands.setMigrationTopology(migrationTopology);
+        islands.setTimeLimit(timeLimit);
+        islands.setTargetDistance(targetDistance);
+
+        bestTour = islands.solve(iterations, progressCallback);
+        convergenceData = islands.getConvergenceData();
+        stopReason = islands.getStopReason();
+        if (profile) {
+            for (int c = 0; c < islands.getNumColonies(); ++c) {
+                profiles.push_back(islands.getColony(c).getStats());
+            }
+        }
+    } else {
+        AntColony colony(graph, numAnts, alpha, beta, rho, Q, useDistinctStartCities);
+        configureColony(colony);
+
+        // Configure random seed
+        if (useSeed) {
+            colony.setSeed(seed);
+        }
+
+        // Configure threading
+        colony.setUseParallel(useParallel);
+        colony.setNumThreads(numThreads);
+
+        // Configure stopping criteria
+        colony.setTimeLimit(timeLimit);
+        colony.setTargetDistance(targetDistance);
+
+        // Configure checkpoints and the starting point
+        if (!checkpointFile.empty()) {
+            colony.setCheckpointFile(checkpointFile, checkpointEvery);
+        }
+        if (!warmStartFile.empty()) {
+            std::vector<int> warmStart;
+            if (!readTourFile(warmStartFile, warmStart) || !colony.setWarmStartTour(warmStart)) {
+                std::cerr << "Error: " << warmStartFile << " is not a tour of all "
+                          << graph->getNumCities() << " cities" << std::endl;
+                return 1;
+            }
+        }
+        if (!resumeFile.empty()) {
+            std::ifstream probe(resumeFile);
+            if (!probe) {
+                std::cerr << "Warning: checkpoint " << resumeFile << " not found, starting fresh" << std::endl;
+            } else if (colony.restore(resumeFile)) {
+                std::cout << "Resuming from " << resumeFile << " after iteration "
+                          << colony.getCompletedIterations() << " (best distance: "
+                          << colony.getBestTour().getDistance() << ")\n";
+            } else {
+                std::cerr << "Error: " << resumeFile << " is not a checkpoint of this instance" << std::endl;
+                return 1;
+            }
+        }
+
+        bestTour = colony.solve(iterations, progressCallback);
+        convergenceData = colony.getConvergenceData();
+        stopReason = colony.getStopReason();
+        if (profile) {
+            profiles.push_back(colony.getStats());
+        }
+    }
 
     // Report final iteration if not already reported
-    if (lastReportedIteration != static_cast<int>(colony.getConvergenceData().size())) {
-        std::cout << "  Iteration " << std::setw(5) << colony.getConvergenceData().size()
+    if (lastReportedIteration != static_cast<int>(convergenceData.size())) {
+        std::cout << "  Iteration " << std::setw(5) << convergenceData.size()
                   << " | Best distance: " << std::fixed << std::setprecision(2)
                   << bestTour.getDistance() << "\n";
     }
@@ -331,7 +799,12 @@ int main(int argc, char** argv) {
     std::cout << "========================================\n\n";
 
     std::cout << "Best tour distance: " << std::fixed << std::setprecision(2)
-              << bestTour.getDistance() << "\n\n";
+              << bestTour.getDistance() << "\n";
+    if (!stopReason.empty()) {
+        std::cout << "Stopped by:         " << stopReason << " (after "
+                  << convergenceData.size() << " iterations)\n";
+    }
+    std::cout << "\n";
 
     std::cout << "Best tour sequence:\n";
     const auto& sequence = bestTour.getSequence();
@@ -344,7 +817,6 @@ int main(int argc, char** argv) {
     std::cout << " -> " << sequence[0] << " (return to start)\n\n";
 
     // Print convergence summary
-    const auto& convergenceData = colony.getConvergenceData();
     if (!convergenceData.empty()) {
         std::cout << "Convergence Summary:\n";
         std::cout << "  First iteration best: " << std::fixed << std::setprecision(2)
@@ -360,6 +832,19 @@ int main(int argc, char** argv) {
                   << improvement << " (" << improvementPercent << "%)\n";
     }
 
+    if (profile) {
+        std::cout << "\n";
+        printProfile(profiles);
+        if (!profileCsv.empty()) {
+            if (writeProfileCsv(profileCsv, profiles)) {
+                std::cout << "Per-iteration profile written to: " << profileCsv << "\n";
+            } else {
+                std::cerr << "Error: Could not write profile to " << profileCsv << std::endl;
+                return 1;
+            }
+        }
+    }
+
     std::cout << "\n========================================\n";
 
     return 0;
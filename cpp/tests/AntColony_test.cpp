@@ -1,7 +1,15 @@
 #include <gtest/gtest.h>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <thread>
 #include "AntColony.h"
 #include "Graph.h"
 #include "City.h"
+#include "TestGraphs.h"
 
 // Helper function to create a simple triangle graph
 Graph createTriangleGraph() {
@@ -555,6 +563,153 @@ TEST(AntColonyTest, RankModeAutoSize) {
     EXPECT_GT(bestTour.getDistance(), 0.0);
 }
 
+// Test MAX-MIN Ant System: trails stay within [tau_min, tau_max] of the best tour
+TEST(AntColonyTest, PheromoneModeMMAS) {
+    Graph graph = scatteredGraph(30);
+    AntColony colony(graph, 10, 1.0, 2.0, 0.1, 1.0);
+    colony.setSeed(3);
+    colony.setPheromoneMode("mmas");
+    EXPECT_EQ(colony.getPheromoneMode(), "mmas");
+
+    Tour bestTour = colony.solve(40);
+    EXPECT_TRUE(bestTour.validate(30));
+
+    // tau_max = Q / (rho * L_best); tau_min is a positive fraction of it
+    const PheromoneMatrix& pheromones = colony.getPheromones();
+    double tauMax = pheromones.getMaxPheromone();
+    double tauMin = pheromones.getMinPheromone();
+    EXPECT_NEAR(tauMax, 1.0 / (0.1 * bestTour.getDistance()), 1e-12);
+    EXPECT_GT(tauMin, 0.0);
+    EXPECT_LT(tauMin, tauMax);
+    for (int i = 0; i < 30; ++i) {
+        for (int j = 0; j < 30; ++j) {
+            if (i != j) {
+                EXPECT_GE(pheromones.getPheromone(i, j), tauMin);
+                EXPECT_LE(pheromones.getPheromone(i, j), tauMax);
+            }
+        }
+    }
+}
+
+// Test MMAS restart setting and that frequent restarts still give valid tours
+TEST(AntColonyTest, MMASRestartIterations) {
+    Graph graph = createSquareGraph();
+    AntColony colony(graph, 10, 1.0, 2.0, 0.5, 100.0);
+    EXPECT_EQ(colony.getMMASRestartIterations(), 100);
+
+    colony.setMMASRestartIterations(-5);  // Negative clamps to 0 (never)
+    EXPECT_EQ(colony.getMMASRestartIterations(), 0);
+
+    colony.setPheromoneMode("mmas");
+    colony.setMMASRestartIterations(2);
+    Tour bestTour = colony.solve(20);
+    EXPECT_TRUE(bestTour.validate(4));
+    EXPECT_NEAR(bestTour.getDistance(), 4.0, 1e-9);
+
+    // Switching back to another mode removes the trail limits again
+    colony.setPheromoneMode("all");
+    colony.initialize();
+    EXPECT_EQ(colony.getPheromones().getMinPheromone(), 0.0);
+}
+
+// Test Ant Colony System: valid tours, parameter clamping, thread-count independence
+TEST(AntColonyTest, PheromoneModeACS) {
+    Graph graph = scatteredGraph(40);
+
+    AntColony colony(graph, 10, 1.0, 2.0, 0.1, 1.0);
+    colony.setQ0(1.5);
+    EXPECT_EQ(colony.getQ0(), 1.0);
+    colony.setXi(-0.5);
+    EXPECT_EQ(colony.getXi(), 0.0);
+
+    for (int candidates : {0, 8}) {
+        auto run = [&](int threads) {
+            AntColony acs(graph, 10, 1.0, 2.0, 0.1, 1.0);
+            acs.setPheromoneMode("acs");
+            acs.setCandidateListSize(candidates);
+            acs.setSeed(11);
+            acs.setNumThreads(threads);
+            return acs.solve(20);
+        };
+        Tour serial = run(1);
+        Tour parallel = run(4);
+        EXPECT_TRUE(serial.validate(40)) << "candidates: " << candidates;
+        EXPECT_EQ(serial.getSequence(), parallel.getSequence()) << "candidates: " << candidates;
+        EXPECT_EQ(serial.getDistance(), parallel.getDistance()) << "candidates: " << candidates;
+    }
+}
+
+// Test ACS trail bookkeeping: local updates pull trails towards tau0 = Q / (n * C^nn)
+// and the global update is limited to the best-so-far tour
+TEST(AntColonyTest, ACSPheromoneUpdates) {
+    Graph graph = createSquareGraph();
+    AntColony colony(graph, 4, 1.0, 2.0, 0.5, 1.0);
+    colony.setPheromoneMode("acs");
+    colony.setSeed(5);
+    colony.initialize();
+
+    double tau0 = 1.0 / (4 * graph.nearestNeighborTourLength());
+    EXPECT_NEAR(colony.getPheromones().getPheromone(0, 1), tau0, 1e-15);
+
+    colony.runIteration();
+    const Tour& best = colony.getBestTour();
+    ASSERT_TRUE(best.validate(4));
+    EXPECT_NEAR(best.getDistance(), 4.0, 1e-9);
+
+    // Best-tour edges were reinforced above tau0; the diagonals (never in an
+    // optimal square tour) only saw local updates and stay at tau0
+    const std::vector<int>& sequence = best.getSequence();
+    for (size_t k = 0; k < sequence.size(); ++k) {
+        int a = sequence[k];
+        int b = sequence[(k + 1) % sequence.size()];
+        EXPECT_GT(colony.getPheromones().getPheromone(a, b), tau0);
+    }
+    EXPECT_NEAR(colony.getPheromones().getPheromone(0, 2), tau0, 1e-15);
+    EXPECT_NEAR(colony.getPheromones().getPheromone(1, 3), tau0, 1e-15);
+}
+
+// Test importTour(): only shorter tours of the right size are adopted
+TEST(AntColonyTest, ImportTour) {
+    Graph graph = createSquareGraph();
+    AntColony colony(graph, 4, 1.0, 2.0, 0.5, 100.0);
+    colony.setSeed(2);
+    colony.initialize();
+
+    // Wrong size and empty tours are ignored
+    colony.importTour(Tour({0, 1, 2}, 3.0));
+    EXPECT_TRUE(colony.getBestTour().getSequence().empty());
+
+    double before = colony.getPheromones().getPheromone(0, 1);
+    colony.importTour(Tour({0, 1, 2, 3}, 4.0));
+    EXPECT_EQ(colony.getBestTour().getSequence(), std::vector<int>({0, 1, 2, 3}));
+    EXPECT_NEAR(colony.getPheromones().getPheromone(0, 1), before + 100.0 / 4.0, 1e-9);
+    EXPECT_NEAR(colony.getPheromones().getPheromone(0, 2), before, 1e-12);
+
+    // A longer tour does not replace the best-so-far tour
+    colony.importTour(Tour({0, 2, 1, 3}, 4.0 + 2.0 * std::sqrt(2.0)));
+    EXPECT_EQ(colony.getBestTour().getSequence(), std::vector<int>({0, 1, 2, 3}));
+}
+
+// Test adding pheromone to individual edges (used to merge other processes' trails)
+TEST(AntColonyTest, AddPheromoneEdges) {
+    Graph graph = createSquareGraph();
+    AntColony colony(graph, 4, 1.0, 2.0, 0.5, 100.0);
+    colony.initialize();
+
+    double before = colony.getPheromones().getPheromone(0, 1);
+    colony.addPheromoneEdges({{0, 1}, {2, 2}, {0, 7}}, {3.0, 5.0, 5.0});
+    EXPECT_NEAR(colony.getPheromones().getPheromone(0, 1), before + 3.0, 1e-12);
+    EXPECT_NEAR(colony.getPheromones().getPheromone(1, 0), before + 3.0, 1e-12);
+    EXPECT_NEAR(colony.getPheromones().getPheromone(1, 2), before, 1e-12);
+
+    // MMAS keeps its upper trail limit
+    colony.setPheromoneMode("mmas");
+    colony.initialize();
+    double tauMax = colony.getPheromones().getMaxPheromone();
+    colony.addPheromoneEdges({{1, 2}}, {1e6});
+    EXPECT_DOUBLE_EQ(colony.getPheromones().getPheromone(1, 2), tauMax);
+}
+
 // Test combining elitist with different pheromone modes
 TEST(AntColonyTest, ElitistWithRankMode) {
     Graph graph = createSquareGraph();
@@ -588,7 +743,7 @@ TEST(AntColonyTest, ElitistWithBestIterationMode) {
 // Test all pheromone modes produce valid tours
 TEST(AntColonyTest, AllPheromoneModes) {
     Graph graph = createSquareGraph();
-    std::vector<std::string> modes = {"all", "best-iteration", "best-so-far", "rank"};
+    std::vector<std::string> modes = {"all", "best-iteration", "best-so-far", "rank", "mmas", "acs"};
 
     for (const auto& mode : modes) {
         AntColony colony(graph, 10, 1.0, 2.0, 0.5, 100.0);
@@ -619,3 +774,519 @@ TEST(AntColonyTest, ElitistConvergence) {
         bestSoFar = std::min(bestSoFar, dist);
     }
 }
+
+// ==================== Candidate List Tests ====================
+
+// Test candidate list construction produces valid tours
+TEST(AntColonyTest, CandidateListValidTours) {
+    Graph graph = scatteredGraph(30);
+    AntColony colony(graph, 10, 1.0, 2.0, 0.5, 100.0);
+
+    colony.setCandidateListSize(5);
+    EXPECT_EQ(colony.getCandidateListSize(), 5);
+
+    Tour bestTour = colony.solve(10);
+
+    EXPECT_TRUE(bestTour.validate(30));
+    EXPECT_GT(bestTour.getDistance(), 0.0);
+}
+
+// Test candidate list larger than the problem behaves like full construction
+TEST(AntColonyTest, CandidateListLargerThanProblem) {
+    Graph graph = createSquareGraph();
+    AntColony colony(graph, 20, 1.0, 2.0, 0.5, 100.0);
+
+    colony.setCandidateListSize(50);
+    Tour bestTour = colony.solve(50);
+
+    EXPECT_TRUE(bestTour.validate(4));
+    EXPECT_NEAR(bestTour.getDistance(), 4.0, 0.1);
+}
+
+// Test colonies constructed from a shared graph reuse it instead of copying
+TEST(AntColonyTest, SharedGraphNotCopied) {
+    auto graph = std::make_shared<const Graph>(createSquareGraph());
+    AntColony first(graph, 5, 1.0, 2.0, 0.5, 100.0);
+    AntColony second(graph, 5, 1.0, 2.0, 0.5, 100.0);
+
+    EXPECT_EQ(&first.getGraph(), graph.get());
+    EXPECT_EQ(&second.getGraph(), graph.get());
+    EXPECT_EQ(first.getSharedGraph(), second.getSharedGraph());
+
+    EXPECT_TRUE(first.solve(10).validate(4));
+    EXPECT_TRUE(second.solve(10).validate(4));
+}
+
+// Test candidate lists on a shared compact graph without prebuilt neighbor lists
+TEST(AntColonyTest, CandidateListsOnSharedTriangularGraph) {
+    auto graph = sharedScatteredGraph(25, DistanceStorage::TRIANGULAR_FLOAT);
+    AntColony colony(graph, 8, 1.0, 2.0, 0.5, 100.0);
+    colony.setCandidateListSize(6);
+
+    Tour bestTour = colony.solve(10);
+
+    EXPECT_TRUE(bestTour.validate(25));
+
+    // Reported length agrees with the compact matrix
+    const std::vector<int>& sequence = bestTour.getSequence();
+    double length = 0.0;
+    for (size_t i = 0; i < sequence.size(); ++i) {
+        length += graph->getDistance(sequence[i], sequence[(i + 1) % sequence.size()]);
+    }
+    EXPECT_NEAR(bestTour.getDistance(), length, 1e-6);
+}
+
+// Test a fixed seed reproduces the same run, also across repeated solve() calls
+TEST(AntColonyTest, SeedReproducible) {
+    Graph graph = scatteredGraph(30);
+
+    AntColony first(graph, 10, 1.0, 2.0, 0.5, 100.0);
+    first.setUseParallel(false);
+    first.setSeed(2024);
+    EXPECT_EQ(first.getSeed(), 2024u);
+    Tour firstTour = first.solve(20);
+
+    AntColony second(graph, 10, 1.0, 2.0, 0.5, 100.0);
+    second.setUseParallel(false);
+    second.setSeed(2024);
+    Tour secondTour = second.solve(20);
+
+    EXPECT_EQ(firstTour.getSequence(), secondTour.getSequence());
+    EXPECT_DOUBLE_EQ(firstTour.getDistance(), secondTour.getDistance());
+    EXPECT_EQ(first.getConvergenceData(), second.getConvergenceData());
+
+    // solve() restarts the seeded stream
+    Tour again = first.solve(20);
+    EXPECT_EQ(again.getSequence(), firstTour.getSequence());
+
+    // Parallel construction and buffered deposits give the same run
+    AntColony parallel(graph, 10, 1.0, 2.0, 0.5, 100.0);
+    parallel.setNumThreads(4);
+    parallel.setSeed(2024);
+    Tour parallelTour = parallel.solve(20);
+    EXPECT_EQ(parallelTour.getSequence(), firstTour.getSequence());
+    EXPECT_EQ(parallel.getConvergenceData(), first.getConvergenceData());
+}
+
+// Test neighbor-list local search operator in "all" mode
+TEST(AntColonyTest, NeighborLocalSearchOperator) {
+    Graph graph = scatteredGraph(40);
+    AntColony colony(graph, 10, 1.0, 2.0, 0.5, 100.0);
+    colony.setUseLocalSearch(true);
+    colony.setLocalSearchMode("all");
+    colony.setLocalSearchOperator("neighbor");
+    EXPECT_EQ(colony.getLocalSearchOperator(), "neighbor");
+
+    // Invalid operators are ignored
+    colony.setLocalSearchOperator("bogus");
+    EXPECT_EQ(colony.getLocalSearchOperator(), "neighbor");
+
+    Tour bestTour = colony.solve(10);
+    EXPECT_TRUE(bestTour.validate(40));
+
+    colony.setLocalSearchOperator("lk");
+    EXPECT_EQ(colony.getLocalSearchOperator(), "lk");
+    Tour lkTour = colony.solve(5);
+    EXPECT_TRUE(lkTour.validate(40));
+}
+
+// Test "top-k" local search mode and parallel-scan "best" mode
+TEST(AntColonyTest, TopKLocalSearchMode) {
+    Graph graph = scatteredGraph(40);
+
+    AntColony colony(graph, 10, 1.0, 2.0, 0.5, 100.0);
+    colony.setUseLocalSearch(true);
+    colony.setLocalSearchMode("top-k");
+    colony.setLocalSearchTopK(3);
+    EXPECT_EQ(colony.getLocalSearchTopK(), 3);
+    colony.setLocalSearchTopK(-1);  // Negative clamps to 0 (auto)
+    EXPECT_EQ(colony.getLocalSearchTopK(), 0);
+
+    // With an explicit k the result does not depend on the thread count
+    auto run = [&](int threads) {
+        AntColony topK(graph, 10, 1.0, 2.0, 0.5, 100.0);
+        topK.setUseLocalSearch(true);
+        topK.setUse3Opt(false);
+        topK.setLocalSearchMode("top-k");
+        topK.setLocalSearchTopK(3);
+        topK.setSeed(21);
+        topK.setNumThreads(threads);
+        return topK.solve(10);
+    };
+    Tour serial = run(1);
+    Tour parallel = run(4);
+    EXPECT_TRUE(serial.validate(40));
+    EXPECT_EQ(serial.getSequence(), parallel.getSequence());
+
+    // Local search on the top tours beats no local search from the same seed
+    AntColony plain(graph, 10, 1.0, 2.0, 0.5, 100.0);
+    plain.setSeed(21);
+    plain.setNumThreads(1);
+    EXPECT_LE(serial.getDistance(), plain.solve(10).getDistance());
+
+    // "best" mode with the parallel exhaustive scans
+    AntColony best(graph, 10, 1.0, 2.0, 0.5, 100.0);
+    best.setUseLocalSearch(true);
+    best.setUseParallel(true);
+    Tour bestTour = best.solve(5);
+    EXPECT_TRUE(bestTour.validate(40));
+    Tour check = bestTour;
+    EXPECT_FALSE(LocalSearch::twoOpt(check, graph));
+}
+
+// Test per-phase profiling through getStats()
+TEST(AntColonyTest, Profiling) {
+    Graph graph = scatteredGraph(40);
+
+    // Disabled by default: nothing is recorded
+    AntColony plain(graph, 10, 1.0, 2.0, 0.5, 100.0);
+    EXPECT_FALSE(plain.getProfiling());
+    plain.solve(3);
+    EXPECT_TRUE(plain.getStats().iterations.empty());
+    EXPECT_EQ(plain.getStats().total.totalSeconds(), 0.0);
+
+    AntColony colony(graph, 10, 1.0, 2.0, 0.5, 100.0);
+    colony.setProfiling(true);
+    colony.setUseLocalSearch(true);
+    colony.setLocalSearchMode("all");
+    colony.setLocalSearchOperator("neighbor");
+    colony.setCandidateListSize(5);
+    colony.setSeed(3);
+
+    // The callback sees the iterations profiled so far
+    std::vector<size_t> seen;
+    colony.setCallbackInterval(1);
+    colony.solve(6, [&](int, double, const std::vector<int>&, const std::vector<double>&) {
+        seen.push_back(colony.getStats().iterations.size());
+    });
+    EXPECT_EQ(seen, (std::vector<size_t>{1, 2, 3, 4, 5, 6}));
+
+    const ColonyStats& stats = colony.getStats();
+    ASSERT_EQ(stats.iterations.size(), 6u);
+    PhaseStats sum;
+    for (const PhaseStats& phases : stats.iterations) {
+        EXPECT_GT(phases.construction, 0.0);
+        EXPECT_GT(phases.localSearch, 0.0);
+        EXPECT_GT(phases.evaporation, 0.0);
+        EXPECT_GE(phases.selection, 0.0);
+        EXPECT_GE(phases.deposit, 0.0);
+        sum += phases;
+    }
+    EXPECT_DOUBLE_EQ(stats.total.totalSeconds(), sum.totalSeconds());
+    EXPECT_EQ(stats.total.localSearchEvaluations, sum.localSearchEvaluations);
+    EXPECT_GT(stats.total.localSearchEvaluations, stats.total.localSearchMoves);
+    EXPECT_GT(stats.total.localSearchMoves, 0u);
+
+    // 5 candidates of 40 cities: ants run out of unvisited candidates
+    EXPECT_GT(stats.total.candidateFallbacks, 0u);
+
+    // Profiling does not change the search; a new solve() starts a new profile
+    AntColony unprofiled(graph, 10, 1.0, 2.0, 0.5, 100.0);
+    unprofiled.setUseLocalSearch(true);
+    unprofiled.setLocalSearchMode("all");
+    unprofiled.setLocalSearchOperator("neighbor");
+    unprofiled.setCandidateListSize(5);
+    unprofiled.setSeed(3);
+    EXPECT_EQ(unprofiled.solve(6).getSequence(), colony.getBestTour().getSequence());
+    colony.solve(2);
+    EXPECT_EQ(colony.getStats().iterations.size(), 2u);
+}
+
+// Test incremental progress updates rebuild the full history and best tour
+TEST(AntColonyTest, IncrementalCallback) {
+    Graph graph = scatteredGraph(30);
+
+    for (bool asynchronous : {false, true}) {
+        AntColony colony(graph, 10, 1.0, 2.0, 0.5, 100.0);
+        colony.setSeed(5);
+        colony.setCallbackInterval(3);
+
+        std::vector<double> history;
+        std::vector<int> tour;
+        std::vector<int> iterations;
+        int finalUpdates = 0;
+        bool inOrder = true;
+        colony.setIncrementalCallback([&](const ProgressUpdate& update) {
+            inOrder = inOrder && update.convergenceOffset == static_cast<int>(history.size());
+            history.insert(history.end(), update.newConvergence.begin(), update.newConvergence.end());
+            if (update.tourImproved) {
+                tour = update.bestTour;
+            } else {
+                inOrder = inOrder && update.bestTour.empty();
+            }
+            iterations.push_back(update.iteration);
+            finalUpdates += update.final ? 1 : 0;
+        }, asynchronous);
+
+        Tour best = colony.solve(10);
+        EXPECT_TRUE(inOrder);
+        EXPECT_EQ(history, colony.getConvergenceData());
+        EXPECT_EQ(tour, best.getSequence());
+        EXPECT_EQ(finalUpdates, 1);
+        ASSERT_FALSE(iterations.empty());
+        EXPECT_EQ(iterations.back(), 10);
+        if (!asynchronous) {
+            // Every third iteration, then the final update
+            EXPECT_EQ(iterations, (std::vector<int>{3, 6, 9, 10}));
+        }
+    }
+
+    // Asynchronous callback errors end solve() with the exception
+    AntColony failing(graph, 10, 1.0, 2.0, 0.5, 100.0);
+    failing.setIncrementalCallback([](const ProgressUpdate&) {
+        throw std::runtime_error("consumer failed");
+    }, true);
+    EXPECT_THROW(failing.solve(5), std::runtime_error);
+}
+
+// Test the early stopping criteria of solve()
+TEST(AntColonyTest, StopCriteria) {
+    Graph square = createSquareGraph();
+    AntColony colony(square, 4, 1.0, 2.0, 0.5, 100.0);
+    colony.setSeed(42);  // Unseeded, all four ants may miss the optimum in iteration 1
+
+    colony.solve(5);
+    EXPECT_EQ(colony.getStopReason(), "iterations");
+
+    // The optimal square tour is found in the first iteration
+    colony.setTargetDistance(4.0);
+    Tour bestTour = colony.solve(100);
+    EXPECT_EQ(colony.getStopReason(), "target");
+    EXPECT_EQ(colony.getConvergenceData().size(), 1u);
+    EXPECT_NEAR(bestTour.getDistance(), 4.0, 1e-9);
+    colony.setTargetDistance(0.0);
+
+    // A stop requested from the callback ends the run after that iteration
+    colony.setCallbackInterval(1);
+    colony.solve(-1, [&colony](int iteration, double bestDistance, const std::vector<int>&,
+                               const std::vector<double>&) {
+        EXPECT_EQ(colony.getCompletedIterations(), iteration);
+        EXPECT_DOUBLE_EQ(colony.getBestTourSnapshot().getDistance(), bestDistance);
+        if (iteration == 3) {
+            colony.requestStop();
+        }
+    });
+    EXPECT_EQ(colony.getStopReason(), "stopped");
+    EXPECT_EQ(colony.getConvergenceData().size(), 3u);
+
+    // The request does not carry over into the next solve()
+    colony.solve(4);
+    EXPECT_EQ(colony.getStopReason(), "iterations");
+
+    // A stop requested before solve() starts ends it before the first
+    // iteration, with the nearest neighbor tour as result
+    colony.requestStop();
+    bestTour = colony.solve(100);
+    EXPECT_EQ(colony.getStopReason(), "stopped");
+    EXPECT_TRUE(colony.getConvergenceData().empty());
+    EXPECT_TRUE(bestTour.validate(4));
+    EXPECT_DOUBLE_EQ(bestTour.getDistance(), square.nearestNeighborTourLength());
+    colony.solve(2);
+    EXPECT_EQ(colony.getStopReason(), "iterations");
+}
+
+// Test the wall-clock budget and stopping a solve() from another thread
+TEST(AntColonyTest, TimeLimitAndAsyncStop) {
+    std::vector<City> cities;
+    for (int i = 0; i < 200; ++i) {
+        double angle = 2.0 * M_PI * i / 200.0;
+        cities.emplace_back(i, 100.0 * std::cos(angle), 100.0 * std::sin(angle));
+    }
+    Graph graph(cities);
+    AntColony colony(graph, 20, 1.0, 2.0, 0.5, 100.0);
+    colony.setSeed(5);
+
+    colony.setTimeLimit(0.05);
+    auto start = std::chrono::steady_clock::now();
+    Tour bestTour = colony.solve(1000000);
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    EXPECT_EQ(colony.getStopReason(), "time-limit");
+    EXPECT_TRUE(bestTour.validate(200));
+    EXPECT_LT(elapsed, 1.0);
+
+    // A budget the setup already used up allows no iteration at all
+    colony.setTimeLimit(1e-9);
+    bestTour = colony.solve(1000000);
+    EXPECT_EQ(colony.getStopReason(), "time-limit");
+    EXPECT_TRUE(colony.getConvergenceData().empty());
+    EXPECT_TRUE(bestTour.validate(200));
+    colony.setTimeLimit(0.0);
+
+    // Poll the snapshot while solving, then stop the run
+    AntColony background(graph, 20, 1.0, 2.0, 0.5, 100.0);
+    background.setConvergenceThreshold(1000000);
+    std::thread worker([&background]() { background.solve(-1); });
+    while (background.getCompletedIterations() < 2) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    Tour snapshot = background.getBestTourSnapshot();
+    EXPECT_TRUE(snapshot.validate(200));
+    background.requestStop();
+    worker.join();
+    EXPECT_EQ(background.getStopReason(), "stopped");
+    EXPECT_LE(background.getBestTour().getDistance(), snapshot.getDistance());
+}
+
+// Test backend selection and errors when the CUDA backend cannot run
+TEST(AntColonyTest, BackendSelection) {
+    Graph graph = createSquareGraph();
+    AntColony colony(graph, 10, 1.0, 2.0, 0.5, 100.0);
+    EXPECT_EQ(colony.getBackend(), "cpu");
+    EXPECT_TRUE(AntColony::isBackendAvailable("cpu"));
+    EXPECT_FALSE(AntColony::isBackendAvailable("opencl"));
+
+    colony.setBackend("opencl");  // Unknown backends are ignored
+    EXPECT_EQ(colony.getBackend(), "cpu");
+    colony.setBackend("cuda");
+    EXPECT_EQ(colony.getBackend(), "cuda");
+
+    if (!AntColony::isBackendAvailable("cuda")) {
+        EXPECT_THROW(colony.initialize(), std::runtime_error);
+        colony.setBackend("cpu");
+        EXPECT_TRUE(colony.solve(5).validate(4));
+        return;
+    }
+
+    // Features only the CPU backend implements are rejected
+    colony.setPheromoneMode("acs");
+    EXPECT_THROW(colony.initialize(), std::invalid_argument);
+    colony.setPheromoneMode("all");
+    colony.setCandidateListSize(2);
+    EXPECT_THROW(colony.initialize(), std::invalid_argument);
+}
+
+// Test a run resumed from a checkpoint matches the uninterrupted run
+TEST(AntColonyTest, CheckpointResume) {
+    namespace fs = std::filesystem;
+    fs::path directory = fs::temp_directory_path() / "aco_checkpoint_test_resume";
+    fs::remove_all(directory);
+    std::string path = (directory / "colony.ckpt").string();
+
+    Graph graph = scatteredGraph(30);
+
+    for (const std::string mode : {"all", "mmas", "acs"}) {
+        auto configure = [&mode](AntColony& colony) {
+            colony.setSeed(7);
+            colony.setUseParallel(false);
+            colony.setPheromoneMode(mode);
+            colony.setMMASRestartIterations(5);
+        };
+
+        AntColony uninterrupted(graph, 10, 1.0, 2.0, 0.5, 100.0);
+        configure(uninterrupted);
+        Tour expected = uninterrupted.solve(20);
+
+        // Interrupted run: checkpoint written when solve() returns
+        AntColony first(graph, 10, 1.0, 2.0, 0.5, 100.0);
+        configure(first);
+        first.setCheckpointFile(path, 0);
+        first.solve(10);
+        ASSERT_TRUE(fs::exists(path)) << mode;
+
+        // The checkpoint brings its own parameters
+        AntColony resumed(graph, 3, 5.0, 1.0, 0.9, 1.0);
+        resumed.setUseParallel(false);
+        ASSERT_TRUE(resumed.restore(path)) << mode;
+        EXPECT_TRUE(resumed.hasRestoredState());
+        EXPECT_EQ(resumed.getNumAnts(), 10);
+        EXPECT_DOUBLE_EQ(resumed.getAlpha(), 1.0);
+        EXPECT_DOUBLE_EQ(resumed.getRho(), 0.5);
+        EXPECT_EQ(resumed.getPheromoneMode(), mode);
+        EXPECT_EQ(resumed.getCompletedIterations(), 10);
+        EXPECT_EQ(resumed.getConvergenceData(), first.getConvergenceData());
+
+        Tour tour = resumed.solve(20);
+        EXPECT_FALSE(resumed.hasRestoredState());
+        EXPECT_DOUBLE_EQ(tour.getDistance(), expected.getDistance()) << mode;
+        EXPECT_EQ(tour.getSequence(), expected.getSequence()) << mode;
+        EXPECT_EQ(resumed.getConvergenceData(), uninterrupted.getConvergenceData()) << mode;
+        for (int i = 0; i < 30; ++i) {
+            for (int j = 0; j < 30; ++j) {
+                ASSERT_DOUBLE_EQ(resumed.getPheromones().getPheromone(i, j),
+                            uninterrupted.getPheromones().getPheromone(i, j)) << mode;
+            }
+        }
+    }
+    fs::remove_all(directory);
+}
+
+// Test restore() rejects missing, corrupt and foreign checkpoints
+TEST(AntColonyTest, CheckpointRejectsInvalidFiles) {
+    namespace fs = std::filesystem;
+    fs::path directory = fs::temp_directory_path() / "aco_checkpoint_test_invalid";
+    fs::remove_all(directory);
+    std::string path = (directory / "colony.ckpt").string();
+
+    Graph square = createSquareGraph();
+    AntColony colony(square, 4, 1.0, 2.0, 0.5, 100.0);
+    colony.setSeed(3);
+    EXPECT_FALSE(colony.checkpoint(path));  // Nothing solved yet
+    colony.setCheckpointFile(path, 2);
+    EXPECT_EQ(colony.getCheckpointFile(), path);
+    colony.solve(5);
+    ASSERT_TRUE(fs::exists(path));
+    for (const auto& entry : fs::directory_iterator(directory)) {
+        EXPECT_EQ(entry.path().filename(), "colony.ckpt");  // No temporary left behind
+    }
+
+    AntColony other(square, 4, 1.0, 2.0, 0.5, 100.0);
+    EXPECT_FALSE(other.restore((directory / "missing.ckpt").string()));
+
+    // Wrong number of cities
+    Graph triangle = createTriangleGraph();
+    AntColony small(triangle, 4, 1.0, 2.0, 0.5, 100.0);
+    EXPECT_FALSE(small.restore(path));
+
+    // Same size, but the best tour has another length on this graph
+    std::vector<City> stretched = {
+        City(0, 0.0, 0.0), City(1, 2.0, 0.0), City(2, 2.0, 1.0), City(3, 0.0, 1.0)
+    };
+    AntColony foreign(Graph(stretched), 4, 1.0, 2.0, 0.5, 100.0);
+    EXPECT_FALSE(foreign.restore(path));
+
+    // Truncated and damaged files
+    auto size = fs::file_size(path);
+    std::string truncated = (directory / "truncated.ckpt").string();
+    fs::copy_file(path, truncated);
+    fs::resize_file(truncated, size - 8);
+    EXPECT_FALSE(other.restore(truncated));
+    {
+        std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+        file.seekp(0);
+        file.write("XXXX", 4);
+    }
+    EXPECT_FALSE(other.restore(path));
+    EXPECT_FALSE(other.hasRestoredState());
+    EXPECT_TRUE(other.getConvergenceData().empty());
+    fs::remove_all(directory);
+}
+
+// Test a warm start tour becomes the starting best-so-far tour
+TEST(AntColonyTest, WarmStartTour) {
+    Graph graph = scatteredGraph(30);
+
+    // A good tour from an earlier run seeds a short one
+    AntColony previous(graph, 10, 1.0, 2.0, 0.5, 100.0);
+    previous.setSeed(11);
+    Tour good = previous.solve(30);
+
+    AntColony colony(graph, 10, 1.0, 2.0, 0.5, 100.0);
+    colony.setSeed(12);
+    EXPECT_FALSE(colony.setWarmStartTour({0, 1, 2}));
+    EXPECT_FALSE(colony.setWarmStartTour(std::vector<int>(30, 0)));
+    EXPECT_TRUE(colony.getWarmStartTour().empty());
+    ASSERT_TRUE(colony.setWarmStartTour(good.getSequence()));
+    EXPECT_EQ(colony.getWarmStartTour(), good.getSequence());
+
+    colony.initialize();
+    EXPECT_EQ(colony.getBestTour().getSequence(), good.getSequence());
+    EXPECT_NEAR(colony.getBestTour().getDistance(), good.getDistance(), 1e-9);
+
+    // Its edges carry more trail than the rest
+    const std::vector<int>& sequence = good.getSequence();
+    EXPECT_GT(colony.getPheromones().getPheromone(sequence[0], sequence[1]),
+              colony.getPheromones().getPheromone(sequence[0], sequence[15]));
+
+    Tour tour = colony.solve(1);
+    EXPECT_LE(tour.getDistance(), good.getDistance() + 1e-9);
+}
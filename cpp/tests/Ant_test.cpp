@@ -3,6 +3,7 @@
 #include "Graph.h"
 #include "City.h"
 #include "PheromoneMatrix.h"
+#include "TestGraphs.h"
 #include <set>
 
 // Helper function to create a simple 3-city graph
@@ -375,3 +376,161 @@ TEST(AntTest, MultipleResets) {
     EXPECT_TRUE(ant.hasVisited(1));
     EXPECT_FALSE(ant.hasVisited(2));
 }
+
+// Test candidate selection only picks unvisited candidates
+TEST(AntTest, SelectNextCityFromCandidatesOnlyCandidates) {
+    std::vector<City> cities = {
+        City(0, 0.0, 0.0),
+        City(1, 1.0, 0.0),
+        City(2, 2.0, 0.0),
+        City(3, 50.0, 0.0),
+        City(4, 60.0, 0.0)
+    };
+    Graph graph(cities);
+    graph.buildNeighborLists(2);
+    PheromoneMatrix pheromones(5, 1.0);
+
+    for (int trial = 0; trial < 50; ++trial) {
+        Ant ant(0, 5);
+        int nextCity = ant.selectNextCityFromCandidates(graph, pheromones, 1.0, 2.0,
+                                                        graph.getNeighbors(0), 2);
+        EXPECT_TRUE(nextCity == 1 || nextCity == 2);
+    }
+}
+
+// Test fallback to best remaining city when all candidates are visited
+TEST(AntTest, SelectNextCityFromCandidatesFallback) {
+    std::vector<City> cities = {
+        City(0, 0.0, 0.0),
+        City(1, 1.0, 0.0),
+        City(2, 2.0, 0.0),
+        City(3, 50.0, 0.0),
+        City(4, 60.0, 0.0)
+    };
+    Graph graph(cities);
+    graph.buildNeighborLists(2);
+    PheromoneMatrix pheromones(5, 1.0);
+
+    Ant ant(0, 5);
+    ant.visitCity(1, graph);
+    ant.visitCity(2, graph);
+
+    // Neighbors of city 2 are {1, 0}, both visited - nearest remaining is 3
+    int nextCity = ant.selectNextCityFromCandidates(graph, pheromones, 1.0, 2.0,
+                                                    graph.getNeighbors(2), 2);
+    EXPECT_EQ(nextCity, 3);
+    EXPECT_EQ(ant.getCandidateFallbacks(), 1);
+
+    ant.visitCity(3, graph);
+    ant.visitCity(4, graph);
+    EXPECT_EQ(ant.selectNextCityFromCandidates(graph, pheromones, 1.0, 2.0,
+                                               graph.getNeighbors(4), 2), -1);
+
+    // A finished tour is not a fallback, and reset() clears the count
+    EXPECT_EQ(ant.getCandidateFallbacks(), 1);
+    ant.reset(0);
+    EXPECT_EQ(ant.getCandidateFallbacks(), 0);
+}
+
+// Test selection from a precomputed choice-info row
+TEST(AntTest, SelectNextCityChoiceInfo) {
+    Ant ant(0, 4);
+
+    // Only city 2 is attractive
+    std::vector<double> choiceRow = {5.0, 0.0, 1.0, 0.0};
+    for (int trial = 0; trial < 20; ++trial) {
+        EXPECT_EQ(ant.selectNextCity(choiceRow.data()), 2);
+    }
+
+    // All-zero weights still yield an unvisited city
+    std::vector<double> zeroRow(4, 0.0);
+    int nextCity = ant.selectNextCity(zeroRow.data());
+    EXPECT_GE(nextCity, 1);
+    EXPECT_LE(nextCity, 3);
+}
+
+// Test choice-info selection visits all cities and ends with -1
+TEST(AntTest, SelectNextCityChoiceInfoVisitsAll) {
+    Graph graph = createSimpleGraph();
+    Ant ant(0, 3);
+    std::vector<double> choiceRow = {1.0, 1.0, 1.0};
+
+    while (!ant.hasVisitedAll()) {
+        int nextCity = ant.selectNextCity(choiceRow.data());
+        ASSERT_NE(nextCity, -1);
+        ant.visitCity(nextCity, graph);
+    }
+
+    EXPECT_EQ(ant.selectNextCity(choiceRow.data()), -1);
+}
+
+// Test candidate selection with precomputed choice info
+TEST(AntTest, SelectNextCityFromCandidatesChoiceInfo) {
+    std::vector<City> cities = {
+        City(0, 0.0, 0.0),
+        City(1, 1.0, 0.0),
+        City(2, 2.0, 0.0),
+        City(3, 50.0, 0.0)
+    };
+    Graph graph(cities);
+    graph.buildNeighborLists(2);
+    PheromoneMatrix pheromones(4, 1.0);
+
+    Ant ant(0, 4);
+    const int* candidates = graph.getNeighbors(0);  // {1, 2}
+    std::vector<double> candidateChoice = {0.0, 3.0};
+
+    EXPECT_EQ(ant.selectNextCityFromCandidates(candidates, candidateChoice.data(), 2,
+                                               graph, pheromones, 1.0, 2.0), 2);
+}
+
+// Test ants with the same seed build the same tour
+TEST(AntTest, SeededAntsReproducible) {
+    Graph graph = scatteredGraph(20);
+    PheromoneMatrix pheromones(20, 1.0);
+
+    Ant first(0, 20, 12345);
+    Ant second(0, 20, 12345);
+    while (!first.hasVisitedAll()) {
+        first.visitCity(first.selectNextCity(graph, pheromones, 1.0, 2.0), graph);
+        second.visitCity(second.selectNextCity(graph, pheromones, 1.0, 2.0), graph);
+    }
+    EXPECT_EQ(first.getTour(), second.getTour());
+
+    // Reseeding an ant restarts its stream
+    Ant third(0, 20, 1);
+    third.setSeed(12345);
+    while (!third.hasVisitedAll()) {
+        third.visitCity(third.selectNextCity(graph, pheromones, 1.0, 2.0), graph);
+    }
+    EXPECT_EQ(third.getTour(), first.getTour());
+}
+
+// Test completing into an existing Tour and reusing the ant after reset
+TEST(AntTest, CompleteTourInPlaceAndReset) {
+    Graph graph = createSimpleGraph();
+    Ant ant(0, 3, 99);
+    ant.visitCity(1, graph);
+    ant.visitCity(2, graph);
+
+    Tour tour;
+    ant.completeTour(graph, tour);
+    EXPECT_TRUE(tour.validate(3));
+    EXPECT_DOUBLE_EQ(tour.getDistance(), 12.0);  // 3 + 5 + 4
+    EXPECT_EQ(tour.getSequence(), ant.completeTour(graph).getSequence());
+
+    // Reset reuses the ant for a new tour from another city
+    ant.reset(2);
+    EXPECT_EQ(ant.getCurrentCity(), 2);
+    EXPECT_EQ(ant.getTour().size(), 1u);
+    EXPECT_TRUE(ant.hasVisited(2));
+    EXPECT_FALSE(ant.hasVisited(0));
+    EXPECT_DOUBLE_EQ(ant.getTourLength(), 0.0);
+
+    const int* data = tour.getSequence().data();
+    ant.visitCity(0, graph);
+    ant.visitCity(1, graph);
+    ant.completeTour(graph, tour);
+    EXPECT_EQ(tour.getSequence().data(), data);
+    EXPECT_EQ(tour.getSequence(), (std::vector<int>{2, 0, 1}));
+}
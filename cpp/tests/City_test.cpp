@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 #include "City.h"
 #include <cmath>
+#include <vector>
 
 // Test constructor and getters
 TEST(CityTest, ConstructorAndGetters) {
@@ -11,6 +12,19 @@ TEST(CityTest, ConstructorAndGetters) {
     EXPECT_DOUBLE_EQ(city.getY(), 20.0);
 }
 
+// Test the coordinate pair is contiguous and cities are evenly strided
+TEST(CityTest, CoordinateLayout) {
+    std::vector<City> cities = {City(0, 1.5, -2.5), City(1, 3.0, 4.0)};
+    const double* first = cities[0].getCoordinates();
+
+    EXPECT_DOUBLE_EQ(first[0], 1.5);
+    EXPECT_DOUBLE_EQ(first[1], -2.5);
+    EXPECT_EQ(sizeof(City) % sizeof(double), 0u);
+    const double* second = first + sizeof(City) / sizeof(double);
+    EXPECT_EQ(second, cities[1].getCoordinates());
+    EXPECT_DOUBLE_EQ(second[1], 4.0);
+}
+
 // Test distance calculation with horizontal distance
 TEST(CityTest, HorizontalDistance) {
     City city1(0, 0.0, 0.0);
@@ -62,3 +76,14 @@ TEST(CityTest, FloatingPointCoordinates) {
     double expected = std::sqrt(9.0 + 16.0); // sqrt((3)^2 + (4)^2) = 5.0
     EXPECT_DOUBLE_EQ(city1.distanceTo(city2), expected);
 }
+
+// Test distances under the TSPLIB metric policies
+TEST(CityTest, MetricPolicies) {
+    City city1(0, 0.0, 0.0);
+    City city2(1, 1.0, 1.2);
+
+    EXPECT_DOUBLE_EQ(city1.distanceTo(city2, metric::Euclidean{}), city1.distanceTo(city2));
+    EXPECT_DOUBLE_EQ(city1.distanceTo(city2, metric::Euc2D{}), 2.0);   // 1.56 rounds to 2
+    EXPECT_DOUBLE_EQ(city1.distanceTo(city2, metric::Ceil2D{}), 2.0);
+    EXPECT_DOUBLE_EQ(city1.distanceTo(City(2, 10.0, 0.0), metric::Att{}), 4.0);  // 3.16 -> 4
+}
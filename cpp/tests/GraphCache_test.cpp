@@ -0,0 +1,212 @@
+#include <gtest/gtest.h>
+#include "GraphCache.h"
+#include "TSPLoader.h"
+#include "Graph.h"
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+// Fresh temporary directory per test, removed afterwards
+class GraphCacheTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        const auto* info = ::testing::UnitTest::GetInstance()->current_test_info();
+        directory_ = fs::temp_directory_path() /
+                     (std::string("aco_cache_test_") + info->name());
+        fs::remove_all(directory_);
+        fs::create_directories(directory_);
+    }
+
+    void TearDown() override { fs::remove_all(directory_); }
+
+    // Write a EUC_2D instance of random cities and return its path
+    std::string writeInstance(int numCities, unsigned seed = 42) {
+        std::string path = (directory_ / "random.tsp").string();
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<double> coordinate(0.0, 1000.0);
+        std::ofstream file(path);
+        file << "NAME : random\nTYPE : TSP\nDIMENSION : " << numCities
+             << "\nEDGE_WEIGHT_TYPE : EUC_2D\nNODE_COORD_SECTION\n";
+        for (int i = 0; i < numCities; ++i) {
+            file << (i + 1) << " " << coordinate(rng) << " " << coordinate(rng) << "\n";
+        }
+        file << "EOF\n";
+        return path;
+    }
+
+    fs::path directory_;
+};
+
+void expectSameGraph(const Graph& expected, const Graph& actual) {
+    ASSERT_EQ(actual.getNumCities(), expected.getNumCities());
+    EXPECT_EQ(actual.getDistanceStorage(), expected.getDistanceStorage());
+    EXPECT_EQ(actual.getDistanceMetric(), expected.getDistanceMetric());
+    int n = expected.getNumCities();
+    for (int i = 0; i < n; ++i) {
+        EXPECT_EQ(actual.getCity(i).getId(), expected.getCity(i).getId());
+        EXPECT_DOUBLE_EQ(actual.getCity(i).getX(), expected.getCity(i).getX());
+        EXPECT_DOUBLE_EQ(actual.getCity(i).getY(), expected.getCity(i).getY());
+        for (int j = 0; j < n; ++j) {
+            ASSERT_DOUBLE_EQ(actual.getDistance(i, j), expected.getDistance(i, j));
+        }
+    }
+}
+
+}  // namespace
+
+// Cache paths: next to the source by default, name plus path hash in a directory
+TEST_F(GraphCacheTest, CachePath) {
+    EXPECT_EQ(GraphCache::cachePath("data/a280.tsp", DistanceStorage::FULL_DOUBLE),
+              "data/a280.tsp.full.acocache");
+    EXPECT_NE(GraphCache::cachePath("data/a280.tsp", DistanceStorage::FULL_DOUBLE),
+              GraphCache::cachePath("data/a280.tsp", DistanceStorage::FULL_FLOAT));
+
+    std::string inDirectory =
+        GraphCache::cachePath("data/a280.tsp", DistanceStorage::FULL_DOUBLE, "cache");
+    EXPECT_EQ(fs::path(inDirectory).parent_path(), fs::path("cache"));
+    EXPECT_EQ(fs::path(inDirectory).filename().string().rfind("a280.tsp-", 0), 0u);
+    EXPECT_NE(inDirectory,
+              GraphCache::cachePath("other/a280.tsp", DistanceStorage::FULL_DOUBLE, "cache"));
+}
+
+// Every storage layout round-trips through a cache file
+TEST_F(GraphCacheTest, RoundTripAllStorages) {
+    std::string source = writeInstance(40);
+    for (DistanceStorage storage :
+         {DistanceStorage::FULL_DOUBLE, DistanceStorage::FULL_FLOAT,
+          DistanceStorage::TRIANGULAR_DOUBLE, DistanceStorage::TRIANGULAR_FLOAT,
+          DistanceStorage::ON_THE_FLY}) {
+        Graph parsed = TSPLoader(source).loadGraph(storage);
+        std::string cache = GraphCache::cachePath(source, storage);
+        ASSERT_TRUE(GraphCache::write(parsed, cache, source));
+
+        Graph mapped = GraphCache::load(cache, source, storage);
+        ASSERT_TRUE(mapped.isValid());
+        EXPECT_TRUE(mapped.isMapped());
+        expectSameGraph(parsed, mapped);
+        EXPECT_EQ(mapped.getDistanceMemoryBytes(), parsed.getDistanceMemoryBytes());
+    }
+}
+
+// Stored neighbor lists and nearest neighbor tour match a fresh computation
+TEST_F(GraphCacheTest, NeighborListsAndNearestNeighborTour) {
+    std::string source = writeInstance(60);
+    Graph parsed = TSPLoader(source).loadGraph();
+    std::string cache = GraphCache::cachePath(source, DistanceStorage::FULL_DOUBLE);
+    ASSERT_TRUE(GraphCache::write(parsed, cache, source));
+
+    Graph mapped = GraphCache::load(cache, source, DistanceStorage::FULL_DOUBLE);
+    ASSERT_TRUE(mapped.isValid());
+    EXPECT_DOUBLE_EQ(mapped.nearestNeighborTourLength(), parsed.nearestNeighborTourLength());
+    EXPECT_DOUBLE_EQ(mapped.nearestNeighborTourLength(5), parsed.nearestNeighborTourLength(5));
+
+    // Shorter lists are prefixes of the stored ones and are used in place
+    const int k = 8;
+    EXPECT_EQ(mapped.computeNeighborLists(k), parsed.computeNeighborLists(k));
+    mapped.buildNeighborLists(k);
+    parsed.buildNeighborLists(k);
+    EXPECT_EQ(mapped.getNeighborListSize(), k);
+    EXPECT_EQ(mapped.getNeighborListStride(), GraphCache::DEFAULT_NEIGHBORS);
+    for (int city = 0; city < 60; ++city) {
+        for (int i = 0; i < k; ++i) {
+            EXPECT_EQ(mapped.getNeighbors(city)[i], parsed.getNeighbors(city)[i]);
+        }
+    }
+
+    // Longer lists than the cache holds are computed as usual
+    mapped.buildNeighborLists(20);
+    parsed.buildNeighborLists(20);
+    EXPECT_EQ(mapped.getNeighborListStride(), 20);
+    EXPECT_EQ(mapped.getNeighbors(7)[19], parsed.getNeighbors(7)[19]);
+}
+
+// Copies share the mapping and stay usable after the original is gone
+TEST_F(GraphCacheTest, CopiesOutliveOriginal) {
+    std::string source = writeInstance(30);
+    Graph parsed = TSPLoader(source).loadGraph();
+    std::string cache = GraphCache::cachePath(source, DistanceStorage::FULL_DOUBLE);
+    ASSERT_TRUE(GraphCache::write(parsed, cache, source));
+
+    Graph copy;
+    {
+        Graph mapped = GraphCache::load(cache, source, DistanceStorage::FULL_DOUBLE);
+        mapped.buildNeighborLists(10);
+        copy = mapped;
+    }
+    EXPECT_TRUE(copy.isMapped());
+    expectSameGraph(parsed, copy);
+    parsed.buildNeighborLists(10);
+    EXPECT_EQ(copy.getNeighbors(3)[9], parsed.getNeighbors(3)[9]);
+}
+
+// Modified sources, other layouts and corrupt files are rejected
+TEST_F(GraphCacheTest, RejectsStaleMismatchedAndCorruptCaches) {
+    std::string source = writeInstance(25);
+    Graph parsed = TSPLoader(source).loadGraph();
+    std::string cache = GraphCache::cachePath(source, DistanceStorage::FULL_DOUBLE);
+    ASSERT_TRUE(GraphCache::write(parsed, cache, source));
+
+    EXPECT_FALSE(GraphCache::load(cache, source, DistanceStorage::FULL_FLOAT).isValid());
+    EXPECT_FALSE(GraphCache::load(cache + ".missing", source, DistanceStorage::FULL_DOUBLE).isValid());
+
+    // Truncated file
+    std::string truncated = (directory_ / "truncated.acocache").string();
+    fs::copy_file(cache, truncated);
+    fs::resize_file(truncated, fs::file_size(truncated) - 4);
+    EXPECT_FALSE(GraphCache::load(truncated, "", DistanceStorage::FULL_DOUBLE).isValid());
+
+    // Source rewritten with different contents
+    writeInstance(26, 7);
+    EXPECT_FALSE(GraphCache::load(cache, source, DistanceStorage::FULL_DOUBLE).isValid());
+    EXPECT_TRUE(GraphCache::load(cache, "", DistanceStorage::FULL_DOUBLE).isValid());
+}
+
+// Explicit matrices are cached exactly, on-the-fly requests included
+TEST_F(GraphCacheTest, ExplicitDistances) {
+    std::string source = (directory_ / "explicit.tsp").string();
+    fs::copy_file("../tests/data/test_explicit_full_4.tsp", source);
+    Graph parsed = TSPLoader(source).loadGraph(DistanceStorage::ON_THE_FLY);
+    ASSERT_TRUE(parsed.isValid());
+    std::string cache = GraphCache::cachePath(source, DistanceStorage::ON_THE_FLY);
+    ASSERT_TRUE(GraphCache::write(parsed, cache, source));
+
+    Graph mapped = GraphCache::load(cache, source, DistanceStorage::ON_THE_FLY);
+    ASSERT_TRUE(mapped.isValid());
+    EXPECT_EQ(mapped.getDistanceMetric(), DistanceMetric::EXPLICIT);
+    expectSameGraph(parsed, mapped);
+}
+
+// TSPLoader reads fresh caches automatically and writes them on request
+TEST_F(GraphCacheTest, LoaderUsesCache) {
+    std::string source = writeInstance(50);
+    fs::path cacheDirectory = directory_ / "cache";
+
+    TSPLoader first(source);
+    first.setCacheDirectory(cacheDirectory.string());
+    Graph parsed = first.loadGraph();
+    EXPECT_FALSE(first.wasLoadedFromCache());
+    EXPECT_FALSE(fs::exists(first.getCachePath()));  // writing is opt-in
+
+    first.setWriteCache(true);
+    first.loadGraph();
+    EXPECT_FALSE(first.wasLoadedFromCache());
+    EXPECT_TRUE(fs::exists(first.getCachePath()));
+    EXPECT_EQ(fs::path(first.getCachePath()).parent_path(), cacheDirectory);
+
+    TSPLoader second(source);
+    second.setCacheDirectory(cacheDirectory.string());
+    Graph cached = second.loadGraph();
+    EXPECT_TRUE(second.wasLoadedFromCache());
+    EXPECT_TRUE(cached.isMapped());
+    expectSameGraph(parsed, cached);
+
+    // Another storage layout has its own cache file
+    second.loadGraph(DistanceStorage::TRIANGULAR_FLOAT);
+    EXPECT_FALSE(second.wasLoadedFromCache());
+}
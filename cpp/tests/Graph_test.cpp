@@ -1,6 +1,10 @@
 #include <gtest/gtest.h>
 #include "Graph.h"
 #include "City.h"
+#include "TestGraphs.h"
+#include <algorithm>
+#include <cstdint>
+#include <utility>
 #include <vector>
 
 // Test empty graph
@@ -127,3 +131,295 @@ TEST(GraphTest, InvalidIndices) {
     EXPECT_DOUBLE_EQ(graph.getDistance(2, 0), 0.0);
     EXPECT_DOUBLE_EQ(graph.getDistance(0, 2), 0.0);
 }
+
+// Test nearest-neighbor lists are sorted by distance and exclude the city itself
+TEST(GraphTest, NeighborListsSortedByDistance) {
+    std::vector<City> cities;
+    cities.push_back(City(0, 0.0, 0.0));
+    cities.push_back(City(1, 1.0, 0.0));
+    cities.push_back(City(2, 3.0, 0.0));
+    cities.push_back(City(3, 6.0, 0.0));
+    cities.push_back(City(4, 10.0, 0.0));
+
+    Graph graph(cities);
+    EXPECT_EQ(graph.getNeighborListSize(), 0);
+
+    graph.buildNeighborLists(3);
+    ASSERT_EQ(graph.getNeighborListSize(), 3);
+
+    const int* neighbors0 = graph.getNeighbors(0);
+    EXPECT_EQ(neighbors0[0], 1);
+    EXPECT_EQ(neighbors0[1], 2);
+    EXPECT_EQ(neighbors0[2], 3);
+
+    const int* neighbors3 = graph.getNeighbors(3);
+    EXPECT_EQ(neighbors3[0], 2);  // distance 3
+    EXPECT_EQ(neighbors3[1], 4);  // distance 4
+    EXPECT_EQ(neighbors3[2], 1);  // distance 5
+
+    for (int i = 0; i < graph.getNumCities(); ++i) {
+        const int* neighbors = graph.getNeighbors(i);
+        for (int r = 0; r < graph.getNeighborListSize(); ++r) {
+            EXPECT_NE(neighbors[r], i);
+            if (r > 0) {
+                EXPECT_LE(graph.getDistance(i, neighbors[r - 1]),
+                          graph.getDistance(i, neighbors[r]));
+            }
+        }
+    }
+}
+
+// Test neighbor list size is clamped to numCities - 1
+TEST(GraphTest, NeighborListSizeClamped) {
+    std::vector<City> cities;
+    cities.push_back(City(0, 0.0, 0.0));
+    cities.push_back(City(1, 1.0, 0.0));
+    cities.push_back(City(2, 0.0, 1.0));
+
+    Graph graph(cities);
+    graph.buildNeighborLists(10);
+
+    EXPECT_EQ(graph.getNeighborListSize(), 2);
+}
+
+// Test unchecked accessor and row pointers match the checked lookup
+TEST(GraphTest, UncheckedAccessMatchesGetDistance) {
+    std::vector<City> cities;
+    for (int i = 0; i < 11; ++i) {
+        cities.push_back(City(i, i * 1.5, (i * 7) % 5));
+    }
+    Graph graph(cities);
+
+    for (int i = 0; i < graph.getNumCities(); ++i) {
+        const double* row = graph.getDistanceRow(i);
+        // Rows start on a cache-line boundary
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(row) % CACHE_LINE_SIZE, 0u);
+        for (int j = 0; j < graph.getNumCities(); ++j) {
+            EXPECT_DOUBLE_EQ(graph.getDistanceUnchecked(i, j), graph.getDistance(i, j));
+            EXPECT_DOUBLE_EQ(row[j], graph.getDistance(i, j));
+        }
+    }
+}
+
+// Test every storage layout reports the same distances as the full double matrix
+TEST(GraphTest, DistanceStorageLayoutsMatch) {
+    std::vector<City> cities = scatteredCities(13);
+    Graph reference(cities);
+
+    const DistanceStorage layouts[] = {
+        DistanceStorage::FULL_FLOAT,
+        DistanceStorage::TRIANGULAR_DOUBLE,
+        DistanceStorage::TRIANGULAR_FLOAT
+    };
+
+    for (DistanceStorage storage : layouts) {
+        Graph graph(cities, storage);
+        EXPECT_EQ(graph.getDistanceStorage(), storage);
+        for (int i = 0; i < graph.getNumCities(); ++i) {
+            EXPECT_DOUBLE_EQ(graph.getDistance(i, i), 0.0);
+            for (int j = 0; j < graph.getNumCities(); ++j) {
+                double expected = reference.getDistance(i, j);
+                EXPECT_NEAR(graph.getDistance(i, j), expected, 1e-4);
+                EXPECT_DOUBLE_EQ(graph.getDistanceUnchecked(i, j), graph.getDistance(i, j));
+                EXPECT_DOUBLE_EQ(graph.getDistance(i, j), graph.getDistance(j, i));
+            }
+        }
+    }
+}
+
+// Test compact layouts actually shrink the distance matrix
+TEST(GraphTest, CompactStorageUsesLessMemory) {
+    std::vector<City> cities;
+    for (int i = 0; i < 100; ++i) {
+        cities.push_back(City(i, i, (i * 7) % 13));
+    }
+
+    Graph full(cities, DistanceStorage::FULL_DOUBLE);
+    Graph fullFloat(cities, DistanceStorage::FULL_FLOAT);
+    Graph triangular(cities, DistanceStorage::TRIANGULAR_DOUBLE);
+    Graph triangularFloat(cities, DistanceStorage::TRIANGULAR_FLOAT);
+
+    EXPECT_LT(fullFloat.getDistanceMemoryBytes(), full.getDistanceMemoryBytes());
+    EXPECT_LT(triangular.getDistanceMemoryBytes(), full.getDistanceMemoryBytes());
+    EXPECT_LT(triangularFloat.getDistanceMemoryBytes(), triangular.getDistanceMemoryBytes());
+    EXPECT_EQ(triangular.getDistanceRow(0), nullptr);
+}
+
+// Test the raw distance buffers address the same entries as getDistance()
+TEST(GraphTest, RawDistanceBuffers) {
+    std::vector<City> cities = scatteredCities(11);
+
+    Graph full(cities, DistanceStorage::FULL_DOUBLE);
+    ASSERT_NE(full.getDistanceData(), nullptr);
+    EXPECT_EQ(full.getDistanceFloatData(), nullptr);
+    const std::size_t stride = full.getDistanceRowStride();
+    EXPECT_GE(stride, cities.size());
+    EXPECT_EQ(full.getDistanceRow(3), full.getDistanceData() + 3 * stride);
+
+    Graph fullFloat(cities, DistanceStorage::FULL_FLOAT);
+    ASSERT_NE(fullFloat.getDistanceFloatData(), nullptr);
+    EXPECT_EQ(fullFloat.getDistanceData(), nullptr);
+    const std::size_t floatStride = fullFloat.getDistanceRowStride();
+    EXPECT_GE(floatStride, cities.size());
+
+    for (int i = 0; i < full.getNumCities(); ++i) {
+        for (int j = 0; j < full.getNumCities(); ++j) {
+            EXPECT_DOUBLE_EQ(full.getDistanceData()[i * stride + j], full.getDistance(i, j));
+            EXPECT_DOUBLE_EQ(fullFloat.getDistanceFloatData()[i * floatStride + j],
+                             fullFloat.getDistance(i, j));
+        }
+    }
+
+    Graph triangular(cities, DistanceStorage::TRIANGULAR_DOUBLE);
+    EXPECT_NE(triangular.getDistanceData(), nullptr);
+    EXPECT_EQ(triangular.getDistanceRowStride(), 0u);
+    Graph onTheFly(cities, DistanceStorage::ON_THE_FLY);
+    EXPECT_EQ(onTheFly.getDistanceData(), nullptr);
+    EXPECT_EQ(onTheFly.getDistanceFloatData(), nullptr);
+}
+
+// Test on-the-fly storage reports the same distances without any matrix
+TEST(GraphTest, OnTheFlyMatchesFullMatrix) {
+    std::vector<City> cities = scatteredCities(17);
+    Graph full(cities);
+    Graph onTheFly(cities, DistanceStorage::ON_THE_FLY);
+
+    EXPECT_EQ(onTheFly.getDistanceMemoryBytes(), 0u);
+    EXPECT_EQ(onTheFly.getDistanceRow(0), nullptr);
+    for (int i = 0; i < full.getNumCities(); ++i) {
+        for (int j = 0; j < full.getNumCities(); ++j) {
+            EXPECT_DOUBLE_EQ(onTheFly.getDistance(i, j), full.getDistance(i, j));
+        }
+    }
+    EXPECT_DOUBLE_EQ(onTheFly.nearestNeighborTourLength(), full.nearestNeighborTourLength());
+}
+
+// Test TSPLIB rounding metrics
+TEST(GraphTest, TSPLIBMetrics) {
+    std::vector<City> cities = {
+        City(0, 0.0, 0.0),
+        City(1, 1.0, 1.2),
+        City(2, 3.0, 4.0),
+        City(3, 10.0, 0.0)
+    };
+
+    Graph euc(cities, DistanceStorage::FULL_DOUBLE, DistanceMetric::EUC_2D);
+    EXPECT_DOUBLE_EQ(euc.getDistance(0, 1), 2.0);   // 1.56 rounds to 2
+    EXPECT_DOUBLE_EQ(euc.getDistance(0, 2), 5.0);
+
+    Graph ceil(cities, DistanceStorage::ON_THE_FLY, DistanceMetric::CEIL_2D);
+    EXPECT_DOUBLE_EQ(ceil.getDistance(0, 1), 2.0);
+    EXPECT_DOUBLE_EQ(ceil.getDistance(0, 2), 5.0);  // Exact values stay put
+
+    Graph att(cities, DistanceStorage::FULL_DOUBLE, DistanceMetric::ATT);
+    EXPECT_DOUBLE_EQ(att.getDistance(0, 3), 4.0);   // sqrt(10) = 3.16 -> 4
+
+    // GEO: one degree of longitude on the equator
+    std::vector<City> geoCities = {City(0, 0.0, 0.0), City(1, 0.0, 1.0)};
+    Graph geo(geoCities, DistanceStorage::ON_THE_FLY, DistanceMetric::GEO);
+    EXPECT_EQ(geo.getDistanceMetric(), DistanceMetric::GEO);
+    EXPECT_DOUBLE_EQ(geo.getDistance(0, 1), 112.0);
+    EXPECT_DOUBLE_EQ(geo.getDistance(1, 1), 0.0);
+}
+
+// Test grid-based neighbor lists match a brute-force scan (incl. duplicates)
+TEST(GraphTest, SpatialNeighborListsMatchBruteForce) {
+    std::vector<City> cities;
+    for (int i = 0; i < 300; ++i) {
+        // Clustered, elongated layout with some coincident cities
+        double x = (i % 3 == 0) ? (i * 7919) % 1000 : (i * 104729) % 50;
+        double y = (i * 31) % 17;
+        cities.push_back(City(i, x, y));
+    }
+    cities.push_back(City(300, 5.0, 5.0));
+    cities.push_back(City(301, 5.0, 5.0));
+
+    Graph graph(cities, DistanceStorage::ON_THE_FLY);
+    const int k = 8;
+    std::vector<int> lists = graph.computeNeighborLists(k);
+    ASSERT_EQ(lists.size(), cities.size() * k);
+
+    for (int i = 0; i < graph.getNumCities(); ++i) {
+        std::vector<std::pair<double, int>> all;
+        for (int j = 0; j < graph.getNumCities(); ++j) {
+            if (j != i) {
+                all.emplace_back(graph.getDistance(i, j), j);
+            }
+        }
+        std::sort(all.begin(), all.end());
+        for (int r = 0; r < k; ++r) {
+            // Same distances in the same order (ties may pick other cities)
+            EXPECT_DOUBLE_EQ(graph.getDistance(i, lists[i * k + r]), all[r].first);
+            EXPECT_NE(lists[i * k + r], i);
+        }
+    }
+}
+
+// Test neighbor lists do not change the nearest neighbor tour length
+TEST(GraphTest, NearestNeighborTourUsesNeighborLists) {
+    std::vector<City> cities;
+    for (int i = 0; i < 60; ++i) {
+        cities.push_back(City(i, (i * 37) % 101 + 0.01 * i, (i * 53) % 97));
+    }
+    Graph graph(cities);
+    double withoutLists = graph.nearestNeighborTourLength();
+
+    graph.buildNeighborLists(5);
+    EXPECT_DOUBLE_EQ(graph.nearestNeighborTourLength(), withoutLists);
+}
+
+// Test explicit distances in every storage layout, with neighbor lists
+TEST(GraphTest, ExplicitDistances) {
+    std::vector<City> cities;
+    for (int i = 0; i < 4; ++i) {
+        cities.push_back(City(i, 0.0, 0.0));  // Coordinates carry no distance information
+    }
+    // d(0,1) d(0,2) d(0,3) d(1,2) d(1,3) d(2,3)
+    const std::vector<double> upper = {3.0, 1.0, 5.0, 6.0, 2.0, 8.0};
+
+    for (DistanceStorage storage : {DistanceStorage::FULL_DOUBLE, DistanceStorage::FULL_FLOAT,
+                                    DistanceStorage::TRIANGULAR_DOUBLE, DistanceStorage::TRIANGULAR_FLOAT}) {
+        Graph graph(cities, upper, storage);
+
+        ASSERT_TRUE(graph.isValid());
+        EXPECT_EQ(graph.getDistanceMetric(), DistanceMetric::EXPLICIT);
+        EXPECT_EQ(graph.getDistanceStorage(), storage);
+        EXPECT_DOUBLE_EQ(graph.getDistance(0, 2), 1.0);
+        EXPECT_DOUBLE_EQ(graph.getDistance(3, 1), 2.0);
+        EXPECT_DOUBLE_EQ(graph.getDistance(2, 3), 8.0);
+        EXPECT_DOUBLE_EQ(graph.getDistance(1, 1), 0.0);
+
+        // Nearest neighbors follow the given distances, not the (identical) coordinates
+        graph.buildNeighborLists(1);
+        EXPECT_EQ(graph.getNeighbors(0)[0], 2);
+        EXPECT_EQ(graph.getNeighbors(1)[0], 3);
+    }
+}
+
+// Test the specialized distance functors agree with getDistance() for every
+// layout and metric
+TEST(GraphTest, DispatchedDistancesMatchLookup) {
+    std::vector<City> cities;
+    for (int i = 0; i < 40; ++i) {
+        cities.push_back(City(i, (i * 37) % 101 + 0.25 * i, (i * 53) % 89 + 10.0));
+    }
+
+    for (DistanceMetric metric : {DistanceMetric::EUCLIDEAN, DistanceMetric::EUC_2D, DistanceMetric::CEIL_2D,
+                                  DistanceMetric::GEO, DistanceMetric::ATT}) {
+        Graph reference(cities, DistanceStorage::FULL_DOUBLE, metric);
+        for (DistanceStorage storage : {DistanceStorage::FULL_DOUBLE, DistanceStorage::FULL_FLOAT,
+                                        DistanceStorage::TRIANGULAR_DOUBLE, DistanceStorage::TRIANGULAR_FLOAT,
+                                        DistanceStorage::ON_THE_FLY}) {
+            Graph graph(cities, storage, metric);
+            graph.dispatchDistances([&](auto distance) {
+                for (int a = 0; a < 40; ++a) {
+                    for (int b = 0; b < 40; ++b) {
+                        ASSERT_EQ(distance(a, b), graph.getDistanceUnchecked(a, b));
+                        ASSERT_NEAR(distance(a, b), reference.getDistance(a, b),
+                                    1e-6 * (1.0 + reference.getDistance(a, b)));
+                    }
+                }
+            });
+        }
+    }
+}
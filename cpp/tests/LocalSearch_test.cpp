@@ -10,6 +10,10 @@
 #include "Tour.h"
 #include <cmath>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 // Forward declaration of helper function
 double calculateDistance(const std::vector<int>& sequence, const Graph& graph);
 
@@ -362,3 +366,353 @@ TEST_F(LocalSearchTest, ThreeOptConverges) {
     EXPECT_LT(iterations, maxIterations);
     EXPECT_TRUE(tour.validate(6));
 }
+
+// Helper: scattered cities and a deliberately poor (stride) tour over them
+static std::vector<City> scatteredCities(int n) {
+    std::vector<City> cities;
+    for (int i = 0; i < n; ++i) {
+        cities.push_back(City(i, (i * 7919) % 1000, (i * 104729) % 997));
+    }
+    return cities;
+}
+
+static std::vector<int> strideTour(int n, int stride) {
+    std::vector<int> sequence;
+    std::vector<bool> used(n, false);
+    int city = 0;
+    for (int i = 0; i < n; ++i) {
+        while (used[city]) {
+            city = (city + 1) % n;
+        }
+        sequence.push_back(city);
+        used[city] = true;
+        city = (city + stride) % n;
+    }
+    return sequence;
+}
+
+// Test neighbor-list 2-opt removes a crossing
+TEST_F(LocalSearchTest, TwoOptNeighborUntanglesSquare) {
+    graphSquare.buildNeighborLists(3);
+    std::vector<int> sequence = {0, 2, 1, 3};
+    Tour tour(sequence, calculateDistance(sequence, graphSquare));
+
+    bool improved = LocalSearch::twoOptNeighbor(tour, graphSquare,
+                                                NeighborLists::fromGraph(graphSquare));
+
+    EXPECT_TRUE(improved);
+    EXPECT_TRUE(tour.validate(4));
+    EXPECT_NEAR(tour.getDistance(), 40.0, 1e-9);
+}
+
+// Test neighbor-list 2-opt on a larger instance keeps tours valid and distances exact
+TEST_F(LocalSearchTest, TwoOptNeighborLargeInstance) {
+    std::vector<City> cities = scatteredCities(300);
+    Graph graph(cities);
+    graph.buildNeighborLists(8);
+
+    std::vector<int> sequence = strideTour(300, 37);
+    double initial = calculateDistance(sequence, graph);
+    Tour tour(sequence, initial);
+
+    EXPECT_TRUE(LocalSearch::twoOptNeighbor(tour, graph, NeighborLists::fromGraph(graph)));
+    EXPECT_TRUE(tour.validate(300));
+    EXPECT_LT(tour.getDistance(), initial * 0.5);
+    EXPECT_NEAR(tour.getDistance(), calculateDistance(tour.getSequence(), graph), 1e-6);
+
+    // Don't-look bits are a heuristic: fresh passes converge quickly
+    int passes = 0;
+    while (LocalSearch::twoOptNeighbor(tour, graph, NeighborLists::fromGraph(graph)) &&
+           passes < 20) {
+        passes++;
+    }
+    EXPECT_LT(passes, 20);
+    EXPECT_TRUE(tour.validate(300));
+
+    // Comparable quality to the exhaustive version
+    Tour exhaustive(sequence, initial);
+    LocalSearch::twoOpt(exhaustive, graph);
+    EXPECT_LT(tour.getDistance(), exhaustive.getDistance() * 1.1);
+}
+
+// Test operator selection in improve() (no lists falls back to exhaustive)
+TEST_F(LocalSearchTest, ImproveWithOperator) {
+    std::vector<int> sequence = {0, 4, 2, 1, 3};
+    Tour withoutLists(sequence, calculateDistance(sequence, graph5));
+    Tour exhaustive(sequence, calculateDistance(sequence, graph5));
+
+    LocalSearch::improve(withoutLists, graph5, false, LocalSearchOperator::NEIGHBOR_LIST,
+                         NeighborLists());
+    LocalSearch::improve(exhaustive, graph5, false);
+    EXPECT_EQ(withoutLists.getSequence(), exhaustive.getSequence());
+
+    graph5.buildNeighborLists(4);
+    Tour neighbor(sequence, calculateDistance(sequence, graph5));
+    LocalSearch::improve(neighbor, graph5, true, LocalSearchOperator::NEIGHBOR_LIST,
+                         NeighborLists::fromGraph(graph5));
+    EXPECT_TRUE(neighbor.validate(5));
+    EXPECT_LE(neighbor.getDistance(), calculateDistance(sequence, graph5));
+}
+
+// Test Or-opt moves a single misplaced city back into its row
+TEST_F(LocalSearchTest, OrOptRelocatesCity) {
+    // Eight cities on a line; city 3 visited at the wrong place
+    std::vector<City> cities;
+    for (int i = 0; i < 8; ++i) {
+        cities.push_back(City(i, i * 10.0, 0.0));
+    }
+    Graph line(cities);
+    line.buildNeighborLists(4);
+
+    std::vector<int> sequence = {0, 1, 2, 4, 5, 3, 6, 7};
+    Tour tour(sequence, calculateDistance(sequence, line));
+
+    EXPECT_TRUE(LocalSearch::orOpt(tour, line, NeighborLists::fromGraph(line)));
+    EXPECT_TRUE(tour.validate(8));
+    EXPECT_NEAR(tour.getDistance(), 140.0, 1e-9);
+    EXPECT_NEAR(tour.getDistance(), calculateDistance(tour.getSequence(), line), 1e-9);
+
+    // Without lists there is nothing to search
+    EXPECT_FALSE(LocalSearch::orOpt(tour, line, NeighborLists()));
+}
+
+// Test Or-opt and or-3opt keep tours valid and only ever shorten them
+TEST_F(LocalSearchTest, SegmentMovesLargeInstance) {
+    std::vector<City> cities = scatteredCities(300);
+    Graph graph(cities);
+    graph.buildNeighborLists(8);
+    NeighborLists lists = NeighborLists::fromGraph(graph);
+
+    std::vector<int> sequence = strideTour(300, 37);
+    Tour tour(sequence, calculateDistance(sequence, graph));
+    LocalSearch::twoOptNeighbor(tour, graph, lists);
+    double afterTwoOpt = tour.getDistance();
+
+    LocalSearch::orOpt(tour, graph, lists);
+    EXPECT_TRUE(tour.validate(300));
+    EXPECT_LE(tour.getDistance(), afterTwoOpt + 1e-9);
+    EXPECT_NEAR(tour.getDistance(), calculateDistance(tour.getSequence(), graph), 1e-6);
+    double afterOrOpt = tour.getDistance();
+
+    // Segment insertion on a 2-opt tour (segments of any length, wrapping)
+    Tour segment(sequence, calculateDistance(sequence, graph));
+    EXPECT_TRUE(LocalSearch::threeOptNeighbor(segment, graph, lists));
+    EXPECT_TRUE(segment.validate(300));
+    EXPECT_LT(segment.getDistance(), calculateDistance(sequence, graph));
+    EXPECT_NEAR(segment.getDistance(), calculateDistance(segment.getSequence(), graph), 1e-6);
+
+    LocalSearch::threeOptNeighbor(tour, graph, lists);
+    EXPECT_TRUE(tour.validate(300));
+    EXPECT_LE(tour.getDistance(), afterOrOpt + 1e-9);
+    EXPECT_NEAR(tour.getDistance(), calculateDistance(tour.getSequence(), graph), 1e-6);
+}
+
+// Test the neighbor operator's 3-opt stage against exhaustive 2-opt + 3-opt
+TEST_F(LocalSearchTest, NeighborImproveWithSegmentMoves) {
+    std::vector<City> cities = scatteredCities(120);
+    Graph graph(cities);
+    graph.buildNeighborLists(10);
+
+    std::vector<int> sequence = strideTour(120, 17);
+    double initial = calculateDistance(sequence, graph);
+
+    Tour twoOptOnly(sequence, initial);
+    LocalSearch::improve(twoOptOnly, graph, false, LocalSearchOperator::NEIGHBOR_LIST,
+                         NeighborLists::fromGraph(graph));
+
+    Tour neighbor(sequence, initial);
+    LocalSearch::improve(neighbor, graph, true, LocalSearchOperator::NEIGHBOR_LIST,
+                         NeighborLists::fromGraph(graph));
+    EXPECT_TRUE(neighbor.validate(120));
+    EXPECT_LE(neighbor.getDistance(), twoOptOnly.getDistance() + 1e-9);
+    EXPECT_NEAR(neighbor.getDistance(), calculateDistance(neighbor.getSequence(), graph), 1e-6);
+
+    Tour exhaustive(sequence, initial);
+    LocalSearch::improve(exhaustive, graph, true);
+    EXPECT_LT(neighbor.getDistance(), exhaustive.getDistance() * 1.1);
+}
+
+// Test Lin-Kernighan chains improve on neighbor 2-opt and keep tours valid
+TEST_F(LocalSearchTest, LinKernighanLargeInstance) {
+    std::vector<City> cities = scatteredCities(300);
+    Graph graph(cities);
+    graph.buildNeighborLists(8);
+    NeighborLists lists = NeighborLists::fromGraph(graph);
+
+    std::vector<int> sequence = strideTour(300, 37);
+    double initial = calculateDistance(sequence, graph);
+
+    Tour lk(sequence, initial);
+    EXPECT_TRUE(LocalSearch::linKernighan(lk, graph, lists));
+    EXPECT_TRUE(lk.validate(300));
+    EXPECT_NEAR(lk.getDistance(), calculateDistance(lk.getSequence(), graph), 1e-6);
+
+    // Starting from a 2-opt optimum, LK only ever shortens the tour
+    Tour twoOpt(sequence, initial);
+    LocalSearch::twoOptNeighbor(twoOpt, graph, lists);
+    while (LocalSearch::twoOptNeighbor(twoOpt, graph, lists)) {
+    }
+    double twoOptDistance = twoOpt.getDistance();
+    LocalSearch::linKernighan(twoOpt, graph, lists);
+    EXPECT_TRUE(twoOpt.validate(300));
+    EXPECT_LE(twoOpt.getDistance(), twoOptDistance + 1e-9);
+    EXPECT_LT(lk.getDistance(), twoOptDistance * 1.02);
+
+    // Operator selection through improve()
+    Tour improved(sequence, initial);
+    LocalSearch::improve(improved, graph, true, LocalSearchOperator::LIN_KERNIGHAN, lists);
+    EXPECT_TRUE(improved.validate(300));
+    EXPECT_LE(improved.getDistance(), lk.getDistance() * 1.02);
+}
+
+// Test Lin-Kernighan on tiny tours and without neighbor lists
+TEST_F(LocalSearchTest, LinKernighanSmallTours) {
+    graphSquare.buildNeighborLists(3);
+    std::vector<int> square = {0, 2, 1, 3};
+    Tour tiny(square, calculateDistance(square, graphSquare));
+    EXPECT_TRUE(LocalSearch::linKernighan(tiny, graphSquare,
+                                          NeighborLists::fromGraph(graphSquare)));
+    EXPECT_TRUE(tiny.validate(4));
+    EXPECT_NEAR(tiny.getDistance(), 40.0, 1e-9);
+
+    std::vector<int> sequence = {0, 4, 2, 1, 3};
+    Tour withoutLists(sequence, calculateDistance(sequence, graph5));
+    Tour exhaustive(sequence, calculateDistance(sequence, graph5));
+    LocalSearch::linKernighan(withoutLists, graph5, NeighborLists());
+    LocalSearch::twoOpt(exhaustive, graph5);
+    EXPECT_EQ(withoutLists.getSequence(), exhaustive.getSequence());
+}
+
+// Test parallel 2-opt reaches a full 2-opt local optimum, independent of thread count
+TEST_F(LocalSearchTest, TwoOptParallelLargeInstance) {
+    std::vector<City> cities = scatteredCities(300);
+    Graph graph(cities);
+
+    std::vector<int> sequence = strideTour(300, 37);
+    double initial = calculateDistance(sequence, graph);
+    Tour tour(sequence, initial);
+
+    EXPECT_TRUE(LocalSearch::twoOptParallel(tour, graph));
+    EXPECT_TRUE(tour.validate(300));
+    EXPECT_NEAR(tour.getDistance(), calculateDistance(tour.getSequence(), graph), 1e-6);
+
+    // No improving 2-opt move is left for the serial scan
+    Tour check = tour;
+    EXPECT_FALSE(LocalSearch::twoOpt(check, graph));
+    EXPECT_FALSE(LocalSearch::twoOptParallel(check, graph));
+
+    // Comparable quality to the serial version
+    Tour serial(sequence, initial);
+    LocalSearch::twoOpt(serial, graph);
+    EXPECT_LT(tour.getDistance(), serial.getDistance() * 1.1);
+
+#ifdef _OPENMP
+    // Fixed scan blocks: the same tour for any thread count
+    int threads = omp_get_max_threads();
+    omp_set_num_threads(threads == 1 ? 3 : 1);
+    Tour other(sequence, initial);
+    LocalSearch::twoOptParallel(other, graph);
+    omp_set_num_threads(threads);
+    EXPECT_EQ(other.getSequence(), tour.getSequence());
+#endif
+}
+
+// Test the per-thread work counters the operators add to
+TEST_F(LocalSearchTest, ThreadCountersTrackWork) {
+    std::vector<City> cities = scatteredCities(120);
+    Graph graph(cities);
+    std::vector<int> sequence = strideTour(120, 37);
+    Tour tour(sequence, calculateDistance(sequence, graph));
+
+    LocalSearchCounters before = LocalSearch::threadCounters();
+    EXPECT_TRUE(LocalSearch::twoOpt(tour, graph));
+    LocalSearchCounters after = LocalSearch::threadCounters();
+    EXPECT_GT(after.moves, before.moves);
+    EXPECT_GT(after.evaluations - before.evaluations, after.moves - before.moves);
+
+    // One full sweep without a move, counted alike by the serial and parallel scans
+    const std::uint64_t pairsPerSweep = 119ull * 118ull / 2;
+    for (bool parallel : {false, true}) {
+        before = LocalSearch::threadCounters();
+        EXPECT_FALSE(parallel ? LocalSearch::twoOptParallel(tour, graph) : LocalSearch::twoOpt(tour, graph));
+        after = LocalSearch::threadCounters();
+        EXPECT_EQ(after.moves, before.moves);
+        EXPECT_EQ(after.evaluations - before.evaluations, pairsPerSweep);
+    }
+
+    // Neighbor-list operators count every delta they evaluate
+    graph.buildNeighborLists(8);
+    Tour neighborTour(sequence, calculateDistance(sequence, graph));
+    before = LocalSearch::threadCounters();
+    EXPECT_TRUE(LocalSearch::improve(neighborTour, graph, true, LocalSearchOperator::LIN_KERNIGHAN,
+                                     NeighborLists::fromGraph(graph)));
+    after = LocalSearch::threadCounters();
+    EXPECT_GT(after.moves, before.moves);
+    EXPECT_GT(after.evaluations, before.evaluations);
+}
+
+// Test parallel 3-opt and improveParallel() on an instance small enough for O(n³)
+TEST_F(LocalSearchTest, ThreeOptParallelReachesLocalOptimum) {
+    std::vector<City> cities = scatteredCities(60);
+    Graph graph(cities);
+
+    std::vector<int> sequence = strideTour(60, 7);
+    double initial = calculateDistance(sequence, graph);
+    Tour tour(sequence, initial);
+
+    EXPECT_TRUE(LocalSearch::threeOptParallel(tour, graph));
+    EXPECT_TRUE(tour.validate(60));
+    EXPECT_LT(tour.getDistance(), initial);
+    EXPECT_NEAR(tour.getDistance(), calculateDistance(tour.getSequence(), graph), 1e-6);
+
+    // The serial best-improvement 3-opt finds nothing left to do
+    Tour check = tour;
+    EXPECT_FALSE(LocalSearch::threeOpt(check, graph));
+
+    Tour combined(sequence, initial);
+    EXPECT_TRUE(LocalSearch::improveParallel(combined, graph, true));
+    EXPECT_TRUE(combined.validate(60));
+    EXPECT_FALSE(LocalSearch::twoOpt(combined, graph));
+
+    // Tours too small for the moves are left alone
+    std::vector<int> five = {0, 4, 2, 1, 3};
+    Tour small(five, calculateDistance(five, graph5));
+    EXPECT_FALSE(LocalSearch::threeOptParallel(small, graph5));
+    std::vector<int> triangle = {0, 1, 2};
+    Tour tiny(triangle, calculateDistance(triangle, graphTriangle));
+    EXPECT_FALSE(LocalSearch::twoOptParallel(tiny, graphTriangle));
+}
+
+// Test every operator finds the same tours whichever distance functor it is
+// compiled for (full matrix, generic layout lookup, on-the-fly metric)
+TEST_F(LocalSearchTest, SameToursForEveryDistanceLayout) {
+    std::vector<City> cities = scatteredCities(200);
+    std::vector<int> sequence = strideTour(200, 37);
+
+    for (DistanceMetric metric : {DistanceMetric::EUCLIDEAN, DistanceMetric::EUC_2D, DistanceMetric::ATT}) {
+        std::vector<std::vector<int>> reference;
+        for (DistanceStorage storage : {DistanceStorage::FULL_DOUBLE, DistanceStorage::TRIANGULAR_DOUBLE,
+                                        DistanceStorage::ON_THE_FLY}) {
+            Graph graph(cities, storage, metric);
+            graph.buildNeighborLists(8);
+            NeighborLists lists = NeighborLists::fromGraph(graph);
+            double initial = calculateDistance(sequence, graph);
+
+            Tour twoOpt(sequence, initial);
+            LocalSearch::twoOpt(twoOpt, graph);
+            Tour neighbor(sequence, initial);
+            LocalSearch::improve(neighbor, graph, true, LocalSearchOperator::NEIGHBOR_LIST, lists);
+            Tour lk(sequence, initial);
+            LocalSearch::improve(lk, graph, true, LocalSearchOperator::LIN_KERNIGHAN, lists);
+
+            std::vector<std::vector<int>> tours = {twoOpt.getSequence(), neighbor.getSequence(),
+                                                   lk.getSequence()};
+            if (reference.empty()) {
+                reference = tours;
+            } else {
+                EXPECT_EQ(tours, reference) << "storage " << static_cast<int>(storage)
+                                            << ", metric " << static_cast<int>(metric);
+            }
+        }
+    }
+}
@@ -0,0 +1,186 @@
+#include <gtest/gtest.h>
+#include "MultiColony.h"
+#include "Graph.h"
+#include "City.h"
+#include "TestGraphs.h"
+#include <chrono>
+#include <limits>
+#include <thread>
+#include <vector>
+
+// Test construction, defaults and parameter validation
+TEST(MultiColonyTest, Constructor) {
+    Graph graph = scatteredGraph(20);
+    MultiColony islands(graph, 3, 10, 1.0, 2.0, 0.5, 100.0);
+
+    EXPECT_EQ(islands.getNumColonies(), 3);
+    EXPECT_EQ(islands.getMigrationInterval(), 10);
+    EXPECT_EQ(islands.getMigrationTopology(), "ring");
+    EXPECT_EQ(islands.getColony(0).getNumAnts(), 10);
+
+    islands.setMigrationTopology("bogus");  // Invalid topologies are ignored
+    EXPECT_EQ(islands.getMigrationTopology(), "ring");
+    islands.setMigrationTopology("broadcast");
+    EXPECT_EQ(islands.getMigrationTopology(), "broadcast");
+    islands.setMigrationInterval(-3);
+    EXPECT_EQ(islands.getMigrationInterval(), 0);
+
+    // At least one colony
+    MultiColony single(graph, 0, 10, 1.0, 2.0, 0.5, 100.0);
+    EXPECT_EQ(single.getNumColonies(), 1);
+}
+
+// Test solve returns the best tour over all colonies and the merged history
+TEST(MultiColonyTest, SolveMergesColonies) {
+    Graph graph = scatteredGraph(30);
+    MultiColony islands(graph, 4, 8, 1.0, 2.0, 0.5, 100.0);
+    islands.setSeed(7);
+    islands.setMigrationInterval(5);
+
+    Tour best = islands.solve(22);
+    EXPECT_TRUE(best.validate(30));
+    EXPECT_EQ(islands.getConvergenceData().size(), 22u);
+    EXPECT_EQ(islands.getNumMigrations(), 4);  // After iterations 5, 10, 15, 20
+
+    ASSERT_GE(islands.getBestColony(), 0);
+    double colonyBest = std::numeric_limits<double>::max();
+    for (int c = 0; c < islands.getNumColonies(); ++c) {
+        EXPECT_EQ(islands.getColony(c).getConvergenceData().size(), 22u);
+        colonyBest = std::min(colonyBest, islands.getColony(c).getBestTour().getDistance());
+    }
+    EXPECT_DOUBLE_EQ(best.getDistance(), colonyBest);
+    EXPECT_DOUBLE_EQ(islands.getColony(islands.getBestColony()).getBestTour().getDistance(),
+                     best.getDistance());
+
+    // Per-iteration best over all colonies
+    for (size_t t = 0; t < islands.getConvergenceData().size(); ++t) {
+        double expected = std::numeric_limits<double>::max();
+        for (int c = 0; c < islands.getNumColonies(); ++c) {
+            expected = std::min(expected, islands.getColony(c).getConvergenceData()[t]);
+        }
+        EXPECT_EQ(islands.getConvergenceData()[t], expected);
+    }
+}
+
+// Test broadcast migration: after the last migration every colony's best
+// tour is at least as good as the overall best before it
+TEST(MultiColonyTest, BroadcastMigration) {
+    Graph graph = scatteredGraph(30);
+    MultiColony islands(graph, 3, 8, 1.0, 2.0, 0.5, 100.0);
+    islands.setSeed(3);
+    islands.setMigrationTopology("broadcast");
+    islands.setMigrationInterval(10);
+
+    std::vector<double> bestAtMigration;
+    islands.setCallbackInterval(10);
+    Tour best = islands.solve(11, [&](int iteration, double bestDistance,
+                                      const std::vector<int>&, const std::vector<double>&) {
+        if (iteration == 10) {
+            bestAtMigration.push_back(bestDistance);
+        }
+    });
+    ASSERT_EQ(bestAtMigration.size(), 1u);
+    EXPECT_EQ(islands.getNumMigrations(), 1);
+    for (int c = 0; c < islands.getNumColonies(); ++c) {
+        EXPECT_LE(islands.getColony(c).getBestTour().getDistance(), bestAtMigration[0]);
+    }
+    EXPECT_LE(best.getDistance(), bestAtMigration[0]);
+}
+
+// Test configure() applies settings to every colony and seeded runs repeat
+// for any thread count
+TEST(MultiColonyTest, ConfigureAndReproducibility) {
+    Graph graph = scatteredGraph(40);
+    auto run = [&](int threads) {
+        MultiColony islands(graph, 3, 6, 1.0, 2.0, 0.5, 100.0);
+        islands.configure([](AntColony& colony) {
+            colony.setUseLocalSearch(true);
+            colony.setLocalSearchOperator("neighbor");
+            colony.setPheromoneMode("mmas");
+        });
+        islands.setSeed(42);
+        islands.setNumThreads(threads);
+        islands.setMigrationInterval(4);
+        Tour best = islands.solve(12);
+        for (int c = 0; c < islands.getNumColonies(); ++c) {
+            EXPECT_EQ(islands.getColony(c).getPheromoneMode(), "mmas");
+            EXPECT_EQ(islands.getColony(c).getLocalSearchOperator(), "neighbor");
+        }
+        return best;
+    };
+
+    Tour serial = run(1);
+    Tour parallel = run(3);
+    EXPECT_TRUE(serial.validate(40));
+    EXPECT_EQ(serial.getSequence(), parallel.getSequence());
+    EXPECT_EQ(serial.getDistance(), parallel.getDistance());
+}
+
+// Test convergence mode (maxIterations < 0) stops after the threshold
+TEST(MultiColonyTest, SolveUntilConvergence) {
+    Graph graph = scatteredGraph(12);
+    MultiColony islands(graph, 2, 6, 1.0, 2.0, 0.5, 100.0);
+    islands.setSeed(1);
+    islands.setConvergenceThreshold(15);
+
+    Tour best = islands.solve(-1);
+    EXPECT_TRUE(best.validate(12));
+    const std::vector<double>& history = islands.getConvergenceData();
+    ASSERT_GE(history.size(), 15u);
+
+    // The last 15 iterations did not improve on the running best before them
+    double before = std::numeric_limits<double>::max();
+    for (size_t t = 0; t + 15 < history.size(); ++t) {
+        before = std::min(before, history[t]);
+    }
+    for (size_t t = history.size() - 15; t < history.size(); ++t) {
+        EXPECT_GE(history[t], before);
+    }
+}
+
+// Test the time limit, target distance and stop requests end the island run
+TEST(MultiColonyTest, StopCriteria) {
+    Graph graph = scatteredGraph(40);
+    MultiColony islands(graph, 3, 8, 1.0, 2.0, 0.5, 100.0);
+    islands.setSeed(3);
+    islands.setMigrationInterval(50);
+
+    islands.solve(12);
+    EXPECT_EQ(islands.getStopReason(), "iterations");
+
+    // Any colony reaching the target ends the epoch, long before the migration
+    islands.setTargetDistance(1e9);
+    Tour best = islands.solve(100);
+    EXPECT_EQ(islands.getStopReason(), "target");
+    EXPECT_EQ(islands.getConvergenceData().size(), 1u);
+    EXPECT_TRUE(best.validate(40));
+    islands.setTargetDistance(0.0);
+
+    // A stop requested before solve() allows no iteration: nearest neighbor tour
+    islands.requestStop();
+    best = islands.solve(100);
+    EXPECT_EQ(islands.getStopReason(), "stopped");
+    EXPECT_TRUE(islands.getConvergenceData().empty());
+    EXPECT_TRUE(best.validate(40));
+    EXPECT_DOUBLE_EQ(best.getDistance(), graph.nearestNeighborTourLength());
+
+    // The budget is honoured inside an epoch that would run far longer
+    islands.setTimeLimit(0.05);
+    auto start = std::chrono::steady_clock::now();
+    best = islands.solve(1000000);
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    EXPECT_EQ(islands.getStopReason(), "time-limit");
+    EXPECT_TRUE(best.validate(40));
+    EXPECT_LT(elapsed, 1.0);
+    islands.setTimeLimit(0.0);
+
+    // Stopped from another thread inside an epoch that would never end
+    islands.setMigrationInterval(0);
+    islands.setConvergenceThreshold(100000000);
+    std::thread worker([&islands]() { islands.solve(-1); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    islands.requestStop();
+    worker.join();
+    EXPECT_EQ(islands.getStopReason(), "stopped");
+    EXPECT_TRUE(islands.getBestTour().validate(40));
+}
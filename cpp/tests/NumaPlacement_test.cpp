@@ -0,0 +1,118 @@
+#include <gtest/gtest.h>
+#include "NumaPlacement.h"
+#include "AlignedAllocator.h"
+#include "Graph.h"
+#include "City.h"
+#include "PheromoneMatrix.h"
+#include "TestGraphs.h"
+#include <algorithm>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+// Test first touch fills large and small buffers, with and without threads
+TEST(NumaPlacementTest, FirstTouchFills) {
+    EXPECT_TRUE(numa::isFirstTouchEnabled());
+    for (bool enabled : {true, false}) {
+        numa::setFirstTouchEnabled(enabled);
+        AlignedVector<double> large;
+        large.resize(numa::FIRST_TOUCH_MIN_BYTES / sizeof(double) + 3);
+        numa::firstTouch(large.data(), large.size(), 2.5);
+        for (double value : large) {
+            ASSERT_EQ(value, 2.5);
+        }
+
+        AlignedVector<float> small;
+        small.resize(17);
+        numa::firstTouch(small.data(), small.size(), 1.0f);
+        EXPECT_EQ(small, AlignedVector<float>(17, 1.0f));
+
+        // Row-wise: every row, padding included (odd row count and stride)
+        const std::size_t rows = 1001;
+        const std::size_t stride = numa::FIRST_TOUCH_MIN_BYTES / sizeof(double) / 1000 + 5;
+        AlignedVector<double> matrix;
+        matrix.resize(rows * stride);
+        numa::firstTouchRows(matrix.data(), rows, stride, -1.5);
+        for (double value : matrix) {
+            ASSERT_EQ(value, -1.5);
+        }
+    }
+    numa::setFirstTouchEnabled(true);
+}
+
+// Test the matrices come out the same with parallel or single-threaded first touch
+TEST(NumaPlacementTest, MatricesIndependentOfPlacement) {
+    std::vector<City> cities = scatteredCities(800);
+
+    numa::setFirstTouchEnabled(false);
+    Graph serial(cities);
+    PheromoneMatrix serialTrails(800, 0.25);
+    numa::setFirstTouchEnabled(true);
+    Graph parallel(cities);
+    PheromoneMatrix parallelTrails(800, 0.25);
+
+    for (int i = 0; i < 800; i += 7) {
+        for (int j = 0; j < 800; ++j) {
+            ASSERT_EQ(parallel.getDistance(i, j), serial.getDistance(i, j));
+            ASSERT_EQ(parallelTrails.getPheromone(i, j), serialTrails.getPheromone(i, j));
+        }
+        EXPECT_EQ(parallel.getDistance(i, i), 0.0);
+    }
+}
+
+// Test the deposit row blocks are the rows schedule(static) gives each thread,
+// so the fused update runs on the rows each thread first touched
+TEST(NumaPlacementTest, DepositBlocksMatchStaticRows) {
+    const int rows = 1003;
+    for (int threads : {1, 3, 8}) {
+        std::vector<int> owner(rows, -1);
+#ifdef _OPENMP
+        #pragma omp parallel for schedule(static) num_threads(threads)
+        for (int row = 0; row < rows; ++row) {
+            owner[row] = omp_get_thread_num();
+        }
+        if (omp_get_max_threads() < threads && owner.back() == 0) {
+            continue;  // Team capped below the requested size
+        }
+#else
+        if (threads > 1) {
+            continue;
+        }
+        std::fill(owner.begin(), owner.end(), 0);
+#endif
+        PheromoneDeposits deposits;
+        deposits.reset(1, rows, threads);
+        ASSERT_EQ(deposits.getNumBlocks(), threads);
+        for (int block = 0; block < threads; ++block) {
+            for (int row = deposits.getBlockBegin(block); row < deposits.getBlockBegin(block + 1); ++row) {
+                ASSERT_EQ(owner[row], block) << threads << " threads, row " << row;
+            }
+        }
+    }
+}
+
+// Test binding names and the CPU order of each policy
+TEST(NumaPlacementTest, ThreadCpus) {
+    numa::ThreadBinding binding = numa::ThreadBinding::NONE;
+    EXPECT_TRUE(numa::parseThreadBinding("spread", binding));
+    EXPECT_EQ(binding, numa::ThreadBinding::SPREAD);
+    EXPECT_FALSE(numa::parseThreadBinding("scatter", binding));
+    EXPECT_EQ(binding, numa::ThreadBinding::SPREAD);
+    EXPECT_STREQ(numa::threadBindingName(numa::ThreadBinding::CLOSE), "close");
+
+    // Two sockets with four CPUs each (hyperthread numbering), one CPU disallowed
+    std::vector<std::vector<int>> nodes = {{0, 1, 2, 3}, {4, 5, 6}};
+    EXPECT_EQ(numa::threadCpus(nodes, numa::ThreadBinding::CLOSE, 5),
+              (std::vector<int>{0, 1, 2, 3, 4}));
+    EXPECT_EQ(numa::threadCpus(nodes, numa::ThreadBinding::SPREAD, 5),
+              (std::vector<int>{0, 4, 1, 5, 2}));
+    EXPECT_EQ(numa::threadCpus(nodes, numa::ThreadBinding::SPREAD, 9),
+              (std::vector<int>{0, 4, 1, 5, 2, 6, 3, 0, 4}));
+    EXPECT_TRUE(numa::threadCpus(nodes, numa::ThreadBinding::NONE, 4).empty());
+    EXPECT_TRUE(numa::threadCpus({}, numa::ThreadBinding::CLOSE, 4).empty());
+
+    EXPECT_GE(numa::numNodes(), 1);
+    EXPECT_TRUE(numa::bindThreads(numa::ThreadBinding::NONE));
+}
@@ -1,6 +1,9 @@
 #include <gtest/gtest.h>
 #include "PheromoneMatrix.h"
+#include <cmath>
+#include <cstdint>
 #include <limits>
+#include <vector>
 
 // Test constructor and initialization
 TEST(PheromoneMatrixTest, ConstructorInitialization) {
@@ -254,3 +257,171 @@ TEST(PheromoneMatrixTest, RealisticACOScenario) {
     matrix.clampPheromones();
     EXPECT_DOUBLE_EQ(matrix.getPheromone(0, 2), 0.1); // Clamped to min
 }
+
+// Test flat storage: rows are cache-line aligned and match getPheromone
+TEST(PheromoneMatrixTest, RowAccessAligned) {
+    PheromoneMatrix matrix(13, 1.0);
+    matrix.setPheromone(3, 7, 4.0);
+
+    for (int i = 0; i < 13; ++i) {
+        const double* row = matrix.getRow(i);
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(row) % CACHE_LINE_SIZE, 0u);
+        for (int j = 0; j < 13; ++j) {
+            EXPECT_DOUBLE_EQ(row[j], matrix.getPheromone(i, j));
+        }
+    }
+    EXPECT_DOUBLE_EQ(matrix.getRow(7)[3], 4.0);
+}
+
+// Test evaporation and clamping sweep odd-sized matrices completely
+TEST(PheromoneMatrixTest, LinearSweepOddSize) {
+    PheromoneMatrix matrix(9, 8.0);
+    matrix.setMinPheromone(3.0);
+    matrix.evaporate(0.75);
+    matrix.clampPheromones();
+
+    for (int i = 0; i < 9; ++i) {
+        for (int j = 0; j < 9; ++j) {
+            EXPECT_DOUBLE_EQ(matrix.getPheromone(i, j), 3.0);
+        }
+    }
+}
+
+// Test buffered deposits give exactly the serial sums for any block count
+TEST(PheromoneMatrixTest, BufferedDepositsMatchSerial) {
+    const int n = 23;
+    std::vector<std::vector<int>> tours;
+    for (int t = 0; t < 6; ++t) {
+        std::vector<int> tour;
+        for (int i = 0; i < n; ++i) {
+            tour.push_back((i * (2 * t + 3) + t) % n);
+        }
+        tours.push_back(tour);
+    }
+
+    PheromoneMatrix serial(n, 0.5);
+    for (size_t t = 0; t < tours.size(); ++t) {
+        for (int i = 0; i < n; ++i) {
+            serial.depositPheromone(tours[t][i], tours[t][(i + 1) % n], 1.0 / (t + 3));
+        }
+    }
+
+    PheromoneDeposits deposits;
+    for (int blocks : {1, 3, 7, 64}) {
+        PheromoneMatrix buffered(n, 0.5);
+        deposits.reset(static_cast<int>(tours.size()), n, blocks);
+        EXPECT_LE(deposits.getNumBlocks(), n);
+        for (size_t t = 0; t < tours.size(); ++t) {
+            deposits.addTour(static_cast<int>(t), tours[t], 1.0 / (t + 3));
+        }
+        buffered.depositPheromones(deposits);
+
+        for (int i = 0; i < n; ++i) {
+            for (int j = 0; j < n; ++j) {
+                EXPECT_EQ(buffered.getPheromone(i, j), serial.getPheromone(i, j));
+            }
+        }
+    }
+}
+
+// Test edges are stored canonically in each endpoint's block and self-loops are dropped
+TEST(PheromoneMatrixTest, BufferedDepositsCanonicalEdges) {
+    PheromoneDeposits deposits;
+    deposits.reset(2, 10, 2);
+    ASSERT_EQ(deposits.getBlockBegin(1), 5);
+    deposits.add(0, 7, 2, 1.0);
+    deposits.add(0, 3, 1, 0.5);
+    deposits.add(1, 4, 4, 1.0);
+
+    ASSERT_EQ(deposits.bucket(0, 0).size(), 2u);
+    EXPECT_EQ(deposits.bucket(0, 0)[0].cityA, 2);
+    EXPECT_EQ(deposits.bucket(0, 0)[0].cityB, 7);
+    EXPECT_EQ(deposits.bucket(0, 0)[1].cityA, 1);
+    EXPECT_EQ(deposits.bucket(0, 0)[1].cityB, 3);
+    ASSERT_EQ(deposits.bucket(0, 1).size(), 1u);
+    EXPECT_EQ(deposits.bucket(0, 1)[0].cityA, 2);
+    EXPECT_EQ(deposits.bucket(0, 1)[0].cityB, 7);
+    for (int block = 0; block < deposits.getNumBlocks(); ++block) {
+        EXPECT_TRUE(deposits.bucket(1, block).empty());
+    }
+
+    PheromoneMatrix matrix(10, 0.0);
+    matrix.depositPheromones(deposits);
+    EXPECT_DOUBLE_EQ(matrix.getPheromone(2, 7), 1.0);
+    EXPECT_DOUBLE_EQ(matrix.getPheromone(7, 2), 1.0);
+    EXPECT_DOUBLE_EQ(matrix.getPheromone(1, 3), 0.5);
+    EXPECT_DOUBLE_EQ(matrix.getPheromone(3, 1), 0.5);
+    EXPECT_DOUBLE_EQ(matrix.getPheromone(4, 4), 0.0);
+
+    // reset() empties the buckets for the next iteration
+    deposits.reset(2, 10, 2);
+    for (int block = 0; block < deposits.getNumBlocks(); ++block) {
+        EXPECT_TRUE(deposits.bucket(0, block).empty());
+    }
+}
+
+// Test the fused pass matches evaporate + deposit + clamp + choice rebuild
+TEST(PheromoneMatrixTest, FusedUpdateMatchesSeparatePasses) {
+    const int n = 17;
+    std::vector<int> tour;
+    for (int i = 0; i < n; ++i) {
+        tour.push_back((i * 5) % n);
+    }
+
+    std::vector<double> heuristic(n * n);
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n; ++j) {
+            heuristic[i * n + j] = 1.0 / (1.0 + i + j);
+        }
+    }
+
+    for (double alpha : {1.0, 1.5}) {
+        PheromoneMatrix separate(n, 2.0);
+        PheromoneMatrix fused(n, 2.0);
+        for (PheromoneMatrix* matrix : {&separate, &fused}) {
+            matrix->setPheromone(3, 4, 9.0);
+            matrix->setMinPheromone(1.2);
+            matrix->setMaxPheromone(5.0);
+        }
+
+        PheromoneDeposits deposits;
+        deposits.reset(2, n, 3);
+        deposits.addTour(0, tour, 0.75);
+        deposits.addTour(1, tour, 0.5);
+
+        separate.evaporate(0.4);
+        separate.depositPheromones(deposits);
+        separate.clampPheromones();
+
+        std::vector<double> choice(n * n, -1.0);
+        ChoiceInfoView view;
+        view.choice = choice.data();
+        view.heuristic = heuristic.data();
+        view.stride = n;
+        view.alpha = alpha;
+        fused.fusedUpdate(0.4, deposits, &view);
+
+        for (int i = 0; i < n; ++i) {
+            for (int j = 0; j < n; ++j) {
+                EXPECT_NEAR(fused.getPheromone(i, j), separate.getPheromone(i, j), 1e-12);
+                EXPECT_EQ(fused.getPheromone(i, j), fused.getPheromone(j, i));
+                double expected = std::pow(separate.getPheromone(i, j), alpha) * heuristic[i * n + j];
+                EXPECT_NEAR(choice[i * n + j], expected, 1e-12);
+            }
+        }
+        EXPECT_DOUBLE_EQ(fused.getPheromone(3, 4), 5.0);
+        EXPECT_DOUBLE_EQ(fused.getPheromone(0, 0), 1.2);
+    }
+}
+
+// Test the fused pass without deposits or choice info is plain evaporation
+TEST(PheromoneMatrixTest, FusedUpdateWithoutDeposits) {
+    PheromoneMatrix matrix(6, 4.0);
+    PheromoneDeposits none;
+    matrix.fusedUpdate(0.25, none);
+    for (int i = 0; i < 6; ++i) {
+        for (int j = 0; j < 6; ++j) {
+            EXPECT_DOUBLE_EQ(matrix.getPheromone(i, j), 3.0);
+        }
+    }
+}
@@ -0,0 +1,37 @@
+#include <gtest/gtest.h>
+#include "Power.h"
+#include <cmath>
+#include <type_traits>
+
+// Test integer powers agree with std::pow to rounding
+TEST(PowerTest, IntegerPowersMatchPow) {
+    for (double x : {0.0, 1e-6, 0.37, 1.0, 2.5, 1234.5}) {
+        EXPECT_DOUBLE_EQ(IntegerPower<1>{}(x), x);
+        EXPECT_DOUBLE_EQ(IntegerPower<2>{}(x), std::pow(x, 2.0));
+        EXPECT_DOUBLE_EQ(IntegerPower<3>{}(x), std::pow(x, 3.0));
+        EXPECT_DOUBLE_EQ(IntegerPower<4>{}(x), std::pow(x, 4.0));
+        EXPECT_DOUBLE_EQ(IntegerPower<5>{}(x), std::pow(x, 5.0));
+    }
+    EXPECT_DOUBLE_EQ(RealPower{2.5}(4.0), 32.0);
+}
+
+// Test dispatch picks multiplications exactly for the exponents 1..5
+TEST(PowerTest, DispatchSelectsIntegerPowers) {
+    auto isInteger = [](double exponent) {
+        return dispatchPower(exponent, [](auto power) {
+            return !std::is_same<decltype(power), RealPower>::value;
+        });
+    };
+    for (double exponent : {1.0, 2.0, 3.0, 4.0, 5.0}) {
+        EXPECT_TRUE(isInteger(exponent)) << exponent;
+    }
+    for (double exponent : {0.0, 0.5, 2.5, 6.0, -1.0}) {
+        EXPECT_FALSE(isInteger(exponent)) << exponent;
+    }
+
+    // Both exponents, same values either way
+    double value = dispatchPowers(1.0, 2.5, [](auto alphaPower, auto betaPower) {
+        return alphaPower(3.0) * betaPower(4.0);
+    });
+    EXPECT_DOUBLE_EQ(value, 3.0 * std::pow(4.0, 2.5));
+}
@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+#include "ProgressReporter.h"
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace {
+
+ProgressUpdate makeUpdate(int iteration, std::vector<double> points, bool improved) {
+    ProgressUpdate update;
+    update.iteration = iteration;
+    update.bestDistance = points.back();
+    update.convergenceOffset = iteration - static_cast<int>(points.size());
+    update.newConvergence = std::move(points);
+    if (improved) {
+        update.tourImproved = true;
+        update.bestTour = {iteration, 0, 1};
+    }
+    return update;
+}
+
+}  // namespace
+
+// Test synchronous delivery calls the callback on the publishing thread
+TEST(ProgressReporterTest, SynchronousDelivery) {
+    std::vector<int> iterations;
+    std::thread::id caller;
+    ProgressReporter reporter([&](const ProgressUpdate& update) {
+        iterations.push_back(update.iteration);
+        caller = std::this_thread::get_id();
+    }, false);
+
+    reporter.publish(makeUpdate(1, {10.0}, true));
+    EXPECT_EQ(iterations, std::vector<int>{1});
+    EXPECT_EQ(caller, std::this_thread::get_id());
+    reporter.publish(makeUpdate(2, {9.0}, false));
+    reporter.finish();
+    EXPECT_EQ(iterations, (std::vector<int>{1, 2}));
+}
+
+// Test a slow asynchronous consumer receives merged updates and loses nothing
+TEST(ProgressReporterTest, AsynchronousMergesPendingUpdates) {
+    std::atomic<bool> started{false};
+    std::atomic<bool> release{false};
+    std::vector<ProgressUpdate> received;
+    std::thread::id caller;
+    ProgressReporter reporter([&](const ProgressUpdate& update) {
+        // Block on the first update until everything else is queued
+        started.store(true);
+        while (!release.load()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        caller = std::this_thread::get_id();
+        received.push_back(update);
+    }, true);
+
+    reporter.publish(makeUpdate(1, {10.0}, true));
+
+    // Once the worker holds the first update, queue three more: none of these
+    // calls may wait for the stalled callback (they would deadlock here)
+    while (!started.load()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    reporter.publish(makeUpdate(2, {9.0}, true));
+    reporter.publish(makeUpdate(3, {9.5}, false));
+    ProgressUpdate last = makeUpdate(4, {8.0}, false);
+    last.final = true;
+    reporter.publish(std::move(last));
+    release.store(true);
+    reporter.finish();
+
+    EXPECT_NE(caller, std::this_thread::get_id());
+    ASSERT_EQ(received.size(), 2u);
+    EXPECT_EQ(received[0].iteration, 1);
+    EXPECT_EQ(received[0].newConvergence, std::vector<double>{10.0});
+
+    // The merged update: all points, the newest tour, the offset of the first
+    const ProgressUpdate& merged = received[1];
+    EXPECT_EQ(merged.iteration, 4);
+    EXPECT_EQ(merged.convergenceOffset, 1);
+    EXPECT_EQ(merged.newConvergence, (std::vector<double>{9.0, 9.5, 8.0}));
+    EXPECT_TRUE(merged.tourImproved);
+    EXPECT_EQ(merged.bestTour, (std::vector<int>{2, 0, 1}));
+    EXPECT_DOUBLE_EQ(merged.bestDistance, 8.0);
+    EXPECT_TRUE(merged.final);
+}
+
+// Test exceptions thrown on the worker thread surface in finish()
+TEST(ProgressReporterTest, AsynchronousExceptionRethrown) {
+    std::atomic<int> calls{0};
+    ProgressReporter reporter([&](const ProgressUpdate&) {
+        ++calls;
+        throw std::runtime_error("consumer failed");
+    }, true);
+
+    reporter.publish(makeUpdate(1, {10.0}, true));
+    reporter.publish(makeUpdate(2, {9.0}, true));  // Merged, or dropped after the failure
+    EXPECT_THROW(reporter.finish(), std::runtime_error);
+    EXPECT_EQ(calls.load(), 1);
+}
+
+// Test destroying a reporter without finish() joins its worker
+TEST(ProgressReporterTest, DestructorStopsWorker) {
+    std::atomic<int> calls{0};
+    {
+        ProgressReporter reporter([&](const ProgressUpdate&) { ++calls; }, true);
+        reporter.publish(makeUpdate(1, {10.0}, true));
+    }
+    EXPECT_LE(calls.load(), 1);
+}
@@ -0,0 +1,90 @@
+#include <gtest/gtest.h>
+#include "Random.h"
+#include <vector>
+
+// Test equal seeds give equal sequences
+TEST(RandomTest, SameSeedSameSequence) {
+    Xoshiro256 a(42);
+    Xoshiro256 b(42);
+
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_EQ(a(), b());
+    }
+}
+
+// Test nearby seeds give unrelated sequences
+TEST(RandomTest, DifferentSeedsDiffer) {
+    Xoshiro256 a(1);
+    Xoshiro256 b(2);
+
+    int equal = 0;
+    for (int i = 0; i < 100; ++i) {
+        if (a() == b()) {
+            equal++;
+        }
+    }
+    EXPECT_EQ(equal, 0);
+}
+
+// Test a saved state continues the stream where it was taken
+TEST(RandomTest, StateRoundTrip) {
+    Xoshiro256 a(7);
+    for (int i = 0; i < 10; ++i) {
+        a();
+    }
+    Xoshiro256 b(99);
+    b.setState(a.getState());
+
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_EQ(a(), b());
+    }
+}
+
+// Test reseeding restarts the stream
+TEST(RandomTest, ReseedRestartsStream) {
+    Xoshiro256 rng(7);
+    std::vector<Xoshiro256::result_type> first;
+    for (int i = 0; i < 10; ++i) {
+        first.push_back(rng());
+    }
+
+    rng.seed(7);
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_EQ(rng(), first[i]);
+    }
+}
+
+// Test nextDouble stays in [0, 1)
+TEST(RandomTest, NextDoubleRange) {
+    Xoshiro256 rng(123);
+    double sum = 0.0;
+
+    for (int i = 0; i < 10000; ++i) {
+        double value = rng.nextDouble();
+        EXPECT_GE(value, 0.0);
+        EXPECT_LT(value, 1.0);
+        sum += value;
+    }
+
+    // Mean of a uniform [0, 1) sample
+    EXPECT_NEAR(sum / 10000.0, 0.5, 0.02);
+}
+
+// Test nextInt covers [0, bound) and nothing else
+TEST(RandomTest, NextIntRange) {
+    Xoshiro256 rng(99);
+    std::vector<int> counts(7, 0);
+
+    for (int i = 0; i < 7000; ++i) {
+        int value = rng.nextInt(7);
+        ASSERT_GE(value, 0);
+        ASSERT_LT(value, 7);
+        counts[value]++;
+    }
+
+    for (int count : counts) {
+        EXPECT_GT(count, 800);
+        EXPECT_LT(count, 1200);
+    }
+    EXPECT_EQ(rng.nextInt(1), 0);
+}
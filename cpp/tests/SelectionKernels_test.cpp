@@ -0,0 +1,191 @@
+#include <gtest/gtest.h>
+#include "SelectionKernels.h"
+#include "Ant.h"
+#include "City.h"
+#include "Graph.h"
+#include "Random.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+using selection::Isa;
+
+// Random weights (some exactly zero) and a random visited mask
+void randomRow(int n, double visitedFraction, std::uint64_t seed,
+               std::vector<double>& weights, std::vector<std::uint8_t>& visited) {
+    Xoshiro256 rng(seed);
+    weights.resize(n);
+    visited.resize(n);
+    for (int i = 0; i < n; ++i) {
+        weights[i] = rng.nextDouble() < 0.1 ? 0.0 : rng.nextDouble() * 1e3;
+        visited[i] = rng.nextDouble() < visitedFraction ? 1 : 0;
+    }
+}
+
+bool sameBits(double a, double b) {
+    return std::memcmp(&a, &b, sizeof(double)) == 0;
+}
+
+// Restores the detected kernels after each test
+class SelectionKernelsTest : public ::testing::Test {
+protected:
+    void SetUp() override { previous_ = selection::activeKernels().isa; }
+    void TearDown() override { selection::setActiveIsa(previous_); }
+
+    Isa previous_ = Isa::SCALAR;
+};
+
+const Isa ALL_ISAS[] = {Isa::SCALAR, Isa::AVX2, Isa::AVX512, Isa::NEON};
+
+}  // namespace
+
+// Test every supported kernel set sums and maximizes bit-identically to the scalar one
+TEST_F(SelectionKernelsTest, KernelsMatchScalarExactly) {
+    const selection::Kernels& scalar = selection::kernels(Isa::SCALAR);
+    std::vector<double> weights;
+    std::vector<std::uint8_t> visited;
+
+    for (Isa isa : ALL_ISAS) {
+        if (!selection::isSupported(isa)) {
+            continue;
+        }
+        const selection::Kernels& simd = selection::kernels(isa);
+        EXPECT_EQ(simd.isa, isa);
+        for (int n : {1, 3, 7, 8, 9, 63, 64, 65, 100, 128, 1002}) {
+            for (double visitedFraction : {0.0, 0.5, 0.95, 1.0}) {
+                randomRow(n, visitedFraction, 1000 + n, weights, visited);
+                int blocks = selection::numBlocks(n);
+                std::vector<double> expectedSums(blocks), actualSums(blocks);
+
+                double expected = scalar.blockSums(weights.data(), visited.data(), n, expectedSums.data());
+                double actual = simd.blockSums(weights.data(), visited.data(), n, actualSums.data());
+                EXPECT_TRUE(sameBits(expected, actual)) << simd.name << " n=" << n;
+                for (int b = 0; b < blocks; ++b) {
+                    EXPECT_TRUE(sameBits(expectedSums[b], actualSums[b])) << simd.name << " block " << b;
+                }
+
+                EXPECT_EQ(scalar.maxWeight(weights.data(), visited.data(), n),
+                          simd.maxWeight(weights.data(), visited.data(), n))
+                    << simd.name << " n=" << n;
+            }
+        }
+    }
+}
+
+// Test block sums and maxima against a plain loop
+TEST_F(SelectionKernelsTest, ScalarKernelsMatchReference) {
+    std::vector<double> weights;
+    std::vector<std::uint8_t> visited;
+    randomRow(200, 0.3, 7, weights, visited);
+    const selection::Kernels& scalar = selection::kernels(Isa::SCALAR);
+
+    std::vector<double> sums(selection::numBlocks(200));
+    double total = scalar.blockSums(weights.data(), visited.data(), 200, sums.data());
+    double expectedTotal = 0.0;
+    double expectedMax = -1.0;
+    for (int i = 0; i < 200; ++i) {
+        if (!visited[i]) {
+            expectedTotal += weights[i];
+            expectedMax = std::max(expectedMax, weights[i]);
+        }
+    }
+    EXPECT_NEAR(total, expectedTotal, 1e-9 * expectedTotal);
+    EXPECT_EQ(scalar.maxWeight(weights.data(), visited.data(), 200), expectedMax);
+
+    // Fully visited rows have no maximum
+    std::vector<std::uint8_t> allVisited(200, 1);
+    EXPECT_EQ(scalar.maxWeight(weights.data(), allVisited.data(), 200), -1.0);
+    EXPECT_EQ(selection::findWeight(weights.data(), allVisited.data(), 200, -1.0), -1);
+}
+
+// Test the block walk picks the same city as a linear roulette scan
+TEST_F(SelectionKernelsTest, PickFromBlocksMatchesLinearScan) {
+    std::vector<double> weights;
+    std::vector<std::uint8_t> visited;
+    const int n = 300;
+    randomRow(n, 0.4, 11, weights, visited);
+    std::vector<double> sums(selection::numBlocks(n));
+    double total = selection::kernels(Isa::SCALAR).blockSums(weights.data(), visited.data(), n, sums.data());
+
+    Xoshiro256 rng(3);
+    for (int trial = 0; trial < 1000; ++trial) {
+        // Targets away from the city boundaries, where rounding could differ
+        double target = rng.nextDouble() * total;
+        double cumulative = 0.0;
+        int expected = -1;
+        double margin = 0.0;
+        for (int i = 0; i < n; ++i) {
+            if (!visited[i]) {
+                cumulative += weights[i];
+                if (target <= cumulative) {
+                    expected = i;
+                    margin = std::min(cumulative - target, target - (cumulative - weights[i]));
+                    break;
+                }
+            }
+        }
+        if (margin < 1e-6) {
+            continue;
+        }
+        EXPECT_EQ(selection::pickFromBlocks(weights.data(), visited.data(), n, sums.data(), target),
+                  expected);
+    }
+
+    // Beyond the total there is nothing to pick
+    EXPECT_EQ(selection::pickFromBlocks(weights.data(), visited.data(), n, sums.data(), total * 2.0), -1);
+}
+
+// Test forcing an instruction set and falling back for unsupported ones
+TEST_F(SelectionKernelsTest, SetActiveIsa) {
+    EXPECT_TRUE(selection::isSupported(Isa::SCALAR));
+    EXPECT_TRUE(selection::setActiveIsa(Isa::SCALAR));
+    EXPECT_EQ(selection::activeKernels().isa, Isa::SCALAR);
+
+    for (Isa isa : ALL_ISAS) {
+        if (selection::isSupported(isa)) {
+            EXPECT_TRUE(selection::setActiveIsa(isa));
+            EXPECT_EQ(selection::activeKernels().isa, isa);
+        } else {
+            EXPECT_FALSE(selection::setActiveIsa(isa));
+            EXPECT_EQ(selection::kernels(isa).isa, Isa::SCALAR);
+        }
+    }
+}
+
+// Test seeded ants build the same tour whichever kernels are active
+TEST_F(SelectionKernelsTest, AntToursIndependentOfIsa) {
+    const int n = 150;
+    std::vector<double> choiceRow;
+    std::vector<std::uint8_t> unused;
+    randomRow(n, 0.0, 5, choiceRow, unused);
+    std::vector<City> cities;
+    for (int i = 0; i < n; ++i) {
+        cities.emplace_back(i, static_cast<double>(i % 13), static_cast<double>(i / 13));
+    }
+    Graph graph(cities);
+
+    auto buildTour = [&](Isa isa, double q0) {
+        selection::setActiveIsa(isa);
+        Ant ant(0, n, 42);
+        for (int step = 1; step < n; ++step) {
+            int city = ant.selectNextCity(choiceRow.data(), q0);
+            EXPECT_GE(city, 0);
+            EXPECT_FALSE(ant.hasVisited(city));
+            ant.visitCity(city, graph);
+        }
+        EXPECT_EQ(ant.selectNextCity(choiceRow.data(), q0), -1);
+        return ant.getTour();
+    };
+
+    for (double q0 : {0.0, 0.9}) {
+        std::vector<int> expected = buildTour(Isa::SCALAR, q0);
+        for (Isa isa : ALL_ISAS) {
+            if (selection::isSupported(isa)) {
+                EXPECT_EQ(buildTour(isa, q0), expected) << selection::kernels(isa).name;
+            }
+        }
+    }
+}
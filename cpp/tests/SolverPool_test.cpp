@@ -0,0 +1,193 @@
+#include <gtest/gtest.h>
+#include "SolverPool.h"
+#include "AntColony.h"
+#include "Graph.h"
+#include "City.h"
+#include "TestGraphs.h"
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace {
+
+SolverJob makeJob(std::shared_ptr<const Graph> graph, std::uint64_t seed) {
+    SolverJob job;
+    job.graph = std::move(graph);
+    job.numAnts = 10;
+    job.maxIterations = 15;
+    job.configure = [seed](AntColony& colony) { colony.setSeed(seed); };
+    return job;
+}
+
+void waitFor(const std::atomic<bool>& flag) {
+    while (!flag.load()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+}  // namespace
+
+// Test jobs share the submitted graph and give the same tours as direct solves
+TEST(SolverPoolTest, SolvesJobsOnSharedGraph) {
+    auto graph = sharedScatteredGraph(25);
+    SolverPool pool(2);
+    EXPECT_EQ(pool.getNumThreads(), 2);
+
+    std::atomic<int> shared{0};
+    std::vector<std::future<SolverResult>> futures;
+    for (std::uint64_t seed = 1; seed <= 5; ++seed) {
+        SolverJob job = makeJob(graph, seed);
+        job.configure = [seed, &shared, raw = graph.get()](AntColony& colony) {
+            colony.setSeed(seed);
+            if (colony.getSharedGraph().get() == raw) {
+                ++shared;
+            }
+        };
+        futures.push_back(pool.submit(std::move(job)));
+    }
+
+    for (std::uint64_t seed = 1; seed <= 5; ++seed) {
+        SolverResult result = futures[seed - 1].get();
+        EXPECT_TRUE(result.tour.validate(25));
+        EXPECT_EQ(result.convergence.size(), 15u);
+        EXPECT_EQ(result.stopReason, "iterations");
+        EXPECT_GE(result.solveSeconds, 0.0);
+
+        AntColony direct(graph, 10, 1.0, 2.0, 0.5, 100.0);
+        direct.setSeed(seed);
+        direct.setUseParallel(false);
+        direct.setNumThreads(1);
+        Tour expected = direct.solve(15);
+        EXPECT_DOUBLE_EQ(result.tour.getDistance(), expected.getDistance());
+        EXPECT_EQ(result.tour.getSequence(), expected.getSequence());
+    }
+    EXPECT_EQ(shared.load(), 5);
+
+    // Finished jobs release their reference to the graph
+    pool.waitIdle();
+    EXPECT_EQ(graph.use_count(), 1);
+    EXPECT_EQ(pool.getQueuedJobs(), 0);
+    EXPECT_EQ(pool.getRunningJobs(), 0);
+}
+
+// Test queued jobs start by priority, then in submission order
+TEST(SolverPoolTest, PriorityOrder) {
+    auto graph = sharedScatteredGraph(10);
+    SolverPool pool(1);
+
+    // Occupy the only worker until every other job is queued
+    std::atomic<bool> started{false};
+    std::atomic<bool> release{false};
+    SolverJob blocker = makeJob(graph, 1);
+    blocker.configure = [&](AntColony&) {
+        started.store(true);
+        waitFor(release);
+    };
+    std::future<SolverResult> blocked = pool.submit(std::move(blocker));
+    waitFor(started);
+
+    std::mutex orderMutex;
+    std::vector<int> order;
+    std::vector<std::future<SolverResult>> futures;
+    const int priorities[] = {0, 5, 1, 5, -2};
+    for (int i = 0; i < 5; ++i) {
+        SolverJob job = makeJob(graph, i);
+        job.priority = priorities[i];
+        job.configure = [i, &orderMutex, &order](AntColony&) {
+            std::lock_guard<std::mutex> lock(orderMutex);
+            order.push_back(i);
+        };
+        futures.push_back(pool.submit(std::move(job)));
+    }
+    EXPECT_EQ(pool.getQueuedJobs(), 5);
+    EXPECT_EQ(pool.getRunningJobs(), 1);
+
+    release.store(true);
+    pool.waitIdle();
+    blocked.get();
+    for (auto& future : futures) {
+        future.get();
+    }
+    EXPECT_EQ(order, (std::vector<int>{1, 3, 2, 0, 4}));
+}
+
+// Test a job's OpenMP regions use its thread budget, clamped to the pool size
+TEST(SolverPoolTest, ThreadBudget) {
+#ifdef _OPENMP
+    auto graph = sharedScatteredGraph(20);
+    SolverPool pool(3);
+    const int callerThreads = omp_get_max_threads();
+
+    std::vector<int> requested = {1, 2, 16};
+    std::vector<std::future<SolverResult>> futures;
+    std::vector<std::atomic<int>> seen(requested.size());
+    for (std::size_t j = 0; j < requested.size(); ++j) {
+        SolverJob job = makeJob(graph, j);
+        job.threads = requested[j];
+        job.configure = [&seen, j](AntColony& colony) {
+            colony.setCallbackInterval(5);
+            colony.setNumThreads(7);  // Overridden by the budget
+            colony.setProgressCallback([&seen, j](int, double, const std::vector<int>&,
+                                                  const std::vector<double>&) {
+                seen[j].store(omp_get_max_threads());
+            });
+        };
+        futures.push_back(pool.submit(std::move(job)));
+    }
+    for (auto& future : futures) {
+        future.get();
+    }
+
+    EXPECT_EQ(seen[0].load(), 1);
+    EXPECT_EQ(seen[1].load(), 2);
+    EXPECT_EQ(seen[2].load(), 3);
+    EXPECT_EQ(omp_get_max_threads(), callerThreads);
+#else
+    GTEST_SKIP() << "OpenMP not available";
+#endif
+}
+
+// Test invalid jobs and failures inside a job surface through the future
+TEST(SolverPoolTest, ErrorsReachFuture) {
+    SolverPool pool(1);
+
+    SolverJob empty;
+    EXPECT_THROW(pool.submit(std::move(empty)).get(), std::invalid_argument);
+
+    SolverJob noAnts = makeJob(sharedScatteredGraph(8), 1);
+    noAnts.numAnts = 0;
+    EXPECT_THROW(pool.submit(std::move(noAnts)).get(), std::invalid_argument);
+
+    SolverJob failing = makeJob(sharedScatteredGraph(8), 1);
+    failing.configure = [](AntColony&) { throw std::runtime_error("bad settings"); };
+    EXPECT_THROW(pool.submit(std::move(failing)).get(), std::runtime_error);
+
+    // The pool keeps working after a failed job
+    SolverResult result = pool.submit(makeJob(sharedScatteredGraph(8), 2)).get();
+    EXPECT_TRUE(result.tour.validate(8));
+}
+
+// Test the destructor finishes queued jobs
+TEST(SolverPoolTest, DestructorDrainsQueue) {
+    auto graph = sharedScatteredGraph(12);
+    std::vector<std::future<SolverResult>> futures;
+    {
+        SolverPool pool(1);
+        for (int i = 0; i < 4; ++i) {
+            futures.push_back(pool.submit(makeJob(graph, i)));
+        }
+    }
+    for (auto& future : futures) {
+        ASSERT_EQ(future.wait_for(std::chrono::seconds(0)), std::future_status::ready);
+        EXPECT_TRUE(future.get().tour.validate(12));
+    }
+}
@@ -54,9 +54,11 @@ TEST(TSPLoaderTest, LoadDistanceMatrixFile) {
     EXPECT_TRUE(graph.isValid());
     EXPECT_EQ(graph.getNumCities(), 4);
 
-    // Note: Due to synthetic coordinate generation, exact distances may not match
-    // We just verify that a valid graph was created
-    EXPECT_GT(graph.getDistance(0, 1), 0.0);
+    // Distances are taken from the matrix as is (coordinates are display only)
+    EXPECT_EQ(graph.getDistanceMetric(), DistanceMetric::EXPLICIT);
+    EXPECT_DOUBLE_EQ(graph.getDistance(0, 1), 1.0);
+    EXPECT_DOUBLE_EQ(graph.getDistance(1, 3), 2.5);
+    EXPECT_DOUBLE_EQ(graph.getDistance(3, 2), 1.0);
 }
 
 // Test auto-detect coordinate format
@@ -143,3 +145,92 @@ TEST(TSPLoaderTest, LoadedGraphSymmetry) {
         }
     }
 }
+
+// Test TSPLIB EDGE_WEIGHT_TYPE selects the distance metric
+TEST(TSPLoaderTest, TSPLIBCeilMetric) {
+    Graph graph = TSPLoader::loadFromTSPLIB(getTestDataPath("test_ceil_4.tsp"));
+
+    EXPECT_TRUE(graph.isValid());
+    EXPECT_EQ(graph.getNumCities(), 4);
+    EXPECT_EQ(graph.getDistanceMetric(), DistanceMetric::CEIL_2D);
+
+    // 1.5 rounds up to 2, diagonal 2.12 rounds up to 3
+    EXPECT_DOUBLE_EQ(graph.getDistance(0, 1), 2.0);
+    EXPECT_DOUBLE_EQ(graph.getDistance(0, 2), 3.0);
+}
+
+// Test GEO metric (TSPLIB great-circle distance, rounded)
+TEST(TSPLoaderTest, TSPLIBGeoMetric) {
+    Graph graph = TSPLoader::loadFromTSPLIB(getTestDataPath("test_geo_3.tsp"));
+
+    EXPECT_TRUE(graph.isValid());
+    EXPECT_EQ(graph.getDistanceMetric(), DistanceMetric::GEO);
+
+    // Values of the published burma14 distance matrix
+    EXPECT_DOUBLE_EQ(graph.getDistance(0, 1), 153.0);
+    EXPECT_DOUBLE_EQ(graph.getDistance(0, 2), 510.0);
+    EXPECT_DOUBLE_EQ(graph.getDistance(1, 2), 422.0);
+}
+
+// Test EXPLICIT edge weight formats: all files describe the same matrix
+TEST(TSPLoaderTest, TSPLIBExplicitFormats) {
+    const double expected[4][4] = {
+        {0, 3, 4, 5},
+        {3, 0, 6, 7},
+        {4, 6, 0, 8},
+        {5, 7, 8, 0}
+    };
+
+    for (const char* file : {"test_explicit_full_4.tsp", "test_explicit_upper_row_4.tsp",
+                             "test_explicit_lower_diag_4.tsp"}) {
+        TSPLoader loader(getTestDataPath(file));
+        Graph graph = loader.loadGraph();
+
+        ASSERT_TRUE(graph.isValid()) << file;
+        EXPECT_EQ(graph.getNumCities(), 4) << file;
+        EXPECT_EQ(graph.getDistanceMetric(), DistanceMetric::EXPLICIT) << file;
+        for (int i = 0; i < 4; ++i) {
+            for (int j = 0; j < 4; ++j) {
+                EXPECT_DOUBLE_EQ(graph.getDistance(i, j), expected[i][j]) << file;
+            }
+        }
+    }
+}
+
+// Test EXPLICIT instances in every distance storage layout
+TEST(TSPLoaderTest, TSPLIBExplicitStorage) {
+    for (DistanceStorage storage : {DistanceStorage::FULL_DOUBLE, DistanceStorage::FULL_FLOAT,
+                                    DistanceStorage::TRIANGULAR_DOUBLE, DistanceStorage::TRIANGULAR_FLOAT,
+                                    DistanceStorage::ON_THE_FLY}) {
+        Graph graph = TSPLoader::loadFromTSPLIB(getTestDataPath("test_explicit_upper_row_4.tsp"), storage);
+
+        ASSERT_TRUE(graph.isValid());
+        EXPECT_DOUBLE_EQ(graph.getDistance(1, 3), 7.0);
+        EXPECT_DOUBLE_EQ(graph.getDistance(3, 1), 7.0);
+        EXPECT_DOUBLE_EQ(graph.getDistance(2, 2), 0.0);
+    }
+
+    // Without coordinates to recompute from, on-the-fly falls back to a triangle
+    Graph onTheFly = TSPLoader::loadFromTSPLIB(getTestDataPath("test_explicit_upper_row_4.tsp"),
+                                               DistanceStorage::ON_THE_FLY);
+    EXPECT_EQ(onTheFly.getDistanceStorage(), DistanceStorage::TRIANGULAR_DOUBLE);
+}
+
+// Test display coordinates of EXPLICIT instances
+TEST(TSPLoaderTest, TSPLIBExplicitDisplayData) {
+    Graph graph = TSPLoader::loadFromTSPLIB(getTestDataPath("test_explicit_lower_diag_4.tsp"));
+
+    ASSERT_TRUE(graph.isValid());
+    EXPECT_DOUBLE_EQ(graph.getCity(1).getX(), 30.0);
+    EXPECT_DOUBLE_EQ(graph.getCity(3).getY(), 40.0);
+
+    // Distances still come from the weights, not the display coordinates
+    EXPECT_DOUBLE_EQ(graph.getDistance(0, 1), 3.0);
+}
+
+// Test EXPLICIT section with too few weights
+TEST(TSPLoaderTest, TSPLIBExplicitTooFewWeights) {
+    Graph graph = TSPLoader::loadFromTSPLIB(getTestDataPath("test_explicit_short_4.tsp"));
+
+    EXPECT_FALSE(graph.isValid());
+}
@@ -0,0 +1,33 @@
+#ifndef TESTGRAPHS_H
+#define TESTGRAPHS_H
+
+#include <memory>
+#include <vector>
+#include "City.h"
+#include "Graph.h"
+
+// Shared test instances: n cities scattered deterministically over a
+// 101 x 103 area, irregular enough that tours differ in length
+
+inline std::vector<City> scatteredCities(int n) {
+    std::vector<City> cities;
+    cities.reserve(n);
+    for (int i = 0; i < n; ++i) {
+        cities.emplace_back(i, (i * 37) % 101, (i * 59) % 103);
+    }
+    return cities;
+}
+
+inline Graph scatteredGraph(int n) {
+    return Graph(scatteredCities(n));
+}
+
+inline std::shared_ptr<const Graph> sharedScatteredGraph(int n) {
+    return std::make_shared<const Graph>(scatteredCities(n));
+}
+
+inline std::shared_ptr<const Graph> sharedScatteredGraph(int n, DistanceStorage storage) {
+    return std::make_shared<const Graph>(scatteredCities(n), storage);
+}
+
+#endif // TESTGRAPHS_H
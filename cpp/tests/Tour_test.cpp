@@ -5,6 +5,8 @@
 
 #include "Tour.h"
 #include <gtest/gtest.h>
+#include <utility>
+#include <vector>
 
 // Test default constructor creates invalid tour
 TEST(TourTest, DefaultConstructor) {
@@ -150,3 +152,32 @@ TEST(TourTest, NegativeDistance) {
     EXPECT_EQ(tour.getDistance(), -10.0);
     EXPECT_TRUE(tour.validate(3));
 }
+
+// Test rvalue overloads take over the sequence
+TEST(TourTest, MoveSequence) {
+    std::vector<int> sequence = {0, 1, 2, 3};
+    const int* data = sequence.data();
+
+    Tour tour(std::move(sequence), 4.0);
+    EXPECT_EQ(tour.getSequence().data(), data);
+    EXPECT_DOUBLE_EQ(tour.getDistance(), 4.0);
+    EXPECT_TRUE(tour.validate(4));
+
+    std::vector<int> next = {3, 2, 1, 0};
+    data = next.data();
+    tour.setTour(std::move(next), 5.0);
+    EXPECT_EQ(tour.getSequence().data(), data);
+    EXPECT_DOUBLE_EQ(tour.getDistance(), 5.0);
+}
+
+// Test copying into an existing tour of the same size keeps its storage
+TEST(TourTest, SetTourReusesStorage) {
+    Tour tour({0, 1, 2, 3}, 4.0);
+    const int* data = tour.getSequence().data();
+
+    std::vector<int> other = {2, 3, 0, 1};
+    tour.setTour(other, 4.0);
+
+    EXPECT_EQ(tour.getSequence().data(), data);
+    EXPECT_EQ(tour.getSequence(), other);
+}
@@ -128,10 +128,13 @@ export function useSocket(): UseSocketReturn {
       addLog(`Preview: ${data.benchmark} (${data.numCities} cities)`)
     })
 
-    socket.on("progress", (data: { iteration: number; bestDistance: number; bestTour: number[]; progress: number; elapsedTime?: number }) => {
+    socket.on("progress", (data: { iteration: number; bestDistance: number; bestTour?: number[]; progress: number; elapsedTime?: number }) => {
       setCurrentIteration(data.iteration)
       setBestDistance(data.bestDistance)
-      setBestTour(data.bestTour)
+      // The tour is only sent when it improved
+      if (data.bestTour) {
+        setBestTour(data.bestTour)
+      }
       setConvergenceData((prev) => [...prev, { iteration: data.iteration, length: data.bestDistance }])
 
       // Show iteration status without repeating distance (we have the graph for that)
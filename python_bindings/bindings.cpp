@@ -1,6 +1,14 @@
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
 #include <pybind11/functional.h>
+#include <pybind11/numpy.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <future>
+#include <stdexcept>
+#include <string>
 
 #include "City.h"
 #include "Graph.h"
@@ -9,10 +17,156 @@
 #include "PheromoneMatrix.h"
 #include "Ant.h"
 #include "AntColony.h"
+#include "MultiColony.h"
 #include "LocalSearch.h"
+#include "SolverPool.h"
+#include "NumaPlacement.h"
 
 namespace py = pybind11;
 
+namespace {
+
+// Read-only NumPy view of memory owned by `owner`. The array holds a
+// reference to owner, so the memory stays alive as long as the view does.
+template <typename T>
+py::array_t<T> readOnlyView(const std::vector<py::ssize_t>& shape,
+                            const std::vector<py::ssize_t>& strides,
+                            const T* data, py::handle owner) {
+    py::array_t<T> view(shape, strides, data, owner);
+    view.attr("flags").attr("writeable") = false;
+    return view;
+}
+
+template <typename T>
+py::array_t<T> readOnlyView(const std::vector<T>& values, py::handle owner) {
+    return readOnlyView<T>({static_cast<py::ssize_t>(values.size())},
+                           {static_cast<py::ssize_t>(sizeof(T))}, values.data(), owner);
+}
+
+// NumPy copy of a vector the owner may reallocate (a tour or a history
+// that grows with every run), which a view would leave dangling
+template <typename T>
+py::array_t<T> arrayCopy(const std::vector<T>& values) {
+    return py::array_t<T>(static_cast<py::ssize_t>(values.size()), values.data());
+}
+
+// (n, 2) view of the city coordinates: City stores x and y adjacently
+py::array_t<double> coordinatesView(const Graph& graph, py::handle owner) {
+    const std::vector<City>& cities = graph.getCities();
+    const double* data = cities.empty() ? nullptr : cities.front().getCoordinates();
+    return readOnlyView<double>({static_cast<py::ssize_t>(cities.size()), 2},
+                                {static_cast<py::ssize_t>(sizeof(City)),
+                                 static_cast<py::ssize_t>(sizeof(double))},
+                                data, owner);
+}
+
+// (n, n) distance matrix: a view of the padded rows for the full layouts,
+// a newly computed float64 array for the triangular and on-the-fly ones
+py::array distanceMatrix(const Graph& graph, py::handle owner) {
+    const py::ssize_t n = graph.getNumCities();
+    const py::ssize_t stride = static_cast<py::ssize_t>(graph.getDistanceRowStride());
+    switch (graph.getDistanceStorage()) {
+        case DistanceStorage::FULL_DOUBLE:
+            return readOnlyView<double>({n, n}, {stride * static_cast<py::ssize_t>(sizeof(double)),
+                                                 static_cast<py::ssize_t>(sizeof(double))},
+                                        graph.getDistanceData(), owner);
+        case DistanceStorage::FULL_FLOAT:
+            return readOnlyView<float>({n, n}, {stride * static_cast<py::ssize_t>(sizeof(float)),
+                                                static_cast<py::ssize_t>(sizeof(float))},
+                                       graph.getDistanceFloatData(), owner);
+        default:
+            break;
+    }
+
+    py::array_t<double> matrix({n, n});
+    double* out = matrix.mutable_data();
+    {
+        py::gil_scoped_release release;
+        for (py::ssize_t i = 0; i < n; ++i) {
+            for (py::ssize_t j = 0; j < n; ++j) {
+                out[i * n + j] = graph.getDistanceUnchecked(static_cast<int>(i),
+                                                            static_cast<int>(j));
+            }
+        }
+    }
+    return matrix;
+}
+
+// Graph from an (n, 2) coordinate array (kind "coords") or an (n, n)
+// distance matrix (kind "distances"). The kind is never guessed from the
+// shape: a 2x2 array is both, and a matrix that is not a valid distance
+// matrix is rejected instead of being cut down to its upper triangle.
+std::shared_ptr<Graph> graphFromArray(
+        py::array_t<double, py::array::c_style | py::array::forcecast> values,
+        const std::string& kind, DistanceStorage storage, DistanceMetric metric) {
+    if (kind != "coords" && kind != "distances") {
+        throw std::invalid_argument("kind must be 'coords' or 'distances'");
+    }
+    if (values.ndim() != 2) {
+        throw std::invalid_argument("Graph array must be 2-D: (n, 2) coordinates or (n, n) distances");
+    }
+    const py::ssize_t rows = values.shape(0);
+    const py::ssize_t cols = values.shape(1);
+    auto data = values.unchecked<2>();
+
+    if (kind == "distances") {
+        if (rows != cols) {
+            throw std::invalid_argument("Distance matrix must have shape (n, n)");
+        }
+        // Symmetric with a zero diagonal (up to rounding of the input)
+        auto differs = [](double a, double b) {
+            return std::abs(a - b) > 1e-9 * std::max(1.0, std::max(std::abs(a), std::abs(b)));
+        };
+        for (py::ssize_t i = 0; i < rows; ++i) {
+            if (differs(data(i, i), 0.0)) {
+                throw std::invalid_argument("Distance matrix diagonal must be zero (entry " +
+                                            std::to_string(i) + ")");
+            }
+            for (py::ssize_t j = i + 1; j < rows; ++j) {
+                if (differs(data(i, j), data(j, i))) {
+                    throw std::invalid_argument("Distance matrix must be symmetric (entries " +
+                                                std::to_string(i) + ", " + std::to_string(j) + ")");
+                }
+            }
+        }
+
+        // Explicit distances, upper triangle row by row
+        const int n = static_cast<int>(rows);
+        std::vector<double> upper;
+        upper.reserve(static_cast<std::size_t>(rows) * (rows > 0 ? rows - 1 : 0) / 2);
+        for (py::ssize_t i = 0; i < rows; ++i) {
+            for (py::ssize_t j = i + 1; j < rows; ++j) {
+                upper.push_back(data(i, j));
+            }
+        }
+        py::gil_scoped_release release;
+        std::vector<City> cities = TSPLoader::syntheticCities(n, upper);
+        return std::make_shared<Graph>(cities, std::move(upper), storage);
+    }
+    if (cols != 2) {
+        throw std::invalid_argument("Coordinate array must have shape (n, 2)");
+    }
+
+    std::vector<City> cities;
+    cities.reserve(static_cast<std::size_t>(rows));
+    for (py::ssize_t i = 0; i < rows; ++i) {
+        cities.emplace_back(static_cast<int>(i), data(i, 0), data(i, 1));
+    }
+    py::gil_scoped_release release;
+    return std::make_shared<Graph>(cities, storage, metric);
+}
+
+// Solver pools are destroyed without the GIL: the destructor waits for
+// running jobs, whose Python configure callbacks need the GIL to finish
+struct ReleaseGilDeleter {
+    void operator()(SolverPool* pool) const {
+        py::gil_scoped_release release;
+        delete pool;
+    }
+};
+
+}  // namespace
+
 PYBIND11_MODULE(aco_solver, m) {
     m.doc() = "Ant Colony Optimization TSP Solver Python Bindings";
 
@@ -38,11 +192,51 @@ PYBIND11_MODULE(aco_solver, m) {
                    " y=" + std::to_string(c.getY()) + ">";
         });
 
-    // Graph class
-    py::class_<Graph>(m, "Graph")
+    // Distance matrix storage layouts
+    py::enum_<DistanceStorage>(m, "DistanceStorage")
+        .value("FULL_DOUBLE", DistanceStorage::FULL_DOUBLE)
+        .value("FULL_FLOAT", DistanceStorage::FULL_FLOAT)
+        .value("TRIANGULAR_DOUBLE", DistanceStorage::TRIANGULAR_DOUBLE)
+        .value("TRIANGULAR_FLOAT", DistanceStorage::TRIANGULAR_FLOAT)
+        .value("ON_THE_FLY", DistanceStorage::ON_THE_FLY);
+
+    // Distance metrics (TSPLIB edge weight types)
+    py::enum_<DistanceMetric>(m, "DistanceMetric")
+        .value("EUCLIDEAN", DistanceMetric::EUCLIDEAN)
+        .value("EUC_2D", DistanceMetric::EUC_2D)
+        .value("CEIL_2D", DistanceMetric::CEIL_2D)
+        .value("GEO", DistanceMetric::GEO)
+        .value("ATT", DistanceMetric::ATT)
+        .value("EXPLICIT", DistanceMetric::EXPLICIT);
+
+    // Graph class (held by shared_ptr so colonies can share it without copying)
+    py::class_<Graph, std::shared_ptr<Graph>>(m, "Graph")
         .def(py::init<const std::vector<City>&>(),
              py::arg("cities"),
              "Construct graph from list of cities")
+        .def(py::init<const std::vector<City>&, DistanceStorage, DistanceMetric>(),
+             py::arg("cities"),
+             py::arg("storage"),
+             py::arg("metric") = DistanceMetric::EUCLIDEAN,
+             "Construct graph with a specific distance matrix layout and metric")
+        .def(py::init<const std::vector<City>&, std::vector<double>, DistanceStorage>(),
+             py::arg("cities"),
+             py::arg("upperTriangle"),
+             py::arg("storage") = DistanceStorage::FULL_DOUBLE,
+             "Construct graph from explicit distances (strict upper triangle, row by row)")
+        .def(py::init(&graphFromArray),
+             py::arg("array"),
+             py::arg("kind"),
+             py::arg("storage") = DistanceStorage::FULL_DOUBLE,
+             py::arg("metric") = DistanceMetric::EUCLIDEAN,
+             "Construct graph from a NumPy array\n\n"
+             "Parameters:\n"
+             "  array: (n, 2) coordinates (city i = row i) or (n, n) distances\n"
+             "  kind: 'coords' or 'distances' (required, never guessed from the shape).\n"
+             "        Distances must be symmetric with a zero diagonal (ValueError\n"
+             "        otherwise); they use the EXPLICIT metric and synthetic display\n"
+             "        coordinates\n"
+             "  storage, metric: As for the City-list constructor (metric: coords only)")
         .def(py::init<>(),
              "Construct empty graph")
         .def("getDistance", &Graph::getDistance,
@@ -51,16 +245,46 @@ PYBIND11_MODULE(aco_solver, m) {
              "Get distance between two cities (O(1) lookup)")
         .def("getNumCities", &Graph::getNumCities,
              "Get total number of cities")
+        .def("getDistanceStorage", &Graph::getDistanceStorage,
+             "Get distance matrix layout")
+        .def("getDistanceMetric", &Graph::getDistanceMetric,
+             "Get distance metric")
+        .def("getDistanceMemoryBytes", &Graph::getDistanceMemoryBytes,
+             "Get size of the distance matrix in bytes")
         .def("getCity", &Graph::getCity,
              py::arg("index"),
              "Get city by index")
         .def("getCities", &Graph::getCities,
              "Get all cities as a list")
+        .def("getCoordinatesArray", [](py::object self) {
+                 return coordinatesView(self.cast<const Graph&>(), self);
+             },
+             "Read-only (n, 2) float64 view of the city coordinates (no copy)")
+        .def("getDistanceMatrixArray", [](py::object self) {
+                 return distanceMatrix(self.cast<const Graph&>(), self);
+             },
+             "(n, n) distance matrix: a read-only view for FULL_DOUBLE (float64) and\n"
+             "FULL_FLOAT (float32), a computed float64 copy for the other layouts")
         .def("isValid", &Graph::isValid,
              "Check if graph has cities")
         .def("nearestNeighborTourLength", &Graph::nearestNeighborTourLength,
              py::arg("startCity") = 0,
              "Calculate tour length using greedy nearest neighbor heuristic")
+        .def("buildNeighborLists", &Graph::buildNeighborLists,
+             py::arg("k"),
+             "Precompute the k nearest neighbors of every city")
+        .def("getNeighbors", [](const Graph &g, int city) {
+                 const int* neighbors = g.getNeighbors(city);
+                 return std::vector<int>(neighbors, neighbors + g.getNeighborListSize());
+             },
+             py::arg("city"),
+             "Get the nearest-neighbor list of a city (nearest first)")
+        .def("getNeighborListSize", &Graph::getNeighborListSize,
+             "Get number of neighbors stored per city (0 if not built)")
+        .def("getNeighborListStride", &Graph::getNeighborListStride,
+             "Get distance between consecutive cities' neighbor lists")
+        .def("isMapped", &Graph::isMapped,
+             "Check if the graph reads from a memory-mapped cache file")
         .def("__repr__", [](const Graph &g) {
             return "<Graph cities=" + std::to_string(g.getNumCities()) + ">";
         });
@@ -73,7 +297,7 @@ PYBIND11_MODULE(aco_solver, m) {
              py::arg("sequence"),
              py::arg("distance"),
              "Construct tour with sequence and distance")
-        .def("setTour", &Tour::setTour,
+        .def("setTour", static_cast<void (Tour::*)(const std::vector<int>&, double)>(&Tour::setTour),
              py::arg("sequence"),
              py::arg("distance"),
              "Set tour sequence and distance")
@@ -81,6 +305,10 @@ PYBIND11_MODULE(aco_solver, m) {
              "Get total tour distance")
         .def("getSequence", &Tour::getSequence,
              "Get city visit sequence")
+        .def("getSequenceArray", [](const Tour& self) {
+                 return arrayCopy(self.getSequence());
+             },
+             "int32 copy of the city visit sequence")
         .def("validate", &Tour::validate,
              py::arg("numCities"),
              "Verify tour visits all cities exactly once")
@@ -95,15 +323,30 @@ PYBIND11_MODULE(aco_solver, m) {
              py::arg("filename"),
              "Construct loader for TSP file (auto-searches data/ directories)")
         .def("loadGraph", &TSPLoader::loadGraph,
-             "Load graph from file (auto-detects format)")
+             py::arg("storage") = DistanceStorage::FULL_DOUBLE,
+             "Load graph from file (auto-detects format, uses a fresh binary cache)")
+        .def("setCacheDirectory", &TSPLoader::setCacheDirectory,
+             py::arg("directory"),
+             "Set directory for binary cache files ('' = next to the instance file)")
+        .def("setWriteCache", &TSPLoader::setWriteCache,
+             py::arg("enabled"),
+             "Write a binary cache after parsing an instance")
+        .def("getCachePath", &TSPLoader::getCachePath,
+             py::arg("storage") = DistanceStorage::FULL_DOUBLE,
+             "Get path of the binary cache file for a storage layout")
+        .def("wasLoadedFromCache", &TSPLoader::wasLoadedFromCache,
+             "Check if the last loadGraph() mapped a binary cache")
         .def_static("loadFromCoordinates", &TSPLoader::loadFromCoordinates,
              py::arg("filename"),
+             py::arg("storage") = DistanceStorage::FULL_DOUBLE,
              "Load graph from coordinate file")
         .def_static("loadFromDistanceMatrix", &TSPLoader::loadFromDistanceMatrix,
              py::arg("filename"),
+             py::arg("storage") = DistanceStorage::FULL_DOUBLE,
              "Load graph from distance matrix file")
         .def_static("loadFromTSPLIB", &TSPLoader::loadFromTSPLIB,
              py::arg("filename"),
+             py::arg("storage") = DistanceStorage::FULL_DOUBLE,
              "Load graph from TSPLIB format file");
 
     // PheromoneMatrix class
@@ -139,6 +382,12 @@ PYBIND11_MODULE(aco_solver, m) {
         .def("getMaxPheromone", &PheromoneMatrix::getMaxPheromone,
              "Get maximum pheromone bound");
 
+    // Local search move families
+    py::enum_<LocalSearchOperator>(m, "LocalSearchOperator")
+        .value("EXHAUSTIVE", LocalSearchOperator::EXHAUSTIVE)
+        .value("NEIGHBOR_LIST", LocalSearchOperator::NEIGHBOR_LIST)
+        .value("LIN_KERNIGHAN", LocalSearchOperator::LIN_KERNIGHAN);
+
     // LocalSearch class (static methods only)
     py::class_<LocalSearch>(m, "LocalSearch")
         .def_static("twoOpt", &LocalSearch::twoOpt,
@@ -159,7 +408,52 @@ PYBIND11_MODULE(aco_solver, m) {
              "  graph: Graph with distance information\n\n"
              "Returns:\n"
              "  True if improvement was made, False if already at local optimum")
-        .def_static("improve", &LocalSearch::improve,
+        .def_static("twoOptNeighbor",
+             [](Tour& tour, const Graph& graph) {
+                 return LocalSearch::twoOptNeighbor(tour, graph, NeighborLists::fromGraph(graph));
+             },
+             py::arg("tour"),
+             py::arg("graph"),
+             "Improve tour using neighbor-list 2-opt with don't-look bits\n\n"
+             "Uses the lists from graph.buildNeighborLists(k); falls back to\n"
+             "exhaustive 2-opt if none were built.\n\n"
+             "Returns:\n"
+             "  True if improvement was made")
+        .def_static("orOpt",
+             [](Tour& tour, const Graph& graph) {
+                 return LocalSearch::orOpt(tour, graph, NeighborLists::fromGraph(graph));
+             },
+             py::arg("tour"),
+             py::arg("graph"),
+             "Improve tour by moving segments of 1-3 cities (neighbor-list Or-opt)\n\n"
+             "Uses the lists from graph.buildNeighborLists(k); does nothing\n"
+             "if none were built.\n\n"
+             "Returns:\n"
+             "  True if improvement was made")
+        .def_static("threeOptNeighbor",
+             [](Tour& tour, const Graph& graph) {
+                 return LocalSearch::threeOptNeighbor(tour, graph, NeighborLists::fromGraph(graph));
+             },
+             py::arg("tour"),
+             py::arg("graph"),
+             "Improve tour using neighbor-list segment-insertion 3-opt (or-3opt)\n\n"
+             "Uses the lists from graph.buildNeighborLists(k); falls back to\n"
+             "exhaustive 3-opt if none were built.\n\n"
+             "Returns:\n"
+             "  True if improvement was made")
+        .def_static("linKernighan",
+             [](Tour& tour, const Graph& graph) {
+                 return LocalSearch::linKernighan(tour, graph, NeighborLists::fromGraph(graph));
+             },
+             py::arg("tour"),
+             py::arg("graph"),
+             "Improve tour using Lin-Kernighan-style variable-depth search\n\n"
+             "Uses the lists from graph.buildNeighborLists(k); falls back to\n"
+             "exhaustive 2-opt if none were built.\n\n"
+             "Returns:\n"
+             "  True if improvement was made")
+        .def_static("improve",
+             static_cast<bool (*)(Tour&, const Graph&, bool)>(&LocalSearch::improve),
              py::arg("tour"),
              py::arg("graph"),
              py::arg("use3opt") = true,
@@ -177,31 +471,118 @@ PYBIND11_MODULE(aco_solver, m) {
              py::arg("startCity"),
              py::arg("numCities"),
              "Construct ant starting at specified city")
+        .def(py::init<int, int, std::uint64_t>(),
+             py::arg("startCity"),
+             py::arg("numCities"),
+             py::arg("seed"),
+             "Construct ant with a reproducible random stream")
+        .def("setSeed", &Ant::setSeed,
+             py::arg("seed"),
+             "Restart the ant's random stream from a seed")
         .def("reset", &Ant::reset,
              py::arg("startCity"),
              "Reset ant to start new tour from specified city")
-        .def("selectNextCity", &Ant::selectNextCity,
+        .def("selectNextCity",
+             static_cast<int (Ant::*)(const Graph&, const PheromoneMatrix&, double, double)>(
+                 &Ant::selectNextCity),
              py::arg("graph"),
              py::arg("pheromones"),
              py::arg("alpha"),
              py::arg("beta"),
              "Choose next city probabilistically")
+        .def("selectNextCityFromCandidates",
+             [](Ant &ant, const Graph &graph, const PheromoneMatrix &pheromones,
+                double alpha, double beta) {
+                 return ant.selectNextCityFromCandidates(
+                     graph, pheromones, alpha, beta,
+                     graph.getNeighbors(ant.getCurrentCity()), graph.getNeighborListSize());
+             },
+             py::arg("graph"),
+             py::arg("pheromones"),
+             py::arg("alpha"),
+             py::arg("beta"),
+             "Choose next city among the graph's nearest-neighbor candidates\n\n"
+             "Requires graph.buildNeighborLists(k) to have been called")
         .def("visitCity", &Ant::visitCity,
              py::arg("city"),
              py::arg("graph"),
              "Add city to tour")
         .def("hasVisitedAll", &Ant::hasVisitedAll,
              "Check if tour is complete")
-        .def("completeTour", &Ant::completeTour,
+        .def("completeTour", static_cast<Tour (Ant::*)(const Graph&)>(&Ant::completeTour),
              py::arg("graph"),
              "Finalize and return the tour")
         .def("calculateTourLength", &Ant::calculateTourLength,
              py::arg("graph"),
              "Calculate total tour distance");
 
+    // Profiling results (AntColony.setProfiling / getStats)
+    py::class_<PhaseStats>(m, "PhaseStats")
+        .def(py::init<>())
+        .def_readonly("construction", &PhaseStats::construction,
+                      "Seconds spent building tours")
+        .def_readonly("localSearch", &PhaseStats::localSearch,
+                      "Seconds spent in local search")
+        .def_readonly("selection", &PhaseStats::selection,
+                      "Seconds spent finding the iteration best and updating the best-so-far tour")
+        .def_readonly("deposit", &PhaseStats::deposit,
+                      "Seconds spent choosing depositing tours and buffering their deposits")
+        .def_readonly("evaporation", &PhaseStats::evaporation,
+                      "Seconds spent in the fused evaporate/deposit/clamp pass")
+        .def_readonly("localSearchMoves", &PhaseStats::localSearchMoves,
+                      "Improving local search moves applied")
+        .def_readonly("localSearchEvaluations", &PhaseStats::localSearchEvaluations,
+                      "Local search move deltas evaluated")
+        .def_readonly("candidateFallbacks", &PhaseStats::candidateFallbacks,
+                      "Construction steps that found every candidate visited")
+        .def("totalSeconds", &PhaseStats::totalSeconds,
+             "Sum of the phase times")
+        .def("toDict", [](const PhaseStats& stats) {
+            py::dict result;
+            result["construction"] = stats.construction;
+            result["localSearch"] = stats.localSearch;
+            result["selection"] = stats.selection;
+            result["deposit"] = stats.deposit;
+            result["evaporation"] = stats.evaporation;
+            result["localSearchMoves"] = stats.localSearchMoves;
+            result["localSearchEvaluations"] = stats.localSearchEvaluations;
+            result["candidateFallbacks"] = stats.candidateFallbacks;
+            return result;
+        }, "Phase times (seconds) and counters as a dict");
+
+    py::class_<ColonyStats>(m, "ColonyStats")
+        .def_readonly("total", &ColonyStats::total,
+                      "Sum over all profiled iterations")
+        .def_readonly("iterations", &ColonyStats::iterations,
+                      "One PhaseStats per iteration");
+
+    // Incremental progress (AntColony.setIncrementalCallback)
+    py::class_<ProgressUpdate>(m, "ProgressUpdate")
+        .def_readonly("iteration", &ProgressUpdate::iteration,
+                      "Iterations completed")
+        .def_readonly("bestDistance", &ProgressUpdate::bestDistance,
+                      "Best-so-far tour length")
+        .def_readonly("tourImproved", &ProgressUpdate::tourImproved,
+                      "Whether the best tour changed since the previous update")
+        .def_readonly("bestTour", &ProgressUpdate::bestTour,
+                      "New best tour (empty unless tourImproved)")
+        .def_readonly("convergenceOffset", &ProgressUpdate::convergenceOffset,
+                      "Iteration index of newConvergence[0]")
+        .def_readonly("newConvergence", &ProgressUpdate::newConvergence,
+                      "Iteration bests since the previous update")
+        .def_readonly("profile", &ProgressUpdate::profile,
+                      "Profile totals so far (zero unless profiling is enabled)")
+        .def_readonly("final", &ProgressUpdate::final,
+                      "Whether this is the last update of the run");
+
     // AntColony class with callback support
     py::class_<AntColony>(m, "AntColony")
-        .def(py::init<const Graph&, int, double, double, double, double, bool>(),
+        .def(py::init([](std::shared_ptr<Graph> graph, int numAnts, double alpha, double beta,
+                         double rho, double Q, bool useDistinctStartCities) {
+                 // Share the Python-owned graph instead of copying its distance matrix
+                 return new AntColony(std::shared_ptr<const Graph>(std::move(graph)), numAnts,
+                                      alpha, beta, rho, Q, useDistinctStartCities);
+             }),
              py::arg("graph"),
              py::arg("numAnts") = 20,
              py::arg("alpha") = 1.0,
@@ -211,7 +592,7 @@ PYBIND11_MODULE(aco_solver, m) {
              py::arg("useDistinctStartCities") = false,
              "Construct ant colony optimizer\n\n"
              "Parameters:\n"
-             "  graph: TSP problem instance\n"
+             "  graph: TSP problem instance (shared, not copied)\n"
              "  numAnts: Number of ants in colony (default: 20)\n"
              "  alpha: Pheromone importance factor (default: 1.0)\n"
              "  beta: Heuristic importance factor (default: 2.0)\n"
@@ -236,13 +617,90 @@ PYBIND11_MODULE(aco_solver, m) {
              "  callback: Optional progress callback function\n\n"
              "Returns:\n"
              "  Best tour found")
+        .def("setTimeLimit", &AntColony::setTimeLimit,
+             py::arg("seconds"),
+             "Stop solve() after this many seconds (default: 0 = no limit)")
+        .def("getTimeLimit", &AntColony::getTimeLimit)
+        .def("setTargetDistance", &AntColony::setTargetDistance,
+             py::arg("distance"),
+             "Stop solve() once a tour of at most this length is found (default: 0 = none)")
+        .def("getTargetDistance", &AntColony::getTargetDistance)
+        .def("requestStop", &AntColony::requestStop,
+             "Ask solve() (e.g. running in another thread) to return after the current\n"
+             "iteration; a request made before solve() starts stops it before the first")
+        .def("getStopReason", &AntColony::getStopReason,
+             "Why the last solve() returned: 'iterations', 'convergence', 'time-limit',\n"
+             "'target' or 'stopped'")
+        .def("getBestTourSnapshot", &AntColony::getBestTourSnapshot,
+             py::call_guard<py::gil_scoped_release>(),
+             "Copy of the best tour so far, safe to call while solve() runs in another thread")
+        .def("getCompletedIterations", &AntColony::getCompletedIterations,
+             "Iterations completed by the current (or last) solve()")
         .def("getBestTour", &AntColony::getBestTour,
              "Get best solution found")
+        .def("importTour", &AntColony::importTour,
+             py::arg("tour"),
+             "Adopt a tour found elsewhere (e.g. by another colony)\n\n"
+             "If it is shorter than the best-so-far tour it replaces it and its\n"
+             "edges receive one best-tour deposit; otherwise it is ignored")
+        .def("checkpoint", &AntColony::checkpoint,
+             py::arg("path"),
+             py::call_guard<py::gil_scoped_release>(),
+             "Save the search state (trails, best tour, history, random stream,\n"
+             "parameters) to a binary file\n\n"
+             "Returns False if nothing was solved yet or the file cannot be written")
+        .def("restore", &AntColony::restore,
+             py::arg("path"),
+             py::call_guard<py::gil_scoped_release>(),
+             "Load a checkpoint of this instance; the next solve() continues from it\n\n"
+             "maxIterations counts the restored iterations too, so solve(N) ends at\n"
+             "iteration N. Returns False (colony unchanged) for a missing, corrupt or\n"
+             "foreign file")
+        .def("hasRestoredState", &AntColony::hasRestoredState,
+             "Whether the next solve() resumes a restored checkpoint")
+        .def("setCheckpointFile", &AntColony::setCheckpointFile,
+             py::arg("path"),
+             py::arg("interval") = 100,
+             "Checkpoint to path every interval iterations and when solve() returns\n\n"
+             "An empty path disables automatic checkpoints; interval 0 writes only at the end")
+        .def("getCheckpointFile", &AntColony::getCheckpointFile)
+        .def("setWarmStartTour", &AntColony::setWarmStartTour,
+             py::arg("sequence"),
+             "Start every solve() from this tour (a permutation of the cities)\n\n"
+             "It becomes the best-so-far tour and its edges receive one best-tour\n"
+             "deposit. Returns False (and clears the warm start) for an invalid sequence")
+        .def("getWarmStartTour", &AntColony::getWarmStartTour)
         .def("getConvergenceData", &AntColony::getConvergenceData,
              "Get iteration history")
+        .def("getConvergenceArray", [](const AntColony& self) {
+                 return arrayCopy(self.getConvergenceData());
+             },
+             "float64 copy of the iteration history")
+        .def("setProfiling", &AntColony::setProfiling,
+             py::arg("profiling"),
+             "Record per-phase timings and work counters of every iteration\n\n"
+             "Default: False (no clocks are read)")
+        .def("getProfiling", &AntColony::getProfiling)
+        .def("getStats", &AntColony::getStats,
+             py::return_value_policy::copy,
+             "Profile collected since the last solve() started (ColonyStats)\n\n"
+             "Can be called from the progress callback to follow the run")
         .def("setProgressCallback", &AntColony::setProgressCallback,
              py::arg("callback"),
              "Set progress callback function")
+        .def("setIncrementalCallback", &AntColony::setIncrementalCallback,
+             py::arg("callback"),
+             py::arg("asynchronous") = false,
+             "Set an incremental progress callback, called with a ProgressUpdate\n\n"
+             "Each update holds only the iteration bests since the previous one,\n"
+             "and the best tour only when it improved. A last update (final=True)\n"
+             "follows when solve() ends.\n\n"
+             "Parameters:\n"
+             "  callback: Function taking one ProgressUpdate\n"
+             "  asynchronous: Call it on a separate thread (default: False). solve()\n"
+             "                then never waits for Python while solving; updates the\n"
+             "                callback has not taken yet are merged, and exceptions\n"
+             "                it raises are re-raised by solve()")
         .def("setCallbackInterval", &AntColony::setCallbackInterval,
              py::arg("interval"),
              "Set callback interval (default: 10 iterations)")
@@ -275,7 +733,23 @@ PYBIND11_MODULE(aco_solver, m) {
              py::arg("mode"),
              "Set when to apply local search\n\n"
              "Parameters:\n"
-             "  mode: 'best' (only best tour), 'all' (all ant tours), or 'none' (default: 'best')")
+             "  mode: 'best' (only best tour), 'all' (all ant tours), 'top-k' (k shortest\n"
+             "        tours of each iteration, one per thread), or 'none' (default: 'best')")
+        .def("setLocalSearchTopK", &AntColony::setLocalSearchTopK,
+             py::arg("k"),
+             "Set the number of tours improved per iteration in 'top-k' mode\n\n"
+             "Parameters:\n"
+             "  k: Tours improved per iteration (default: 0 = number of threads)")
+        .def("getLocalSearchTopK", &AntColony::getLocalSearchTopK)
+        .def("setLocalSearchOperator", &AntColony::setLocalSearchOperator,
+             py::arg("op"),
+             "Set the local search move family\n\n"
+             "Parameters:\n"
+             "  op: 'exhaustive' (full-scan 2-opt/3-opt, default),\n"
+             "      'neighbor' (neighbor-list 2-opt, Or-opt and or-3opt) or\n"
+             "      'lk' (Lin-Kernighan-style variable-depth search)")
+        .def("getLocalSearchOperator", &AntColony::getLocalSearchOperator,
+             "Get the local search move family")
         .def("setUseElitist", &AntColony::setUseElitist,
              py::arg("useElitist"),
              "Enable/disable elitist pheromone strategy\n\n"
@@ -296,13 +770,71 @@ PYBIND11_MODULE(aco_solver, m) {
              "    - 'all': All ants deposit pheromones (classic Ant Cycle, default)\n"
              "    - 'best-iteration': Only iteration-best ant deposits\n"
              "    - 'best-so-far': Only global-best tour deposits\n"
-             "    - 'rank': Top-k ants deposit with decreasing weights")
+             "    - 'rank': Top-k ants deposit with decreasing weights\n"
+             "    - 'mmas': MAX-MIN Ant System (single depositor, trails bounded by\n"
+             "      tau_min/tau_max, reset to tau_max on stagnation)\n"
+             "    - 'acs': Ant Colony System (q0 exploitation, local updates while\n"
+             "      building tours, global update of the best-so-far tour only)")
         .def("setRankSize", &AntColony::setRankSize,
              py::arg("rankSize"),
              "Set number of elite ants for rank-based mode\n\n"
              "Parameters:\n"
              "  rankSize: Number of top ants that deposit pheromones (default: numAnts/2)\n\n"
              "Note: Only effective when pheromoneMode is 'rank'")
+        .def("setMMASRestartIterations", &AntColony::setMMASRestartIterations,
+             py::arg("iterations"),
+             "Set the MMAS stagnation length that triggers a trail reset\n\n"
+             "Parameters:\n"
+             "  iterations: Iterations without improvement before all trails are\n"
+             "              reset to tau_max (default: 100, 0 = never)\n\n"
+             "Note: Only effective when pheromoneMode is 'mmas'")
+        .def("getMMASRestartIterations", &AntColony::getMMASRestartIterations)
+        .def("getPheromoneMode", &AntColony::getPheromoneMode)
+        .def("setQ0", &AntColony::setQ0,
+             py::arg("q0"),
+             "Set the ACS exploitation probability\n\n"
+             "Parameters:\n"
+             "  q0: Probability of taking the best edge instead of roulette\n"
+             "      selection, in [0, 1] (default: 0.9)\n\n"
+             "Note: Only effective when pheromoneMode is 'acs'")
+        .def("getQ0", &AntColony::getQ0)
+        .def("setXi", &AntColony::setXi,
+             py::arg("xi"),
+             "Set the ACS local pheromone update rate\n\n"
+             "Parameters:\n"
+             "  xi: Rate of tau <- (1 - xi) * tau + xi * tau0 on every traversed\n"
+             "      edge, in [0, 1] (default: 0.1)\n\n"
+             "Note: Only effective when pheromoneMode is 'acs'")
+        .def("getXi", &AntColony::getXi)
+        .def("setBackend", &AntColony::setBackend,
+             py::arg("backend"),
+             "Set the execution backend\n\n"
+             "Parameters:\n"
+             "  backend: 'cpu' (default) or 'cuda' (tour construction and pheromone\n"
+             "           updates on the GPU; only the needed tours are copied back)\n\n"
+             "Note: no build includes the 'cuda' device code yet, so solve() raises\n"
+             "for it (see isBackendAvailable()); it will support neither 'acs' nor\n"
+             "candidate lists")
+        .def("getBackend", &AntColony::getBackend)
+        .def_static("isBackendAvailable", &AntColony::isBackendAvailable,
+                    py::arg("backend"),
+                    "Whether a backend ('cpu' or 'cuda') can run in this build")
+        .def("setCandidateListSize", &AntColony::setCandidateListSize,
+             py::arg("candidateListSize"),
+             "Set candidate list size for tour construction\n\n"
+             "Parameters:\n"
+             "  candidateListSize: Nearest neighbors considered per step (0 = all cities, default)\n\n"
+             "Reduces tour construction from O(n^2) to roughly O(n*k) per ant")
+        .def("getCandidateListSize", &AntColony::getCandidateListSize,
+             "Get candidate list size (0 = disabled)")
+        .def("setSeed", &AntColony::setSeed,
+             py::arg("seed"),
+             "Seed the random number generators\n\n"
+             "Parameters:\n"
+             "  seed: Non-negative integer; the same seed gives the same run\n\n"
+             "Each ant draws from its own stream derived from this seed")
+        .def("getSeed", &AntColony::getSeed,
+             "Get the seed of the current run (random unless setSeed was called)")
         .def("getNumAnts", &AntColony::getNumAnts,
              "Get number of ants")
         .def("getAlpha", &AntColony::getAlpha,
@@ -318,4 +850,233 @@ PYBIND11_MODULE(aco_solver, m) {
                    " alpha=" + std::to_string(ac.getAlpha()) +
                    " beta=" + std::to_string(ac.getBeta()) + ">";
         });
+
+    // MultiColony class (island model)
+    py::class_<MultiColony>(m, "MultiColony")
+        .def(py::init([](std::shared_ptr<Graph> graph, int numColonies, int numAnts, double alpha,
+                         double beta, double rho, double Q, bool useDistinctStartCities) {
+                 // All colonies share the Python-owned graph
+                 return new MultiColony(std::shared_ptr<const Graph>(std::move(graph)), numColonies,
+                                        numAnts, alpha, beta, rho, Q, useDistinctStartCities);
+             }),
+             py::arg("graph"),
+             py::arg("numColonies") = 4,
+             py::arg("numAnts") = 20,
+             py::arg("alpha") = 1.0,
+             py::arg("beta") = 2.0,
+             py::arg("rho") = 0.5,
+             py::arg("Q") = 100.0,
+             py::arg("useDistinctStartCities") = false,
+             "Construct an island-model solver of independent colonies\n\n"
+             "Parameters:\n"
+             "  graph: TSP problem instance (shared by all colonies, not copied)\n"
+             "  numColonies: Number of colonies, run one per thread (default: 4)\n"
+             "  numAnts: Ants per colony (default: 20)\n"
+             "  alpha, beta, rho, Q: As for AntColony")
+        .def("configure", &MultiColony::configure,
+             py::arg("setup"),
+             "Apply the same settings to every colony\n\n"
+             "Parameters:\n"
+             "  setup: Function called with each AntColony, e.g.\n"
+             "         lambda colony: colony.setUseLocalSearch(True)")
+        .def("solve", &MultiColony::solve,
+             py::arg("maxIterations"),
+             py::arg("callback") = nullptr,
+             py::call_guard<py::gil_scoped_release>(),  // Release GIL during C++ computation
+             "Run all colonies with periodic best-tour migration\n\n"
+             "Parameters:\n"
+             "  maxIterations: Iterations per colony (or -1 for auto-convergence)\n"
+             "  callback: Optional progress callback (best over all colonies)\n\n"
+             "Returns:\n"
+             "  Best tour found by any colony")
+        .def("setSeed", &MultiColony::setSeed,
+             py::arg("seed"),
+             "Seed all colonies (each gets its own stream derived from this seed)")
+        .def("setMigrationInterval", &MultiColony::setMigrationInterval,
+             py::arg("iterations"),
+             "Set iterations between migrations (default: 10, 0 = never)")
+        .def("getMigrationInterval", &MultiColony::getMigrationInterval)
+        .def("setMigrationTopology", &MultiColony::setMigrationTopology,
+             py::arg("topology"),
+             "Set migration topology: 'ring' (default) or 'broadcast'")
+        .def("getMigrationTopology", &MultiColony::getMigrationTopology)
+        .def("setNumThreads", &MultiColony::setNumThreads,
+             py::arg("numThreads"),
+             "Set number of threads running colonies (0 = auto)")
+        .def("setProgressCallback", &MultiColony::setProgressCallback,
+             py::arg("callback"),
+             "Set progress callback function")
+        .def("setCallbackInterval", &MultiColony::setCallbackInterval,
+             py::arg("interval"),
+             "Set callback interval (default: 10 iterations)")
+        .def("setConvergenceThreshold", &MultiColony::setConvergenceThreshold,
+             py::arg("threshold"),
+             "Set convergence threshold (default: 200 iterations without improvement)")
+        .def("setTimeLimit", &MultiColony::setTimeLimit,
+             py::arg("seconds"),
+             "Wall-clock budget of solve() in seconds, setup included (default: 0 = none)")
+        .def("getTimeLimit", &MultiColony::getTimeLimit)
+        .def("setTargetDistance", &MultiColony::setTargetDistance,
+             py::arg("distance"),
+             "Stop solve() once any colony finds a tour of at most this length (default: 0 = none)")
+        .def("getTargetDistance", &MultiColony::getTargetDistance)
+        .def("requestStop", &MultiColony::requestStop,
+             "Ask solve() (e.g. running in another thread) to return after the colonies'\n"
+             "current iterations")
+        .def("getStopReason", &MultiColony::getStopReason,
+             "Why the last solve() returned: 'iterations', 'convergence', 'time-limit',\n"
+             "'target' or 'stopped'")
+        .def("getNumColonies", &MultiColony::getNumColonies)
+        .def("getColony", static_cast<AntColony& (MultiColony::*)(int)>(&MultiColony::getColony),
+             py::arg("index"),
+             py::return_value_policy::reference_internal,
+             "Get one colony (owned by the MultiColony)")
+        .def("getBestTour", &MultiColony::getBestTour,
+             "Get best solution found by any colony")
+        .def("getBestColony", &MultiColony::getBestColony,
+             "Get index of the colony that found the best tour")
+        .def("getConvergenceData", &MultiColony::getConvergenceData,
+             "Get per-iteration best over all colonies")
+        .def("getConvergenceArray", [](const MultiColony& self) {
+                 return arrayCopy(self.getConvergenceData());
+             },
+             "float64 copy of the per-iteration best over all colonies")
+        .def("getNumMigrations", &MultiColony::getNumMigrations,
+             "Get number of migrations in the last solve()")
+        .def("__repr__", [](const MultiColony &mc) {
+            return "<MultiColony colonies=" + std::to_string(mc.getNumColonies()) +
+                   " migrateEvery=" + std::to_string(mc.getMigrationInterval()) +
+                   " topology=" + mc.getMigrationTopology() + ">";
+        });
+
+    // Batch solving: many jobs on one shared thread pool
+    py::class_<SolverJob>(m, "SolverJob")
+        .def(py::init([](std::shared_ptr<Graph> graph, int numAnts, double alpha, double beta,
+                         double rho, double Q, int maxIterations, int threads, int priority,
+                         std::function<void(AntColony&)> configure) {
+                 SolverJob job;
+                 job.graph = std::move(graph);  // Shared with the caller, not copied
+                 job.numAnts = numAnts;
+                 job.alpha = alpha;
+                 job.beta = beta;
+                 job.rho = rho;
+                 job.Q = Q;
+                 job.maxIterations = maxIterations;
+                 job.threads = threads;
+                 job.priority = priority;
+                 job.configure = std::move(configure);
+                 return job;
+             }),
+             py::arg("graph"),
+             py::arg("numAnts") = 20,
+             py::arg("alpha") = 1.0,
+             py::arg("beta") = 2.0,
+             py::arg("rho") = 0.5,
+             py::arg("Q") = 100.0,
+             py::arg("maxIterations") = 100,
+             py::arg("threads") = 1,
+             py::arg("priority") = 0,
+             py::arg("configure") = nullptr,
+             "Describe one solve for a SolverPool\n\n"
+             "Parameters:\n"
+             "  graph: TSP problem instance (shared between jobs, not copied)\n"
+             "  maxIterations: Iterations (< 0: until convergence)\n"
+             "  threads: Thread budget of the job (clamped to the pool size)\n"
+             "  priority: Higher starts first, FIFO within a priority\n"
+             "  configure: Optional callable(colony) applying further settings;\n"
+             "             runs on a pool thread, thread settings are the pool's")
+        .def_property("graph",
+                      [](const SolverJob& job) { return std::const_pointer_cast<Graph>(job.graph); },
+                      [](SolverJob& job, std::shared_ptr<Graph> graph) { job.graph = std::move(graph); })
+        .def_readwrite("numAnts", &SolverJob::numAnts)
+        .def_readwrite("alpha", &SolverJob::alpha)
+        .def_readwrite("beta", &SolverJob::beta)
+        .def_readwrite("rho", &SolverJob::rho)
+        .def_readwrite("Q", &SolverJob::Q)
+        .def_readwrite("maxIterations", &SolverJob::maxIterations)
+        .def_readwrite("threads", &SolverJob::threads)
+        .def_readwrite("priority", &SolverJob::priority)
+        .def_readwrite("configure", &SolverJob::configure);
+
+    py::class_<SolverResult>(m, "SolverResult")
+        .def_readonly("tour", &SolverResult::tour,
+                      "Best tour found")
+        .def_readonly("convergence", &SolverResult::convergence,
+                      "Iteration bests")
+        .def_readonly("stopReason", &SolverResult::stopReason,
+                      "Why the solve ended (see AntColony.getStopReason)")
+        .def_readonly("waitSeconds", &SolverResult::waitSeconds,
+                      "Time spent queued")
+        .def_readonly("solveSeconds", &SolverResult::solveSeconds,
+                      "Time spent running");
+
+    py::class_<std::shared_future<SolverResult>>(m, "SolverFuture")
+        .def("result", [](const std::shared_future<SolverResult>& future) {
+                 {
+                     py::gil_scoped_release release;
+                     future.wait();
+                 }
+                 return future.get();  // Rethrows the job's exception
+             },
+             "Wait for the job and return its SolverResult")
+        .def("wait", [](const std::shared_future<SolverResult>& future, double timeout) {
+                 py::gil_scoped_release release;
+                 if (timeout < 0.0) {
+                     future.wait();
+                     return true;
+                 }
+                 return future.wait_for(std::chrono::duration<double>(timeout)) ==
+                        std::future_status::ready;
+             },
+             py::arg("timeout") = -1.0,
+             "Wait up to timeout seconds (< 0: no limit); True once the job is done")
+        .def("done", [](const std::shared_future<SolverResult>& future) {
+                 return future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+             },
+             "Check whether the job has finished");
+
+    py::class_<SolverPool, std::unique_ptr<SolverPool, ReleaseGilDeleter>>(m, "SolverPool")
+        .def(py::init<int>(),
+             py::arg("numThreads") = 0,
+             "Create a pool with numThreads thread slots (0 = one per hardware thread)")
+        .def("submit", [](SolverPool& pool, const SolverJob& job) {
+                 return pool.submit(job).share();
+             },
+             py::arg("job"),
+             "Queue a job and return its SolverFuture")
+        .def("waitIdle", &SolverPool::waitIdle,
+             py::call_guard<py::gil_scoped_release>(),
+             "Block until no job is queued or running")
+        .def("getNumThreads", &SolverPool::getNumThreads,
+             "Get number of thread slots")
+        .def("getQueuedJobs", &SolverPool::getQueuedJobs,
+             "Get number of jobs waiting to start")
+        .def("getRunningJobs", &SolverPool::getRunningJobs,
+             "Get number of jobs running")
+        .def("__repr__", [](const SolverPool &pool) {
+            return "<SolverPool threads=" + std::to_string(pool.getNumThreads()) +
+                   " queued=" + std::to_string(pool.getQueuedJobs()) +
+                   " running=" + std::to_string(pool.getRunningJobs()) + ">";
+        });
+
+    // NUMA placement (process-wide)
+    m.def("setFirstTouch", &numa::setFirstTouchEnabled,
+          py::arg("enabled"),
+          "Fill new matrices with the compute threads' static row blocks (default: True)\n\n"
+          "Spreads their pages over the NUMA nodes; False fills them on the calling thread");
+    m.def("getFirstTouch", &numa::isFirstTouchEnabled);
+    m.def("numaNodes", &numa::numNodes,
+          "Number of NUMA nodes this process can run on");
+    m.def("bindThreads", [](const std::string& binding, int numThreads) {
+              numa::ThreadBinding value;
+              if (!numa::parseThreadBinding(binding, value)) {
+                  throw std::invalid_argument("binding must be 'none', 'close' or 'spread'");
+              }
+              return numa::bindThreads(value, numThreads);
+          },
+          py::arg("binding"),
+          py::arg("numThreads") = 0,
+          py::call_guard<py::gil_scoped_release>(),
+          "Pin the OpenMP threads of the calling thread ('close' or 'spread', Linux)\n\n"
+          "Call before building graphs; returns False if binding is unavailable");
 }
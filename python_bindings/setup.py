@@ -20,7 +20,15 @@ cpp_sources = [
     '../cpp/src/PheromoneMatrix.cpp',
     '../cpp/src/Ant.cpp',
     '../cpp/src/AntColony.cpp',
+    '../cpp/src/MultiColony.cpp',
     '../cpp/src/LocalSearch.cpp',
+    '../cpp/src/MappedFile.cpp',
+    '../cpp/src/GraphCache.cpp',
+    '../cpp/src/SelectionKernels.cpp',
+    '../cpp/src/GpuColony.cpp',
+    '../cpp/src/ProgressReporter.cpp',
+    '../cpp/src/SolverPool.cpp',
+    '../cpp/src/NumaPlacement.cpp',
 ]
 
 # Compiler flags
@@ -67,5 +75,6 @@ setup(
     python_requires=">=3.7",
     install_requires=[
         "pybind11>=2.6.0",
+        "numpy>=1.16",
     ],
 )
@@ -9,9 +9,13 @@ This script tests all major functionality of the Python bindings:
 - Comparing results with C++ CLI
 """
 
+import os
 import sys
+import tempfile
 import time
 
+import numpy as np
+
 # Add python_bindings to path
 sys.path.insert(0, '/home/roger/dev/ant_colony/python_bindings')
 
@@ -77,7 +81,8 @@ def test_aco_with_callback(graph):
             'iteration': iteration,
             'best_distance': best_distance,
             'tour_length': len(best_tour),
-            'convergence_length': len(convergence)
+            'convergence_length': len(convergence),
+            'profiled_iterations': len(colony.getStats().iterations)
         })
         print(f"  Iteration {iteration:3d}: Best = {best_distance:.2f}, "
               f"Improvement = {convergence[0] - best_distance:.2f}")
@@ -96,7 +101,8 @@ def test_aco_with_callback(graph):
     print(f"Parameters: numAnts={colony.getNumAnts()}, "
           f"alpha={colony.getAlpha()}, beta={colony.getBeta()}")
 
-    # Set callback
+    # Set callback (with per-phase profiling, readable from the callback)
+    colony.setProfiling(True)
     colony.setProgressCallback(progress_callback)
     colony.setCallbackInterval(10)
 
@@ -115,6 +121,16 @@ def test_aco_with_callback(graph):
     assert len(callback_data) > 0, "Callback was never invoked"
     print(f"\n✓ Callback invoked {len(callback_data)} times")
 
+    # Verify profiling
+    assert all(d['profiled_iterations'] == d['iteration'] for d in callback_data), \
+        "Profile out of step with the callback"
+    stats = colony.getStats()
+    assert len(stats.iterations) == 100, "Profile length mismatch"
+    assert stats.total.construction > 0.0, "Construction was not timed"
+    profile = stats.total.toDict()
+    print(f"✓ Profile: construction {profile['construction'] * 1e3:.1f} ms, "
+          f"evaporation {profile['evaporation'] * 1e3:.1f} ms")
+
     # Verify convergence
     convergence = colony.getConvergenceData()
     assert len(convergence) == 100, "Convergence data length mismatch"
@@ -148,10 +164,181 @@ def test_tour_validation(graph):
     print("✓ Invalid tour fails validation\n")
 
 
+def test_incremental_callback(graph):
+    """Test incremental, asynchronous progress updates"""
+    print("=" * 60)
+    print("Test 5: Incremental Progress Callback")
+    print("=" * 60)
+
+    for asynchronous in (False, True):
+        history = []
+        state = {'tour': None, 'final': 0}
+
+        def on_update(update):
+            assert update.convergenceOffset == len(history), "Missed convergence points"
+            history.extend(update.newConvergence)
+            if update.tourImproved:
+                state['tour'] = list(update.bestTour)
+            if update.final:
+                state['final'] += 1
+
+        colony = aco_solver.AntColony(graph, numAnts=20)
+        colony.setSeed(7)
+        colony.setIncrementalCallback(on_update, asynchronous)
+        best_tour = colony.solve(50)
+
+        assert history == list(colony.getConvergenceData()), "History mismatch"
+        assert state['tour'] == list(best_tour.getSequence()), "Best tour mismatch"
+        assert state['final'] == 1, "Expected one final update"
+        mode = "asynchronous" if asynchronous else "synchronous"
+        print(f"✓ {mode}: {len(history)} convergence points, best {best_tour.getDistance():.2f}")
+    print()
+
+
+def test_numpy_interop(graph):
+    """Test zero-copy NumPy views and array-based graph construction"""
+    print("=" * 60)
+    print("Test 6: NumPy Interop")
+    print("=" * 60)
+
+    # Coordinates: a strided view over the City objects
+    coords = graph.getCoordinatesArray()
+    assert coords.shape == (52, 2), "Coordinate shape mismatch"
+    city = graph.getCity(5)
+    assert coords[5, 0] == city.getX() and coords[5, 1] == city.getY(), "Coordinate mismatch"
+    assert not coords.flags.writeable, "Views must be read-only"
+    assert not coords.flags.owndata, "Coordinates were copied"
+
+    # Distance matrix: a view of the padded rows
+    distances = graph.getDistanceMatrixArray()
+    assert distances.shape == (52, 52), "Distance shape mismatch"
+    assert distances[3, 17] == graph.getDistance(3, 17), "Distance mismatch"
+    assert not distances.flags.owndata, "Distance matrix was copied"
+
+    # Graphs from arrays: coordinates, then the distance matrix itself
+    from_coords = aco_solver.Graph(coords, kind="coords", metric=aco_solver.DistanceMetric.EUC_2D)
+    assert from_coords.getNumCities() == 52, "Coordinate graph size mismatch"
+    assert from_coords.getDistance(3, 17) == graph.getDistance(3, 17), "Coordinate graph mismatch"
+    from_matrix = aco_solver.Graph(distances, kind="distances")
+    assert from_matrix.getDistanceMetric() == aco_solver.DistanceMetric.EXPLICIT
+    assert np.array_equal(from_matrix.getDistanceMatrixArray(), distances), "Matrix graph mismatch"
+
+    # Two cities as coordinates, not as a 2x2 distance matrix
+    pair = aco_solver.Graph(np.array([[0.0, 0.0], [3.0, 4.0]]), kind="coords")
+    assert pair.getDistance(0, 1) == 5.0, "Two-city coordinate graph mismatch"
+
+    # Matrices that are not distances are rejected, not truncated
+    asymmetric = np.array(distances)
+    asymmetric[3, 17] += 1.0
+    diagonal = np.array(distances)
+    diagonal[5, 5] = 1.0
+    for bad in (asymmetric, diagonal):
+        try:
+            aco_solver.Graph(bad, kind="distances")
+            assert False, "Expected an error for an invalid distance matrix"
+        except ValueError:
+            pass
+
+    # Tour and convergence copies
+    colony = aco_solver.AntColony(graph, numAnts=20)
+    colony.setSeed(7)
+    best_tour = colony.solve(20)
+    sequence = best_tour.getSequenceArray()
+    assert sequence.dtype == np.int32, "Sequence dtype mismatch"
+    assert sequence.tolist() == list(best_tour.getSequence()), "Sequence mismatch"
+    history = colony.getConvergenceArray()
+    assert history.tolist() == list(colony.getConvergenceData()), "Convergence mismatch"
+    first_run = history.tolist()
+    colony.solve(5)
+    assert history.tolist() == first_run, "Convergence copy changed by the next solve"
+
+    print(f"✓ Views: coordinates {coords.shape}, distances {distances.shape}, "
+          f"tour {sequence.shape}, history {history.shape}\n")
+
+
+def test_solver_pool(graph):
+    """Test batch solving on a shared SolverPool"""
+    print("=" * 60)
+    print("Test 7: Solver Pool")
+    print("=" * 60)
+
+    pool = aco_solver.SolverPool(2)
+    futures = []
+    for seed in range(6):
+        job = aco_solver.SolverJob(graph, numAnts=10, maxIterations=20, threads=1,
+                                   priority=seed % 2,
+                                   configure=lambda colony, seed=seed: colony.setSeed(seed))
+        futures.append(pool.submit(job))
+
+    results = [future.result() for future in futures]
+    for result in results:
+        assert result.tour.validate(graph.getNumCities()), "Invalid pool tour"
+        assert len(result.convergence) == 20, "Convergence length mismatch"
+    pool.waitIdle()
+    assert pool.getRunningJobs() == 0 and pool.getQueuedJobs() == 0, "Pool not idle"
+
+    # A seeded pool job matches the same solve run directly
+    colony = aco_solver.AntColony(graph, numAnts=10)
+    colony.setSeed(3)
+    colony.setUseParallel(False)
+    assert colony.solve(20).getDistance() == results[3].tour.getDistance(), "Pool result mismatch"
+
+    # Errors reach the future
+    failing = aco_solver.SolverJob(aco_solver.Graph(), numAnts=10)
+    try:
+        pool.submit(failing).result()
+        assert False, "Expected an error for an empty graph"
+    except ValueError:
+        pass
+
+    best = min(result.tour.getDistance() for result in results)
+    print(f"✓ {len(results)} jobs on {pool.getNumThreads()} threads, best {best:.2f}\n")
+
+
+def test_checkpoint(graph):
+    """Test checkpoint/restore and warm start"""
+    print("=" * 60)
+    print("Test 8: Checkpoint and Warm Start")
+    print("=" * 60)
+
+    def seeded():
+        colony = aco_solver.AntColony(graph, numAnts=10)
+        colony.setSeed(5)
+        colony.setUseParallel(False)
+        return colony
+
+    expected = seeded().solve(20)
+
+    with tempfile.TemporaryDirectory() as directory:
+        path = os.path.join(directory, "colony.ckpt")
+        first = seeded()
+        first.setCheckpointFile(path, 5)
+        first.solve(10)
+        assert os.path.exists(path), "No checkpoint written"
+
+        resumed = seeded()
+        assert resumed.restore(path), "Restore failed"
+        assert resumed.hasRestoredState(), "Restored state not pending"
+        tour = resumed.solve(20)
+        assert tour.getSequence() == expected.getSequence(), "Resumed run diverged"
+        assert len(resumed.getConvergenceData()) == 20, "History not continued"
+        assert not aco_solver.AntColony(graph, numAnts=10).restore(
+            os.path.join(directory, "missing.ckpt")), "Restored a missing file"
+
+    # A warm start tour is the best-so-far tour from the first iteration on
+    colony = aco_solver.AntColony(graph, numAnts=10)
+    assert not colony.setWarmStartTour([0, 1, 2]), "Accepted a partial tour"
+    assert colony.setWarmStartTour(expected.getSequence()), "Rejected a valid tour"
+    warm = colony.solve(1)
+    assert warm.getDistance() <= expected.getDistance() + 1e-9, "Warm start ignored"
+
+    print(f"✓ Resumed run matches the uninterrupted one ({expected.getDistance():.2f})\n")
+
+
 def benchmark_performance(graph):
     """Benchmark solver performance"""
     print("=" * 60)
-    print("Test 5: Performance Benchmark")
+    print("Test 9: Performance Benchmark")
     print("=" * 60)
 
     iterations_list = [10, 50, 100]
@@ -182,6 +369,10 @@ def main():
         graph = test_tsplib_loading()
         best_tour = test_aco_with_callback(graph)
         test_tour_validation(graph)
+        test_incremental_callback(graph)
+        test_numpy_interop(graph)
+        test_solver_pool(graph)
+        test_checkpoint(graph)
         benchmark_performance(graph)
 
         print("=" * 60)